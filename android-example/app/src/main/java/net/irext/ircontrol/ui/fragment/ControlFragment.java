@@ -6,7 +6,6 @@ import android.os.Bundle;
 import android.os.Handler;
 import android.os.Message;
 import android.os.Vibrator;
-import android.support.annotation.Nullable;
 import android.support.v4.app.Fragment;
 import android.util.Log;
 import android.view.LayoutInflater;
@@ -15,7 +14,7 @@ import android.view.ViewGroup;
 import android.widget.*;
 
 import net.irext.decodesdk.bean.ACStatus;
-import net.irext.decodesdk.IRDecode;
+import net.irext.decodesdk.IRDecoder;
 import net.irext.decodesdk.utils.Constants;
 import net.irext.ircontrol.R;
 import net.irext.ircontrol.bean.RemoteControl;
@@ -64,8 +63,8 @@ public class ControlFragment extends Fragment implements View.OnClickListener {
     private Long mRemoteID;
     private RemoteControl mCurrentRemoteControl;
 
-    // define the single instance of IRDecode
-    private IRDecode mIRDecode;
+    // decoder of the remote shown, decodes run on its executor off the UI thread
+    private IRDecoder mIRDecoder;
 
     public ControlFragment() {
     }
@@ -74,7 +73,6 @@ public class ControlFragment extends Fragment implements View.OnClickListener {
     public View onCreateView(LayoutInflater inflater, ViewGroup container,
                              Bundle savedInstanceState) {
 
-        mIRDecode = IRDecode.getInstance();
         mHandler = new MsgHandler(this);
 
         mParent = (ControlActivity)getActivity();
@@ -121,12 +119,7 @@ public class ControlFragment extends Fragment implements View.OnClickListener {
     }
 
     private void getRemote() {
-        new Thread() {
-            @Override
-            public void run() {
-                MessageUtil.postMessage(mHandler, CMD_GET_REMOTE_CONTROL);
-            }
-        }.start();
+        MessageUtil.postMessage(mHandler, CMD_GET_REMOTE_CONTROL);
     }
 
     private void showRemote() {
@@ -137,7 +130,8 @@ public class ControlFragment extends Fragment implements View.OnClickListener {
                     mCurrentRemoteControl.getRemoteMap() + FileUtils.FILE_NAME_EXT;
 
             /* decode SDK - load binary file */
-            int ret = mIRDecode.openFile(category, mCurrentRemoteControl.getSubCategory(), binFileName);
+            closeIRBinary();
+            mIRDecoder = IRDecoder.openFile(category, mCurrentRemoteControl.getSubCategory(), binFileName);
             File binFile = new File(binFileName);
             byte []binaries = new byte[(int)binFile.length()];
             try {
@@ -148,17 +142,22 @@ public class ControlFragment extends Fragment implements View.OnClickListener {
             } catch (Exception e) {
                 e.printStackTrace();
             }
-            Log.d(TAG, "binary opened : " + ret);
+            Log.d(TAG, "binary opened : " + (null != mIRDecoder));
         }
     }
 
     public void closeIRBinary() {
-        mIRDecode.closeBinary();
+        if (null != mIRDecoder) {
+            mIRDecoder.close();
+            mIRDecoder = null;
+        }
     }
 
-    @Nullable
-    private int[] irControl(int keyCode) {
+    private void irControl(int keyCode) {
         int inputKeyCode;
+        if (null == mIRDecoder) {
+            return;
+        }
         ACStatus acStatus = new ACStatus();
         /* decode SDK - decode according to key code */
         if (Constants.CategoryID.AIR_CONDITIONER.getValue() ==
@@ -203,7 +202,7 @@ public class ControlFragment extends Fragment implements View.OnClickListener {
                     break;
 
                 default:
-                    return null;
+                    return;
             }
         } else {
             inputKeyCode = keyCode;
@@ -213,67 +212,68 @@ public class ControlFragment extends Fragment implements View.OnClickListener {
         /* translate key code for AC according to the mapping above */
         /* ac status is useless for decoding devices other than AC, it's an optional parameter */
         /* change wind dir is an optional parameter, set to 0 as default */
-        return mIRDecode.decodeBinary(inputKeyCode, acStatus, 0);
+        /* the decoded integer array is sent to IR emitter from the decode thread */
+        final ConsumerIrManager irEmitter =
+                (ConsumerIrManager) mParent.getSystemService(Context.CONSUMER_IR_SERVICE);
+        mIRDecoder.decodeAsync(inputKeyCode, acStatus, 0, new IRDecoder.DecodeCallback() {
+            @Override
+            public void onDecoded(int[] decoded) {
+                if (irEmitter.hasIrEmitter() && decoded.length > 0) {
+                    irEmitter.transmit(38000, decoded);
+                }
+            }
+        });
     }
 
     // control
     @Override
     public void onClick(View v) {
         vibrate(mParent);
-        int []decoded = null;
         switch(v.getId()) {
             case R.id.iv_power:
-                decoded = irControl(KEY_POWER);
+                irControl(KEY_POWER);
                 break;
 
             case R.id.iv_up:
-                decoded = irControl(KEY_UP);
+                irControl(KEY_UP);
                 break;
 
             case R.id.iv_down:
-                decoded = irControl(KEY_DOWN);
+                irControl(KEY_DOWN);
                 break;
 
             case R.id.iv_left:
-                decoded = irControl(KEY_LEFT);
+                irControl(KEY_LEFT);
                 break;
 
             case R.id.iv_right:
-                decoded = irControl(KEY_RIGHT);
+                irControl(KEY_RIGHT);
                 break;
 
             case R.id.iv_ok:
-                decoded = irControl(KEY_OK);
+                irControl(KEY_OK);
                 break;
 
             case R.id.iv_plus:
-                decoded = irControl(KEY_PLUS);
+                irControl(KEY_PLUS);
                 break;
 
             case R.id.iv_minus:
-                decoded = irControl(KEY_MINUS);
+                irControl(KEY_MINUS);
                 break;
 
             case R.id.iv_back:
-                decoded = irControl(KEY_BACK);
+                irControl(KEY_BACK);
                 break;
 
             case R.id.iv_home:
-                decoded = irControl(KEY_HOME);
+                irControl(KEY_HOME);
                 break;
 
             case R.id.iv_menu:
-                decoded = irControl(KEY_MENU);
+                irControl(KEY_MENU);
                 break;
         }
-        // send decoded integer array to IR emitter
-        ConsumerIrManager irEmitter =
-                (ConsumerIrManager) mParent.getSystemService(Context.CONSUMER_IR_SERVICE);
-        if (irEmitter.hasIrEmitter()) {
-            if (null != decoded && decoded.length > 0) {
-                irEmitter.transmit(38000, decoded);
-            }
-        }
     }
 
     private static class MsgHandler extends Handler {
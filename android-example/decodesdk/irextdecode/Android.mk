@@ -14,6 +14,16 @@ LOCAL_SRC_FILES := ./jni/ir_decode_jni.c \
                    ./src/ir_ac_parse_frame_info.c \
 				   ./src/ir_ac_binary_parse.c \
 				   ./src/ir_ac_control.c \
+                   ./src/ir_ac_cache.c \
+                   ./src/ir_ac_compiled.c \
+                   ./src/ir_ac_memo.c \
+                   ./src/ir_ac_delta.c \
+                   ./src/ir_output.c \
+                   ./src/ir_waveform.c \
+                   ./src/ir_codec.c \
+                   ./src/ir_alloc.c \
+                   ./src/ir_scan.c \
+                   ./src/ir_bundle.c \
                    ./src/ir_utils.c \
 
 LOCAL_LDLIBS += -L$(SYSROOT)/usr/lib -llog
@@ -22,15 +22,15 @@ extern "C"
 #define MIN_TAG_LENGTH_TYPE_1   4
 #define MIN_TAG_LENGTH_TYPE_2   6
 
-INT8 apply_power(remote_ac_status_t ac_status, UINT8 function_code);
+INT8 apply_power(protocol *context, remote_ac_status_t ac_status, UINT8 function_code);
 
-INT8 apply_mode(remote_ac_status_t ac_status, UINT8 function_code);
+INT8 apply_mode(protocol *context, remote_ac_status_t ac_status, UINT8 function_code);
 
-INT8 apply_wind_speed(remote_ac_status_t ac_status, UINT8 function_code);
+INT8 apply_wind_speed(protocol *context, remote_ac_status_t ac_status, UINT8 function_code);
 
-INT8 apply_swing(remote_ac_status_t ac_status, UINT8 function_code);
+INT8 apply_swing(protocol *context, remote_ac_status_t ac_status, UINT8 function_code);
 
-INT8 apply_temperature(remote_ac_status_t ac_status, UINT8 function_code);
+INT8 apply_temperature(protocol *context, remote_ac_status_t ac_status, UINT8 function_code);
 
 INT8 apply_function(struct ac_protocol *protocol, UINT8 function);
 
@@ -19,13 +19,15 @@ extern "C"
 
 #include "ir_defs.h"
 
-extern INT8 binary_parse_offset();
+struct ir_decoder;
 
-extern INT8 binary_parse_len();
+extern INT8 binary_parse_offset(struct ir_decoder *decoder);
 
-extern void binary_tags_info();
+extern INT8 binary_parse_len(struct ir_decoder *decoder);
 
-extern INT8 binary_parse_data();
+extern void binary_tags_info(struct ir_decoder *decoder);
+
+extern INT8 binary_parse_data(struct ir_decoder *decoder);
 
 #ifdef __cplusplus
 }
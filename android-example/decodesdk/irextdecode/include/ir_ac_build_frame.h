@@ -18,8 +18,16 @@ extern "C"
 #endif
 
 #include "ir_defs.h"
+#include "ir_ac_control.h"
+#include "ir_output.h"
 
-extern UINT16 create_ir_frame();
+// work out the frame plan of a parsed protocol, once its code length, bitnum and delay codes are known
+extern void build_frame_plan(protocol *context);
+
+extern UINT create_ir_frame(protocol *context, ir_output_t *output);
+
+// number of timings create_ir_frame puts, repeats included
+extern UINT ac_frame_length(protocol *context);
 
 #ifdef __cplusplus
 }
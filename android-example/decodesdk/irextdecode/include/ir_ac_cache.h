@@ -0,0 +1,145 @@
+/**************************************************************************************
+Filename:       ir_ac_cache.h
+Revised:        Date: 2026-10-17
+Revision:       Revision: 1.0
+
+Description:    This file provides a cache of parsed AC protocols keyed by binary content
+
+Revision log:
+* 2026-10-17: created by agent
+**************************************************************************************/
+
+#ifndef _IR_AC_CACHE_H_
+#define _IR_AC_CACHE_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+
+#include "ir_defs.h"
+#include "ir_ac_control.h"
+
+#define IR_AC_CACHE_BUCKETS          64
+
+typedef void (*ir_ac_cache_lock_t)(void *lock_data);
+
+/*
+ * a parsed protocol shared by every decoder opened from the same binary content,
+ * the protocol is never modified after insertion, decoders take a shallow copy
+ * of it and only own their working frame (ir_hex_code)
+ * the source binary is kept with the entry so that a hash collision is never taken as a hit
+ */
+typedef struct ir_ac_cache_entry
+{
+    UINT64 hash;
+    UINT8 *binary;
+    UINT16 binary_length;
+    UINT16 ref_count;
+    size_t size;
+    protocol ac;
+    struct ir_ac_cache *cache;
+    struct ir_ac_cache_entry *hash_next;
+    struct ir_ac_cache_entry *lru_prev;
+    struct ir_ac_cache_entry *lru_next;
+} ir_ac_cache_entry_t;
+
+/*
+ * LRU cache of parsed AC protocols, the caller owns the storage
+ * a cache is not locked unless a lock is set with ir_ac_cache_set_lock, without one opens and closes
+ * of decoders sharing one cache must not run concurrently, while decoding with decoders sharing entries is safe
+ */
+typedef struct ir_ac_cache
+{
+    size_t memory_budget;
+    size_t memory_used;
+    UINT entry_count;
+    UINT hits;
+    UINT misses;
+    UINT evictions;
+    ir_ac_cache_entry_t *buckets[IR_AC_CACHE_BUCKETS];
+    ir_ac_cache_entry_t *lru_head;
+    ir_ac_cache_entry_t *lru_tail;
+    ir_ac_cache_lock_t lock_fn;
+    ir_ac_cache_lock_t unlock_fn;
+    void *lock_data;
+} ir_ac_cache_t;
+
+typedef struct ir_ac_cache_stats
+{
+    UINT hits;
+    UINT misses;
+    UINT evictions;
+    UINT entry_count;
+    size_t memory_used;
+    size_t memory_budget;
+} ir_ac_cache_stats_t;
+
+/**
+ * function     ir_ac_cache_init
+ *
+ * description: initialize an empty parsed protocol cache
+ *
+ * parameters:  cache (in) - cache storage
+ *              memory_budget (in) - bytes of parsed protocol data the cache may keep,
+ *                                   entries still opened by a decoder are never evicted
+ *
+ * returns:     IR_DECODE_SUCCEEDED / IR_DECODE_FAILED
+ */
+extern INT8 ir_ac_cache_init(ir_ac_cache_t *cache, size_t memory_budget);
+
+/**
+ * function     ir_ac_cache_set_lock
+ *
+ * description: lock a cache around its lookups, inserts and releases so that decoders could be opened
+ *              and closed with it from several threads, binaries are parsed outside of the lock
+ *
+ * parameters:  cache (in) - cache
+ *              lock_fn (in) - takes the lock, NULL for no locking
+ *              unlock_fn (in) - releases the lock, NULL for no locking
+ *              lock_data (in) - parameter passed to lock_fn and unlock_fn
+ *
+ * returns:     IR_DECODE_SUCCEEDED / IR_DECODE_FAILED
+ */
+extern INT8 ir_ac_cache_set_lock(ir_ac_cache_t *cache, ir_ac_cache_lock_t lock_fn, ir_ac_cache_lock_t unlock_fn,
+                                 void *lock_data);
+
+/**
+ * function     ir_ac_cache_destroy
+ *
+ * description: release every cached protocol, decoders opened with the cache should be closed before
+ *
+ * parameters:  cache (in) - cache to destroy
+ *
+ * returns:     IR_DECODE_SUCCEEDED / IR_DECODE_FAILED (entries still referenced, they are kept)
+ */
+extern INT8 ir_ac_cache_destroy(ir_ac_cache_t *cache);
+
+/**
+ * function     ir_ac_cache_get_stats
+ *
+ * description: get hit / miss counters and memory usage of a cache
+ *
+ * parameters:  cache (in) - cache
+ *              stats (out) - statistics
+ *
+ * returns:     IR_DECODE_SUCCEEDED / IR_DECODE_FAILED
+ */
+extern INT8 ir_ac_cache_get_stats(ir_ac_cache_t *cache, ir_ac_cache_stats_t *stats);
+
+// internal functions used by decoder open / close
+extern ir_ac_cache_entry_t *ir_ac_cache_acquire(ir_ac_cache_t *cache, UINT8 *binary, UINT16 binary_length,
+                                                UINT64 *hash);
+
+extern ir_ac_cache_entry_t *ir_ac_cache_insert(ir_ac_cache_t *cache, UINT64 hash,
+                                               UINT8 *binary, UINT16 binary_length, protocol *context);
+
+extern void ir_ac_cache_release(ir_ac_cache_entry_t *entry);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _IR_AC_CACHE_H_
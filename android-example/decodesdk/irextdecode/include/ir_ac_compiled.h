@@ -0,0 +1,62 @@
+/**************************************************************************************
+Filename:       ir_ac_compiled.h
+Revised:        Date: 2026-10-17
+Revision:       Revision: 1.0
+
+Description:    This file provides the precompiled AC binary format
+
+Revision log:
+* 2026-10-17: created by agent
+**************************************************************************************/
+
+#ifndef _IR_AC_COMPILED_H_
+#define _IR_AC_COMPILED_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "ir_defs.h"
+#include "ir_ac_control.h"
+
+/*
+ * compiled image layout, all integers are little endian
+ *
+ * header:      magic "IRCA" (4) | version (2) | reserved (2) | image length (4)
+ * fixed part:  every protocol field in a fixed order, see io_protocol in ir_ac_compiled.c,
+ *              byte arrays are referred to as length (1) | offset from image start (2)
+ * data part:   byte arrays referred to by the fixed part
+ *
+ * loading an image resolves the byte arrays to pointers into the image itself,
+ * thus the image should be kept until the decoder is closed
+ */
+#define IR_AC_COMPILED_MAGIC         "IRCA"
+#define IR_AC_COMPILED_VERSION       1
+#define IR_AC_COMPILED_HEADER_SIZE   12
+
+#define IR_AC_COMPILED_MAX_SWING     16
+#define IR_AC_COMPILED_MAX_CHECKSUM  8
+#define IR_AC_COMPILED_MAX_CODE      255
+
+// arrays of structures a compiled image is loaded into, allocated by the decoder instance on load
+typedef struct ir_ac_compiled_storage
+{
+    tag_comp swing1[IR_AC_COMPILED_MAX_SWING];
+    tag_comp swing2[IR_AC_COMPILED_MAX_SWING];
+    tag_checksum_data checksum[IR_AC_COMPILED_MAX_CHECKSUM];
+    UINT8 ir_hex_code[IR_AC_COMPILED_MAX_CODE];
+} ir_ac_compiled_storage_t;
+
+extern BOOL ir_ac_is_compiled(UINT8 *binary, UINT16 binary_length);
+
+extern INT8 ir_ac_compile(protocol *context, UINT8 *image, UINT16 *image_length);
+
+extern INT8 ir_ac_compiled_load(protocol *context, ir_ac_compiled_storage_t *storage,
+                                UINT8 *image, UINT16 image_length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _IR_AC_COMPILED_H_
@@ -16,6 +16,8 @@ extern "C"
 {
 #endif
 
+#include <stddef.h>
+
 #include "ir_defs.h"
 
 
@@ -25,6 +27,8 @@ extern "C"
 
 #define MAX_DELAYCODE_NUM            16
 #define MAX_BITNUM                   16
+// bytes of a frame sent with other than 8 bits or followed by delay codes
+#define MAX_FRAME_STEP               (MAX_BITNUM + MAX_DELAYCODE_NUM)
 
 #define AC_PARAMETER_TYPE_1          0
 #define AC_PARAMETER_TYPE_2          1
@@ -275,6 +279,32 @@ typedef struct _ac_bitnum
     UINT16 bits;
 } ac_bitnum;
 
+typedef struct _ac_frame_step
+{
+    UINT8 pos;
+    UINT8 bits;
+    // delay codes sent after the byte, dc_order[dc_first] onwards
+    UINT8 dc_first;
+    UINT8 dc_count;
+} ac_frame_step;
+
+/*
+ * frame layout worked out once from bitnum and delay codes, bytes between steps are sent with
+ * 8 bits each, nibble_timing holds the 8 timings of every nibble in the order they are sent
+ */
+typedef struct _ac_frame_plan
+{
+    UINT16 nibble_timing[16][8];
+    ac_frame_step step[MAX_FRAME_STEP];
+    UINT8 step_cnt;
+    UINT8 dc_order[MAX_DELAYCODE_NUM];
+    // delay code sent at the end of frame, 0xFF for none
+    UINT8 tail_dc;
+    // timings of a frame, whatever the bytes are
+    UINT frame_length;
+    UINT8 ready;
+} ac_frame_plan;
+
 typedef enum
 {
     N_COOL = 0,
@@ -350,6 +380,16 @@ typedef struct ac_protocol
     UINT8 lastbit;
     UINT16 *time;
     UINT8 solo_function_mark;
+
+    // working frame the parameters are applied to, sized as default code
+    UINT8 *ir_hex_code;
+    UINT8 ir_hex_len;
+    // allocated when built, few boards could afford it in every protocol
+    ac_frame_plan *frame_plan;
+
+    // binary the parameter segments were decoded into, they are not freed with the context
+    UINT8 *in_place_data;
+    UINT16 in_place_len;
 } protocol;
 
 typedef struct tag_head
@@ -358,6 +398,8 @@ typedef struct tag_head
     UINT16 len;
     unsigned short offset;
     UINT8 *pdata;
+    // hex text is decoded over itself and kept referenced by the parsed protocol
+    UINT8 in_place;
 } t_tag_head;
 
 struct ir_bin_buffer
@@ -380,7 +422,7 @@ typedef struct REMOTE_AC_STATUS
 } remote_ac_status_t;
 
 // function polymorphism
-typedef INT8 (*lp_apply_ac_parameter)(remote_ac_status_t ac_status, UINT8 function_code);
+typedef INT8 (*lp_apply_ac_parameter)(protocol *context, remote_ac_status_t ac_status, UINT8 function_code);
 
 
 #define TAG_AC_BOOT_CODE                  1
@@ -415,22 +457,39 @@ typedef INT8 (*lp_apply_ac_parameter)(remote_ac_status_t ac_status, UINT8 functi
 #define TAG_AC_REPEAT_TIMES               47
 #define TAG_AC_BITNUM                     48
 
+// groups of tags parsed together, those but the frame group are parsed when first needed by a lazily opened remote
+#define AC_TAG_GROUP_FRAME                0x0001
+#define AC_TAG_GROUP_POWER                0x0002
+#define AC_TAG_GROUP_MODE                 0x0004
+#define AC_TAG_GROUP_TEMPERATURE          0x0008
+#define AC_TAG_GROUP_WIND_SPEED           0x0010
+#define AC_TAG_GROUP_SWING                0x0020
+#define AC_TAG_GROUP_FUNCTION             0x0040
+#define AC_TAG_GROUP_SOLO                 0x0080
+#define AC_TAG_GROUP_BAN                  0x0100
+#define AC_TAG_GROUP_CHECKSUM             0x0200
+#define AC_TAG_GROUP_ALL                  0x03FF
 
 // definition about size
 
 #define PROTOCOL_SIZE (sizeof(protocol))
 
-/* exported variables */
-extern UINT8 *ir_hex_code;
-extern UINT8 ir_hex_len;
-extern protocol *context;
+// first arena block for an AC binary of A bytes, the tag index, the hex text decoded
+// and the segments parsed from it with their alignment and the frame plan
+#define AC_ARENA_SIZE(A) (TAG_COUNT_FOR_PROTOCOL * sizeof(t_tag_head) + (size_t) (A) * 3 / 2 + \
+                          sizeof(ac_frame_plan))
+
+struct ir_decoder;
+
+extern INT8 ir_ac_lib_parse(struct ir_decoder *decoder);
 
+extern INT8 ir_ac_lib_parse_groups(struct ir_decoder *decoder, UINT16 groups);
 
-extern INT8 ir_ac_lib_parse();
+extern INT8 free_ac_context(protocol *context);
 
-extern INT8 free_ac_context();
+extern size_t ac_context_size(protocol *context);
 
-extern BOOL is_solo_function(UINT8 function_code);
+extern BOOL is_solo_function(protocol *context, UINT8 function_code);
 
 #ifdef __cplusplus
 }
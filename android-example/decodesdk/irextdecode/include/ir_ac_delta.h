@@ -0,0 +1,93 @@
+/**************************************************************************************
+Filename:       ir_ac_delta.h
+Revised:        Date: 2026-10-17
+Revision:       Revision: 1.0
+
+Description:    This file provides the incremental re-encoding of the AC working frame
+
+Revision log:
+* 2026-10-17: created by agent
+**************************************************************************************/
+
+#ifndef _IR_AC_DELTA_H_
+#define _IR_AC_DELTA_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "ir_defs.h"
+#include "ir_ac_control.h"
+
+// steps of a frame rebuild in the order they are applied, followed by a step for every function code
+typedef enum
+{
+    AC_DELTA_POWER = 0,
+    AC_DELTA_MODE,
+    AC_DELTA_WIND_SPEED,
+    AC_DELTA_SWING,
+    AC_DELTA_TEMPERATURE,
+    AC_DELTA_CHECKSUM,
+    AC_DELTA_FUNCTION,
+    AC_DELTA_MAX = AC_DELTA_FUNCTION + AC_FUNCTION_MAX - 1
+} ac_delta_step;
+
+/*
+ * the status the working frame of a decoder was last built with, and the bits every step
+ * of a rebuild may write, so that a changed step is applied over the frame as it is
+ */
+typedef struct ir_ac_delta
+{
+    // bytes a step may write and the bits of them, the ones of a step start at first[step]
+    UINT16 first[AC_DELTA_MAX + 1];
+    UINT8 *positions;
+    UINT8 *bits;
+    // the steps of wind speed, swing and temperature writing bits of each step, a bit for every step
+    UINT8 overlaps[AC_DELTA_MAX];
+    // the steps a rebuild with power on applies, a bit for every step
+    UINT8 applied;
+    // the frame of base_mode before wind speed, swing and temperature are applied
+    UINT8 *base;
+    UINT8 base_mode;
+    BOOL base_ready;
+    // cleared for remotes with a segment out of their frame or of no range, they are always rebuilt
+    BOOL usable;
+    // set while the working frame is the one of status, function_code and swing_status
+    BOOL valid;
+    remote_ac_status_t status;
+    UINT8 function_code;
+    UINT8 swing_status;
+    UINT patched;
+    UINT rebuilt;
+    UINT overlapped;
+} ir_ac_delta_t;
+
+typedef struct ir_ac_delta_stats
+{
+    // frames patched in place
+    UINT patched;
+    // frames built from default code
+    UINT rebuilt;
+    // frames rebuilt because the steps to apply again overlap every other step
+    UINT overlapped;
+} ir_ac_delta_stats_t;
+
+// internal functions used by decoder decode / close
+extern ir_ac_delta_t *ir_ac_delta_create(protocol *context);
+
+extern void ir_ac_delta_destroy(ir_ac_delta_t *delta);
+
+extern void ir_ac_delta_get_stats(ir_ac_delta_t *delta, ir_ac_delta_stats_t *stats);
+
+extern BOOL ir_ac_delta_apply(ir_ac_delta_t *delta, protocol *context, remote_ac_status_t *ac_status,
+                              UINT8 function_code, INT8 *ret);
+
+extern void ir_ac_delta_record(ir_ac_delta_t *delta, protocol *context, remote_ac_status_t *ac_status,
+                               UINT8 function_code, INT8 ret);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _IR_AC_DELTA_H_
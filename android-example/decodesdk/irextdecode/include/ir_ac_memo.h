@@ -0,0 +1,108 @@
+/**************************************************************************************
+Filename:       ir_ac_memo.h
+Revised:        Date: 2026-10-17
+Revision:       Revision: 1.0
+
+Description:    This file provides a cache of decoded AC frames keyed by AC status
+
+Revision log:
+* 2026-10-17: created by agent
+**************************************************************************************/
+
+#ifndef _IR_AC_MEMO_H_
+#define _IR_AC_MEMO_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+
+#include "ir_defs.h"
+#include "ir_ac_control.h"
+
+#define IR_AC_MEMO_BUCKETS           256
+
+/*
+ * everything a decoded AC frame depends on besides the protocol itself,
+ * swing_status and dir_index are the swing state of the decoder before the decode
+ */
+typedef struct ir_ac_memo_key
+{
+    UINT8 power;
+    UINT8 temperature;
+    UINT8 mode;
+    UINT8 wind_dir;
+    UINT8 wind_speed;
+    UINT8 display;
+    UINT8 sleep;
+    UINT8 timer;
+    UINT8 function_code;
+    UINT8 change_wind_direction;
+    UINT8 swing_status;
+    UINT8 dir_index;
+} ir_ac_memo_key_t;
+
+/*
+ * a decoded frame and the swing state of the decoder after the decode,
+ * the timings are allocated right after the entry
+ */
+typedef struct ir_ac_memo_entry
+{
+    UINT64 hash;
+    ir_ac_memo_key_t key;
+    UINT8 swing_status;
+    UINT8 dir_index;
+    UINT16 length;
+    size_t size;
+    UINT16 *timings;
+    struct ir_ac_memo_entry *hash_next;
+    struct ir_ac_memo_entry *lru_prev;
+    struct ir_ac_memo_entry *lru_next;
+} ir_ac_memo_entry_t;
+
+// LRU cache of decoded frames of a single decoder instance
+typedef struct ir_ac_memo
+{
+    size_t memory_budget;
+    size_t memory_used;
+    UINT entry_count;
+    UINT hits;
+    UINT misses;
+    UINT evictions;
+    ir_ac_memo_entry_t *buckets[IR_AC_MEMO_BUCKETS];
+    ir_ac_memo_entry_t *lru_head;
+    ir_ac_memo_entry_t *lru_tail;
+} ir_ac_memo_t;
+
+typedef struct ir_ac_memo_stats
+{
+    UINT hits;
+    UINT misses;
+    UINT evictions;
+    UINT entry_count;
+    size_t memory_used;
+    size_t memory_budget;
+} ir_ac_memo_stats_t;
+
+// internal functions used by decoder decode / close
+extern ir_ac_memo_t *ir_ac_memo_create(size_t memory_budget);
+
+extern void ir_ac_memo_destroy(ir_ac_memo_t *memo);
+
+extern void ir_ac_memo_get_stats(ir_ac_memo_t *memo, ir_ac_memo_stats_t *stats);
+
+extern BOOL ir_ac_memo_make_key(ir_ac_memo_key_t *key, remote_ac_status_t *ac_status, UINT8 function_code,
+                                BOOL change_wind_direction, protocol *context);
+
+extern ir_ac_memo_entry_t *ir_ac_memo_lookup(ir_ac_memo_t *memo, ir_ac_memo_key_t *key, UINT64 *hash);
+
+extern void ir_ac_memo_store(ir_ac_memo_t *memo, UINT64 hash, ir_ac_memo_key_t *key,
+                             UINT16 *timings, UINT16 length, protocol *context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _IR_AC_MEMO_H_
@@ -19,7 +19,7 @@ extern "C"
 
 #include "ir_decode.h"
 
-extern INT8 parse_nmode(struct tag_head *tag, ac_n_mode index);
+extern INT8 parse_nmode(protocol *context, struct tag_head *tag, ac_n_mode index);
 
 #ifdef __cplusplus
 }
@@ -19,23 +19,23 @@ extern "C"
 
 #include "ir_decode.h"
 
-extern INT8 parse_boot_code(struct tag_head *tag);
+extern INT8 parse_boot_code(protocol *context, struct tag_head *tag);
 
-extern INT8 parse_zero(struct tag_head *tag);
+extern INT8 parse_zero(protocol *context, struct tag_head *tag);
 
-extern INT8 parse_one(struct tag_head *tag);
+extern INT8 parse_one(protocol *context, struct tag_head *tag);
 
-extern INT8 parse_delay_code(struct tag_head *tag);
+extern INT8 parse_delay_code(protocol *context, struct tag_head *tag);
 
-extern INT8 parse_frame_len(struct tag_head *tag, UINT16 len);
+extern INT8 parse_frame_len(protocol *context, struct tag_head *tag, UINT16 len);
 
-extern INT8 parse_endian(struct tag_head *tag);
+extern INT8 parse_endian(protocol *context, struct tag_head *tag);
 
-extern INT8 parse_lastbit(struct tag_head *tag);
+extern INT8 parse_lastbit(protocol *context, struct tag_head *tag);
 
-extern INT8 parse_repeat_times(struct tag_head *tag);
+extern INT8 parse_repeat_times(protocol *context, struct tag_head *tag);
 
-extern INT8 parse_bit_num(struct tag_head *tag);
+extern INT8 parse_bit_num(protocol *context, struct tag_head *tag);
 
 #ifdef __cplusplus
 }
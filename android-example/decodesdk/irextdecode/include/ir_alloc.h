@@ -0,0 +1,127 @@
+/**************************************************************************************
+Filename:       ir_alloc.h
+Revised:        Date: 2026-10-17
+Revision:       Revision: 1.0
+
+Description:    This file provides the pluggable allocator and the parse arena of IR decode
+
+Revision log:
+* 2026-10-17: created by agent
+**************************************************************************************/
+
+#ifndef _IR_ALLOC_H_
+#define _IR_ALLOC_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+
+#include "ir_defs.h"
+
+// allocator behind ir_malloc / ir_free, alloc_context is passed back to both functions
+typedef struct ir_allocator
+{
+    void *(*malloc_fn)(void *alloc_context, size_t size);
+    void (*free_fn)(void *alloc_context, void *ptr);
+    void *alloc_context;
+} ir_allocator_t;
+
+// counted on the allocator, allocations served by an arena block are not counted
+typedef struct ir_alloc_stats
+{
+    UINT alloc_count;
+    UINT free_count;
+    size_t live_bytes;
+    size_t peak_bytes;
+} ir_alloc_stats_t;
+
+typedef struct ir_arena_block
+{
+    struct ir_arena_block *next;
+    size_t size;
+    size_t used;
+} ir_arena_block_t;
+
+// parsed state of one remote, blocks are chained only if the first one is outgrown
+typedef struct ir_arena
+{
+    ir_arena_block_t *head;
+    size_t last;
+    UINT block_count;
+    struct ir_arena *previous;
+} ir_arena_t;
+
+/**
+ * function     ir_set_allocator
+ *
+ * description: replace the allocator used by the library, should be called before any remote is opened
+ *
+ * parameters:  allocator (in) - allocator to use, NULL restores malloc / free
+ *
+ * returns:     N/A
+ */
+extern void ir_set_allocator(const ir_allocator_t *allocator);
+
+/**
+ * function     ir_set_ac_arena
+ *
+ * description: parse each AC remote into a single block sized from its binary, closing the
+ *              remote releases the block as a whole instead of freeing every segment,
+ *              AC remotes opened through a protocol cache fail to open meanwhile
+ *
+ * parameters:  enable (in) - TRUE to parse AC remotes opened from now on into an arena
+ *
+ * returns:     N/A
+ */
+extern void ir_set_ac_arena(BOOL enable);
+
+extern BOOL ir_get_ac_arena();
+
+/**
+ * function     ir_get_alloc_stats / ir_reset_alloc_stats
+ *
+ * description: get allocation count and peak bytes of the allocator since start or last reset,
+ *              reset keeps the live bytes and restarts the peak from them
+ *
+ * parameters:  stats (out) - allocation statistics
+ *
+ * returns:     N/A
+ */
+extern void ir_get_alloc_stats(ir_alloc_stats_t *stats);
+
+extern void ir_reset_alloc_stats();
+
+/**
+ * function     ir_arena_begin / ir_arena_end
+ *
+ * description: serve ir_malloc of the calling thread from the arena between begin and end,
+ *              ir_free of an arena allocation only gives back the latest one
+ *
+ * parameters:  arena (in) - arena, zeroed before the first begin
+ *              size (in) - size of the first block, reserved on the first begin
+ *
+ * returns:     IR_DECODE_SUCCEEDED / IR_DECODE_FAILED
+ */
+extern INT8 ir_arena_begin(ir_arena_t *arena, size_t size);
+
+extern void ir_arena_end(ir_arena_t *arena);
+
+/**
+ * function     ir_arena_release
+ *
+ * description: release every block of an arena, outside of begin and end
+ *
+ * parameters:  arena (in) - arena
+ *
+ * returns:     N/A
+ */
+extern void ir_arena_release(ir_arena_t *arena);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _IR_ALLOC_H_
@@ -0,0 +1,138 @@
+/**************************************************************************************
+Filename:       ir_bundle.h
+Revised:        Date: 2026-10-17
+Revision:       Revision: 1.0
+
+Description:    This file provides the single file bundle of IR binaries
+
+Revision log:
+* 2026-10-17: created by agent
+**************************************************************************************/
+
+#ifndef _IR_BUNDLE_H_
+#define _IR_BUNDLE_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+
+#include "ir_defs.h"
+#include "ir_decode.h"
+
+/*
+ * bundle layout, all integers are little endian
+ *
+ * header:      magic "IRXB" (4) | version (2) | reserved (2) | entry count (4) | bundle length (4)
+ * name index:  entry count records sorted by remote map name (byte order),
+ *              remote id (4) | category (1) | sub_category (1) | reserved (2) |
+ *              blob offset (4) | blob length (4) | remote map name, NUL padded (32)
+ * id index:    entry count records sorted by remote id,
+ *              remote id (4) | position of the record in the name index (4)
+ * blobs:       IR binaries, each starting at a multiple of IR_BUNDLE_ALIGNMENT
+ *
+ * remote ids and remote map names are unique within a bundle
+ */
+#define IR_BUNDLE_MAGIC              "IRXB"
+#define IR_BUNDLE_VERSION            1
+#define IR_BUNDLE_HEADER_SIZE        16
+#define IR_BUNDLE_RECORD_SIZE        48
+#define IR_BUNDLE_ID_RECORD_SIZE     8
+#define IR_BUNDLE_NAME_SIZE          32
+#define IR_BUNDLE_ALIGNMENT          16
+
+// an opened bundle, the caller owns the storage
+typedef struct ir_bundle
+{
+    UINT8 *content;
+    size_t length;
+    // content is mapped or read by ir_bundle_open_file and released on close
+    UINT8 owned;
+    UINT entry_count;
+    UINT8 *names;
+    UINT8 *ids;
+} ir_bundle_t;
+
+// a remote in a bundle, binary points into the bundle content
+typedef struct ir_bundle_item
+{
+    UINT remote_id;
+    UINT8 category;
+    UINT8 sub_category;
+    char name[IR_BUNDLE_NAME_SIZE];
+    UINT8 *binary;
+    UINT16 binary_length;
+} ir_bundle_item_t;
+
+/**
+ * function     ir_bundle_open_file
+ *
+ * description: open a bundle file, the file is mapped read only where supported
+ *
+ * parameters:  bundle (in) - bundle storage
+ *              file_name (in) - file name of the bundle
+ *
+ * returns:     IR_DECODE_SUCCEEDED / IR_DECODE_FAILED
+ */
+extern INT8 ir_bundle_open_file(ir_bundle_t *bundle, const char *file_name);
+
+/**
+ * function     ir_bundle_open_binary
+ *
+ * description: open a bundle from buffer
+ *
+ * parameters:  bundle (in) - bundle storage
+ *              content (in) - pointer to bundle buffer, should be kept until the bundle is closed
+ *              length (in) - bundle buffer size
+ *
+ * returns:     IR_DECODE_SUCCEEDED / IR_DECODE_FAILED
+ */
+extern INT8 ir_bundle_open_binary(ir_bundle_t *bundle, UINT8 *content, size_t length);
+
+/**
+ * function     ir_bundle_close
+ *
+ * description: close a bundle, decoders opened from its items should be closed before
+ *
+ * parameters:  bundle (in) - bundle
+ *
+ * returns:     IR_DECODE_SUCCEEDED / IR_DECODE_FAILED
+ */
+extern INT8 ir_bundle_close(ir_bundle_t *bundle);
+
+/**
+ * function     ir_bundle_find_name / ir_bundle_find_id / ir_bundle_get
+ *
+ * description: look up a remote by remote map name, by remote id or by position in the name index
+ *
+ * parameters:  bundle (in) - bundle
+ *              name / remote_id / index (in) - key of the remote
+ *              item (out) - remote found, its binary could be passed to ir_binary_open as is
+ *
+ * returns:     IR_DECODE_SUCCEEDED / IR_DECODE_FAILED (not found)
+ */
+extern INT8 ir_bundle_find_name(ir_bundle_t *bundle, const char *name, ir_bundle_item_t *item);
+
+extern INT8 ir_bundle_find_id(ir_bundle_t *bundle, UINT remote_id, ir_bundle_item_t *item);
+
+extern INT8 ir_bundle_get(ir_bundle_t *bundle, UINT index, ir_bundle_item_t *item);
+
+/**
+ * function     ir_decoder_open_bundle_item
+ *
+ * description: open a remote of a bundle with a decoder instance, without copying its binary
+ *
+ * parameters:  decoder (in) - decoder instance to hold the opened remote
+ *              item (in) - remote found in a bundle
+ *
+ * returns:     IR_DECODE_SUCCEEDED / IR_DECODE_FAILED
+ */
+extern INT8 ir_decoder_open_bundle_item(ir_decoder_t *decoder, ir_bundle_item_t *item);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _IR_BUNDLE_H_
@@ -0,0 +1,100 @@
+/**************************************************************************************
+Filename:       ir_codec.h
+Revised:        Date: 2026-10-17
+Revision:       Revision: 1.0
+
+Description:    This file provides the compact encoding of decoded IR timings for transport
+
+Revision log:
+* 2026-10-17: created by agent
+**************************************************************************************/
+
+#ifndef _IR_CODEC_H_
+#define _IR_CODEC_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "ir_defs.h"
+#include "ir_waveform.h"
+
+#define IR_CODEC_VERSION             1
+#define IR_CODEC_DICTIONARY_MAX      255
+
+/*
+ * encoded timings, all numbers little endian
+ *
+ *   version (1 byte)
+ *   dictionary size D (1 byte), followed by the D distinct durations (2 bytes each)
+ *   segment count S (1 byte), followed by length, repeat and gap of each segment (2 bytes each)
+ *   symbols, the index into the dictionary of every timing of every segment span, packed
+ *   from the lowest bit of each byte on, with as many bits per symbol as D - 1 needs
+ *
+ * a segment is sent repeat times as an ir_segment_t is, its span is encoded once
+ */
+
+/**
+ * function     ir_codec_encode_waveform
+ *
+ * description: encode the segments of a waveform
+ *
+ * parameters:  waveform (in) - waveform
+ *              data (out) - encoded timings
+ *              capacity (in) - size of data buffer
+ *              length (out) - length of encoded timings
+ *
+ * returns:     IR_DECODE_SUCCEEDED / IR_DECODE_FAILED if the encoding does not fit or there are
+ *              more than IR_CODEC_DICTIONARY_MAX distinct durations
+ */
+extern INT8 ir_codec_encode_waveform(const ir_waveform_t *waveform, UINT8 *data, UINT16 capacity, UINT16 *length);
+
+/**
+ * function     ir_codec_encode
+ *
+ * description: encode timings as decoded by ir_decoder_decode, a frame sent several times back to back
+ *              is found and encoded once
+ *
+ * parameters:  timings (in) - decoded timings
+ *              count (in) - number of timings
+ *              data (out) - encoded timings
+ *              capacity (in) - size of data buffer
+ *              length (out) - length of encoded timings
+ *
+ * returns:     IR_DECODE_SUCCEEDED / IR_DECODE_FAILED
+ */
+extern INT8 ir_codec_encode(const UINT16 *timings, UINT16 count, UINT8 *data, UINT16 capacity, UINT16 *length);
+
+/**
+ * function     ir_codec_decode
+ *
+ * description: decode encoded timings in full, every repeat of every segment written out
+ *
+ * parameters:  data (in) - encoded timings
+ *              length (in) - length of encoded timings
+ *              user_data (out) - timings
+ *              capacity (in) - size of user_data in UINT16
+ *
+ * returns:     number of timings (0 indicates malformed data or data not fitting in user_data)
+ */
+extern UINT16 ir_codec_decode(const UINT8 *data, UINT16 length, UINT16 *user_data, UINT16 capacity);
+
+/**
+ * function     ir_codec_decode_waveform
+ *
+ * description: decode encoded timings into a waveform, each segment span written once
+ *
+ * parameters:  data (in) - encoded timings
+ *              length (in) - length of encoded timings
+ *              waveform (out) - waveform set up by ir_waveform_init
+ *
+ * returns:     number of timings held by the waveform (0 indicates malformed data or data not fitting)
+ */
+extern UINT16 ir_codec_decode_waveform(const UINT8 *data, UINT16 length, ir_waveform_t *waveform);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _IR_CODEC_H_
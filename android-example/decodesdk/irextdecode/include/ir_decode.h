@@ -21,6 +21,13 @@ extern "C"
 #include "ir_defs.h"
 #include "ir_ac_control.h"
 #include "ir_tv_control.h"
+#include "ir_ac_cache.h"
+#include "ir_ac_compiled.h"
+#include "ir_ac_memo.h"
+#include "ir_ac_delta.h"
+#include "ir_output.h"
+#include "ir_waveform.h"
+#include "ir_alloc.h"
 
 #define IR_DECODE_FAILED             (-1)
 #define IR_DECODE_SUCCEEDED          (0)
@@ -34,11 +41,376 @@ extern "C"
 #define SUB_CATEGORY_QUATERNARY      0
 #define SUB_CATEGORY_HEXADECIMAL     1
 
+/*
+ * decoder instance, holding everything an opened remote needs
+ * instances are independent of each other, thus different remotes could be decoded concurrently
+ * as long as a single instance is not accessed by more than one thread at a time
+ */
+typedef struct ir_decoder
+{
+    UINT8 binary_type;
+    UINT8 hexadecimal;
+    size_t binary_length;
+    UINT8 *binary_content;
+    // binary_content is a read only mapping of the file rather than a heap copy
+    UINT8 binary_mapped;
+
+    // AC (status type) context
+    protocol ac;
+    struct ir_bin_buffer ac_buffer;
+    struct tag_head *tags;
+    UINT8 tag_count;
+    UINT16 tag_head_offset;
+    // set when the parsed protocol is shared through an ir_ac_cache_t
+    ir_ac_cache_entry_t *ac_cache_entry;
+    // set when the protocol is loaded from a compiled image, only the storage and the frame plan are allocated then
+    UINT8 ac_precompiled;
+    ir_ac_compiled_storage_t *ac_compiled;
+    // optional cache of decoded frames, set by ir_decoder_enable_memo
+    ir_ac_memo_t *ac_memo;
+    // status the working frame was last built with, set on the first decode
+    ir_ac_delta_t *ac_delta;
+    // holds the whole parsed protocol when parsed with ir_set_ac_arena enabled
+    ir_arena_t ac_arena;
+    // set when opened by ir_decoder_open_binary_in_place
+    UINT8 ac_in_place;
+    // set when opened with ir_set_ac_lazy enabled, tags are kept until no group of them is pending
+    UINT8 ac_lazy;
+    // copy of the text of the pending tags, so that the binary is not needed after open
+    UINT8 *ac_lazy_tags;
+    // AC_TAG_GROUP_* not parsed yet
+    UINT16 ac_pending;
+    // a pending group failed to parse, whatever needs it fails from then on
+    UINT8 ac_lazy_failed;
+
+    // TV (command type) context
+    ir_tv_context_t tv;
+} ir_decoder_t;
+
+// a key press or an AC status of a batch, ac_status is ignored by TV remotes
+typedef struct ir_command
+{
+    UINT8 key_code;
+    remote_ac_status_t ac_status;
+    BOOL change_wind_direction;
+} ir_command_t;
+
+/*
+ * us of silence between two commands of a batch, gaps (optional) holds the gap after each command
+ * but the last and overrides gap
+ */
+typedef struct ir_batch_gap
+{
+    UINT16 gap;
+    const UINT16 *gaps;
+} ir_batch_gap_t;
+
 // exported functions
+/**
+ * function     ir_decoder_open_file
+ *
+ * description: open IR binary code from file with a decoder instance
+ *
+ * parameters:  decoder (in) - decoder instance to hold the opened remote
+ *              category (in) - category ID get from indexing API
+ *              sub_category (in) - subcategory ID get from indexing API
+ *              file_name (in) - file name of IR binary
+ *
+ * returns:     IR_DECODE_SUCCEEDED / IR_DECODE_FAILED
+ */
+extern INT8 ir_decoder_open_file(ir_decoder_t *decoder, const UINT8 category, const UINT8 sub_category,
+                                 const char* file_name);
+
+/**
+ * function     ir_decoder_open_binary
+ *
+ * description: open IR binary code from buffer with a decoder instance
+ *
+ * parameters:  decoder (in) - decoder instance to hold the opened remote
+ *              category (in) - category ID get from indexing API
+ *              sub_category (in) - subcategory ID get from indexing API
+ *              binary (in) - pointer to binary buffer, should be kept until the decoder is closed
+ *              binary_length (in) - binary buffer size
+ *
+ * returns:     IR_DECODE_SUCCEEDED / IR_DECODE_FAILED
+ */
+extern INT8 ir_decoder_open_binary(ir_decoder_t *decoder, const UINT8 category, const UINT8 sub_category,
+                                   UINT8* binary, UINT16 binary_length);
+
+/**
+ * function     ir_decoder_open_binary_in_place
+ *
+ * description: open IR binary code from a writable buffer with a decoder instance, AC parameters are decoded
+ *              over their hex text and referenced from there instead of being copied to the heap
+ *
+ * parameters:  decoder (in) - decoder instance to hold the opened remote
+ *              category (in) - category ID get from indexing API
+ *              sub_category (in) - subcategory ID get from indexing API
+ *              binary (in) - pointer to binary buffer, overwritten and kept until the decoder is closed,
+ *                            it could not be opened again afterwards
+ *              binary_length (in) - binary buffer size
+ *
+ * returns:     IR_DECODE_SUCCEEDED / IR_DECODE_FAILED
+ */
+extern INT8 ir_decoder_open_binary_in_place(ir_decoder_t *decoder, const UINT8 category, const UINT8 sub_category,
+                                            UINT8* binary, UINT16 binary_length);
+
+/**
+ * function     ir_decoder_open_binary_cached
+ *
+ * description: open IR binary code from buffer with a decoder instance, reusing the parsed AC protocol
+ *              of an identical binary opened before instead of parsing it again,
+ *              cached protocols are always parsed as a whole out of any arena, so opening an AC binary
+ *              other than a compiled image fails while ir_set_ac_lazy or ir_set_ac_arena is enabled
+ *
+ * parameters:  decoder (in) - decoder instance to hold the opened remote
+ *              cache (in) - parsed protocol cache, NULL behaves as ir_decoder_open_binary
+ *              category (in) - category ID get from indexing API
+ *              sub_category (in) - subcategory ID get from indexing API
+ *              binary (in) - pointer to binary buffer
+ *              binary_length (in) - binary buffer size
+ *
+ * returns:     IR_DECODE_SUCCEEDED / IR_DECODE_FAILED
+ */
+extern INT8 ir_decoder_open_binary_cached(ir_decoder_t *decoder, ir_ac_cache_t *cache,
+                                          const UINT8 category, const UINT8 sub_category,
+                                          UINT8* binary, UINT16 binary_length);
+
+/**
+ * function     ir_set_ac_lazy
+ *
+ * description: parse only the frame tags of AC remotes when they are opened, the tags of every parameter, solo
+ *              function, ban and checksum are parsed the first time a decode or a query of the remote needs them,
+ *              remotes parsed into an arena are still parsed as a whole, opening through a cache fails meanwhile,
+ *              the text of the pending tags is copied on open so the binary need not outlive the decoder
+ *
+ * parameters:  enable (in) - TRUE to parse AC remotes opened from now on lazily
+ *
+ * returns:     N/A
+ */
+extern void ir_set_ac_lazy(BOOL enable);
+
+extern BOOL ir_get_ac_lazy();
+
+/**
+ * function     ir_decoder_compile
+ *
+ * description: compile the AC remote opened by a decoder instance into a precompiled image,
+ *              which could be opened later on like any other AC binary without parsing
+ *
+ * parameters:  decoder (in) - decoder instance with an AC remote opened
+ *              image (out) - buffer of the compiled image, NULL to query the size only
+ *              image_length (in/out) - size of the image buffer / size of the compiled image
+ *
+ * returns:     IR_DECODE_SUCCEEDED / IR_DECODE_FAILED
+ */
+extern INT8 ir_decoder_compile(ir_decoder_t *decoder, UINT8 *image, UINT16 *image_length);
+
+/**
+ * function     ir_decoder_materialize
+ *
+ * description: render every key of the TV remote opened by a decoder instance into a run-length coded table once,
+ *              later decodes of the instance expand from it, the table is released on close
+ *
+ * parameters:  decoder (in) - decoder instance with a TV remote opened
+ *              memory_size (out) - bytes held by the table (optional)
+ *
+ * returns:     IR_DECODE_SUCCEEDED / IR_DECODE_FAILED
+ */
+extern INT8 ir_decoder_materialize(ir_decoder_t *decoder, size_t *memory_size);
+
+/**
+ * function     ir_decoder_enable_memo
+ *
+ * description: keep the frames decoded by the AC remote opened by a decoder instance, decoding the same
+ *              status and function again copies the kept frame, the frames are released on close
+ *
+ * parameters:  decoder (in) - decoder instance with an AC remote opened
+ *              memory_budget (in) - bytes of frames to keep, least recently used ones are dropped first
+ *
+ * returns:     IR_DECODE_SUCCEEDED / IR_DECODE_FAILED
+ */
+extern INT8 ir_decoder_enable_memo(ir_decoder_t *decoder, size_t memory_budget);
+
+/**
+ * function     ir_decoder_get_memo_stats
+ *
+ * description: get hit / miss counters and memory usage of the decoded frames kept by a decoder instance
+ *
+ * parameters:  decoder (in) - decoder instance with memo enabled
+ *              stats (out) - statistics
+ *
+ * returns:     IR_DECODE_SUCCEEDED / IR_DECODE_FAILED
+ */
+extern INT8 ir_decoder_get_memo_stats(ir_decoder_t *decoder, ir_ac_memo_stats_t *stats);
+
+/**
+ * function     ir_decoder_get_delta_stats
+ *
+ * description: get how many AC frames of a decoder instance have been patched from the previous frame
+ *              rather than rebuilt from default code
+ *
+ * parameters:  decoder (in) - decoder instance with an AC remote opened
+ *              stats (out) - statistics
+ *
+ * returns:     IR_DECODE_SUCCEEDED / IR_DECODE_FAILED
+ */
+extern INT8 ir_decoder_get_delta_stats(ir_decoder_t *decoder, ir_ac_delta_stats_t *stats);
+
+/**
+ * function     ir_decoder_decode
+ *
+ * description: decode IR binary opened by a decoder instance into INT16 array which indicates the IR levels
+ *
+ * parameters:  decoder (in) - decoder instance
+ *              key_code (in) - the code of pressed key
+ *              user_data (out) - output decoded data in INT16 array format
+ *              ac_status(in) - pointer to AC status (optional)
+ *              change_wind_direction (in) - if control changes wind direction for AC (for AC only)
+ *
+ * returns:     length of decoded data (0 indicates decode failure)
+ */
+extern UINT16 ir_decoder_decode(ir_decoder_t *decoder, UINT8 key_code, UINT16* user_data,
+                                remote_ac_status_t* ac_status, BOOL change_wind_direction);
+
+/**
+ * function     ir_decoder_decode_into
+ *
+ * description: decode IR binary opened by a decoder instance into a buffer of any size,
+ *              a frame longer than the buffer fails rather than being truncated
+ *
+ * parameters:  decoder (in) - decoder instance
+ *              key_code (in) - the code of pressed key
+ *              user_data (out) - output decoded data in INT16 array format
+ *              capacity (in) - size of user_data in UINT16
+ *              ac_status(in) - pointer to AC status (optional)
+ *              change_wind_direction (in) - if control changes wind direction for AC (for AC only)
+ *
+ * returns:     length of decoded data (0 indicates decode failure)
+ */
+extern UINT16 ir_decoder_decode_into(ir_decoder_t *decoder, UINT8 key_code, UINT16* user_data, UINT16 capacity,
+                                     remote_ac_status_t* ac_status, BOOL change_wind_direction);
+
+/**
+ * function     ir_decoder_decode_stream
+ *
+ * description: decode IR binary opened by a decoder instance and hand the IR levels to a sink chunk by chunk,
+ *              no buffer for the whole frame is needed and no length limit applies
+ *
+ * parameters:  decoder (in) - decoder instance
+ *              key_code (in) - the code of pressed key
+ *              ac_status(in) - pointer to AC status (optional)
+ *              change_wind_direction (in) - if control changes wind direction for AC (for AC only)
+ *              chunk (in) - staging buffer of IR levels, valid within the sink call only
+ *              chunk_size (in) - staging buffer size in UINT16, 2 at least
+ *              sink (in) - callback receiving the IR levels in order
+ *              sink_data (in) - parameter passed to the sink
+ *
+ * returns:     length of decoded data (0 indicates decode failure)
+ */
+extern UINT ir_decoder_decode_stream(ir_decoder_t *decoder, UINT8 key_code, remote_ac_status_t* ac_status,
+                                     BOOL change_wind_direction, UINT16 *chunk, UINT16 chunk_size,
+                                     ir_sink_t sink, void *sink_data);
+
+/**
+ * function     ir_decoder_decode_waveform
+ *
+ * description: decode IR binary opened by a decoder instance into a waveform, a frame sent several times
+ *              is written once and described as a repeated segment, with the space ending the frame as
+ *              the gap between repeats and a segment of its own after the last one,
+ *              see ir_waveform_flatten for the IR levels in full
+ *
+ * parameters:  decoder (in) - decoder instance
+ *              key_code (in) - the code of pressed key
+ *              ac_status(in) - pointer to AC status (optional)
+ *              change_wind_direction (in) - if control changes wind direction for AC (for AC only)
+ *              waveform (out) - waveform set up by ir_waveform_init
+ *
+ * returns:     length of decoded data held by the waveform (0 indicates decode failure)
+ */
+extern UINT16 ir_decoder_decode_waveform(ir_decoder_t *decoder, UINT8 key_code, remote_ac_status_t* ac_status,
+                                         BOOL change_wind_direction, ir_waveform_t *waveform);
+
+/**
+ * function     ir_decoder_decode_batch
+ *
+ * description: decode commands one after another into a single schedule, as a scene would send them,
+ *              the gap after a command is added to its last space or is a space of its own
+ *
+ * parameters:  decoder (in) - decoder instance
+ *              commands (in) - commands in the order they are sent
+ *              command_count (in) - number of commands
+ *              gap (in) - gaps between commands (optional, commands back to back if NULL)
+ *              user_data (out) - decoded schedule
+ *              capacity (in) - size of user_data in UINT16
+ *              offsets (out) - offset in user_data of each command (optional)
+ *
+ * returns:     length of the schedule (0 indicates decode failure or a schedule not fitting in user_data),
+ *              a command failing to decode takes no room and its offset is that of the next one
+ */
+extern UINT16 ir_decoder_decode_batch(ir_decoder_t *decoder, const ir_command_t *commands, UINT8 command_count,
+                                      const ir_batch_gap_t *gap, UINT16 *user_data, UINT16 capacity,
+                                      UINT16 *offsets);
+
+/**
+ * function     ir_decoder_decode_length
+ *
+ * description: number of timings ir_decoder_decode_into would decode, without decoding nor changing the state
+ *              of the decoder (TV toggle bit, AC swing or working frame)
+ *
+ * parameters:  decoder (in) - decoder instance
+ *              key_code (in) - the code of pressed key
+ *              ac_status(in) - pointer to AC status (optional)
+ *              change_wind_direction (in) - if control changes wind direction for AC (for AC only)
+ *
+ * returns:     length of decoded data (0 indicates decode failure)
+ */
+extern UINT16 ir_decoder_decode_length(ir_decoder_t *decoder, UINT8 key_code, remote_ac_status_t* ac_status,
+                                       BOOL change_wind_direction);
+
+/**
+ * function     ir_decoder_max_decode_length
+ *
+ * description: most timings any key or AC status of the remote opened by a decoder instance decodes to,
+ *              worked out when the remote is opened, a buffer of that size holds every decode
+ *
+ * parameters:  decoder (in) - decoder instance
+ *
+ * returns:     length of the longest decoded data, a remote decoding to more than USER_DATA_SIZE
+ *              is to be decoded with ir_decoder_decode_into
+ */
+extern UINT16 ir_decoder_max_decode_length(ir_decoder_t *decoder);
+
+/**
+ * function     ir_decoder_close
+ *
+ * description: close IR binary code opened by a decoder instance
+ *
+ * parameters:  decoder (in) - decoder instance
+ *
+ * returns:     IR_DECODE_SUCCEEDED / IR_DECODE_FAILED
+ */
+extern INT8 ir_decoder_close(ir_decoder_t *decoder);
+
+/**
+ * function     ir_decoder_get_temperature_range / ir_decoder_get_supported_*
+ *
+ * description: per instance variants of get_temperature_range and get_supported_* listed below
+ */
+extern INT8 ir_decoder_get_temperature_range(ir_decoder_t *decoder, UINT8 ac_mode, INT8 *temp_min, INT8 *temp_max);
+
+extern INT8 ir_decoder_get_supported_mode(ir_decoder_t *decoder, UINT8 *supported_mode);
+
+extern INT8 ir_decoder_get_supported_wind_speed(ir_decoder_t *decoder, UINT8 ac_mode, UINT8 *supported_wind_speed);
+
+extern INT8 ir_decoder_get_supported_swing(ir_decoder_t *decoder, UINT8 ac_mode, UINT8 *supported_swing);
+
+extern INT8 ir_decoder_get_supported_wind_direction(ir_decoder_t *decoder, UINT8 *supported_wind_direction);
+
 /**
  * function     ir_file_open
  *
- * description: open IR binary code from file
+ * description: open IR binary code from file into the default decoder instance
  *
  * parameters:  category (in) - category ID get from indexing API
  *              sub_category (in) - subcategory ID get from indexing API
@@ -52,7 +424,7 @@ extern INT8 ir_file_open(const UINT8 category, const UINT8 sub_category, const c
 /**
  * function     ir_binary_open
  *
- * description: open IR binary code from buffer
+ * description: open IR binary code from buffer into the default decoder instance
  *
  * parameters:  category (in) - category ID get from indexing API
  *              sub_category (in) - subcategory ID get from indexing API
@@ -63,10 +435,38 @@ extern INT8 ir_file_open(const UINT8 category, const UINT8 sub_category, const c
  */
 extern INT8 ir_binary_open(const UINT8 category, const UINT8 sub_category, UINT8* binary, UINT16 binary_length);
 
+/**
+ * function     ir_binary_open_in_place
+ *
+ * description: open IR binary code from a writable buffer into the default decoder instance,
+ *              see ir_decoder_open_binary_in_place
+ *
+ * parameters:  category (in) - category ID get from indexing API
+ *              sub_category (in) - subcategory ID get from indexing API
+ *              binary (in) - pointer to binary buffer, overwritten
+ *              binary_length (in) - binary buffer size
+ *
+ * returns:     IR_DECODE_SUCCEEDED / IR_DECODE_FAILED
+ */
+extern INT8 ir_binary_open_in_place(const UINT8 category, const UINT8 sub_category, UINT8* binary,
+                                    UINT16 binary_length);
+
+/**
+ * function     ir_set_ac_cache
+ *
+ * description: set the parsed protocol cache used by ir_binary_open of the default decoder instance,
+ *              which then fails to open AC binaries while ir_set_ac_lazy or ir_set_ac_arena is enabled
+ *
+ * parameters:  cache (in) - parsed protocol cache, NULL to parse on every open
+ *
+ * returns:     N/A
+ */
+extern void ir_set_ac_cache(ir_ac_cache_t *cache);
+
 /**
  * function     ir_decode
  *
- * description: decode IR binary into INT16 array which indicates the IR levels
+ * description: decode IR binary into INT16 array which indicates the IR levels (default decoder instance)
  *
  * parameters:  key_code (in) - the code of pressed key
  *              user_data (out) - output decoded data in INT16 array format
@@ -77,10 +477,83 @@ extern INT8 ir_binary_open(const UINT8 category, const UINT8 sub_category, UINT8
  */
 extern UINT16 ir_decode(UINT8 key_code, UINT16* user_data, remote_ac_status_t* ac_status, BOOL change_wind_direction);
 
+/**
+ * function     ir_decode_into
+ *
+ * description: decode IR binary into a buffer of any size (default decoder instance), see ir_decoder_decode_into
+ *
+ * parameters:  key_code (in) - the code of pressed key
+ *              user_data (out) - output decoded data in INT16 array format
+ *              capacity (in) - size of user_data in UINT16
+ *              ac_status(in) - pointer to AC status (optional)
+ *              change_wind_direction (in) - if control changes wind direction for AC (for AC only)
+ *
+ * returns:     length of decoded data (0 indicates decode failure)
+ */
+extern UINT16 ir_decode_into(UINT8 key_code, UINT16* user_data, UINT16 capacity, remote_ac_status_t* ac_status,
+                             BOOL change_wind_direction);
+
+/**
+ * function     ir_decode_waveform
+ *
+ * description: decode IR binary into a waveform (default decoder instance), see ir_decoder_decode_waveform
+ *
+ * parameters:  key_code (in) - the code of pressed key
+ *              ac_status(in) - pointer to AC status (optional)
+ *              change_wind_direction (in) - if control changes wind direction for AC (for AC only)
+ *              waveform (out) - waveform set up by ir_waveform_init
+ *
+ * returns:     length of decoded data held by the waveform (0 indicates decode failure)
+ */
+extern UINT16 ir_decode_waveform(UINT8 key_code, remote_ac_status_t* ac_status, BOOL change_wind_direction,
+                                 ir_waveform_t *waveform);
+
+/**
+ * function     ir_decode_batch
+ *
+ * description: decode commands into a single schedule (default decoder instance), see ir_decoder_decode_batch
+ *
+ * parameters:  commands (in) - commands in the order they are sent
+ *              command_count (in) - number of commands
+ *              gap (in) - gaps between commands (optional)
+ *              user_data (out) - decoded schedule
+ *              capacity (in) - size of user_data in UINT16
+ *              offsets (out) - offset in user_data of each command (optional)
+ *
+ * returns:     length of the schedule (0 indicates decode failure)
+ */
+extern UINT16 ir_decode_batch(const ir_command_t *commands, UINT8 command_count, const ir_batch_gap_t *gap,
+                              UINT16 *user_data, UINT16 capacity, UINT16 *offsets);
+
+/**
+ * function     ir_decode_length
+ *
+ * description: number of timings ir_decode_into would decode (default decoder instance), see ir_decoder_decode_length
+ *
+ * parameters:  key_code (in) - the code of pressed key
+ *              ac_status(in) - pointer to AC status (optional)
+ *              change_wind_direction (in) - if control changes wind direction for AC (for AC only)
+ *
+ * returns:     length of decoded data (0 indicates decode failure)
+ */
+extern UINT16 ir_decode_length(UINT8 key_code, remote_ac_status_t* ac_status, BOOL change_wind_direction);
+
+/**
+ * function     ir_max_decode_length
+ *
+ * description: most timings the remote opened by the default decoder instance decodes to
+ *
+ * parameters:  N/A
+ *
+ * returns:     length of the longest decoded data, a remote decoding to more than USER_DATA_SIZE
+ *              is to be decoded with ir_decode_into
+ */
+extern UINT16 ir_max_decode_length();
+
 /**
  * function     ir_close
  *
- * description: close IR binary code
+ * description: close IR binary code opened by the default decoder instance
  *
  * parameters:  N/A
  *
@@ -150,7 +623,7 @@ extern INT8 get_supported_wind_direction(UINT8 *supported_wind_direction);
 
 // private extern function
 #if (defined BOARD_PC || defined BOARD_PC_DLL)
-extern void ir_lib_free_inner_buffer();
+extern void ir_lib_free_inner_buffer(ir_decoder_t *decoder);
 #endif
 
 #ifdef __cplusplus
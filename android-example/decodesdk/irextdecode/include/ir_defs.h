@@ -26,6 +26,8 @@ extern "C"
 #include "OSAL.h"
 #endif
 
+#include <stddef.h>
+
 #define TRUE    1
 #define FALSE   0
 
@@ -35,17 +37,17 @@ typedef unsigned short UINT16;
 typedef signed short INT16;
 typedef signed int INT;
 typedef unsigned int UINT;
+typedef unsigned long long UINT64;
 typedef int BOOL;
 
 void noprint(const char *fmt, ...);
 
-#if !defined BOARD_CC26XX
-#define ir_malloc(A) malloc(A)
-#define ir_free(A) free(A)
-#else
-#define ir_malloc(A) ICall_malloc(A)
-#define ir_free(A) ICall_free(A)
-#endif
+// served by the allocator set with ir_set_allocator, see ir_alloc.h
+void *ir_alloc_malloc(size_t size);
+void ir_alloc_free(void *ptr);
+
+#define ir_malloc(A) ir_alloc_malloc(A)
+#define ir_free(A) ir_alloc_free(A)
 
 #define ir_memcpy(A, B, C) memcpy(A, B, C)
 #define ir_memset(A, B, C) memset(A, B, C)
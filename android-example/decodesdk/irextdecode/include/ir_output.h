@@ -0,0 +1,63 @@
+/**************************************************************************************
+Filename:       ir_output.h
+Revised:        Date: 2026-10-17
+Revision:       Revision: 1.0
+
+Description:    This file provides the output of decoded IR timings into a buffer or a sink
+
+Revision log:
+* 2026-10-17: created by agent
+**************************************************************************************/
+
+#ifndef _IR_OUTPUT_H_
+#define _IR_OUTPUT_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "ir_defs.h"
+
+/*
+ * sink of streamed timings, called with the timings in order as they are produced,
+ * the timings are only valid during the call
+ */
+typedef void (*ir_sink_t)(void *sink_data, const UINT16 *timings, UINT16 count);
+
+/*
+ * decoded timings go to buffer, without a sink the buffer holds the whole output and
+ * anything beyond its capacity marks an overflow, with a sink the buffer is a chunk flushed
+ * to the sink when full, the last timing is held back since the next one may be merged into it
+ */
+typedef struct ir_output
+{
+    UINT16 *buffer;
+    UINT16 capacity;
+    UINT16 used;
+    UINT total;
+    ir_sink_t sink;
+    void *sink_data;
+    UINT8 overflow;
+    // set to have a repeated frame written once, repeat_times then tells how many times it is sent
+    UINT8 single_frame;
+    UINT16 repeat_times;
+} ir_output_t;
+
+extern void ir_output_init(ir_output_t *output, UINT16 *buffer, UINT16 capacity, ir_sink_t sink, void *sink_data);
+
+extern void ir_output_put(ir_output_t *output, UINT16 timing);
+
+extern void ir_output_write(ir_output_t *output, const UINT16 *timings, UINT16 count);
+
+// add to the last timing put, merging two consecutive levels of the same kind
+extern void ir_output_add_last(ir_output_t *output, UINT16 timing);
+
+// flush what is left to the sink, returns the number of timings of the whole output
+extern UINT ir_output_finish(ir_output_t *output);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _IR_OUTPUT_H_
@@ -0,0 +1,93 @@
+/**************************************************************************************
+Filename:       ir_scan.h
+Revised:        Date: 2026-10-17
+Revision:       Revision: 1.0
+
+Description:    This file provides the scanner of AC text tags
+
+Revision log:
+* 2026-10-17: created by agent
+**************************************************************************************/
+
+#ifndef _IR_SCAN_H_
+#define _IR_SCAN_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "ir_defs.h"
+
+/*
+ * text tags are lists of decimal integers, "key&value" pairs and records of them separated by '|',
+ * for instance "0&3000,3000|4&500,400". A scan is a view of such text, it is never copied nor
+ * required to be NUL terminated, and every character is read once.
+ */
+typedef struct ir_scan
+{
+    UINT8 *cursor;
+    UINT8 *end;
+    // the last field has been taken, which may be empty
+    UINT8 done;
+} ir_scan_t;
+
+/**
+ * function     ir_scan_init
+ *
+ * description: start a scan on a text of given length
+ *
+ * parameters:  scan (out) - scan
+ *              text (in) - text, not required to be NUL terminated
+ *              length (in) - length of text
+ *
+ * returns:     N/A
+ */
+extern void ir_scan_init(ir_scan_t *scan, UINT8 *text, UINT16 length);
+
+/**
+ * function     ir_scan_field
+ *
+ * description: take the next field up to a separator, a text with n separators has n + 1 fields
+ *
+ * parameters:  scan (in) - scan
+ *              separator (in) - separator of fields
+ *              field (out) - field without the separator
+ *
+ * returns:     TRUE if a field is taken, FALSE once every field has been taken
+ */
+extern BOOL ir_scan_field(ir_scan_t *scan, UINT8 separator, ir_scan_t *field);
+
+/**
+ * function     ir_scan_pair
+ *
+ * description: split a field at the first separator into key and value
+ *
+ * parameters:  field (in) - field
+ *              separator (in) - separator of key and value
+ *              key (out) - text before the separator
+ *              value (out) - text after the separator
+ *
+ * returns:     TRUE if the separator is found, otherwise key and value are both empty
+ */
+extern BOOL ir_scan_pair(const ir_scan_t *field, UINT8 separator, ir_scan_t *key, ir_scan_t *value);
+
+/**
+ * function     ir_scan_int
+ *
+ * description: read a decimal integer at the start of a field as atoi does,
+ *              leading spaces and sign are accepted and an empty field reads 0
+ *
+ * parameters:  field (in) - field
+ *
+ * returns:     value read
+ */
+extern INT ir_scan_int(const ir_scan_t *field);
+
+extern UINT16 ir_scan_length(const ir_scan_t *field);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _IR_SCAN_H_
@@ -0,0 +1,114 @@
+/**************************************************************************************
+Filename:       ir_synth.h
+Revised:        Date: 2026-10-17
+Revision:       Revision: 1.0
+
+Description:    This file provides the generator of synthetic AC and TV binaries
+
+Revision log:
+* 2026-10-17: created by agent
+**************************************************************************************/
+
+#ifndef _IR_SYNTH_H_
+#define _IR_SYNTH_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "ir_defs.h"
+
+// AC parameter tags of type 2 (bit ranges) instead of type 1 (byte and value pairs)
+#define IR_SYNTH_AC_TYPE_2           0x01
+// temperature tag as a step added per degree instead of a segment per degree
+#define IR_SYNTH_AC_DYNAMIC_TEMP     0x02
+#define IR_SYNTH_AC_FUNCTIONS        0x04
+#define IR_SYNTH_AC_SOLO             0x08
+// speeds and temperatures banned in some modes, some modes banned as a whole
+#define IR_SYNTH_AC_BAN              0x10
+
+/*
+ * shape of a synthetic AC binary, the content of every segment is drawn from the seed
+ * a binary of any shape within the limits below parses and decodes, frames longer than
+ * USER_DATA_SIZE decode to 0 timings as real ones would
+ */
+typedef struct ir_synth_ac
+{
+    // bytes of the default code, 4 to 255, type 2 bit ranges only cover the first 32
+    UINT8 code_length;
+    // 0 to 16 timings
+    UINT8 boot_code_count;
+    // 0 to 16 delay records of 1 to 8 timings each
+    UINT8 delay_code_count;
+    UINT8 delay_time_count;
+    // 0 to 16 bytes sent with less than 8 bits
+    UINT8 bitnum_count;
+    // 0 to 8 checksum records, of every checksum type in turn
+    UINT8 checksum_count;
+    UINT8 repeat_times;
+    // 0 for swing only, otherwise 2 to 10 swing positions
+    UINT8 swing_count;
+    // 1 to 8 bytes or bit ranges changed by every status and function segment
+    UINT8 segment_changes;
+    UINT8 flags;
+} ir_synth_ac_t;
+
+/*
+ * shape of a synthetic TV binary
+ */
+typedef struct ir_synth_tv
+{
+    // 1 for quaternary (1 or 2 bits per symbol), 2 for hexadecimal (4 bits per symbol)
+    UINT8 sub_category;
+    // 2 bits per symbol instead of 1, for quaternary binaries only
+    UINT8 two_bits;
+    // 1 to 19 key code bytes per key
+    UINT8 key_bytes;
+    // 1 to 256 keys
+    UINT16 key_count;
+    // key code bytes are sent in 1 to 8 frames separated by SEP
+    UINT8 frame_count;
+    // a toggle bit flipping on every decode
+    UINT8 flip;
+} ir_synth_tv_t;
+
+/**
+ * function     ir_synth_ac_random / ir_synth_tv_random
+ *
+ * description: draw a shape within limits, each field of the limit is the largest value drawn
+ *              and each flag of the limit is set with half probability
+ *
+ * parameters:  shape (out) - shape drawn
+ *              limit (in) - largest shape
+ *              seed (in/out) - random state, any value other than 0
+ *
+ * returns:     N/A
+ */
+extern void ir_synth_ac_random(ir_synth_ac_t *shape, const ir_synth_ac_t *limit, UINT64 *seed);
+
+extern void ir_synth_tv_random(ir_synth_tv_t *shape, const ir_synth_tv_t *limit, UINT64 *seed);
+
+/**
+ * function     ir_synth_ac / ir_synth_tv
+ *
+ * description: write a binary of the given shape, the AC binary carries the 29 tag header
+ *              read by binary_parse_offset and the TV binary the layout read by tv_lib_parse
+ *
+ * parameters:  shape (in) - shape of binary, out of range fields are clamped
+ *              seed (in/out) - random state, any value other than 0
+ *              binary (out) - binary
+ *              capacity (in) - size of binary buffer
+ *              length (out) - length of binary written
+ *
+ * returns:     IR_DECODE_SUCCEEDED / IR_DECODE_FAILED if the binary does not fit
+ */
+extern INT8 ir_synth_ac(const ir_synth_ac_t *shape, UINT64 *seed, UINT8 *binary, UINT capacity, UINT16 *length);
+
+extern INT8 ir_synth_tv(const ir_synth_tv_t *shape, UINT64 *seed, UINT8 *binary, UINT capacity, UINT16 *length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _IR_SYNTH_H_
@@ -17,7 +17,10 @@ extern "C"
 {
 #endif
 
+#include <stddef.h>
+
 #include "ir_defs.h"
+#include "ir_output.h"
 
 #define STB_CHANNEL_OFFSET              14
 
@@ -197,14 +200,84 @@ typedef struct ir_data_tv
     UINT8 per_keycode_bytes;
 } ir_data_tv_t;
 
+struct tv_buffer
+{
+    UINT8 *data;
+    UINT16 len;
+    UINT16 offset;
+};
+
+/*
+ * waveforms of every key rendered once by tv_lib_materialize, allocated as a single block
+ * entries are indexed by key * toggle_states + toggle bit, keys of identical waveforms share runs
+ *
+ * a waveform is kept as runs of equal timings, a run is the index of its timing in values, or
+ * IR_TV_RUN_LITERAL followed by the timing in 2 bytes (little endian) for timings not among them,
+ * with IR_TV_RUN_REPEAT set when a byte telling the length of the run comes next
+ */
+#define IR_TV_RUN_VALUES             127
+#define IR_TV_RUN_LITERAL            0x7F
+#define IR_TV_RUN_REPEAT             0x80
+#define IR_TV_RUN_MAX                255
+
+typedef struct ir_tv_key_entry
+{
+    UINT offset;
+    UINT16 run_bytes;
+    UINT16 length;
+} ir_tv_key_entry_t;
+
+typedef struct ir_tv_key_table
+{
+    size_t size;
+    UINT16 key_count;
+    UINT8 toggle_states;
+    UINT8 value_count;
+    UINT run_size;
+    ir_tv_key_entry_t *entries;
+    UINT16 *values;
+    UINT8 *runs;
+} ir_tv_key_table_t;
+
+/*
+ * per-instance state of an opened TV (command type) remote
+ * all pointers refer to the binary given to tv_lib_open, which must outlive the context
+ */
+typedef struct ir_tv_context
+{
+    struct tv_buffer buffer;
+    UINT8 *prot_cycles_num;
+    ir_cycles_t *prot_cycles_data[IRDA_MAX];
+    UINT8 prot_items_cnt;
+    ir_data_t *prot_items_data;
+    ir_data_tv_t *remote_p;
+    UINT8 *remote_pdata;
+
+    UINT8 ir_level;
+    UINT8 ir_toggle_bit;
+    UINT8 ir_decode_flag;
+    UINT8 cycles_num_size;
+
+    // optional, decodes copy from it when set
+    ir_tv_key_table_t *key_table;
+
+    // no key decodes to more timings, worked out at parse time
+    UINT max_length;
+} ir_tv_context_t;
+
+
+extern INT8 tv_lib_open(ir_tv_context_t *tv, UINT8 *binary, UINT16 binary_length);
+
+extern BOOL tv_lib_parse(ir_tv_context_t *tv, UINT8 encode_type);
 
-extern INT8 tv_lib_open(UINT8 *binary, UINT16 binary_length);
+extern INT8 tv_lib_materialize(ir_tv_context_t *tv, size_t *memory_size);
 
-extern BOOL tv_lib_parse(UINT8 encode_type);
+extern UINT tv_lib_control(ir_tv_context_t *tv, UINT8 key, ir_output_t *output);
 
-extern UINT16 tv_lib_control(UINT8 key, UINT16 *user_data);
+// number of timings tv_lib_control would put for a key, the toggle bit is left as it is
+extern UINT tv_lib_key_length(ir_tv_context_t *tv, UINT8 key);
 
-extern UINT8 tv_lib_close();
+extern UINT8 tv_lib_close(ir_tv_context_t *tv);
 
 #ifdef __cplusplus
 }
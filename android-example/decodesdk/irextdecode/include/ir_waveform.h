@@ -0,0 +1,90 @@
+/**************************************************************************************
+Filename:       ir_waveform.h
+Revised:        Date: 2026-10-17
+Revision:       Revision: 1.0
+
+Description:    This file provides the compact description of decoded IR timings by repeated segments
+
+Revision log:
+* 2026-10-17: created by agent
+**************************************************************************************/
+
+#ifndef _IR_WAVEFORM_H_
+#define _IR_WAVEFORM_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "ir_defs.h"
+
+#define IR_WAVEFORM_SEGMENT_MAX      4
+
+/*
+ * a span of timings sent repeat times in a row, with gap us of silence after every repeat but the last,
+ * the gap is added to the last timing of a span ending with a space and is a timing of its own otherwise
+ */
+typedef struct ir_segment
+{
+    UINT16 offset;
+    UINT16 length;
+    UINT16 repeat;
+    UINT16 gap;
+} ir_segment_t;
+
+/*
+ * decoded timings held once however many times they are sent, a transmitter loops over the
+ * segments in order rather than having every repeat written out
+ */
+typedef struct ir_waveform
+{
+    UINT16 *timings;
+    UINT16 capacity;
+    UINT16 used;
+    ir_segment_t segments[IR_WAVEFORM_SEGMENT_MAX];
+    UINT8 segment_count;
+} ir_waveform_t;
+
+/**
+ * function     ir_waveform_init
+ *
+ * description: set up an empty waveform over a timing buffer
+ *
+ * parameters:  waveform (out) - waveform
+ *              timings (in) - buffer of timings the segments refer to
+ *              capacity (in) - size of buffer in UINT16
+ *
+ * returns:     N/A
+ */
+extern void ir_waveform_init(ir_waveform_t *waveform, UINT16 *timings, UINT16 capacity);
+
+/**
+ * function     ir_waveform_length
+ *
+ * description: number of timings of a waveform once written out in full
+ *
+ * parameters:  waveform (in) - waveform
+ *
+ * returns:     number of timings
+ */
+extern UINT ir_waveform_length(const ir_waveform_t *waveform);
+
+/**
+ * function     ir_waveform_flatten
+ *
+ * description: write a waveform out in full, as ir_decoder_decode would have decoded it
+ *
+ * parameters:  waveform (in) - waveform
+ *              user_data (out) - timings in full
+ *              capacity (in) - size of user_data in UINT16
+ *
+ * returns:     length of timings written (0 indicates the waveform does not fit)
+ */
+extern UINT16 ir_waveform_flatten(const ir_waveform_t *waveform, UINT16 *user_data, UINT16 capacity);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _IR_WAVEFORM_H_
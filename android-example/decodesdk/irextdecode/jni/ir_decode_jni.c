@@ -10,19 +10,93 @@ Revision log:
 **************************************************************************************************/
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
+#include <stdint.h>
 
 #include "ir_decode_jni.h"
 #include "../include/ir_defs.h"
 #include "../include/ir_decode.h"
 
-// global variable definition
-extern size_t binary_length;
-extern UINT8 *binary_content;
+// commands of a scene decoded by a single call
+#define IR_BATCH_COMMAND_MAX         32
+
+// sized for the opened remote once it is opened, rather than for the longest remote on every decode
+static UINT16 *decode_buffer = NULL;
+static jint *copy_buffer = NULL;
+static UINT16 decode_capacity = 0;
+
+// copy of the opened binary owned by the native side, the Java array is not kept pinned
+static UINT8 *binary_copy = NULL;
+
+// native side of an IRDecoder, one per opened remote
+typedef struct ir_decoder_handle
+{
+    ir_decoder_t decoder;
+    UINT8 *binary;
+    UINT16 *decode_buffer;
+    UINT16 decode_capacity;
+} ir_decoder_handle_t;
+
+// looked up once at JNI_OnLoad rather than on every call
+static jfieldID ac_power_fid = NULL;
+static jfieldID ac_mode_fid = NULL;
+static jfieldID ac_temp_fid = NULL;
+static jfieldID ac_wind_dir_fid = NULL;
+static jfieldID ac_wind_speed_fid = NULL;
+static jclass temperature_range_class = NULL;
+static jmethodID temperature_range_mid = NULL;
+static jfieldID min_temp_fid = NULL;
+static jfieldID max_temp_fid = NULL;
+
+static void get_ac_status(JNIEnv *env, jobject jni_ac_status, remote_ac_status_t *ac_status);
+static void set_ac_status(remote_ac_status_t *ac_status, jint ac_power, jint ac_mode, jint ac_temp,
+                          jint ac_wind_speed, jint ac_wind_dir);
+static INT8 alloc_decode_buffers();
+static void free_decode_buffers();
+static jlong open_handle(ir_decoder_handle_t *handle);
+static void close_handle(ir_decoder_handle_t *handle);
+
+
+JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM *vm, void *reserved)
+{
+    JNIEnv *env = NULL;
+    jclass ac_status_class = NULL;
+    jclass range_class = NULL;
+
+    if (JNI_OK != (*vm)->GetEnv(vm, (void **) &env, JNI_VERSION_1_6))
+    {
+        return JNI_ERR;
+    }
+
+    ac_status_class = (*env)->FindClass(env, "net/irext/decodesdk/bean/ACStatus");
+    range_class = (*env)->FindClass(env, "net/irext/decodesdk/bean/TemperatureRange");
+    if (NULL == ac_status_class || NULL == range_class)
+    {
+        return JNI_ERR;
+    }
+    ac_power_fid = (*env)->GetFieldID(env, ac_status_class, "acPower", "I");
+    ac_mode_fid = (*env)->GetFieldID(env, ac_status_class, "acMode", "I");
+    ac_temp_fid = (*env)->GetFieldID(env, ac_status_class, "acTemp", "I");
+    ac_wind_dir_fid = (*env)->GetFieldID(env, ac_status_class, "acWindDir", "I");
+    ac_wind_speed_fid = (*env)->GetFieldID(env, ac_status_class, "acWindSpeed", "I");
+
+    temperature_range_class = (jclass) (*env)->NewGlobalRef(env, range_class);
+    temperature_range_mid = (*env)->GetMethodID(env, range_class, "<init>", "()V");
+    min_temp_fid = (*env)->GetFieldID(env, range_class, "tempMin", "I");
+    max_temp_fid = (*env)->GetFieldID(env, range_class, "tempMax", "I");
+
+    (*env)->DeleteLocalRef(env, ac_status_class);
+    (*env)->DeleteLocalRef(env, range_class);
+    return JNI_VERSION_1_6;
+}
 
 JNIEXPORT jint JNICALL Java_net_irext_decodesdk_IRDecode_irOpen
           (JNIEnv *env, jobject this_obj, jint category_id, jint sub_cate, jstring file_name)
 {
     const char *n_file_name = (*env)->GetStringUTFChars(env, file_name, 0);
+
+    free(binary_copy);
+    binary_copy = NULL;
     if (IR_DECODE_FAILED == ir_file_open(category_id, sub_cate, n_file_name))
     {
         ir_close();
@@ -31,64 +105,48 @@ JNIEXPORT jint JNICALL Java_net_irext_decodesdk_IRDecode_irOpen
     }
 
     (*env)->ReleaseStringUTFChars(env, file_name, n_file_name);
-    return IR_DECODE_SUCCEEDED;
+    return alloc_decode_buffers();
 }
 
 JNIEXPORT jint JNICALL Java_net_irext_decodesdk_IRDecode_irOpenBinary
           (JNIEnv *env, jobject this_obj, jint category_id, jint sub_cate,
            jbyteArray binaries, jint bin_length)
 {
-    jbyte* j_buffer = (*env)->GetByteArrayElements(env, binaries, 0);
-    unsigned char* buffer = (unsigned char*)j_buffer;
+    // TV remotes refer to the binary as long as they are open, it is copied once rather than pinned
+    free(binary_copy);
+    binary_copy = (UINT8 *) malloc(bin_length > 0 ? bin_length : 1);
+    if (NULL == binary_copy)
+    {
+        return IR_DECODE_FAILED;
+    }
+    (*env)->GetByteArrayRegion(env, binaries, 0, bin_length, (jbyte *) binary_copy);
 
-    if (IR_DECODE_FAILED == ir_binary_open(category_id, sub_cate, buffer, bin_length))
+    if (IR_DECODE_FAILED == ir_binary_open(category_id, sub_cate, binary_copy, bin_length))
     {
         ir_close();
-        (*env)->ReleaseByteArrayElements(env, binaries, j_buffer, JNI_ABORT);
+        free(binary_copy);
+        binary_copy = NULL;
         return IR_DECODE_FAILED;
     }
 
-    return IR_DECODE_SUCCEEDED;
+    return alloc_decode_buffers();
 }
 
 JNIEXPORT jintArray JNICALL Java_net_irext_decodesdk_IRDecode_irDecode
           (JNIEnv *env, jobject this_obj, jint key_code, jobject jni_ac_status, jint change_wind_direction)
 {
-    UINT16 user_data[USER_DATA_SIZE];
+    UINT16 *user_data = decode_buffer;
     int i = 0;
-    jint copy_array[USER_DATA_SIZE] = {0};
+    jint *copy_array = copy_buffer;
     remote_ac_status_t ac_status;
 
-    jclass n_ac_status = (*env)->GetObjectClass(env, jni_ac_status);
-
-    if (NULL != n_ac_status)
+    if (NULL == user_data)
     {
-        jfieldID ac_power_fid = (*env)->GetFieldID(env, n_ac_status, "acPower", "I");
-        jint i_ac_power = (*env)->GetIntField(env, jni_ac_status, ac_power_fid);
-
-        jfieldID ac_mode_fid = (*env)->GetFieldID(env, n_ac_status, "acMode", "I");
-        jint i_ac_mode = (*env)->GetIntField(env, jni_ac_status, ac_mode_fid);
-
-        jfieldID ac_temp_fid = (*env)->GetFieldID(env, n_ac_status, "acTemp", "I");
-        jint i_ac_temp = (*env)->GetIntField(env, jni_ac_status, ac_temp_fid);
-
-        jfieldID ac_wind_dir_fid = (*env)->GetFieldID(env, n_ac_status, "acWindDir", "I");
-        jint i_ac_wind_dir = (*env)->GetIntField(env, jni_ac_status, ac_wind_dir_fid);
-
-        jfieldID ac_wind_speed_fid = (*env)->GetFieldID(env, n_ac_status, "acWindSpeed", "I");
-        jint i_ac_wind_speed = (*env)->GetIntField(env, jni_ac_status, ac_wind_speed_fid);
-
-        ac_status.acDisplay = 0;
-        ac_status.acSleep = 0;
-        ac_status.acTimer = 0;
-        ac_status.acPower = i_ac_power;
-        ac_status.acMode = i_ac_mode;
-        ac_status.acTemp = i_ac_temp;
-        ac_status.acWindDir = i_ac_wind_dir;
-        ac_status.acWindSpeed = i_ac_wind_speed;
+        return NULL;
     }
+    get_ac_status(env, jni_ac_status, &ac_status);
 
-    int wave_code_length = ir_decode(key_code, user_data, &ac_status, change_wind_direction);
+    int wave_code_length = ir_decode_into(key_code, user_data, decode_capacity, &ac_status, change_wind_direction);
 
     jintArray result = (*env)->NewIntArray(env, wave_code_length);
     if (result == NULL)
@@ -100,15 +158,170 @@ JNIEXPORT jintArray JNICALL Java_net_irext_decodesdk_IRDecode_irDecode
         copy_array[i] = (int)user_data[i];
     }
     (*env)->SetIntArrayRegion(env, result, 0, wave_code_length, copy_array);
-    (*env)->DeleteLocalRef(env, n_ac_status);
 
     return result;
 }
 
+JNIEXPORT jint JNICALL Java_net_irext_decodesdk_IRDecode_irDecodeInto
+          (JNIEnv *env, jobject this_obj, jint key_code, jint ac_power, jint ac_mode, jint ac_temp,
+           jint ac_wind_speed, jint ac_wind_dir, jint change_wind_direction, jintArray output)
+{
+    remote_ac_status_t ac_status;
+    jint *timings = NULL;
+    int wave_code_length = 0;
+    int i = 0;
+
+    if (NULL == decode_buffer || NULL == output)
+    {
+        return 0;
+    }
+    set_ac_status(&ac_status, ac_power, ac_mode, ac_temp, ac_wind_speed, ac_wind_dir);
+    wave_code_length = ir_decode_into(key_code, decode_buffer, decode_capacity, &ac_status, change_wind_direction);
+    if (wave_code_length > (*env)->GetArrayLength(env, output))
+    {
+        return 0;
+    }
+
+    // widened straight into the array of the caller
+    timings = (jint *) (*env)->GetPrimitiveArrayCritical(env, output, NULL);
+    if (NULL == timings)
+    {
+        return 0;
+    }
+    for (i = 0; i < wave_code_length; i++)
+    {
+        timings[i] = decode_buffer[i];
+    }
+    (*env)->ReleasePrimitiveArrayCritical(env, output, timings, 0);
+    return wave_code_length;
+}
+
+JNIEXPORT jint JNICALL Java_net_irext_decodesdk_IRDecode_irDecodeDirect
+          (JNIEnv *env, jobject this_obj, jint key_code, jint ac_power, jint ac_mode, jint ac_temp,
+           jint ac_wind_speed, jint ac_wind_dir, jint change_wind_direction, jobject output)
+{
+    remote_ac_status_t ac_status;
+    UINT16 *timings = (UINT16 *) (*env)->GetDirectBufferAddress(env, output);
+    jlong capacity = (*env)->GetDirectBufferCapacity(env, output);
+
+    // decoded in place as native order UINT16, a frame longer than the buffer fails
+    if (NULL == timings || 0 != ((size_t) timings & 0x01) || capacity < (jlong) sizeof(UINT16))
+    {
+        return 0;
+    }
+    capacity /= sizeof(UINT16);
+    set_ac_status(&ac_status, ac_power, ac_mode, ac_temp, ac_wind_speed, ac_wind_dir);
+    return ir_decode_into(key_code, timings, (UINT16) (capacity > 0xFFFF ? 0xFFFF : capacity), &ac_status,
+                          change_wind_direction);
+}
+
+JNIEXPORT jint JNICALL Java_net_irext_decodesdk_IRDecode_irMaxDecodeLength
+          (JNIEnv *env, jobject this_obj)
+{
+    return ir_max_decode_length();
+}
+
+JNIEXPORT jintArray JNICALL Java_net_irext_decodesdk_IRDecode_irDecodeBatch
+          (JNIEnv *env, jobject this_obj, jintArray key_codes, jobjectArray jni_ac_statuses,
+           jintArray change_wind_directions, jint gap, jintArray offsets)
+{
+    jsize command_count = (*env)->GetArrayLength(env, key_codes);
+    ir_command_t commands[IR_BATCH_COMMAND_MAX];
+    UINT16 command_offsets[IR_BATCH_COMMAND_MAX];
+    jint copy_offsets[IR_BATCH_COMMAND_MAX];
+    jint *j_key_codes = NULL;
+    jint *j_change_wind_directions = NULL;
+    jobject jni_ac_status = NULL;
+    ir_batch_gap_t batch_gap;
+    UINT16 *user_data = NULL;
+    jint *timings = NULL;
+    jintArray result = NULL;
+    UINT capacity = 0;
+    int schedule_length = 0;
+    int i = 0;
+
+    // a command takes one element of each array
+    if (command_count > (*env)->GetArrayLength(env, jni_ac_statuses))
+    {
+        command_count = (*env)->GetArrayLength(env, jni_ac_statuses);
+    }
+    if (command_count > (*env)->GetArrayLength(env, change_wind_directions))
+    {
+        command_count = (*env)->GetArrayLength(env, change_wind_directions);
+    }
+    if (command_count > IR_BATCH_COMMAND_MAX)
+    {
+        command_count = IR_BATCH_COMMAND_MAX;
+    }
+    if (NULL != offsets && (*env)->GetArrayLength(env, offsets) < command_count)
+    {
+        return NULL;
+    }
+    ir_memset(commands, 0x00, sizeof(commands));
+    j_key_codes = (*env)->GetIntArrayElements(env, key_codes, 0);
+    j_change_wind_directions = (*env)->GetIntArrayElements(env, change_wind_directions, 0);
+    for (i = 0; i < command_count; i++)
+    {
+        commands[i].key_code = (UINT8) j_key_codes[i];
+        commands[i].change_wind_direction = (BOOL) j_change_wind_directions[i];
+        jni_ac_status = (*env)->GetObjectArrayElement(env, jni_ac_statuses, i);
+        if (NULL != jni_ac_status)
+        {
+            get_ac_status(env, jni_ac_status, &commands[i].ac_status);
+            (*env)->DeleteLocalRef(env, jni_ac_status);
+        }
+    }
+    (*env)->ReleaseIntArrayElements(env, key_codes, j_key_codes, JNI_ABORT);
+    (*env)->ReleaseIntArrayElements(env, change_wind_directions, j_change_wind_directions, JNI_ABORT);
+
+    // room for every command at the longest the opened remote decodes to and a gap after it, decoded by a single call
+    capacity = (UINT) command_count * ((UINT) ir_max_decode_length() + 1);
+    capacity = (capacity > 0xFFFF) ? 0xFFFF : capacity;
+    user_data = (UINT16 *) malloc((0 == capacity ? 1 : capacity) * sizeof(UINT16));
+    if (NULL == user_data)
+    {
+        return NULL;
+    }
+    batch_gap.gap = (UINT16) gap;
+    batch_gap.gaps = NULL;
+    schedule_length = ir_decode_batch(commands, (UINT8) command_count, &batch_gap, user_data, (UINT16) capacity,
+                                      command_offsets);
+
+    result = (*env)->NewIntArray(env, schedule_length);
+    if (result != NULL)
+    {
+        // widened straight into the new array
+        timings = (jint *) (*env)->GetPrimitiveArrayCritical(env, result, NULL);
+        if (NULL == timings)
+        {
+            free(user_data);
+            return NULL;
+        }
+        for (i = 0; i < schedule_length; i++)
+        {
+            timings[i] = user_data[i];
+        }
+        (*env)->ReleasePrimitiveArrayCritical(env, result, timings, 0);
+        if (NULL != offsets && 0 != schedule_length)
+        {
+            for (i = 0; i < command_count; i++)
+            {
+                copy_offsets[i] = (jint) command_offsets[i];
+            }
+            (*env)->SetIntArrayRegion(env, offsets, 0, command_count, copy_offsets);
+        }
+    }
+    free(user_data);
+    return result;
+}
+
 JNIEXPORT void JNICALL Java_net_irext_decodesdk_IRDecode_irClose
           (JNIEnv *env, jobject this_obj)
 {
     ir_close();
+    free_decode_buffers();
+    free(binary_copy);
+    binary_copy = NULL;
 }
 
 JNIEXPORT jobject JNICALL Java_net_irext_decodesdk_IRDecode_irACGetTemperatureRange
@@ -118,14 +331,6 @@ JNIEXPORT jobject JNICALL Java_net_irext_decodesdk_IRDecode_irACGetTemperatureRa
     int tempMax = 0;
 
     jobject temperature_range = NULL;
-    jclass temperature_range_class =
-        (*env)->FindClass(env, "com/irext/remote/bean/jnibean/JNITemperatureRange");
-
-    jmethodID temperature_range_mid =
-        (*env)->GetMethodID(env, temperature_range_class, "<init>", "()V");
-
-    jfieldID min_temp_fid = (*env)->GetFieldID(env, temperature_range_class, "tempMin", "I");
-    jfieldID max_temp_fid = (*env)->GetFieldID(env, temperature_range_class, "tempMax", "I");
 
     temperature_range = (*env)->NewObject(env, temperature_range_class, temperature_range_mid);
 
@@ -167,4 +372,274 @@ JNIEXPORT jint JNICALL Java_net_irext_decodesdk_IRDecode_irACGetSupportedWindDir
     int supported_wind_direction = 0;
     get_supported_wind_direction((UINT8*)&supported_wind_direction);
     return supported_wind_direction;
-}
\ No newline at end of file
+}
+
+
+JNIEXPORT jlong JNICALL Java_net_irext_decodesdk_IRDecoder_irOpen
+          (JNIEnv *env, jclass clazz, jint category_id, jint sub_cate, jstring file_name)
+{
+    ir_decoder_handle_t *handle = (ir_decoder_handle_t *) calloc(1, sizeof(ir_decoder_handle_t));
+    const char *n_file_name = NULL;
+    INT8 ret = IR_DECODE_FAILED;
+
+    if (NULL == handle)
+    {
+        return 0;
+    }
+    n_file_name = (*env)->GetStringUTFChars(env, file_name, 0);
+    ret = ir_decoder_open_file(&handle->decoder, (UINT8) category_id, (UINT8) sub_cate, n_file_name);
+    (*env)->ReleaseStringUTFChars(env, file_name, n_file_name);
+    if (IR_DECODE_FAILED == ret)
+    {
+        ir_decoder_close(&handle->decoder);
+        close_handle(handle);
+        return 0;
+    }
+    return open_handle(handle);
+}
+
+JNIEXPORT jlong JNICALL Java_net_irext_decodesdk_IRDecoder_irOpenBinary
+          (JNIEnv *env, jclass clazz, jint category_id, jint sub_cate, jbyteArray binaries, jint bin_length)
+{
+    ir_decoder_handle_t *handle = (ir_decoder_handle_t *) calloc(1, sizeof(ir_decoder_handle_t));
+
+    if (NULL == handle)
+    {
+        return 0;
+    }
+    handle->binary = (UINT8 *) malloc(bin_length > 0 ? bin_length : 1);
+    if (NULL == handle->binary)
+    {
+        close_handle(handle);
+        return 0;
+    }
+    (*env)->GetByteArrayRegion(env, binaries, 0, bin_length, (jbyte *) handle->binary);
+    if (IR_DECODE_FAILED == ir_decoder_open_binary(&handle->decoder, (UINT8) category_id, (UINT8) sub_cate,
+                                                   handle->binary, (UINT16) bin_length))
+    {
+        ir_decoder_close(&handle->decoder);
+        close_handle(handle);
+        return 0;
+    }
+    return open_handle(handle);
+}
+
+JNIEXPORT jintArray JNICALL Java_net_irext_decodesdk_IRDecoder_irDecode
+          (JNIEnv *env, jclass clazz, jlong native_handle, jint key_code, jint ac_power, jint ac_mode, jint ac_temp,
+           jint ac_wind_speed, jint ac_wind_dir, jint change_wind_direction)
+{
+    ir_decoder_handle_t *handle = (ir_decoder_handle_t *) (intptr_t) native_handle;
+    remote_ac_status_t ac_status;
+    jintArray result = NULL;
+    jint *timings = NULL;
+    int wave_code_length = 0;
+    int i = 0;
+
+    set_ac_status(&ac_status, ac_power, ac_mode, ac_temp, ac_wind_speed, ac_wind_dir);
+    wave_code_length = ir_decoder_decode_into(&handle->decoder, (UINT8) key_code, handle->decode_buffer,
+                                              handle->decode_capacity, &ac_status, (BOOL) change_wind_direction);
+    result = (*env)->NewIntArray(env, wave_code_length);
+    if (NULL == result)
+    {
+        return NULL;
+    }
+    timings = (jint *) (*env)->GetPrimitiveArrayCritical(env, result, NULL);
+    if (NULL == timings)
+    {
+        return NULL;
+    }
+    for (i = 0; i < wave_code_length; i++)
+    {
+        timings[i] = handle->decode_buffer[i];
+    }
+    (*env)->ReleasePrimitiveArrayCritical(env, result, timings, 0);
+    return result;
+}
+
+JNIEXPORT jint JNICALL Java_net_irext_decodesdk_IRDecoder_irDecodeInto
+          (JNIEnv *env, jclass clazz, jlong native_handle, jint key_code, jint ac_power, jint ac_mode, jint ac_temp,
+           jint ac_wind_speed, jint ac_wind_dir, jint change_wind_direction, jintArray output)
+{
+    ir_decoder_handle_t *handle = (ir_decoder_handle_t *) (intptr_t) native_handle;
+    remote_ac_status_t ac_status;
+    jint *timings = NULL;
+    int wave_code_length = 0;
+    int i = 0;
+
+    if (NULL == output)
+    {
+        return 0;
+    }
+    set_ac_status(&ac_status, ac_power, ac_mode, ac_temp, ac_wind_speed, ac_wind_dir);
+    wave_code_length = ir_decoder_decode_into(&handle->decoder, (UINT8) key_code, handle->decode_buffer,
+                                              handle->decode_capacity, &ac_status, (BOOL) change_wind_direction);
+    if (wave_code_length > (*env)->GetArrayLength(env, output))
+    {
+        return 0;
+    }
+    timings = (jint *) (*env)->GetPrimitiveArrayCritical(env, output, NULL);
+    if (NULL == timings)
+    {
+        return 0;
+    }
+    for (i = 0; i < wave_code_length; i++)
+    {
+        timings[i] = handle->decode_buffer[i];
+    }
+    (*env)->ReleasePrimitiveArrayCritical(env, output, timings, 0);
+    return wave_code_length;
+}
+
+JNIEXPORT jint JNICALL Java_net_irext_decodesdk_IRDecoder_irMaxDecodeLength
+          (JNIEnv *env, jclass clazz, jlong native_handle)
+{
+    ir_decoder_handle_t *handle = (ir_decoder_handle_t *) (intptr_t) native_handle;
+    return ir_decoder_max_decode_length(&handle->decoder);
+}
+
+JNIEXPORT void JNICALL Java_net_irext_decodesdk_IRDecoder_irClose
+          (JNIEnv *env, jclass clazz, jlong native_handle)
+{
+    ir_decoder_handle_t *handle = (ir_decoder_handle_t *) (intptr_t) native_handle;
+
+    if (NULL != handle)
+    {
+        ir_decoder_close(&handle->decoder);
+        close_handle(handle);
+    }
+}
+
+JNIEXPORT jobject JNICALL Java_net_irext_decodesdk_IRDecoder_irACGetTemperatureRange
+          (JNIEnv *env, jclass clazz, jlong native_handle, jint ac_mode)
+{
+    ir_decoder_handle_t *handle = (ir_decoder_handle_t *) (intptr_t) native_handle;
+    jobject temperature_range = NULL;
+    INT8 temp_min = 0;
+    INT8 temp_max = 0;
+
+    temperature_range = (*env)->NewObject(env, temperature_range_class, temperature_range_mid);
+    ir_decoder_get_temperature_range(&handle->decoder, (UINT8) ac_mode, &temp_min, &temp_max);
+    (*env)->SetIntField(env, temperature_range, min_temp_fid, temp_min);
+    (*env)->SetIntField(env, temperature_range, max_temp_fid, temp_max);
+    return temperature_range;
+}
+
+JNIEXPORT jint JNICALL Java_net_irext_decodesdk_IRDecoder_irACGetSupportedMode
+          (JNIEnv *env, jclass clazz, jlong native_handle)
+{
+    ir_decoder_handle_t *handle = (ir_decoder_handle_t *) (intptr_t) native_handle;
+    UINT8 supported_mode = 0;
+
+    ir_decoder_get_supported_mode(&handle->decoder, &supported_mode);
+    return supported_mode;
+}
+
+JNIEXPORT jint JNICALL Java_net_irext_decodesdk_IRDecoder_irACGetSupportedWindSpeed
+          (JNIEnv *env, jclass clazz, jlong native_handle, jint ac_mode)
+{
+    ir_decoder_handle_t *handle = (ir_decoder_handle_t *) (intptr_t) native_handle;
+    UINT8 supported_wind_speed = 0;
+
+    ir_decoder_get_supported_wind_speed(&handle->decoder, (UINT8) ac_mode, &supported_wind_speed);
+    return supported_wind_speed;
+}
+
+JNIEXPORT jint JNICALL Java_net_irext_decodesdk_IRDecoder_irACGetSupportedSwing
+          (JNIEnv *env, jclass clazz, jlong native_handle, jint ac_mode)
+{
+    ir_decoder_handle_t *handle = (ir_decoder_handle_t *) (intptr_t) native_handle;
+    UINT8 supported_swing = 0;
+
+    ir_decoder_get_supported_swing(&handle->decoder, (UINT8) ac_mode, &supported_swing);
+    return supported_swing;
+}
+
+JNIEXPORT jint JNICALL Java_net_irext_decodesdk_IRDecoder_irACGetSupportedWindDirection
+          (JNIEnv *env, jclass clazz, jlong native_handle)
+{
+    ir_decoder_handle_t *handle = (ir_decoder_handle_t *) (intptr_t) native_handle;
+    UINT8 supported_wind_direction = 0;
+
+    ir_decoder_get_supported_wind_direction(&handle->decoder, &supported_wind_direction);
+    return supported_wind_direction;
+}
+
+static void get_ac_status(JNIEnv *env, jobject jni_ac_status, remote_ac_status_t *ac_status)
+{
+    if (NULL == jni_ac_status)
+    {
+        ir_memset(ac_status, 0x00, sizeof(remote_ac_status_t));
+        return;
+    }
+    set_ac_status(ac_status,
+                  (*env)->GetIntField(env, jni_ac_status, ac_power_fid),
+                  (*env)->GetIntField(env, jni_ac_status, ac_mode_fid),
+                  (*env)->GetIntField(env, jni_ac_status, ac_temp_fid),
+                  (*env)->GetIntField(env, jni_ac_status, ac_wind_speed_fid),
+                  (*env)->GetIntField(env, jni_ac_status, ac_wind_dir_fid));
+}
+
+static void set_ac_status(remote_ac_status_t *ac_status, jint ac_power, jint ac_mode, jint ac_temp,
+                          jint ac_wind_speed, jint ac_wind_dir)
+{
+    ac_status->acDisplay = 0;
+    ac_status->acSleep = 0;
+    ac_status->acTimer = 0;
+    ac_status->acPower = ac_power;
+    ac_status->acMode = ac_mode;
+    ac_status->acTemp = ac_temp;
+    ac_status->acWindDir = ac_wind_dir;
+    ac_status->acWindSpeed = ac_wind_speed;
+}
+
+// a buffer of ir_max_decode_length timings holds whatever the opened remote decodes to
+static INT8 alloc_decode_buffers()
+{
+    UINT16 length = ir_max_decode_length();
+
+    free_decode_buffers();
+    length = (0 == length) ? 1 : length;
+    decode_buffer = (UINT16 *) malloc(length * sizeof(UINT16));
+    copy_buffer = (jint *) malloc(length * sizeof(jint));
+    if (NULL == decode_buffer || NULL == copy_buffer)
+    {
+        free_decode_buffers();
+        ir_close();
+        return IR_DECODE_FAILED;
+    }
+    decode_capacity = length;
+    return IR_DECODE_SUCCEEDED;
+}
+
+static void free_decode_buffers()
+{
+    free(decode_buffer);
+    free(copy_buffer);
+    decode_buffer = NULL;
+    copy_buffer = NULL;
+    decode_capacity = 0;
+}
+
+// the decode buffer of a handle is sized for its remote once opened
+static jlong open_handle(ir_decoder_handle_t *handle)
+{
+    UINT16 length = ir_decoder_max_decode_length(&handle->decoder);
+
+    length = (0 == length) ? 1 : length;
+    handle->decode_buffer = (UINT16 *) malloc(length * sizeof(UINT16));
+    if (NULL == handle->decode_buffer)
+    {
+        ir_decoder_close(&handle->decoder);
+        close_handle(handle);
+        return 0;
+    }
+    handle->decode_capacity = length;
+    return (jlong) (intptr_t) handle;
+}
+
+static void close_handle(ir_decoder_handle_t *handle)
+{
+    free(handle->decode_buffer);
+    free(handle->binary);
+    free(handle);
+}
@@ -83,6 +83,38 @@ JNIEXPORT jint JNICALL Java_net_irext_decodesdk_IRDecode_irOpenBinary
 JNIEXPORT jintArray JNICALL Java_net_irext_decodesdk_IRDecode_irDecode
   (JNIEnv *, jobject, jint, jobject, jint);
 
+/*
+ * Class:     net_irext_decodesdk_IRDecode
+ * Method:    irDecodeInto
+ * Signature: (IIIIIII[I)I
+ */
+JNIEXPORT jint JNICALL Java_net_irext_decodesdk_IRDecode_irDecodeInto
+  (JNIEnv *, jobject, jint, jint, jint, jint, jint, jint, jint, jintArray);
+
+/*
+ * Class:     net_irext_decodesdk_IRDecode
+ * Method:    irDecodeDirect
+ * Signature: (IIIIIIILjava/nio/ByteBuffer;)I
+ */
+JNIEXPORT jint JNICALL Java_net_irext_decodesdk_IRDecode_irDecodeDirect
+  (JNIEnv *, jobject, jint, jint, jint, jint, jint, jint, jint, jobject);
+
+/*
+ * Class:     net_irext_decodesdk_IRDecode
+ * Method:    irMaxDecodeLength
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL Java_net_irext_decodesdk_IRDecode_irMaxDecodeLength
+  (JNIEnv *, jobject);
+
+/*
+ * Class:     net_irext_decodesdk_IRDecode
+ * Method:    irDecodeBatch
+ * Signature: ([I[Lnet/irext/decodesdk/bean/ACStatus;[II[I)[I
+ */
+JNIEXPORT jintArray JNICALL Java_net_irext_decodesdk_IRDecode_irDecodeBatch
+  (JNIEnv *, jobject, jintArray, jobjectArray, jintArray, jint, jintArray);
+
 /*
  * Class:     net_irext_decodesdk_IRDecode
  * Method:    irClose
@@ -146,3 +178,102 @@ extern "C" {
 }
 #endif
 #endif
+/* Header for class net_irext_decodesdk_IRDecoder */
+
+#ifndef _Included_net_irext_decodesdk_IRDecoder
+#define _Included_net_irext_decodesdk_IRDecoder
+#ifdef __cplusplus
+extern "C" {
+#endif
+/*
+ * Class:     net_irext_decodesdk_IRDecoder
+ * Method:    irOpen
+ * Signature: (IILjava/lang/String;)J
+ */
+JNIEXPORT jlong JNICALL Java_net_irext_decodesdk_IRDecoder_irOpen
+  (JNIEnv *, jclass, jint, jint, jstring);
+
+/*
+ * Class:     net_irext_decodesdk_IRDecoder
+ * Method:    irOpenBinary
+ * Signature: (II[BI)J
+ */
+JNIEXPORT jlong JNICALL Java_net_irext_decodesdk_IRDecoder_irOpenBinary
+  (JNIEnv *, jclass, jint, jint, jbyteArray, jint);
+
+/*
+ * Class:     net_irext_decodesdk_IRDecoder
+ * Method:    irDecode
+ * Signature: (JIIIIIII)[I
+ */
+JNIEXPORT jintArray JNICALL Java_net_irext_decodesdk_IRDecoder_irDecode
+  (JNIEnv *, jclass, jlong, jint, jint, jint, jint, jint, jint, jint);
+
+/*
+ * Class:     net_irext_decodesdk_IRDecoder
+ * Method:    irDecodeInto
+ * Signature: (JIIIIIII[I)I
+ */
+JNIEXPORT jint JNICALL Java_net_irext_decodesdk_IRDecoder_irDecodeInto
+  (JNIEnv *, jclass, jlong, jint, jint, jint, jint, jint, jint, jint, jintArray);
+
+/*
+ * Class:     net_irext_decodesdk_IRDecoder
+ * Method:    irMaxDecodeLength
+ * Signature: (J)I
+ */
+JNIEXPORT jint JNICALL Java_net_irext_decodesdk_IRDecoder_irMaxDecodeLength
+  (JNIEnv *, jclass, jlong);
+
+/*
+ * Class:     net_irext_decodesdk_IRDecoder
+ * Method:    irClose
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_net_irext_decodesdk_IRDecoder_irClose
+  (JNIEnv *, jclass, jlong);
+
+/*
+ * Class:     net_irext_decodesdk_IRDecoder
+ * Method:    irACGetTemperatureRange
+ * Signature: (JI)Lnet/irext/decodesdk/bean/TemperatureRange;
+ */
+JNIEXPORT jobject JNICALL Java_net_irext_decodesdk_IRDecoder_irACGetTemperatureRange
+  (JNIEnv *, jclass, jlong, jint);
+
+/*
+ * Class:     net_irext_decodesdk_IRDecoder
+ * Method:    irACGetSupportedMode
+ * Signature: (J)I
+ */
+JNIEXPORT jint JNICALL Java_net_irext_decodesdk_IRDecoder_irACGetSupportedMode
+  (JNIEnv *, jclass, jlong);
+
+/*
+ * Class:     net_irext_decodesdk_IRDecoder
+ * Method:    irACGetSupportedWindSpeed
+ * Signature: (JI)I
+ */
+JNIEXPORT jint JNICALL Java_net_irext_decodesdk_IRDecoder_irACGetSupportedWindSpeed
+  (JNIEnv *, jclass, jlong, jint);
+
+/*
+ * Class:     net_irext_decodesdk_IRDecoder
+ * Method:    irACGetSupportedSwing
+ * Signature: (JI)I
+ */
+JNIEXPORT jint JNICALL Java_net_irext_decodesdk_IRDecoder_irACGetSupportedSwing
+  (JNIEnv *, jclass, jlong, jint);
+
+/*
+ * Class:     net_irext_decodesdk_IRDecoder
+ * Method:    irACGetSupportedWindDirection
+ * Signature: (J)I
+ */
+JNIEXPORT jint JNICALL Java_net_irext_decodesdk_IRDecoder_irACGetSupportedWindDirection
+  (JNIEnv *, jclass, jlong);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
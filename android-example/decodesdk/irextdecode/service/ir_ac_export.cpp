@@ -0,0 +1,570 @@
+/**************************************************************************************
+Filename:       ir_ac_export.cpp
+Revised:        Date: 2026-10-17
+Revision:       Revision: 1.0
+
+Description:    This file provides the offline pre-render of every AC command of remotes
+
+Revision log:
+* 2026-10-17: created by agent
+**************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "ir_decode.h"
+#include "ir_bundle.h"
+
+/*
+ * output, all integers are little endian
+ *
+ * <prefix>.table   timings (2 bytes each) of every distinct waveform, back to back
+ *
+ * <prefix>.index   header:   magic "IRXE" (4) | version (2) | reserved (2) |
+ *                            remote count (4) | record count (4) | table timing count (4)
+ *                  remotes:  sorted by remote id,
+ *                            remote id (4) | first record (4) | record count (4)
+ *                  records:  sorted by key within a remote,
+ *                            key: power (1) | mode (1) | temperature (1) | wind speed (1) |
+ *                                 wind direction (1) | function (1) | swing position (1) | reserved (1)
+ *                            timing offset in table (4) | timing count (2) | reserved (2)
+ *
+ * swing position is the swing state the frame carries, 0 for swinging and 1 .. n for the
+ * fixed positions (n from get_supported_wind_direction), clients keep track of it as the decoder does
+ */
+#define EXPORT_MAGIC                "IRXE"
+#define EXPORT_VERSION              1
+#define EXPORT_HEADER_SIZE          20
+#define EXPORT_REMOTE_SIZE          12
+#define EXPORT_RECORD_SIZE          16
+#define EXPORT_KEY_SIZE             8
+
+struct export_remote
+{
+    UINT remote_id;
+    UINT8 category;
+    UINT8 sub_category;
+    std::string name;
+    std::vector<UINT8> content;
+};
+
+struct export_record
+{
+    UINT8 key[EXPORT_KEY_SIZE];
+    // waveform of the remote, an index into export_result::waveforms
+    UINT waveform;
+    // waveform in the merged table
+    UINT offset;
+    UINT16 length;
+};
+
+struct export_result
+{
+    bool opened;
+    UINT states;
+    std::vector<export_record> records;
+    std::vector<std::vector<UINT16> > waveforms;
+};
+
+static UINT64 waveform_hash(const UINT16 *timings, size_t length)
+{
+    // FNV-1a over the timings
+    UINT64 hash = 0xCBF29CE484222325ULL;
+    size_t i = 0;
+
+    for (i = 0; i < length; i++)
+    {
+        hash ^= timings[i];
+        hash *= 0x00000100000001B3ULL;
+    }
+    return hash;
+}
+
+static void put_le16(std::vector<UINT8> &out, UINT value)
+{
+    out.push_back((UINT8) (value & 0xFF));
+    out.push_back((UINT8) ((value >> 8) & 0xFF));
+}
+
+static void put_le32(std::vector<UINT8> &out, UINT value)
+{
+    put_le16(out, value & 0xFFFF);
+    put_le16(out, value >> 16);
+}
+
+// pushes the bits set in mask, or only fallback when none is
+static void values_of_mask(UINT8 mask, UINT count, UINT fallback, std::vector<UINT> &values)
+{
+    UINT i = 0;
+
+    values.clear();
+    for (i = 0; i < count; i++)
+    {
+        if (0 != (mask & (1 << i)))
+        {
+            values.push_back(i);
+        }
+    }
+    if (values.empty())
+    {
+        values.push_back(fallback);
+    }
+}
+
+// enumerates and renders every status of a remote, identical waveforms of the remote are kept once
+static void render_remote(export_remote &remote, export_result &result)
+{
+    ir_decoder_t decoder;
+    remote_ac_status_t ac_status;
+    std::vector<UINT16> user_data(USER_DATA_SIZE);
+    std::unordered_map<UINT64, std::vector<UINT> > seen;
+    std::vector<UINT> modes;
+    std::vector<UINT> speeds;
+    std::vector<UINT> swings;
+    UINT8 mask = 0;
+    UINT positions = 0;
+    UINT power = 0;
+    UINT function = 0;
+    INT8 temp_min = 0;
+    INT8 temp_max = 0;
+
+    result.opened = false;
+    result.states = 0;
+    if (IR_DECODE_SUCCEEDED != ir_decoder_open_binary(&decoder, IR_CATEGORY_AC, remote.sub_category,
+                                                      remote.content.data(), (UINT16) remote.content.size()))
+    {
+        ir_decoder_close(&decoder);
+        return;
+    }
+    result.opened = true;
+
+    ir_decoder_get_supported_mode(&decoder, &mask);
+    values_of_mask(mask, AC_MODE_MAX, AC_MODE_COOL, modes);
+    if (SWING_TYPE_NORMAL == decoder.ac.si.type && decoder.ac.si.mode_count > 1)
+    {
+        positions = decoder.ac.si.mode_count - 1;
+    }
+
+    memset(&ac_status, 0x00, sizeof(remote_ac_status_t));
+    for (power = 0; power < AC_POWER_MAX; power++)
+    {
+        for (UINT mode : modes)
+        {
+            ir_decoder_get_temperature_range(&decoder, (UINT8) mode, &temp_min, &temp_max);
+            if (temp_min < 0 || temp_max < 0)
+            {
+                // temperature is not controlled in this mode
+                temp_min = temp_max = AC_TEMP_16;
+            }
+            ir_decoder_get_supported_wind_speed(&decoder, (UINT8) mode, &mask);
+            values_of_mask(mask, AC_WS_MAX, AC_WS_AUTO, speeds);
+            ir_decoder_get_supported_swing(&decoder, (UINT8) mode, &mask);
+            values_of_mask(mask, AC_SWING_MAX, AC_SWING_ON, swings);
+
+            for (INT8 temperature = temp_min; temperature <= temp_max; temperature++)
+            {
+                for (UINT speed : speeds)
+                {
+                    for (UINT swing : swings)
+                    {
+                        for (function = AC_FUNCTION_POWER; function < AC_FUNCTION_MAX; function++)
+                        {
+                            UINT first = (AC_FUNCTION_WIND_FIX == function && positions > 0) ? 1 : 0;
+                            UINT last = (AC_FUNCTION_WIND_SWING == function) ? 0 : positions;
+
+                            for (UINT position = first; position <= last; position++)
+                            {
+                                export_record record;
+                                UINT16 length = 0;
+                                UINT64 hash = 0;
+                                UINT found = 0;
+                                bool duplicated = false;
+
+                                ac_status.acPower = (ac_power) power;
+                                ac_status.acMode = (ac_mode) mode;
+                                ac_status.acTemp = (ac_temperature) temperature;
+                                ac_status.acWindSpeed = (ac_wind_speed) speed;
+                                ac_status.acWindDir = (ac_swing) swing;
+
+                                // render in the given swing position without stepping it
+                                decoder.ac.swing_status = (UINT8) position;
+                                decoder.ac.si.dir_index = (UINT8) position;
+                                length = ir_decoder_decode(&decoder, (UINT8) function, user_data.data(),
+                                                           &ac_status, FALSE);
+                                result.states++;
+                                if (0 == length)
+                                {
+                                    continue;
+                                }
+
+                                hash = waveform_hash(user_data.data(), length);
+                                std::vector<UINT> &candidates = seen[hash];
+                                for (UINT candidate : candidates)
+                                {
+                                    const std::vector<UINT16> &waveform = result.waveforms[candidate];
+                                    if (waveform.size() == length &&
+                                        0 == memcmp(waveform.data(), user_data.data(), length * sizeof(UINT16)))
+                                    {
+                                        found = candidate;
+                                        duplicated = true;
+                                        break;
+                                    }
+                                }
+                                if (!duplicated)
+                                {
+                                    found = (UINT) result.waveforms.size();
+                                    result.waveforms.push_back(
+                                            std::vector<UINT16>(user_data.begin(), user_data.begin() + length));
+                                    candidates.push_back(found);
+                                }
+
+                                record.key[0] = (UINT8) power;
+                                record.key[1] = (UINT8) mode;
+                                record.key[2] = (UINT8) temperature;
+                                record.key[3] = (UINT8) speed;
+                                record.key[4] = (UINT8) swing;
+                                record.key[5] = (UINT8) function;
+                                record.key[6] = (UINT8) position;
+                                record.key[7] = 0;
+                                record.waveform = found;
+                                record.offset = 0;
+                                record.length = length;
+                                result.records.push_back(record);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    ir_decoder_close(&decoder);
+
+    std::sort(result.records.begin(), result.records.end(),
+              [](const export_record &a, const export_record &b)
+              {
+                  return memcmp(a.key, b.key, EXPORT_KEY_SIZE) < 0;
+              });
+}
+
+static bool read_file(const char *file_name, std::vector<UINT8> &content)
+{
+    FILE *stream = fopen(file_name, "rb");
+    long size = 0;
+
+    if (NULL == stream)
+    {
+        return false;
+    }
+    fseek(stream, 0, SEEK_END);
+    size = ftell(stream);
+    fseek(stream, 0, SEEK_SET);
+    if (size <= 0 || size > 0xFFFF)
+    {
+        fclose(stream);
+        return false;
+    }
+    content.resize((size_t) size);
+    if (1 != fread(content.data(), content.size(), 1, stream))
+    {
+        fclose(stream);
+        return false;
+    }
+    fclose(stream);
+    return true;
+}
+
+// list lines as for ir_bundle: <remote id> <category> <sub_category> <remote map name> <binary file>
+static bool load_list(const char *list_name, std::vector<export_remote> &remotes)
+{
+    FILE *stream = fopen(list_name, "r");
+    char line[1024];
+    char name[256];
+    char file_name[512];
+
+    if (NULL == stream)
+    {
+        return false;
+    }
+    while (NULL != fgets(line, sizeof(line), stream))
+    {
+        export_remote remote;
+        UINT category = 0;
+        UINT sub_category = 0;
+
+        if ('#' == line[0] || '\n' == line[0])
+        {
+            continue;
+        }
+        if (5 != sscanf(line, "%u %u %u %255s %511s", &remote.remote_id, &category, &sub_category,
+                        name, file_name))
+        {
+            fprintf(stderr, "invalid list line: %s", line);
+            fclose(stream);
+            return false;
+        }
+        if (IR_CATEGORY_AC != category)
+        {
+            continue;
+        }
+        remote.category = (UINT8) category;
+        remote.sub_category = (UINT8) sub_category;
+        remote.name = name;
+        if (!read_file(file_name, remote.content))
+        {
+            fprintf(stderr, "failed to read %s\n", file_name);
+            fclose(stream);
+            return false;
+        }
+        remotes.push_back(remote);
+    }
+    fclose(stream);
+    return true;
+}
+
+static bool load_bundle(const char *bundle_name, std::vector<export_remote> &remotes)
+{
+    ir_bundle_t bundle;
+    ir_bundle_item_t item;
+    UINT i = 0;
+
+    if (IR_DECODE_SUCCEEDED != ir_bundle_open_file(&bundle, bundle_name))
+    {
+        return false;
+    }
+    for (i = 0; i < bundle.entry_count; i++)
+    {
+        if (IR_DECODE_SUCCEEDED != ir_bundle_get(&bundle, i, &item) || IR_CATEGORY_AC != item.category)
+        {
+            continue;
+        }
+        export_remote remote;
+        remote.remote_id = item.remote_id;
+        remote.category = item.category;
+        remote.sub_category = item.sub_category;
+        remote.name = item.name;
+        remote.content.assign(item.binary, item.binary + item.binary_length);
+        remotes.push_back(remote);
+    }
+    ir_bundle_close(&bundle);
+    return true;
+}
+
+static bool write_file(const std::string &file_name, const std::vector<UINT8> &content)
+{
+    FILE *stream = fopen(file_name.c_str(), "wb");
+    bool written = false;
+
+    if (NULL == stream)
+    {
+        return false;
+    }
+    written = content.empty() || 1 == fwrite(content.data(), content.size(), 1, stream);
+    fclose(stream);
+    return written;
+}
+
+static double now_seconds()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + (double) ts.tv_nsec / 1e9;
+}
+
+static void usage(const char *program)
+{
+    printf("usage: %s [-t threads] (-l <list> | -b <bundle>) -o <output prefix>\n", program);
+    printf("  -l  remote list as for ir_bundle, remotes other than AC are skipped\n");
+    printf("  -b  remote bundle packed by ir_bundle\n");
+    printf("writes <output prefix>.table and <output prefix>.index\n");
+}
+
+int main(int argc, char *argv[])
+{
+    size_t threads = std::max(1u, std::thread::hardware_concurrency());
+    const char *list_name = NULL;
+    const char *bundle_name = NULL;
+    const char *prefix = NULL;
+    std::vector<export_remote> remotes;
+    std::vector<export_result> results;
+    std::vector<std::thread> workers;
+    std::atomic<size_t> next(0);
+    std::unordered_map<UINT64, std::vector<UINT> > table_seen;
+    std::vector<UINT16> table;
+    std::vector<UINT8> table_file;
+    std::vector<UINT8> index_file;
+    std::vector<size_t> order;
+    UINT64 states = 0;
+    UINT records = 0;
+    UINT unique = 0;
+    UINT failed = 0;
+    double start = 0;
+    int option = 0;
+    size_t i = 0;
+
+    while (-1 != (option = getopt(argc, argv, "t:l:b:o:h")))
+    {
+        switch (option)
+        {
+            case 't':
+                threads = (size_t) std::max(1, atoi(optarg));
+                break;
+            case 'l':
+                list_name = optarg;
+                break;
+            case 'b':
+                bundle_name = optarg;
+                break;
+            case 'o':
+                prefix = optarg;
+                break;
+            default:
+                usage(argv[0]);
+                return 'h' == option ? 0 : -1;
+        }
+    }
+    if (NULL == prefix || (NULL == list_name) == (NULL == bundle_name))
+    {
+        usage(argv[0]);
+        return -1;
+    }
+    if ((NULL != list_name && !load_list(list_name, remotes)) ||
+        (NULL != bundle_name && !load_bundle(bundle_name, remotes)))
+    {
+        fprintf(stderr, "failed to load remotes\n");
+        return -1;
+    }
+
+    // remotes are rendered in parallel, each worker takes the next remote not taken yet
+    start = now_seconds();
+    results.resize(remotes.size());
+    for (i = 0; i < std::min(threads, remotes.size()); i++)
+    {
+        workers.push_back(std::thread([&]()
+        {
+            size_t index = 0;
+            while ((index = next.fetch_add(1)) < remotes.size())
+            {
+                render_remote(remotes[index], results[index]);
+            }
+        }));
+    }
+    for (i = 0; i < workers.size(); i++)
+    {
+        workers[i].join();
+    }
+
+    // merge in remote id order, so the output does not depend on scheduling
+    for (i = 0; i < remotes.size(); i++)
+    {
+        order.push_back(i);
+    }
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b)
+    {
+        return remotes[a].remote_id < remotes[b].remote_id;
+    });
+    for (i = 1; i < order.size(); i++)
+    {
+        if (remotes[order[i - 1]].remote_id == remotes[order[i]].remote_id)
+        {
+            fprintf(stderr, "duplicated remote %u\n", remotes[order[i]].remote_id);
+            return -1;
+        }
+    }
+
+    for (size_t index : order)
+    {
+        export_result &result = results[index];
+        std::vector<UINT> offsets(result.waveforms.size());
+
+        if (!result.opened)
+        {
+            fprintf(stderr, "failed to open remote %u (%s)\n", remotes[index].remote_id, remotes[index].name.c_str());
+            failed++;
+        }
+        states += result.states;
+
+        // waveforms shared by remotes are kept once in the table as well
+        for (i = 0; i < result.waveforms.size(); i++)
+        {
+            const std::vector<UINT16> &waveform = result.waveforms[i];
+            UINT64 hash = waveform_hash(waveform.data(), waveform.size());
+            std::vector<UINT> &candidates = table_seen[hash];
+            bool duplicated = false;
+
+            for (UINT offset : candidates)
+            {
+                if (offset + waveform.size() <= table.size() &&
+                    std::equal(waveform.begin(), waveform.end(), table.begin() + offset))
+                {
+                    offsets[i] = offset;
+                    duplicated = true;
+                    break;
+                }
+            }
+            if (!duplicated)
+            {
+                offsets[i] = (UINT) table.size();
+                candidates.push_back(offsets[i]);
+                table.insert(table.end(), waveform.begin(), waveform.end());
+                unique++;
+            }
+        }
+        for (export_record &record : result.records)
+        {
+            record.offset = offsets[record.waveform];
+        }
+        records += (UINT) result.records.size();
+    }
+
+    index_file.insert(index_file.end(), EXPORT_MAGIC, EXPORT_MAGIC + 4);
+    put_le16(index_file, EXPORT_VERSION);
+    put_le16(index_file, 0);
+    put_le32(index_file, (UINT) order.size());
+    put_le32(index_file, records);
+    put_le32(index_file, (UINT) table.size());
+    records = 0;
+    for (size_t index : order)
+    {
+        put_le32(index_file, remotes[index].remote_id);
+        put_le32(index_file, records);
+        put_le32(index_file, (UINT) results[index].records.size());
+        records += (UINT) results[index].records.size();
+    }
+    for (size_t index : order)
+    {
+        for (const export_record &record : results[index].records)
+        {
+            index_file.insert(index_file.end(), record.key, record.key + EXPORT_KEY_SIZE);
+            put_le32(index_file, record.offset);
+            put_le16(index_file, record.length);
+            put_le16(index_file, 0);
+        }
+    }
+    for (i = 0; i < table.size(); i++)
+    {
+        put_le16(table_file, table[i]);
+    }
+
+    if (!write_file(std::string(prefix) + ".table", table_file) ||
+        !write_file(std::string(prefix) + ".index", index_file))
+    {
+        fprintf(stderr, "failed to write %s.table / %s.index\n", prefix, prefix);
+        return -1;
+    }
+
+    printf("remotes: %zu (%u failed), threads: %zu, seconds: %.3f\n",
+           remotes.size(), failed, std::min(threads, remotes.size()), now_seconds() - start);
+    printf("states: %llu, records: %u, distinct waveforms: %u\n", (unsigned long long) states, records, unique);
+    printf("table: %zu bytes, index: %zu bytes\n", table_file.size(), index_file.size());
+    return 0 == failed ? 0 : -1;
+}
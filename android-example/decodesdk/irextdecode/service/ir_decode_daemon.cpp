@@ -0,0 +1,502 @@
+/**************************************************************************************
+Filename:       ir_decode_daemon.cpp
+Revised:        Date: 2026-10-17
+Revision:       Revision: 1.0
+
+Description:    This file provides a local socket daemon and benchmark for the decode service
+
+Revision log:
+* 2026-10-17: created by agent
+**************************************************************************************/
+
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+
+#include "ir_decode_service.h"
+
+/*
+ * wire format, all integers are little endian
+ *
+ * request:     op (1 byte) | payload length (4 bytes) | payload
+ *   OP_REGISTER    remote_id (4) | category (1) | sub_category (1) | binary
+ *   OP_UNREGISTER  remote_id (4)
+ *   OP_DECODE      remote_id (4) | key_code (1) | change_wind_direction (1) |
+ *                  power (1) | temperature (1) | mode (1) | wind_direction (1) | wind_speed (1)
+ *
+ * response:    status (1) | timing count (2) | timings (2 bytes each, OP_DECODE only)
+ */
+#define OP_REGISTER                 1
+#define OP_UNREGISTER               2
+#define OP_DECODE                   3
+
+#define DEFAULT_SOCKET_PATH         "/tmp/irext_decode.sock"
+#define MAX_PAYLOAD_LENGTH          (0xFFFF + 6)
+#define BENCH_DEFAULT_JOBS          200000
+
+using namespace irext;
+
+struct remote_arg
+{
+    UINT remote_id;
+    UINT8 category;
+    UINT8 sub_category;
+    std::vector<UINT8> content;
+};
+
+static UINT read_le32(const UINT8 *p)
+{
+    return (UINT) p[0] | ((UINT) p[1] << 8) | ((UINT) p[2] << 16) | ((UINT) p[3] << 24);
+}
+
+static bool read_fully(int fd, UINT8 *buffer, size_t length)
+{
+    size_t done = 0;
+    while (done < length)
+    {
+        ssize_t n = read(fd, buffer + done, length - done);
+        if (n < 0 && EINTR == errno)
+        {
+            continue;
+        }
+        if (n <= 0)
+        {
+            return false;
+        }
+        done += (size_t) n;
+    }
+    return true;
+}
+
+static bool write_fully(int fd, const UINT8 *buffer, size_t length)
+{
+    size_t done = 0;
+    while (done < length)
+    {
+        ssize_t n = write(fd, buffer + done, length - done);
+        if (n < 0 && EINTR == errno)
+        {
+            continue;
+        }
+        if (n <= 0)
+        {
+            return false;
+        }
+        done += (size_t) n;
+    }
+    return true;
+}
+
+static bool write_response(int fd, INT8 status, const std::vector<UINT16> &timings)
+{
+    std::vector<UINT8> response(3 + timings.size() * 2);
+    size_t i = 0;
+
+    response[0] = (UINT8) status;
+    response[1] = (UINT8) (timings.size() & 0xFF);
+    response[2] = (UINT8) ((timings.size() >> 8) & 0xFF);
+    for (i = 0; i < timings.size(); i++)
+    {
+        response[3 + i * 2] = (UINT8) (timings[i] & 0xFF);
+        response[4 + i * 2] = (UINT8) ((timings[i] >> 8) & 0xFF);
+    }
+    return write_fully(fd, response.data(), response.size());
+}
+
+static void serve_connection(decode_service *service, int fd)
+{
+    UINT8 header[5];
+    std::vector<UINT8> payload;
+    std::vector<UINT16> no_timings;
+
+    while (read_fully(fd, header, sizeof(header)))
+    {
+        UINT8 op = header[0];
+        UINT length = read_le32(header + 1);
+        INT8 status = IR_DECODE_FAILED;
+
+        if (length < 4 || length > MAX_PAYLOAD_LENGTH)
+        {
+            break;
+        }
+        payload.resize(length);
+        if (!read_fully(fd, payload.data(), length))
+        {
+            break;
+        }
+
+        UINT remote_id = read_le32(payload.data());
+        if (OP_REGISTER == op && length > 6)
+        {
+            status = service->register_remote(remote_id, payload[4], payload[5], payload.data() + 6, length - 6);
+        }
+        else if (OP_UNREGISTER == op)
+        {
+            status = service->unregister_remote(remote_id);
+        }
+        else if (OP_DECODE == op && length >= 11 &&
+                 payload[6] < AC_POWER_MAX && payload[7] < AC_TEMP_MAX && payload[8] < AC_MODE_MAX &&
+                 payload[9] < AC_SWING_MAX && payload[10] < AC_WS_MAX)
+        {
+            // status values index the parsed protocol, out of range ones are answered as failed below
+            decode_job job;
+            memset(&job, 0x00, sizeof(decode_job));
+            job.remote_id = remote_id;
+            job.key_code = payload[4];
+            job.change_wind_direction = payload[5] ? TRUE : FALSE;
+            job.ac_status.acPower = (ac_power) payload[6];
+            job.ac_status.acTemp = (ac_temperature) payload[7];
+            job.ac_status.acMode = (ac_mode) payload[8];
+            job.ac_status.acWindDir = (ac_swing) payload[9];
+            job.ac_status.acWindSpeed = (ac_wind_speed) payload[10];
+
+            decode_result result = service->decode(job);
+            if (!write_response(fd, result.status, result.timings))
+            {
+                break;
+            }
+            continue;
+        }
+
+        if (!write_response(fd, status, no_timings))
+        {
+            break;
+        }
+    }
+    close(fd);
+}
+
+static int run_daemon(decode_service &service, const char *socket_path)
+{
+    struct sockaddr_un address;
+    int server_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    if (server_fd < 0)
+    {
+        perror("socket");
+        return -1;
+    }
+
+    memset(&address, 0x00, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, socket_path, sizeof(address.sun_path) - 1);
+    unlink(socket_path);
+
+    if (bind(server_fd, (struct sockaddr *) &address, sizeof(address)) < 0 || listen(server_fd, 16) < 0)
+    {
+        perror("bind");
+        close(server_fd);
+        return -1;
+    }
+    printf("decode daemon listening on %s with %u workers\n", socket_path, (UINT) service.worker_count());
+
+    for (;;)
+    {
+        int client_fd = accept(server_fd, NULL, NULL);
+        if (client_fd < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+            perror("accept");
+            break;
+        }
+        std::thread(serve_connection, &service, client_fd).detach();
+    }
+    close(server_fd);
+    return 0;
+}
+
+static UINT64 percentile(const std::vector<UINT64> &sorted, double ratio)
+{
+    size_t index = (size_t) (ratio * (double) (sorted.size() - 1));
+    return sorted[index];
+}
+
+/*
+ * collect the jobs a remote actually accepts, remotes reject modes, temperatures
+ * and functions they do not support and such jobs would only measure the early return
+ */
+static void build_job_pool(const remote_arg &remote, std::vector<decode_job> &pool)
+{
+    ir_decoder_t decoder;
+    std::vector<UINT8> content(remote.content);
+    std::vector<UINT16> user_data(USER_DATA_SIZE);
+    decode_job job;
+    UINT key = 0;
+    UINT temperature = 0;
+    UINT mode = 0;
+    UINT speed = 0;
+
+    if (IR_DECODE_SUCCEEDED != ir_decoder_open_binary(&decoder, remote.category, remote.sub_category,
+                                                      content.data(), (UINT16) content.size()))
+    {
+        ir_decoder_close(&decoder);
+        return;
+    }
+
+    memset(&job, 0x00, sizeof(decode_job));
+    job.remote_id = remote.remote_id;
+    if (IR_CATEGORY_AC == remote.category)
+    {
+        for (key = AC_FUNCTION_POWER; key < AC_FUNCTION_MAX; key++)
+        {
+            for (mode = 0; mode < AC_MODE_MAX; mode++)
+            {
+                for (temperature = 0; temperature < AC_TEMP_MAX; temperature++)
+                {
+                    for (speed = 0; speed < AC_WS_MAX; speed++)
+                    {
+                        job.key_code = (UINT8) key;
+                        job.ac_status.acPower = AC_POWER_ON;
+                        job.ac_status.acMode = (ac_mode) mode;
+                        job.ac_status.acTemp = (ac_temperature) temperature;
+                        job.ac_status.acWindSpeed = (ac_wind_speed) speed;
+                        if (ir_decoder_decode(&decoder, job.key_code, user_data.data(), &job.ac_status, FALSE) > 0)
+                        {
+                            pool.push_back(job);
+                        }
+                    }
+                }
+            }
+        }
+    }
+    else
+    {
+        for (key = 0; key <= 0xFF; key++)
+        {
+            job.key_code = (UINT8) key;
+            if (ir_decoder_decode(&decoder, job.key_code, user_data.data(), NULL, FALSE) > 0)
+            {
+                pool.push_back(job);
+            }
+        }
+    }
+    ir_decoder_close(&decoder);
+}
+
+static void bench_client(decode_service *service, const std::vector<decode_job> *pool, size_t jobs,
+                         unsigned seed, std::vector<UINT64> *latencies)
+{
+    std::mt19937 random(seed);
+    size_t i = 0;
+
+    for (i = 0; i < jobs; i++)
+    {
+        latencies->push_back(service->decode((*pool)[random() % pool->size()]).latency_ns);
+    }
+}
+
+/*
+ * closed loop benchmark, 2 clients per worker keep the queues busy while
+ * each client measures the latency of its own synchronous requests
+ *
+ * the jobs of a remote run on one worker at a time, so the remotes are registered
+ * again under new ids until there are at least as many of them as workers
+ */
+static void run_bench(const std::vector<remote_arg> &remotes, size_t max_workers, size_t jobs)
+{
+    size_t workers = 1;
+    std::vector<remote_arg> registered;
+    std::vector<decode_job> pool;
+    size_t i = 0;
+
+    while (registered.size() < std::max(max_workers, remotes.size()))
+    {
+        remote_arg remote = remotes[registered.size() % remotes.size()];
+        remote.remote_id = (UINT) registered.size() + 1;
+        registered.push_back(remote);
+    }
+    for (i = 0; i < registered.size(); i++)
+    {
+        build_job_pool(registered[i], pool);
+    }
+    if (pool.empty())
+    {
+        fprintf(stderr, "none of the remotes could be decoded\n");
+        return;
+    }
+
+    printf("%u remotes registered\n", (UINT) registered.size());
+    printf("%8s %10s %10s %12s %10s %10s %10s %8s %8s %8s\n",
+           "workers", "jobs", "seconds", "jobs/s", "p50(us)", "p99(us)", "failed", "stolen", "opens", "cached");
+
+    while (workers <= max_workers)
+    {
+        decode_service service(workers);
+        size_t clients = workers * 2;
+        std::vector<std::vector<UINT64> > latencies(clients);
+        std::vector<std::thread> threads;
+        std::vector<UINT64> merged;
+
+        for (i = 0; i < registered.size(); i++)
+        {
+            service.register_remote(registered[i].remote_id, registered[i].category, registered[i].sub_category,
+                                    registered[i].content.data(), registered[i].content.size());
+        }
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (i = 0; i < clients; i++)
+        {
+            latencies[i].reserve(jobs / clients + 1);
+            threads.push_back(std::thread(bench_client, &service, &pool, jobs / clients,
+                                          (unsigned) (i + 1), &latencies[i]));
+        }
+        for (i = 0; i < clients; i++)
+        {
+            threads[i].join();
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        for (i = 0; i < clients; i++)
+        {
+            merged.insert(merged.end(), latencies[i].begin(), latencies[i].end());
+        }
+        std::sort(merged.begin(), merged.end());
+
+        service_stats stats = service.stats();
+        printf("%8u %10u %10.3f %12.0f %10.2f %10.2f %10llu %8llu %8llu %8u\n",
+               (UINT) workers, (UINT) merged.size(), seconds, (double) merged.size() / seconds,
+               percentile(merged, 0.50) / 1000.0, percentile(merged, 0.99) / 1000.0,
+               stats.jobs_failed, stats.jobs_stolen, stats.decoder_opens, stats.cache_hits);
+
+        if (workers < max_workers && workers * 2 > max_workers)
+        {
+            workers = max_workers;
+        }
+        else
+        {
+            workers *= 2;
+        }
+    }
+}
+
+static bool load_remote_arg(const char *arg, remote_arg &remote)
+{
+    unsigned remote_id = 0;
+    unsigned category = 0;
+    unsigned sub_category = 0;
+    int consumed = 0;
+    FILE *stream = NULL;
+    long size = 0;
+
+    // id:category:sub_category:path
+    if (sscanf(arg, "%u:%u:%u:%n", &remote_id, &category, &sub_category, &consumed) < 3 || 0 == consumed)
+    {
+        return false;
+    }
+    stream = fopen(arg + consumed, "rb");
+    if (NULL == stream)
+    {
+        return false;
+    }
+    fseek(stream, 0, SEEK_END);
+    size = ftell(stream);
+    fseek(stream, 0, SEEK_SET);
+    if (size <= 0)
+    {
+        fclose(stream);
+        return false;
+    }
+    remote.remote_id = remote_id;
+    remote.category = (UINT8) category;
+    remote.sub_category = (UINT8) sub_category;
+    remote.content.resize((size_t) size);
+    if ((size_t) size != fread(remote.content.data(), 1, (size_t) size, stream))
+    {
+        fclose(stream);
+        return false;
+    }
+    fclose(stream);
+    return true;
+}
+
+static void usage(const char *name)
+{
+    printf("usage: %s [-s socket_path] [-t workers] [-r id:category:sub_category:file]... [-b [-n jobs]]\n",
+           name);
+    printf("  -s  local socket to listen on, default %s\n", DEFAULT_SOCKET_PATH);
+    printf("  -t  worker threads, in benchmark mode the maximum of the 1, 2, 4... sweep\n");
+    printf("  -r  preload a remote binary, may be repeated\n");
+    printf("  -b  run the throughput / latency benchmark over the preloaded remotes instead of serving\n");
+    printf("  -n  jobs per benchmark round, default %d\n", BENCH_DEFAULT_JOBS);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *socket_path = DEFAULT_SOCKET_PATH;
+    size_t workers = std::max(1u, std::thread::hardware_concurrency());
+    size_t jobs = BENCH_DEFAULT_JOBS;
+    bool bench = false;
+    std::vector<remote_arg> remotes;
+    int option = 0;
+    size_t i = 0;
+
+    while (-1 != (option = getopt(argc, argv, "s:t:r:bn:h")))
+    {
+        switch (option)
+        {
+            case 's':
+                socket_path = optarg;
+                break;
+            case 't':
+                workers = (size_t) std::max(1, atoi(optarg));
+                break;
+            case 'r':
+            {
+                remote_arg remote;
+                if (!load_remote_arg(optarg, remote))
+                {
+                    fprintf(stderr, "failed to load remote %s\n", optarg);
+                    return -1;
+                }
+                remotes.push_back(remote);
+                break;
+            }
+            case 'b':
+                bench = true;
+                break;
+            case 'n':
+                jobs = (size_t) std::max(1, atoi(optarg));
+                break;
+            default:
+                usage(argv[0]);
+                return 'h' == option ? 0 : -1;
+        }
+    }
+
+    if (bench)
+    {
+        if (remotes.empty())
+        {
+            fprintf(stderr, "benchmark needs at least one remote (-r)\n");
+            return -1;
+        }
+        run_bench(remotes, workers, jobs);
+        return 0;
+    }
+
+    signal(SIGPIPE, SIG_IGN);
+    decode_service service(workers);
+    for (i = 0; i < remotes.size(); i++)
+    {
+        if (IR_DECODE_SUCCEEDED != service.register_remote(remotes[i].remote_id, remotes[i].category,
+                                                           remotes[i].sub_category, remotes[i].content.data(),
+                                                           remotes[i].content.size()))
+        {
+            fprintf(stderr, "failed to register remote %u\n", remotes[i].remote_id);
+            return -1;
+        }
+    }
+    return run_daemon(service, socket_path);
+}
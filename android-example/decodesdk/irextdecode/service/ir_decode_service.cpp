@@ -0,0 +1,432 @@
+/**************************************************************************************
+Filename:       ir_decode_service.cpp
+Revised:        Date: 2026-10-17
+Revision:       Revision: 1.0
+
+Description:    This file provides a multi-threaded decode service built on ir_decoder_t
+
+Revision log:
+* 2026-10-17: created by agent
+**************************************************************************************/
+
+#include <string.h>
+
+#include "ir_decode_service.h"
+
+namespace irext
+{
+
+decode_service::decode_service(size_t worker_count, size_t decoders_per_worker, size_t cache_budget) :
+    decoders_per_worker(decoders_per_worker > 0 ? decoders_per_worker : 1),
+    pending(0),
+    stopping(false),
+    jobs_completed(0),
+    jobs_failed(0),
+    jobs_stolen(0),
+    decoder_opens(0)
+{
+    size_t i = 0;
+
+    ir_ac_cache_init(&cache, cache_budget);
+    ir_ac_cache_set_lock(&cache, lock_cache, unlock_cache, &cache_lock);
+    if (0 == worker_count)
+    {
+        worker_count = 1;
+    }
+    for (i = 0; i < worker_count; i++)
+    {
+        queues.push_back(std::unique_ptr<work_queue>(new work_queue()));
+        queues.back()->idle = false;
+    }
+    for (i = 0; i < worker_count; i++)
+    {
+        workers.push_back(std::thread(&decode_service::worker_main, this, i));
+    }
+}
+
+decode_service::~decode_service()
+{
+    shutdown();
+    ir_ac_cache_destroy(&cache);
+}
+
+INT8 decode_service::register_remote(UINT remote_id, UINT8 category, UINT8 sub_category,
+                                     const UINT8 *binary, size_t binary_length)
+{
+    // ir_decoder_open_binary takes a 16-bit length
+    if (NULL == binary || 0 == binary_length || binary_length > 0xFFFF)
+    {
+        return IR_DECODE_FAILED;
+    }
+
+    std::shared_ptr<remote_binary> remote(new remote_binary());
+    remote->category = category;
+    remote->sub_category = sub_category;
+    remote->content.assign(binary, binary + binary_length);
+
+    std::lock_guard<std::mutex> guard(registry_lock);
+    registry[remote_id] = remote;
+    return IR_DECODE_SUCCEEDED;
+}
+
+INT8 decode_service::unregister_remote(UINT remote_id)
+{
+    std::lock_guard<std::mutex> guard(registry_lock);
+    return (0 == registry.erase(remote_id)) ? IR_DECODE_FAILED : IR_DECODE_SUCCEEDED;
+}
+
+std::future<decode_result> decode_service::submit(const decode_job &job)
+{
+    task t;
+    t.job = job;
+    t.submitted = std::chrono::steady_clock::now();
+    std::future<decode_result> result = t.promise.get_future();
+
+    {
+        // checked under the same lock shutdown takes, no job gets queued behind the last worker
+        std::lock_guard<std::mutex> guard(queue_lock);
+        if (stopping)
+        {
+            decode_result failed;
+            failed.status = IR_DECODE_FAILED;
+            failed.latency_ns = 0;
+            t.promise.set_value(failed);
+            return result;
+        }
+
+        // a remote stays with the worker it is pinned to, others start at their home worker
+        std::unordered_map<UINT, remote_pin>::iterator pin = pins.find(job.remote_id);
+        if (pin == pins.end())
+        {
+            remote_pin home;
+            home.worker = job.remote_id % queues.size();
+            home.queued = 0;
+            home.opened = false;
+            pin = pins.insert(std::make_pair(job.remote_id, home)).first;
+        }
+        pin->second.queued++;
+        queues[pin->second.worker]->tasks.push_back(std::move(t));
+        ++pending;
+        wake_worker(pin->second.worker, !pin->second.opened);
+    }
+    return result;
+}
+
+decode_result decode_service::decode(const decode_job &job)
+{
+    return submit(job).get();
+}
+
+void decode_service::shutdown()
+{
+    size_t i = 0;
+
+    {
+        std::lock_guard<std::mutex> guard(queue_lock);
+        if (stopping)
+        {
+            return;
+        }
+        stopping = true;
+        for (i = 0; i < queues.size(); i++)
+        {
+            queues[i]->wake.notify_one();
+        }
+    }
+    for (i = 0; i < workers.size(); i++)
+    {
+        workers[i].join();
+    }
+}
+
+size_t decode_service::worker_count() const
+{
+    return workers.size();
+}
+
+service_stats decode_service::stats() const
+{
+    service_stats s;
+    s.jobs_completed = jobs_completed.load();
+    s.jobs_failed = jobs_failed.load();
+    s.jobs_stolen = jobs_stolen.load();
+    s.decoder_opens = decoder_opens.load();
+
+    ir_ac_cache_stats_t cache_stats;
+    ir_ac_cache_get_stats(&cache, &cache_stats);
+    s.cache_hits = cache_stats.hits;
+    s.cache_misses = cache_stats.misses;
+    return s;
+}
+
+void decode_service::worker_main(size_t index)
+{
+    decoder_map decoders;
+    // grown to the longest decode of the remotes this worker has served
+    std::vector<UINT16> user_data;
+    UINT64 tick = 0;
+    bool popped = false;
+    task t;
+    work_queue &own = *queues[index];
+
+    for (;;)
+    {
+        {
+            // sleeps until a job is queued to this worker or a remote it could steal shows up
+            std::unique_lock<std::mutex> guard(queue_lock);
+            while (!(popped = pop_task(index, t)) && !(stopping && 0 == pending))
+            {
+                own.idle = true;
+                own.wake.wait(guard);
+                own.idle = false;
+            }
+        }
+        if (!popped)
+        {
+            break;
+        }
+        run_task(index, decoders, ++tick, user_data, t);
+    }
+
+    for (decoder_map::iterator it = decoders.begin(); it != decoders.end(); ++it)
+    {
+        ir_decoder_close(&it->second->decoder);
+    }
+}
+
+// called with queue_lock held
+bool decode_service::pop_task(size_t index, task &out)
+{
+    size_t i = 0;
+    work_queue &own = *queues[index];
+
+    for (i = 1; own.tasks.empty() && i < queues.size(); i++)
+    {
+        steal_remote(index, *queues[(index + i) % queues.size()]);
+    }
+    if (own.tasks.empty())
+    {
+        return false;
+    }
+
+    out = std::move(own.tasks.front());
+    own.tasks.pop_front();
+    remote_pin &pin = pins[out.job.remote_id];
+    pin.queued--;
+    // the remote could not be stolen from now on, this worker is about to open it
+    pin.opened = true;
+    if (0 == --pending && stopping)
+    {
+        // workers left waiting for jobs of other workers could exit now
+        for (i = 0; i < queues.size(); i++)
+        {
+            queues[i]->wake.notify_one();
+        }
+    }
+    return true;
+}
+
+// called with queue_lock held, wakes the worker if it is idle, or any idle worker when the job could be stolen
+void decode_service::wake_worker(size_t index, bool any)
+{
+    size_t i = 0;
+
+    for (i = 0; i < queues.size(); i++)
+    {
+        work_queue &queue = *queues[(index + i) % queues.size()];
+        if (queue.idle)
+        {
+            // cleared here so that the next job wakes another worker
+            queue.idle = false;
+            queue.wake.notify_one();
+            return;
+        }
+        if (!any)
+        {
+            return;
+        }
+    }
+}
+
+bool decode_service::steal_remote(size_t index, work_queue &victim)
+{
+    std::deque<task>::reverse_iterator it;
+    std::deque<task> &own = queues[index]->tasks;
+    UINT remote_id = 0;
+    bool found = false;
+
+    // the remote queued last has the longest wait ahead, only remotes nobody holds a decoder of move
+    for (it = victim.tasks.rbegin(); it != victim.tasks.rend() && !found; ++it)
+    {
+        remote_id = it->job.remote_id;
+        found = !pins[remote_id].opened;
+    }
+    if (!found)
+    {
+        return false;
+    }
+
+    // every job of the remote moves, in order, so they still run one at a time
+    std::deque<task> kept;
+    while (!victim.tasks.empty())
+    {
+        if (victim.tasks.front().job.remote_id == remote_id)
+        {
+            own.push_back(std::move(victim.tasks.front()));
+            ++jobs_stolen;
+        }
+        else
+        {
+            kept.push_back(std::move(victim.tasks.front()));
+        }
+        victim.tasks.pop_front();
+    }
+    victim.tasks.swap(kept);
+    pins[remote_id].worker = index;
+    return true;
+}
+
+void decode_service::run_task(size_t index, decoder_map &decoders, UINT64 tick, std::vector<UINT16> &user_data,
+                              task &t)
+{
+    decode_result result;
+    UINT16 length = 0;
+    ir_decoder_t *decoder = acquire_decoder(index, decoders, tick, t.job.remote_id);
+
+    if (NULL != decoder)
+    {
+        remote_ac_status_t ac_status = t.job.ac_status;
+        UINT16 capacity = ir_decoder_max_decode_length(decoder);
+        if (user_data.size() < capacity)
+        {
+            user_data.resize(capacity);
+        }
+        length = ir_decoder_decode_into(decoder, t.job.key_code, user_data.data(), (UINT16) user_data.size(),
+                                        &ac_status, t.job.change_wind_direction);
+    }
+
+    if (length > 0)
+    {
+        result.status = IR_DECODE_SUCCEEDED;
+        result.timings.assign(user_data.begin(), user_data.begin() + length);
+    }
+    else
+    {
+        result.status = IR_DECODE_FAILED;
+        ++jobs_failed;
+    }
+    if (NULL == decoder)
+    {
+        // unregistered or failed to open, nothing is held for the remote
+        close_decoder(index, t.job.remote_id, NULL);
+    }
+    result.latency_ns = (UINT64) std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - t.submitted).count();
+    ++jobs_completed;
+    t.promise.set_value(std::move(result));
+}
+
+ir_decoder_t *decode_service::acquire_decoder(size_t index, decoder_map &decoders, UINT64 tick, UINT remote_id)
+{
+    std::shared_ptr<const remote_binary> remote = find_remote(remote_id);
+    decoder_map::iterator it = decoders.find(remote_id);
+
+    if (it != decoders.end())
+    {
+        if (it->second->binary == remote)
+        {
+            it->second->last_used = tick;
+            return &it->second->decoder;
+        }
+        // unregistered or replaced since it was opened, the remote stays pinned while its job runs
+        ir_decoder_close(&it->second->decoder);
+        decoders.erase(it);
+    }
+
+    if (!remote)
+    {
+        return NULL;
+    }
+
+    if (decoders.size() >= decoders_per_worker)
+    {
+        decoder_map::iterator lru = decoders.begin();
+        for (it = decoders.begin(); it != decoders.end(); ++it)
+        {
+            if (it->second->last_used < lru->second->last_used)
+            {
+                lru = it;
+            }
+        }
+        close_decoder(index, lru->first, &lru->second->decoder);
+        decoders.erase(lru);
+    }
+
+    std::unique_ptr<opened_decoder> opened(new opened_decoder());
+    memset(&opened->decoder, 0x00, sizeof(ir_decoder_t));
+    opened->binary = remote;
+    opened->last_used = tick;
+
+    // the decoder only reads the binary, so one copy is shared by every worker,
+    // the cache locks itself around lookups and inserts, the parse runs unlocked
+    ++decoder_opens;
+    INT8 ret = ir_decoder_open_binary_cached(&opened->decoder, &cache, remote->category, remote->sub_category,
+                                             const_cast<UINT8 *>(remote->content.data()),
+                                             (UINT16) remote->content.size());
+    if (IR_DECODE_SUCCEEDED != ret)
+    {
+        ir_decoder_close(&opened->decoder);
+        return NULL;
+    }
+
+    ir_decoder_t *decoder = &opened->decoder;
+    decoders[remote_id] = std::move(opened);
+    return decoder;
+}
+
+void decode_service::close_decoder(size_t index, UINT remote_id, ir_decoder_t *decoder)
+{
+    if (NULL != decoder)
+    {
+        ir_decoder_close(decoder);
+    }
+
+    // with no state left on this worker the remote could move, it is unpinned once nothing is queued either
+    std::lock_guard<std::mutex> guard(queue_lock);
+    std::unordered_map<UINT, remote_pin>::iterator pin = pins.find(remote_id);
+    if (pin == pins.end() || pin->second.worker != index)
+    {
+        return;
+    }
+    pin->second.opened = false;
+    if (0 == pin->second.queued)
+    {
+        pins.erase(pin);
+        return;
+    }
+    // the jobs left behind could be taken by an idle worker meanwhile
+    wake_worker(index, true);
+}
+
+void decode_service::lock_cache(void *lock_data)
+{
+    static_cast<std::mutex *>(lock_data)->lock();
+}
+
+void decode_service::unlock_cache(void *lock_data)
+{
+    static_cast<std::mutex *>(lock_data)->unlock();
+}
+
+std::shared_ptr<const decode_service::remote_binary> decode_service::find_remote(UINT remote_id)
+{
+    std::lock_guard<std::mutex> guard(registry_lock);
+    std::unordered_map<UINT, std::shared_ptr<const remote_binary> >::const_iterator it = registry.find(remote_id);
+    if (it == registry.end())
+    {
+        return std::shared_ptr<const remote_binary>();
+    }
+    return it->second;
+}
+
+}
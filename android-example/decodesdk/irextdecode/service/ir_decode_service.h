@@ -0,0 +1,196 @@
+/**************************************************************************************
+Filename:       ir_decode_service.h
+Revised:        Date: 2026-10-17
+Revision:       Revision: 1.0
+
+Description:    This file provides a multi-threaded decode service built on ir_decoder_t
+
+Revision log:
+* 2026-10-17: created by agent
+**************************************************************************************/
+
+#ifndef _IR_DECODE_SERVICE_H_
+#define _IR_DECODE_SERVICE_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "../include/ir_decode.h"
+
+namespace irext
+{
+
+// a single decode request, remote_id refers to a binary registered with register_remote
+struct decode_job
+{
+    UINT remote_id;
+    UINT8 key_code;
+    remote_ac_status_t ac_status;
+    BOOL change_wind_direction;
+};
+
+struct decode_result
+{
+    INT8 status;
+    std::vector<UINT16> timings;
+    // from submit to completion, queueing included
+    UINT64 latency_ns;
+};
+
+struct service_stats
+{
+    UINT64 jobs_completed;
+    UINT64 jobs_failed;
+    UINT64 jobs_stolen;
+    UINT64 decoder_opens;
+    UINT cache_hits;
+    UINT cache_misses;
+};
+
+class decode_service
+{
+public:
+    /**
+     * worker_count workers are started immediately, each of them keeps up to
+     * decoders_per_worker opened ir_decoder_t instances of its own,
+     * parsed AC protocols are shared between workers through a cache of cache_budget bytes
+     */
+    explicit decode_service(size_t worker_count, size_t decoders_per_worker = 16,
+                            size_t cache_budget = 4 * 1024 * 1024);
+    ~decode_service();
+
+    /**
+     * function     register_remote
+     *
+     * description: register (or replace) a remote binary, the content is copied and shared by all workers
+     *
+     * parameters:  remote_id (in) - id used by decode jobs to refer to this binary
+     *              category (in) - category ID get from indexing API
+     *              sub_category (in) - subcategory ID get from indexing API
+     *              binary (in) - IR binary content
+     *              binary_length (in) - IR binary size, no more than 65535 bytes
+     *
+     * returns:     IR_DECODE_SUCCEEDED / IR_DECODE_FAILED
+     */
+    INT8 register_remote(UINT remote_id, UINT8 category, UINT8 sub_category,
+                         const UINT8 *binary, size_t binary_length);
+
+    /**
+     * function     unregister_remote
+     *
+     * description: drop a remote binary, decoders opened by workers are released on their next lookup
+     *
+     * parameters:  remote_id (in) - id of the remote
+     *
+     * returns:     IR_DECODE_SUCCEEDED / IR_DECODE_FAILED
+     */
+    INT8 unregister_remote(UINT remote_id);
+
+    /**
+     * function     submit
+     *
+     * description: queue a decode job, the jobs of a remote run one at a time and in order on the worker
+     *              it is pinned to, so that the TV toggle and AC wind direction states stay consistent,
+     *              idle workers steal only remotes no worker holds a decoder of
+     *
+     * parameters:  job (in) - decode job
+     *
+     * returns:     future of the decode result
+     */
+    std::future<decode_result> submit(const decode_job &job);
+
+    // blocking variant of submit
+    decode_result decode(const decode_job &job);
+
+    // stop accepting jobs, drain the queues and join all workers
+    void shutdown();
+
+    size_t worker_count() const;
+
+    service_stats stats() const;
+
+private:
+    struct remote_binary
+    {
+        UINT8 category;
+        UINT8 sub_category;
+        std::vector<UINT8> content;
+    };
+
+    struct task
+    {
+        decode_job job;
+        std::promise<decode_result> promise;
+        std::chrono::steady_clock::time_point submitted;
+    };
+
+    // per worker deque, the owner pops from the front, thieves move every job of a remote at once
+    struct work_queue
+    {
+        std::deque<task> tasks;
+        std::condition_variable wake;
+        bool idle;
+    };
+
+    // a remote is pinned to a worker while it has queued jobs or the worker keeps a decoder of it
+    struct remote_pin
+    {
+        size_t worker;
+        size_t queued;
+        bool opened;
+    };
+
+    struct opened_decoder
+    {
+        std::shared_ptr<const remote_binary> binary;
+        ir_decoder_t decoder;
+        UINT64 last_used;
+    };
+
+    typedef std::unordered_map<UINT, std::unique_ptr<opened_decoder> > decoder_map;
+
+    void worker_main(size_t index);
+    bool pop_task(size_t index, task &out);
+    bool steal_remote(size_t index, work_queue &victim);
+    void wake_worker(size_t index, bool any);
+    void run_task(size_t index, decoder_map &decoders, UINT64 tick, std::vector<UINT16> &user_data, task &t);
+    ir_decoder_t *acquire_decoder(size_t index, decoder_map &decoders, UINT64 tick, UINT remote_id);
+    std::shared_ptr<const remote_binary> find_remote(UINT remote_id);
+    void close_decoder(size_t index, UINT remote_id, ir_decoder_t *decoder);
+    static void lock_cache(void *lock_data);
+    static void unlock_cache(void *lock_data);
+
+    size_t decoders_per_worker;
+    std::vector<std::unique_ptr<work_queue> > queues;
+    std::vector<std::thread> workers;
+
+    // guards the queues, the pins and the idle workers together, a remote moves between workers with all of its jobs
+    std::mutex queue_lock;
+    std::unordered_map<UINT, remote_pin> pins;
+    size_t pending;
+    bool stopping;
+
+    std::mutex registry_lock;
+    std::unordered_map<UINT, std::shared_ptr<const remote_binary> > registry;
+
+    // held by the cache for its lookups, inserts and releases only, binaries are parsed outside of it
+    std::mutex cache_lock;
+    mutable ir_ac_cache_t cache;
+
+    std::atomic<UINT64> jobs_completed;
+    std::atomic<UINT64> jobs_failed;
+    std::atomic<UINT64> jobs_stolen;
+    std::atomic<UINT64> decoder_opens;
+};
+
+}
+
+#endif // _IR_DECODE_SERVICE_H_
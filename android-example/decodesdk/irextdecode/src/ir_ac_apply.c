@@ -146,7 +146,9 @@ static INT8 apply_ac_power(struct ac_protocol *protocol, UINT8 power_status)
     }
     for (i = 0; i < protocol->power1.comp_data[power_status].seg_len; i += 2)
     {
-        apply_ac_parameter_type_1(ir_hex_code, &(protocol->power1.comp_data[power_status]), (UINT8) i, FALSE);
+        apply_ac_parameter_type_1(protocol->ir_hex_code,
+                                  &(protocol->power1.comp_data[power_status]),
+                                  (UINT8) i, FALSE);
     }
     return IR_DECODE_SUCCEEDED;
 }
@@ -167,7 +169,9 @@ static INT8 apply_ac_mode(struct ac_protocol *protocol, UINT8 mode_status)
 
     for (i = 0; i < protocol->mode1.comp_data[mode_status].seg_len; i += 2)
     {
-        apply_ac_parameter_type_1(ir_hex_code, &(protocol->mode1.comp_data[mode_status]), (UINT8) i, FALSE);
+        apply_ac_parameter_type_1(protocol->ir_hex_code,
+                                  &(protocol->mode1.comp_data[mode_status]),
+                                  (UINT8) i, FALSE);
     }
 
     // get return here since wind mode 1 is already applied
@@ -186,7 +190,7 @@ static INT8 apply_ac_mode(struct ac_protocol *protocol, UINT8 mode_status)
 
     for (i = 0; i < protocol->mode2.comp_data[mode_status].seg_len; i += 3)
     {
-        apply_ac_parameter_type_2(ir_hex_code,
+        apply_ac_parameter_type_2(protocol->ir_hex_code,
                                   &(protocol->mode2.comp_data[mode_status]),
                                   (UINT8) i, FALSE);
     }
@@ -209,7 +213,9 @@ static INT8 apply_ac_wind_speed(struct ac_protocol *protocol, UINT8 wind_speed)
 
     for (i = 0; i < protocol->speed1.comp_data[wind_speed].seg_len; i += 2)
     {
-        apply_ac_parameter_type_1(ir_hex_code, &(protocol->speed1.comp_data[wind_speed]), (UINT8) i, FALSE);
+        apply_ac_parameter_type_1(protocol->ir_hex_code,
+                                  &(protocol->speed1.comp_data[wind_speed]),
+                                  (UINT8) i, FALSE);
     }
 
     // get return here since wind speed 1 is already applied
@@ -228,7 +234,7 @@ static INT8 apply_ac_wind_speed(struct ac_protocol *protocol, UINT8 wind_speed)
 
     for (i = 0; i < protocol->speed2.comp_data[wind_speed].seg_len; i += 3)
     {
-        apply_ac_parameter_type_2(ir_hex_code,
+        apply_ac_parameter_type_2(protocol->ir_hex_code,
                                   &(protocol->speed2.comp_data[wind_speed]),
                                   (UINT8) i, FALSE);
     }
@@ -253,11 +259,15 @@ static INT8 apply_ac_temperature(struct ac_protocol *protocol, UINT8 temp_diff)
     {
         if (TEMP_TYPE_DYNAMIC == protocol->temp1.type)
         {
-            apply_ac_parameter_type_1(ir_hex_code, &(protocol->temp1.comp_data[temp_diff]), (UINT8) i, TRUE);
+            apply_ac_parameter_type_1(protocol->ir_hex_code,
+                                      &(protocol->temp1.comp_data[temp_diff]),
+                                      (UINT8) i, TRUE);
         }
         else if (TEMP_TYPE_STATIC == protocol->temp1.type)
         {
-            apply_ac_parameter_type_1(ir_hex_code, &(protocol->temp1.comp_data[temp_diff]), (UINT8) i, FALSE);
+            apply_ac_parameter_type_1(protocol->ir_hex_code,
+                                      &(protocol->temp1.comp_data[temp_diff]),
+                                      (UINT8) i, FALSE);
         }
     }
 
@@ -281,11 +291,15 @@ static INT8 apply_ac_temperature(struct ac_protocol *protocol, UINT8 temp_diff)
         {
             if (TEMP_TYPE_DYNAMIC == protocol->temp2.type)
             {
-                apply_ac_parameter_type_2(ir_hex_code, &(protocol->temp2.comp_data[temp_diff]), (UINT8) i, TRUE);
+                apply_ac_parameter_type_2(protocol->ir_hex_code,
+                                          &(protocol->temp2.comp_data[temp_diff]),
+                                          (UINT8) i, TRUE);
             }
             else if (TEMP_TYPE_STATIC == protocol->temp2.type)
             {
-                apply_ac_parameter_type_2(ir_hex_code, &(protocol->temp2.comp_data[temp_diff]), (UINT8) i, FALSE);
+                apply_ac_parameter_type_2(protocol->ir_hex_code,
+                                          &(protocol->temp2.comp_data[temp_diff]),
+                                          (UINT8) i, FALSE);
             }
         }
     }
@@ -314,7 +328,9 @@ static INT8 apply_ac_swing(struct ac_protocol *protocol, UINT8 swing_mode)
 
     for (i = 0; i < protocol->swing1.comp_data[swing_mode].seg_len; i += 2)
     {
-        apply_ac_parameter_type_1(ir_hex_code, &(protocol->swing1.comp_data[swing_mode]), (UINT8) i, FALSE);
+        apply_ac_parameter_type_1(protocol->ir_hex_code,
+                                  &(protocol->swing1.comp_data[swing_mode]),
+                                  (UINT8) i, FALSE);
     }
 
     // get return here since temperature 1 is already applied
@@ -339,7 +355,7 @@ static INT8 apply_ac_swing(struct ac_protocol *protocol, UINT8 swing_mode)
 
     for (i = 0; i < protocol->swing2.comp_data[swing_mode].seg_len; i += 3)
     {
-        apply_ac_parameter_type_2(ir_hex_code,
+        apply_ac_parameter_type_2(protocol->ir_hex_code,
                                   &(protocol->swing2.comp_data[swing_mode]),
                                   (UINT8) i, FALSE);
     }
@@ -534,7 +550,9 @@ INT8 apply_function(struct ac_protocol *protocol, UINT8 function)
 
     for (i = 0; i < protocol->function1.comp_data[function - 1].seg_len; i += 2)
     {
-        apply_ac_parameter_type_1(ir_hex_code, &(protocol->function1.comp_data[function - 1]), (UINT8) i, FALSE);
+        apply_ac_parameter_type_1(protocol->ir_hex_code,
+                                  &(protocol->function1.comp_data[function - 1]),
+                                  (UINT8) i, FALSE);
     }
 
     // get return here since function 1 is already applied
@@ -553,7 +571,7 @@ INT8 apply_function(struct ac_protocol *protocol, UINT8 function)
 
     for (i = 0; i < protocol->function2.comp_data[function - 1].seg_len; i += 3)
     {
-        apply_ac_parameter_type_2(ir_hex_code,
+        apply_ac_parameter_type_2(protocol->ir_hex_code,
                                   &(protocol->function2.comp_data[function - 1]),
                                   (UINT8) i, FALSE);
     }
@@ -574,28 +592,28 @@ INT8 apply_checksum(struct ac_protocol *protocol)
         switch (protocol->checksum.checksum_data[i].type)
         {
             case CHECKSUM_TYPE_BYTE:
-                apply_checksum_byte(ir_hex_code, protocol->checksum.checksum_data[i], FALSE);
+                apply_checksum_byte(protocol->ir_hex_code, protocol->checksum.checksum_data[i], FALSE);
                 break;
             case CHECKSUM_TYPE_BYTE_INVERSE:
-                apply_checksum_byte(ir_hex_code, protocol->checksum.checksum_data[i], TRUE);
+                apply_checksum_byte(protocol->ir_hex_code, protocol->checksum.checksum_data[i], TRUE);
                 break;
             case CHECKSUM_TYPE_HALF_BYTE:
-                apply_checksum_halfbyte(ir_hex_code, protocol->checksum.checksum_data[i], FALSE);
+                apply_checksum_halfbyte(protocol->ir_hex_code, protocol->checksum.checksum_data[i], FALSE);
                 break;
             case CHECKSUM_TYPE_HALF_BYTE_INVERSE:
-                apply_checksum_halfbyte(ir_hex_code, protocol->checksum.checksum_data[i], TRUE);
+                apply_checksum_halfbyte(protocol->ir_hex_code, protocol->checksum.checksum_data[i], TRUE);
                 break;
             case CHECKSUM_TYPE_SPEC_HALF_BYTE:
-                apply_checksum_spec_byte(ir_hex_code, protocol->checksum.checksum_data[i], FALSE);
+                apply_checksum_spec_byte(protocol->ir_hex_code, protocol->checksum.checksum_data[i], FALSE);
                 break;
             case CHECKSUM_TYPE_SPEC_HALF_BYTE_INVERSE:
-                apply_checksum_spec_byte(ir_hex_code, protocol->checksum.checksum_data[i], TRUE);
+                apply_checksum_spec_byte(protocol->ir_hex_code, protocol->checksum.checksum_data[i], TRUE);
                 break;
             case CHECKSUM_TYPE_SPEC_HALF_BYTE_ONE_BYTE:
-                apply_checksum_spec_byte_onebyte(ir_hex_code, protocol->checksum.checksum_data[i], FALSE);
+                apply_checksum_spec_byte_onebyte(protocol->ir_hex_code, protocol->checksum.checksum_data[i], FALSE);
                 break;
             case CHECKSUM_TYPE_SPEC_HALF_BYTE_INVERSE_ONE_BYTE:
-                apply_checksum_spec_byte_onebyte(ir_hex_code, protocol->checksum.checksum_data[i], TRUE);
+                apply_checksum_spec_byte_onebyte(protocol->ir_hex_code, protocol->checksum.checksum_data[i], TRUE);
                 break;
             default:
                 break;
@@ -605,13 +623,13 @@ INT8 apply_checksum(struct ac_protocol *protocol)
     return IR_DECODE_SUCCEEDED;
 }
 
-INT8 apply_power(remote_ac_status_t ac_status, UINT8 function_code)
+INT8 apply_power(protocol *context, remote_ac_status_t ac_status, UINT8 function_code)
 {
     apply_ac_power(context, ac_status.acPower);
     return IR_DECODE_SUCCEEDED;
 }
 
-INT8 apply_mode(remote_ac_status_t ac_status, UINT8 function_code)
+INT8 apply_mode(protocol *context, remote_ac_status_t ac_status, UINT8 function_code)
 {
     if (IR_DECODE_FAILED == apply_ac_mode(context, ac_status.acMode))
     {
@@ -626,7 +644,7 @@ INT8 apply_mode(remote_ac_status_t ac_status, UINT8 function_code)
     return IR_DECODE_SUCCEEDED;
 }
 
-INT8 apply_wind_speed(remote_ac_status_t ac_status, UINT8 function_code)
+INT8 apply_wind_speed(protocol *context, remote_ac_status_t ac_status, UINT8 function_code)
 {
     if (FALSE == context->n_mode[ac_status.acMode].allspeed)
     {
@@ -676,7 +694,7 @@ INT8 apply_wind_speed(remote_ac_status_t ac_status, UINT8 function_code)
     return IR_DECODE_SUCCEEDED;
 }
 
-INT8 apply_swing(remote_ac_status_t ac_status, UINT8 function_code)
+INT8 apply_swing(protocol *context, remote_ac_status_t ac_status, UINT8 function_code)
 {
     if (function_code == AC_FUNCTION_WIND_FIX)
     {
@@ -719,7 +737,7 @@ INT8 apply_swing(remote_ac_status_t ac_status, UINT8 function_code)
     return IR_DECODE_SUCCEEDED;
 }
 
-INT8 apply_temperature(remote_ac_status_t ac_status, UINT8 function_code)
+INT8 apply_temperature(protocol *context, remote_ac_status_t ac_status, UINT8 function_code)
 {
     if (FALSE == context->n_mode[ac_status.acMode].alltemp)
     {
@@ -14,12 +14,6 @@ Revision log:
 #include "../include/ir_ac_binary_parse.h"
 #include "../include/ir_decode.h"
 
-UINT16 tag_head_offset = 0;
-
-extern struct ir_bin_buffer *p_ir_buffer;
-extern struct tag_head *tags;
-
-UINT8 tag_count = 0;
 const UINT16 tag_index[TAG_COUNT_FOR_PROTOCOL] =
 {
     1, 2, 3, 4, 5, 6, 7,
@@ -27,26 +21,29 @@ const UINT16 tag_index[TAG_COUNT_FOR_PROTOCOL] =
     41, 42, 43, 44, 45, 46, 47, 48
 };
 
-INT8 binary_parse_offset()
+INT8 binary_parse_offset(struct ir_decoder *decoder)
 {
     int i = 0;
+    struct ir_bin_buffer *p_ir_buffer = &decoder->ac_buffer;
+    struct tag_head *tags = NULL;
     UINT16 *phead = (UINT16 *) &p_ir_buffer->data[1];
 
-    tag_count = p_ir_buffer->data[0];
-    if (TAG_COUNT_FOR_PROTOCOL != tag_count)
+    decoder->tag_count = p_ir_buffer->data[0];
+    if (TAG_COUNT_FOR_PROTOCOL != decoder->tag_count)
     {
         return IR_DECODE_FAILED;
     }
 
-    tag_head_offset = (UINT16) ((tag_count << 1) + 1);
+    decoder->tag_head_offset = (UINT16) ((decoder->tag_count << 1) + 1);
 
-    tags = (t_tag_head *) ir_malloc(tag_count * sizeof(t_tag_head));
+    tags = (t_tag_head *) ir_malloc(decoder->tag_count * sizeof(t_tag_head));
     if (NULL == tags)
     {
         return IR_DECODE_FAILED;
     }
+    decoder->tags = tags;
 
-    for (i = 0; i < tag_count; i++)
+    for (i = 0; i < decoder->tag_count; i++)
     {
         tags[i].tag = tag_index[i];
         tags[i].offset = *(phead + i);
@@ -59,9 +56,14 @@ INT8 binary_parse_offset()
     return IR_DECODE_SUCCEEDED;
 }
 
-INT8 binary_parse_len()
+INT8 binary_parse_len(struct ir_decoder *decoder)
 {
     UINT16 i = 0, j = 0;
+    struct ir_bin_buffer *p_ir_buffer = &decoder->ac_buffer;
+    struct tag_head *tags = decoder->tags;
+    UINT8 tag_count = decoder->tag_count;
+    UINT16 tag_head_offset = decoder->tag_head_offset;
+
     for (i = 0; i < (tag_count - 1); i++)
     {
         if (tags[i].offset == TAG_INVALID)
@@ -94,10 +96,13 @@ INT8 binary_parse_len()
     return IR_DECODE_SUCCEEDED;
 }
 
-void binary_tags_info()
+void binary_tags_info(struct ir_decoder *decoder)
 {
 #if defined BOARD_PC
     UINT16 i = 0;
+    struct tag_head *tags = decoder->tags;
+    UINT8 tag_count = decoder->tag_count;
+
     for (i = 0; i < tag_count; i++)
     {
         if (tags[i].len == 0)
@@ -106,15 +111,20 @@ void binary_tags_info()
         }
         ir_printf("tag(%d).len = %d\n", tags[i].tag, tags[i].len);
     }
+#else
+    (void) decoder;
 #endif
 }
 
-INT8 binary_parse_data()
+INT8 binary_parse_data(struct ir_decoder *decoder)
 {
     UINT16 i = 0;
-    for (i = 0; i < tag_count; i++)
+    struct tag_head *tags = decoder->tags;
+
+    for (i = 0; i < decoder->tag_count; i++)
     {
-        tags[i].pdata = p_ir_buffer->data + tags[i].offset + tag_head_offset;
+        tags[i].pdata = decoder->ac_buffer.data + tags[i].offset + decoder->tag_head_offset;
+        tags[i].in_place = decoder->ac_in_place;
     }
 
     return IR_DECODE_SUCCEEDED;
@@ -9,14 +9,22 @@ Revision log:
 * 2016-10-01: created by strawmanbobi
 **************************************************************************************/
 
+#include <string.h>
+
+#if defined __SSE2__
+#include <immintrin.h>
+#elif defined __ARM_NEON
+#include <arm_neon.h>
+#endif
+
 #include "../include/ir_ac_build_frame.h"
 #include "../include/ir_decode.h"
 
-extern protocol *context;
-
+// bytes expanded into timings before they are written out
+#define FRAME_STAGE_BYTES            16
 
 //return bit number per byte,default value is 8
-UINT8 bits_per_byte(UINT8 index)
+UINT8 bits_per_byte(protocol *context, UINT8 index)
 {
     UINT8 i = 0;
     UINT8 size = 0;
@@ -39,107 +47,263 @@ UINT8 bits_per_byte(UINT8 index)
     return 8;
 }
 
-UINT16 add_delaycode(UINT8 index)
+static void put_bit(protocol *context, UINT8 set, ir_output_t *output)
 {
-    UINT8 i = 0, j = 0;
-    UINT8 size = 0;
-    UINT8 tail_delaycode = 0;
-    UINT16 tail_pos = 0;
+    if (set)
+    {
+        ir_output_put(output, context->one.low);
+        ir_output_put(output, context->one.high);
+    }
+    else
+    {
+        ir_output_put(output, context->zero.low);
+        ir_output_put(output, context->zero.high);
+    }
+}
+
+// a byte sent with other than 8 bits, bit by bit
+static void put_bits(protocol *context, UINT8 data, UINT8 bitnum, ir_output_t *output)
+{
+    UINT16 j = 0;
+    UINT8 mask = 1;
 
-    if (context->dc_cnt != 0)
+    for (j = 0; j < bitnum; j++)
     {
-        size = (UINT8) context->dc_cnt;
+        if (context->endian == 0)
+            mask = (UINT8) ((1 << (bitnum - 1)) >> j);
+        else
+            mask = (UINT8) (1 << j);
+
+        put_bit(context, (UINT8) (data & mask), output);
+    }
+}
 
-        for (i = 0; i < size; i++)
+static void copy_nibble(UINT16 *timings, const UINT16 *pattern)
+{
+#if defined __SSE2__
+    _mm_storeu_si128((__m128i *) timings, _mm_loadu_si128((const __m128i *) pattern));
+#elif defined __ARM_NEON
+    vst1q_u16(timings, vld1q_u16(pattern));
+#else
+    timings[0] = pattern[0];
+    timings[1] = pattern[1];
+    timings[2] = pattern[2];
+    timings[3] = pattern[3];
+    timings[4] = pattern[4];
+    timings[5] = pattern[5];
+    timings[6] = pattern[6];
+    timings[7] = pattern[7];
+#endif
+}
+
+// bytes sent with 8 bits, staged a few at a time so the output is written in bulk
+static void put_bytes(protocol *context, const UINT8 *data, UINT16 count, ir_output_t *output)
+{
+    UINT16 staged[FRAME_STAGE_BYTES * 16];
+    const ac_frame_plan *plan = context->frame_plan;
+    UINT16 *timings = NULL;
+    UINT16 run = 0;
+    UINT16 i = 0;
+    UINT8 first = 0;
+    UINT8 second = 0;
+
+    while (count > 0)
+    {
+        run = (count < FRAME_STAGE_BYTES) ? count : FRAME_STAGE_BYTES;
+        timings = staged;
+        for (i = 0; i < run; i++)
         {
-            if (context->dc[i].pos == index)
-            {
-                for (j = 0; j < context->dc[i].time_cnt; j++)
-                {
-                    context->time[context->code_cnt++] = context->dc[i].time[j];
-                }
-            }
-            else if (context->dc[i].pos == -1)
-            {
-                tail_delaycode = 1;
-                tail_pos = i;
-            }
+            // most significant nibble first in big endian
+            first = (UINT8) ((context->endian == 0) ? data[i] >> 4 : data[i] & 0x0F);
+            second = (UINT8) ((context->endian == 0) ? data[i] & 0x0F : data[i] >> 4);
+#if defined __AVX2__
+            _mm256_storeu_si256((__m256i *) timings,
+                                _mm256_inserti128_si256(_mm256_castsi128_si256(
+                                    _mm_loadu_si128((const __m128i *) plan->nibble_timing[first])),
+                                    _mm_loadu_si128((const __m128i *) plan->nibble_timing[second]), 1));
+#else
+            copy_nibble(timings, plan->nibble_timing[first]);
+            copy_nibble(timings + 8, plan->nibble_timing[second]);
+#endif
+            timings += 16;
         }
+        ir_output_write(output, staged, (UINT16) (run * 16));
+        data += run;
+        count = (UINT16) (count - run);
     }
+}
 
-    if ((context->lastbit == 0) && (index == (ir_hex_len - 1)))
+static void put_delaycode(protocol *context, UINT8 index, ir_output_t *output)
+{
+    ir_output_write(output, context->dc[index].time, context->dc[index].time_cnt);
+}
+
+void build_frame_plan(protocol *context)
+{
+    ac_frame_plan *plan = context->frame_plan;
+    ac_frame_step *step = NULL;
+    UINT16 i = 0;
+    UINT8 j = 0;
+    UINT8 bits = 0;
+    UINT8 dc_count = 0;
+    UINT8 dc_used = 0;
+    UINT8 nibble = 0;
+    UINT8 set = 0;
+
+    if (NULL == plan)
     {
-        context->time[context->code_cnt++] = context->one.low; //high
+        // left unbuilt, no frame could be created then
+        plan = (ac_frame_plan *) ir_malloc(sizeof(ac_frame_plan));
+        if (NULL == plan)
+        {
+            return;
+        }
+        context->frame_plan = plan;
+    }
+    ir_memset(plan, 0x00, sizeof(ac_frame_plan));
+    plan->tail_dc = 0xFF;
+    plan->frame_length = context->bootcode.len + ((context->lastbit == 0) ? 1U : 0U);
+
+    for (nibble = 0; nibble < 16; nibble++)
+    {
+        for (j = 0; j < 4; j++)
+        {
+            set = (UINT8) ((context->endian == 0) ? (nibble >> (3 - j)) & 0x01 : (nibble >> j) & 0x01);
+            plan->nibble_timing[nibble][j * 2] = set ? context->one.low : context->zero.low;
+            plan->nibble_timing[nibble][j * 2 + 1] = set ? context->one.high : context->zero.high;
+        }
     }
 
-    if (context->dc_cnt != 0)
+    // the last delay code at -1 is sent at the end, the others after the byte they are at, in order
+    for (j = 0; j < context->dc_cnt && j < MAX_DELAYCODE_NUM; j++)
     {
-        if ((index == (ir_hex_len - 1)) && (tail_delaycode == 1))
+        if (context->dc[j].pos == -1)
         {
-            for (i = 0; i < context->dc[tail_pos].time_cnt; i++)
+            plan->tail_dc = j;
+        }
+    }
+    if (0xFF != plan->tail_dc)
+    {
+        plan->frame_length += context->dc[plan->tail_dc].time_cnt;
+    }
+
+    for (i = 0; i < context->ir_hex_len; i++)
+    {
+        bits = bits_per_byte(context, (UINT8) i);
+        plan->frame_length += bits * 2U;
+        dc_count = 0;
+        for (j = 0; j < context->dc_cnt && j < MAX_DELAYCODE_NUM; j++)
+        {
+            if (context->dc[j].pos == i)
             {
-                context->time[context->code_cnt++] = context->dc[tail_pos].time[i];
+                plan->dc_order[dc_used + dc_count++] = j;
+                plan->frame_length += context->dc[j].time_cnt;
             }
         }
+        if (8 == bits && 0 == dc_count)
+        {
+            continue;
+        }
+        step = &plan->step[plan->step_cnt++];
+        step->pos = (UINT8) i;
+        step->bits = bits;
+        step->dc_first = dc_used;
+        step->dc_count = dc_count;
+        dc_used = (UINT8) (dc_used + dc_count);
     }
-
-    return context->dc[i].time_cnt;
+    plan->ready = TRUE;
 }
 
-UINT16 create_ir_frame()
+static void emit_frame(protocol *context, ir_output_t *output)
 {
-    UINT16 i = 0, j = 0;
-    UINT8 bitnum = 0;
-    UINT8 *irdata = ir_hex_code;
-    UINT8 mask = 1;
-    UINT16 framelen = 0;
-
-    context->code_cnt = 0;
+    const ac_frame_plan *plan = context->frame_plan;
+    const ac_frame_step *step = NULL;
+    UINT8 *irdata = context->ir_hex_code;
+    UINT16 pos = 0;
+    UINT8 i = 0;
+    UINT8 j = 0;
 
     // boot code
-    for (i = 0; i < context->bootcode.len; i++)
+    ir_output_write(output, context->bootcode.data, context->bootcode.len);
+
+    for (i = 0; i < plan->step_cnt; i++)
     {
-        context->time[context->code_cnt++] = context->bootcode.data[i];
+        step = &plan->step[i];
+        put_bytes(context, irdata + pos, (UINT16) (step->pos - pos), output);
+        if (8 == step->bits)
+        {
+            put_bytes(context, irdata + step->pos, 1, output);
+        }
+        else
+        {
+            put_bits(context, irdata[step->pos], step->bits, output);
+        }
+        for (j = 0; j < step->dc_count; j++)
+        {
+            put_delaycode(context, plan->dc_order[step->dc_first + j], output);
+        }
+        pos = (UINT16) (step->pos + 1);
     }
-    //code_cnt += context->bootcode.len;
+    put_bytes(context, irdata + pos, (UINT16) (context->ir_hex_len - pos), output);
 
-    for (i = 0; i < ir_hex_len; i++)
+    if (context->lastbit == 0)
     {
-        bitnum = bits_per_byte((UINT8) i);
-        for (j = 0; j < bitnum; j++)
-        {
-            if (context->endian == 0)
-                mask = (UINT8) ((1 << (bitnum - 1)) >> j);
-            else
-                mask = (UINT8) (1 << j);
+        ir_output_put(output, context->one.low); //high
+    }
+    if (0xFF != plan->tail_dc)
+    {
+        put_delaycode(context, plan->tail_dc, output);
+    }
+}
 
-            if (irdata[i] & mask)
-            {
-                //ir_printf("%d,%d,", context->one.low, context->one.high);
-                context->time[context->code_cnt++] = context->one.low;
-                context->time[context->code_cnt++] = context->one.high;
-            }
-            else
-            {
-                //ir_printf("%d,%d,", context->zero.low, context->zero.high);
-                context->time[context->code_cnt++] = context->zero.low;
-                context->time[context->code_cnt++] = context->zero.high;
-            }
+UINT create_ir_frame(protocol *context, ir_output_t *output)
+{
+    UINT16 i = 0;
+    UINT16 framelen = 0;
+
+    if (NULL == context->frame_plan || FALSE == context->frame_plan->ready)
+    {
+        build_frame_plan(context);
+        if (NULL == context->frame_plan)
+        {
+            return 0;
         }
-        add_delaycode((UINT8) i);
     }
+    emit_frame(context, output);
+    framelen = (UINT16) output->total;
 
-    framelen = context->code_cnt;
+    if (TRUE == output->single_frame)
+    {
+        // repeats are left to the transmitter, a protocol of 0 repeat times sends its frame once as well
+        output->repeat_times = (context->repeat_times > 1) ? context->repeat_times : 1;
+    }
 
-    for (i = 0; i < (context->repeat_times - 1); i++)
+    for (i = 0; FALSE == output->single_frame && i < (context->repeat_times - 1); i++)
     {
-        for (j = 0; j < framelen; j++)
+        if (NULL == output->sink)
+        {
+            // the whole frame is still at the start of the buffer
+            ir_output_write(output, output->buffer, framelen);
+        }
+        else
         {
-            context->time[context->code_cnt++] = context->time[j];
+            emit_frame(context, output);
         }
     }
 
-    return context->code_cnt;
+    context->code_cnt = (UINT16) output->total;
+    return output->total;
 }
 
-
+UINT ac_frame_length(protocol *context)
+{
+    if (NULL == context->frame_plan || FALSE == context->frame_plan->ready)
+    {
+        build_frame_plan(context);
+        if (NULL == context->frame_plan)
+        {
+            return 0;
+        }
+    }
+    return context->frame_plan->frame_length * ((context->repeat_times > 1) ? context->repeat_times : 1U);
+}
@@ -0,0 +1,314 @@
+/**************************************************************************************
+Filename:       ir_ac_cache.c
+Revised:        Date: 2026-10-17
+Revision:       Revision: 1.0
+
+Description:    This file provides a cache of parsed AC protocols keyed by binary content
+
+Revision log:
+* 2026-10-17: created by agent
+**************************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/ir_ac_cache.h"
+#include "../include/ir_decode.h"
+
+#define FNV_OFFSET_BASIS            0xCBF29CE484222325ULL
+#define FNV_PRIME                   0x00000100000001B3ULL
+
+static UINT64 content_hash(UINT8 *binary, UINT16 binary_length);
+static ir_ac_cache_entry_t *find_entry(ir_ac_cache_t *cache, UINT64 hash, UINT8 *binary, UINT16 binary_length);
+static void cache_lock(ir_ac_cache_t *cache);
+static void cache_unlock(ir_ac_cache_t *cache);
+static void lru_unlink(ir_ac_cache_t *cache, ir_ac_cache_entry_t *entry);
+static void lru_push_front(ir_ac_cache_t *cache, ir_ac_cache_entry_t *entry);
+static void evict_entry(ir_ac_cache_t *cache, ir_ac_cache_entry_t *entry);
+static void trim_to_budget(ir_ac_cache_t *cache);
+
+
+INT8 ir_ac_cache_init(ir_ac_cache_t *cache, size_t memory_budget)
+{
+    if (NULL == cache)
+    {
+        return IR_DECODE_FAILED;
+    }
+    ir_memset(cache, 0x00, sizeof(ir_ac_cache_t));
+    cache->memory_budget = memory_budget;
+    return IR_DECODE_SUCCEEDED;
+}
+
+INT8 ir_ac_cache_set_lock(ir_ac_cache_t *cache, ir_ac_cache_lock_t lock_fn, ir_ac_cache_lock_t unlock_fn,
+                          void *lock_data)
+{
+    if (NULL == cache)
+    {
+        return IR_DECODE_FAILED;
+    }
+    if (NULL == lock_fn || NULL == unlock_fn)
+    {
+        lock_fn = NULL;
+        unlock_fn = NULL;
+    }
+    cache->lock_fn = lock_fn;
+    cache->unlock_fn = unlock_fn;
+    cache->lock_data = lock_data;
+    return IR_DECODE_SUCCEEDED;
+}
+
+INT8 ir_ac_cache_destroy(ir_ac_cache_t *cache)
+{
+    ir_ac_cache_entry_t *entry = NULL;
+    ir_ac_cache_entry_t *prev = NULL;
+
+    if (NULL == cache)
+    {
+        return IR_DECODE_FAILED;
+    }
+
+    entry = cache->lru_tail;
+    while (NULL != entry)
+    {
+        prev = entry->lru_prev;
+        if (0 == entry->ref_count)
+        {
+            evict_entry(cache, entry);
+        }
+        entry = prev;
+    }
+    return (0 == cache->entry_count) ? IR_DECODE_SUCCEEDED : IR_DECODE_FAILED;
+}
+
+INT8 ir_ac_cache_get_stats(ir_ac_cache_t *cache, ir_ac_cache_stats_t *stats)
+{
+    if (NULL == cache || NULL == stats)
+    {
+        return IR_DECODE_FAILED;
+    }
+    cache_lock(cache);
+    stats->hits = cache->hits;
+    stats->misses = cache->misses;
+    stats->evictions = cache->evictions;
+    stats->entry_count = cache->entry_count;
+    stats->memory_used = cache->memory_used;
+    stats->memory_budget = cache->memory_budget;
+    cache_unlock(cache);
+    return IR_DECODE_SUCCEEDED;
+}
+
+ir_ac_cache_entry_t *ir_ac_cache_acquire(ir_ac_cache_t *cache, UINT8 *binary, UINT16 binary_length,
+                                         UINT64 *hash)
+{
+    ir_ac_cache_entry_t *entry = NULL;
+
+    *hash = content_hash(binary, binary_length);
+    cache_lock(cache);
+    entry = find_entry(cache, *hash, binary, binary_length);
+    if (NULL == entry)
+    {
+        cache->misses++;
+        cache_unlock(cache);
+        return NULL;
+    }
+
+    cache->hits++;
+    entry->ref_count++;
+    lru_unlink(cache, entry);
+    lru_push_front(cache, entry);
+    cache_unlock(cache);
+    return entry;
+}
+
+ir_ac_cache_entry_t *ir_ac_cache_insert(ir_ac_cache_t *cache, UINT64 hash,
+                                        UINT8 *binary, UINT16 binary_length, protocol *context)
+{
+    ir_ac_cache_entry_t *entry = NULL;
+    size_t size = sizeof(ir_ac_cache_entry_t) + binary_length + ac_context_size(context);
+    UINT8 bucket = (UINT8) (hash % IR_AC_CACHE_BUCKETS);
+
+    // the caller keeps the protocol for itself if it could never fit
+    if (size > cache->memory_budget)
+    {
+        return NULL;
+    }
+
+    // the copy of the source binary follows the entry in the same allocation
+    entry = (ir_ac_cache_entry_t *) ir_malloc(sizeof(ir_ac_cache_entry_t) + binary_length);
+    if (NULL == entry)
+    {
+        return NULL;
+    }
+    ir_memset(entry, 0x00, sizeof(ir_ac_cache_entry_t));
+    entry->binary = (UINT8 *) (entry + 1);
+    ir_memcpy(entry->binary, binary, binary_length);
+
+    // the same binary could have been parsed and inserted by another thread meanwhile
+    cache_lock(cache);
+    if (NULL != find_entry(cache, hash, binary, binary_length))
+    {
+        cache_unlock(cache);
+        ir_free(entry);
+        return NULL;
+    }
+
+    // parsed segments move to the entry, the working frame stays with the decoder
+    ir_memcpy(&entry->ac, context, sizeof(protocol));
+    entry->ac.ir_hex_code = NULL;
+    entry->ac.ir_hex_len = 0;
+    entry->hash = hash;
+    entry->binary_length = binary_length;
+    entry->ref_count = 1;
+    entry->size = size;
+    entry->cache = cache;
+
+    entry->hash_next = cache->buckets[bucket];
+    cache->buckets[bucket] = entry;
+    lru_push_front(cache, entry);
+    cache->entry_count++;
+    cache->memory_used += size;
+
+    trim_to_budget(cache);
+    cache_unlock(cache);
+    return entry;
+}
+
+void ir_ac_cache_release(ir_ac_cache_entry_t *entry)
+{
+    ir_ac_cache_t *cache = NULL;
+
+    if (NULL == entry)
+    {
+        return;
+    }
+    cache = entry->cache;
+    cache_lock(cache);
+    if (0 != entry->ref_count)
+    {
+        entry->ref_count--;
+        trim_to_budget(cache);
+    }
+    cache_unlock(cache);
+}
+
+
+static UINT64 content_hash(UINT8 *binary, UINT16 binary_length)
+{
+    // FNV-1a over the whole binary
+    UINT64 hash = FNV_OFFSET_BASIS;
+    UINT16 i = 0;
+
+    for (i = 0; i < binary_length; i++)
+    {
+        hash ^= binary[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+static ir_ac_cache_entry_t *find_entry(ir_ac_cache_t *cache, UINT64 hash, UINT8 *binary, UINT16 binary_length)
+{
+    ir_ac_cache_entry_t *entry = cache->buckets[hash % IR_AC_CACHE_BUCKETS];
+
+    while (NULL != entry)
+    {
+        if (entry->hash == hash && entry->binary_length == binary_length &&
+            0 == memcmp(entry->binary, binary, binary_length))
+        {
+            return entry;
+        }
+        entry = entry->hash_next;
+    }
+    return NULL;
+}
+
+static void cache_lock(ir_ac_cache_t *cache)
+{
+    if (NULL != cache->lock_fn)
+    {
+        cache->lock_fn(cache->lock_data);
+    }
+}
+
+static void cache_unlock(ir_ac_cache_t *cache)
+{
+    if (NULL != cache->unlock_fn)
+    {
+        cache->unlock_fn(cache->lock_data);
+    }
+}
+
+static void lru_unlink(ir_ac_cache_t *cache, ir_ac_cache_entry_t *entry)
+{
+    if (NULL != entry->lru_prev)
+    {
+        entry->lru_prev->lru_next = entry->lru_next;
+    }
+    else
+    {
+        cache->lru_head = entry->lru_next;
+    }
+    if (NULL != entry->lru_next)
+    {
+        entry->lru_next->lru_prev = entry->lru_prev;
+    }
+    else
+    {
+        cache->lru_tail = entry->lru_prev;
+    }
+    entry->lru_prev = NULL;
+    entry->lru_next = NULL;
+}
+
+static void lru_push_front(ir_ac_cache_t *cache, ir_ac_cache_entry_t *entry)
+{
+    entry->lru_prev = NULL;
+    entry->lru_next = cache->lru_head;
+    if (NULL != cache->lru_head)
+    {
+        cache->lru_head->lru_prev = entry;
+    }
+    cache->lru_head = entry;
+    if (NULL == cache->lru_tail)
+    {
+        cache->lru_tail = entry;
+    }
+}
+
+static void evict_entry(ir_ac_cache_t *cache, ir_ac_cache_entry_t *entry)
+{
+    ir_ac_cache_entry_t **link = &cache->buckets[entry->hash % IR_AC_CACHE_BUCKETS];
+
+    while (NULL != *link && *link != entry)
+    {
+        link = &(*link)->hash_next;
+    }
+    if (NULL != *link)
+    {
+        *link = entry->hash_next;
+    }
+    lru_unlink(cache, entry);
+
+    cache->entry_count--;
+    cache->memory_used -= entry->size;
+    free_ac_context(&entry->ac);
+    ir_free(entry);
+}
+
+static void trim_to_budget(ir_ac_cache_t *cache)
+{
+    ir_ac_cache_entry_t *entry = cache->lru_tail;
+    ir_ac_cache_entry_t *prev = NULL;
+
+    // entries in use are skipped, the budget could be exceeded until they are released
+    while (NULL != entry && cache->memory_used > cache->memory_budget)
+    {
+        prev = entry->lru_prev;
+        if (0 == entry->ref_count)
+        {
+            evict_entry(cache, entry);
+            cache->evictions++;
+        }
+        entry = prev;
+    }
+}
@@ -0,0 +1,540 @@
+/**************************************************************************************
+Filename:       ir_ac_compiled.c
+Revised:        Date: 2026-10-17
+Revision:       Revision: 1.0
+
+Description:    This file provides the precompiled AC binary format
+
+Revision log:
+* 2026-10-17: created by agent
+**************************************************************************************/
+
+#include <string.h>
+
+#include "../include/ir_ac_compiled.h"
+#include "../include/ir_ac_build_frame.h"
+#include "../include/ir_decode.h"
+
+/*
+ * the same walk over the protocol either writes an image or reads one back,
+ * so that the writer and the loader could never disagree about the layout
+ */
+typedef struct image_cursor
+{
+    UINT8 *image;
+    size_t length;
+    size_t pos;
+    size_t data_pos;
+    BOOL writing;
+    BOOL failed;
+} image_cursor;
+
+static void io_u8(image_cursor *cursor, UINT8 *value);
+static void io_u16(image_cursor *cursor, UINT16 *value);
+static void io_i16(image_cursor *cursor, INT16 *value);
+static void io_segment(image_cursor *cursor, UINT8 *seg_len, UINT8 **segment);
+static void io_comp_array(image_cursor *cursor, tag_comp *comp_data, UINT8 count);
+static void io_swing(image_cursor *cursor, UINT8 *len, UINT16 *count, tag_comp **comp_data, tag_comp *storage);
+static void io_checksum(image_cursor *cursor, tchecksum *checksum, tag_checksum_data *storage);
+static void io_protocol(image_cursor *cursor, protocol *context, ir_ac_compiled_storage_t *storage);
+static BOOL check_comp(tag_comp *comp_data, UINT8 count, UINT8 type, UINT8 hex_len);
+static BOOL check_protocol(protocol *context);
+static void put_u16(UINT8 *p, UINT16 value);
+static UINT16 get_u16(UINT8 *p);
+
+
+BOOL ir_ac_is_compiled(UINT8 *binary, UINT16 binary_length)
+{
+    if (NULL == binary || binary_length < IR_AC_COMPILED_HEADER_SIZE)
+    {
+        return FALSE;
+    }
+    return (0 == memcmp(binary, IR_AC_COMPILED_MAGIC, 4)) ? TRUE : FALSE;
+}
+
+INT8 ir_ac_compile(protocol *context, UINT8 *image, UINT16 *image_length)
+{
+    image_cursor cursor;
+    size_t fixed_size = 0;
+    size_t data_size = 0;
+    size_t total = 0;
+
+    if (NULL == context || NULL == image_length || 0 == context->default_code.len)
+    {
+        return IR_DECODE_FAILED;
+    }
+    // the loader has fixed room for these
+    if ((NULL != context->swing1.comp_data && context->swing1.count > IR_AC_COMPILED_MAX_SWING) ||
+        (NULL != context->swing2.comp_data && context->swing2.count > IR_AC_COMPILED_MAX_SWING) ||
+        (NULL != context->checksum.checksum_data && context->checksum.count > IR_AC_COMPILED_MAX_CHECKSUM))
+    {
+        return IR_DECODE_FAILED;
+    }
+
+    // measure
+    ir_memset(&cursor, 0x00, sizeof(image_cursor));
+    cursor.writing = TRUE;
+    io_protocol(&cursor, context, NULL);
+    fixed_size = cursor.pos;
+    data_size = cursor.data_pos;
+    total = IR_AC_COMPILED_HEADER_SIZE + fixed_size + data_size;
+    // offsets into the image are stored in 2 bytes
+    if (total > 0xFFFF)
+    {
+        return IR_DECODE_FAILED;
+    }
+
+    if (NULL == image)
+    {
+        *image_length = (UINT16) total;
+        return IR_DECODE_SUCCEEDED;
+    }
+    if (*image_length < total)
+    {
+        return IR_DECODE_FAILED;
+    }
+
+    // write
+    ir_memset(image, 0x00, total);
+    ir_memcpy(image, IR_AC_COMPILED_MAGIC, 4);
+    put_u16(image + 4, IR_AC_COMPILED_VERSION);
+    put_u16(image + 8, (UINT16) total);
+
+    ir_memset(&cursor, 0x00, sizeof(image_cursor));
+    cursor.image = image;
+    cursor.length = total;
+    cursor.pos = IR_AC_COMPILED_HEADER_SIZE;
+    cursor.data_pos = IR_AC_COMPILED_HEADER_SIZE + fixed_size;
+    cursor.writing = TRUE;
+    io_protocol(&cursor, context, NULL);
+
+    *image_length = (UINT16) total;
+    return IR_DECODE_SUCCEEDED;
+}
+
+INT8 ir_ac_compiled_load(protocol *context, ir_ac_compiled_storage_t *storage,
+                         UINT8 *image, UINT16 image_length)
+{
+    image_cursor cursor;
+
+    if (NULL == context || NULL == storage || FALSE == ir_ac_is_compiled(image, image_length))
+    {
+        return IR_DECODE_FAILED;
+    }
+    if (IR_AC_COMPILED_VERSION != get_u16(image + 4) || 0 != get_u16(image + 10) ||
+        get_u16(image + 8) > image_length)
+    {
+        return IR_DECODE_FAILED;
+    }
+
+    ir_memset(context, 0x00, sizeof(protocol));
+    ir_memset(&cursor, 0x00, sizeof(image_cursor));
+    cursor.image = image;
+    cursor.length = get_u16(image + 8);
+    cursor.pos = IR_AC_COMPILED_HEADER_SIZE;
+    cursor.writing = FALSE;
+    io_protocol(&cursor, context, storage);
+
+    // counts index fixed size arrays and positions index the working frame when decoding
+    if (TRUE == cursor.failed || FALSE == check_protocol(context))
+    {
+        ir_memset(context, 0x00, sizeof(protocol));
+        return IR_DECODE_FAILED;
+    }
+
+    context->ir_hex_code = storage->ir_hex_code;
+    context->ir_hex_len = context->default_code.len;
+    ir_memset(context->ir_hex_code, 0x00, context->ir_hex_len);
+    build_frame_plan(context);
+    return IR_DECODE_SUCCEEDED;
+}
+
+
+static void put_u16(UINT8 *p, UINT16 value)
+{
+    p[0] = (UINT8) (value & 0xFF);
+    p[1] = (UINT8) (value >> 8);
+}
+
+static UINT16 get_u16(UINT8 *p)
+{
+    return (UINT16) (p[0] | (p[1] << 8));
+}
+
+static void io_u8(image_cursor *cursor, UINT8 *value)
+{
+    if (TRUE == cursor->writing)
+    {
+        if (NULL != cursor->image)
+        {
+            cursor->image[cursor->pos] = *value;
+        }
+    }
+    else
+    {
+        if (cursor->pos + 1 > cursor->length)
+        {
+            cursor->failed = TRUE;
+            return;
+        }
+        *value = cursor->image[cursor->pos];
+    }
+    cursor->pos++;
+}
+
+static void io_u16(image_cursor *cursor, UINT16 *value)
+{
+    if (TRUE == cursor->writing)
+    {
+        if (NULL != cursor->image)
+        {
+            put_u16(cursor->image + cursor->pos, *value);
+        }
+    }
+    else
+    {
+        if (cursor->pos + 2 > cursor->length)
+        {
+            cursor->failed = TRUE;
+            return;
+        }
+        *value = get_u16(cursor->image + cursor->pos);
+    }
+    cursor->pos += 2;
+}
+
+static void io_i16(image_cursor *cursor, INT16 *value)
+{
+    UINT16 raw = (UINT16) *value;
+    io_u16(cursor, &raw);
+    *value = (INT16) raw;
+}
+
+static void io_segment(image_cursor *cursor, UINT8 *seg_len, UINT8 **segment)
+{
+    UINT16 offset = 0;
+    UINT8 len = (NULL != *segment) ? *seg_len : 0;
+
+    io_u8(cursor, &len);
+    if (TRUE == cursor->writing)
+    {
+        offset = (UINT16) cursor->data_pos;
+        if (NULL != cursor->image && len > 0)
+        {
+            ir_memcpy(cursor->image + offset, *segment, len);
+        }
+        cursor->data_pos += len;
+        io_u16(cursor, &offset);
+    }
+    else
+    {
+        io_u16(cursor, &offset);
+        if (TRUE == cursor->failed || (size_t) offset + len > cursor->length)
+        {
+            cursor->failed = TRUE;
+            return;
+        }
+        *seg_len = len;
+        *segment = (len > 0) ? cursor->image + offset : NULL;
+    }
+}
+
+static void io_comp_array(image_cursor *cursor, tag_comp *comp_data, UINT8 count)
+{
+    UINT8 i = 0;
+
+    for (i = 0; i < count; i++)
+    {
+        io_segment(cursor, &comp_data[i].seg_len, &comp_data[i].segment);
+    }
+}
+
+static void io_swing(image_cursor *cursor, UINT8 *len, UINT16 *count, tag_comp **comp_data, tag_comp *storage)
+{
+    UINT16 i = 0;
+    UINT16 stored_count = (NULL != *comp_data) ? *count : 0;
+
+    io_u8(cursor, len);
+    io_u16(cursor, count);
+    io_u16(cursor, &stored_count);
+    if (FALSE == cursor->writing)
+    {
+        // the swing mode is checked against count only, every mode up to it needs its segment
+        if (TRUE == cursor->failed || stored_count > IR_AC_COMPILED_MAX_SWING || *count != stored_count)
+        {
+            cursor->failed = TRUE;
+            return;
+        }
+        *comp_data = (stored_count > 0) ? storage : NULL;
+    }
+    for (i = 0; i < stored_count; i++)
+    {
+        io_segment(cursor, &(*comp_data)[i].seg_len, &(*comp_data)[i].segment);
+    }
+}
+
+static void io_checksum(image_cursor *cursor, tchecksum *checksum, tag_checksum_data *storage)
+{
+    UINT16 i = 0;
+    UINT16 stored_count = (NULL != checksum->checksum_data) ? checksum->count : 0;
+    tag_checksum_data *data = NULL;
+    UINT8 spec_len = 0;
+
+    io_u8(cursor, &checksum->len);
+    io_u16(cursor, &stored_count);
+    if (FALSE == cursor->writing)
+    {
+        if (TRUE == cursor->failed || stored_count > IR_AC_COMPILED_MAX_CHECKSUM)
+        {
+            cursor->failed = TRUE;
+            return;
+        }
+        checksum->count = stored_count;
+        checksum->checksum_data = (stored_count > 0) ? storage : NULL;
+    }
+    for (i = 0; i < stored_count; i++)
+    {
+        data = &checksum->checksum_data[i];
+        io_u8(cursor, &data->len);
+        io_u8(cursor, &data->type);
+        io_u8(cursor, &data->start_byte_pos);
+        io_u8(cursor, &data->end_byte_pos);
+        io_u8(cursor, &data->checksum_byte_pos);
+        io_u8(cursor, &data->checksum_plus);
+        // specified positions follow the 4 leading bytes of the checksum tag, see parse_checksum_spec_half_byte_typed
+        spec_len = (NULL != data->spec_pos) ? (UINT8) (data->len - 3) : 0;
+        io_segment(cursor, &spec_len, &data->spec_pos);
+        if (FALSE == cursor->writing && NULL != data->spec_pos && (data->len < 3 || spec_len != data->len - 3))
+        {
+            cursor->failed = TRUE;
+        }
+    }
+}
+
+static void io_protocol(image_cursor *cursor, protocol *context, ir_ac_compiled_storage_t *storage)
+{
+    UINT8 i = 0;
+    UINT8 j = 0;
+    UINT8 value = 0;
+    ac_n_mode_info *n_mode = NULL;
+
+    io_u8(cursor, &context->endian);
+    io_u8(cursor, &context->lastbit);
+    io_u8(cursor, &context->solo_function_mark);
+    value = (UINT8) context->si.type;
+    io_u8(cursor, &value);
+    context->si.type = (swing_type) value;
+    io_u8(cursor, &context->si.mode_count);
+
+    io_u16(cursor, &context->zero.low);
+    io_u16(cursor, &context->zero.high);
+    io_u16(cursor, &context->one.low);
+    io_u16(cursor, &context->one.high);
+
+    // only the used part of the fixed size arrays is stored, the loader starts from a zeroed protocol
+    io_u16(cursor, &context->bootcode.len);
+    for (i = 0; i < context->bootcode.len && i < 16; i++)
+    {
+        io_u16(cursor, &context->bootcode.data[i]);
+    }
+
+    io_u16(cursor, &context->dc_cnt);
+    for (i = 0; i < context->dc_cnt && i < MAX_DELAYCODE_NUM; i++)
+    {
+        io_i16(cursor, &context->dc[i].pos);
+        io_u16(cursor, &context->dc[i].time_cnt);
+        if (context->dc[i].time_cnt > 8)
+        {
+            cursor->failed = TRUE;
+        }
+        for (j = 0; j < context->dc[i].time_cnt && j < 8; j++)
+        {
+            io_u16(cursor, &context->dc[i].time[j]);
+        }
+    }
+
+    io_u16(cursor, &context->bitnum_cnt);
+    for (i = 0; i < context->bitnum_cnt && i < MAX_BITNUM; i++)
+    {
+        io_i16(cursor, &context->bitnum[i].pos);
+        io_u16(cursor, &context->bitnum[i].bits);
+    }
+    io_u16(cursor, &context->repeat_times);
+    io_u16(cursor, &context->frame_length);
+
+    for (i = 0; i < N_MODE_MAX; i++)
+    {
+        n_mode = &context->n_mode[i];
+        io_u8(cursor, &n_mode->enable);
+        io_u8(cursor, &n_mode->allspeed);
+        io_u8(cursor, &n_mode->alltemp);
+        for (j = 0; j < AC_TEMP_MAX; j++)
+        {
+            io_u8(cursor, &n_mode->temp[j]);
+        }
+        io_u8(cursor, &n_mode->temp_cnt);
+        for (j = 0; j < AC_WS_MAX; j++)
+        {
+            io_u8(cursor, &n_mode->speed[j]);
+        }
+        io_u8(cursor, &n_mode->speed_cnt);
+    }
+
+    io_u8(cursor, &context->sc.len);
+    io_u8(cursor, &context->sc.solo_func_count);
+    for (i = 0; i < AC_FUNCTION_MAX - 1; i++)
+    {
+        io_u8(cursor, &context->sc.solo_function_codes[i]);
+    }
+
+    io_segment(cursor, &context->default_code.len, &context->default_code.data);
+
+    io_u8(cursor, &context->power1.len);
+    io_comp_array(cursor, context->power1.comp_data, AC_POWER_MAX);
+    io_u8(cursor, &context->temp1.len);
+    io_u8(cursor, &context->temp1.type);
+    io_comp_array(cursor, context->temp1.comp_data, AC_TEMP_MAX);
+    io_u8(cursor, &context->mode1.len);
+    io_comp_array(cursor, context->mode1.comp_data, AC_MODE_MAX);
+    io_u8(cursor, &context->speed1.len);
+    io_comp_array(cursor, context->speed1.comp_data, AC_WS_MAX);
+
+    io_u8(cursor, &context->function1.len);
+    io_comp_array(cursor, context->function1.comp_data, AC_FUNCTION_MAX - 1);
+    io_u8(cursor, &context->function2.len);
+    io_comp_array(cursor, context->function2.comp_data, AC_FUNCTION_MAX - 1);
+
+    io_u8(cursor, &context->temp2.len);
+    io_u8(cursor, &context->temp2.type);
+    io_comp_array(cursor, context->temp2.comp_data, AC_TEMP_MAX);
+    io_u8(cursor, &context->mode2.len);
+    io_comp_array(cursor, context->mode2.comp_data, AC_MODE_MAX);
+    io_u8(cursor, &context->speed2.len);
+    io_comp_array(cursor, context->speed2.comp_data, AC_WS_MAX);
+
+    io_swing(cursor, &context->swing1.len, &context->swing1.count, &context->swing1.comp_data,
+             (NULL != storage) ? storage->swing1 : NULL);
+    io_swing(cursor, &context->swing2.len, &context->swing2.count, &context->swing2.comp_data,
+             (NULL != storage) ? storage->swing2 : NULL);
+    io_checksum(cursor, &context->checksum, (NULL != storage) ? storage->checksum : NULL);
+}
+
+static BOOL check_comp(tag_comp *comp_data, UINT8 count, UINT8 type, UINT8 hex_len)
+{
+    UINT8 i = 0;
+    UINT16 j = 0;
+    UINT8 *segment = NULL;
+
+    for (i = 0; i < count; i++)
+    {
+        segment = comp_data[i].segment;
+        if (1 == type)
+        {
+            // pairs of byte position and value
+            for (j = 0; j + 1 < comp_data[i].seg_len; j += 2)
+            {
+                if (segment[j] >= hex_len)
+                {
+                    return FALSE;
+                }
+            }
+        }
+        else
+        {
+            // triples of start bit, end bit and value
+            for (j = 0; j + 2 < comp_data[i].seg_len; j += 3)
+            {
+                if ((segment[j] >> 3) >= hex_len || 0 == segment[j + 1] || ((segment[j + 1] - 1) >> 3) >= hex_len)
+                {
+                    return FALSE;
+                }
+            }
+        }
+    }
+    return TRUE;
+}
+
+static BOOL check_protocol(protocol *context)
+{
+    UINT8 hex_len = context->default_code.len;
+    UINT16 i = 0;
+    UINT8 j = 0;
+    tag_checksum_data *cs = NULL;
+
+    if (0 == hex_len || context->bootcode.len > 16 ||
+        context->dc_cnt > MAX_DELAYCODE_NUM || context->bitnum_cnt > MAX_BITNUM ||
+        context->sc.solo_func_count >= AC_FUNCTION_MAX)
+    {
+        return FALSE;
+    }
+    for (i = 0; i < N_MODE_MAX; i++)
+    {
+        if (context->n_mode[i].temp_cnt > AC_TEMP_MAX || context->n_mode[i].speed_cnt > AC_WS_MAX)
+        {
+            return FALSE;
+        }
+    }
+
+    if (FALSE == check_comp(context->power1.comp_data, AC_POWER_MAX, 1, hex_len) ||
+        FALSE == check_comp(context->temp1.comp_data, AC_TEMP_MAX, 1, hex_len) ||
+        FALSE == check_comp(context->mode1.comp_data, AC_MODE_MAX, 1, hex_len) ||
+        FALSE == check_comp(context->speed1.comp_data, AC_WS_MAX, 1, hex_len) ||
+        FALSE == check_comp(context->function1.comp_data, AC_FUNCTION_MAX - 1, 1, hex_len) ||
+        FALSE == check_comp(context->temp2.comp_data, AC_TEMP_MAX, 2, hex_len) ||
+        FALSE == check_comp(context->mode2.comp_data, AC_MODE_MAX, 2, hex_len) ||
+        FALSE == check_comp(context->speed2.comp_data, AC_WS_MAX, 2, hex_len) ||
+        FALSE == check_comp(context->function2.comp_data, AC_FUNCTION_MAX - 1, 2, hex_len))
+    {
+        return FALSE;
+    }
+    if ((NULL != context->swing1.comp_data &&
+         FALSE == check_comp(context->swing1.comp_data, (UINT8) context->swing1.count, 1, hex_len)) ||
+        (NULL != context->swing2.comp_data &&
+         FALSE == check_comp(context->swing2.comp_data, (UINT8) context->swing2.count, 2, hex_len)))
+    {
+        return FALSE;
+    }
+
+    for (i = 0; i < context->checksum.count; i++)
+    {
+        cs = &context->checksum.checksum_data[i];
+        switch (cs->type)
+        {
+            case CHECKSUM_TYPE_BYTE:
+            case CHECKSUM_TYPE_BYTE_INVERSE:
+            case CHECKSUM_TYPE_HALF_BYTE:
+            case CHECKSUM_TYPE_HALF_BYTE_INVERSE:
+                // the end position is exclusive
+                if (cs->len >= 3 && (cs->start_byte_pos >= hex_len || cs->end_byte_pos > hex_len ||
+                                     cs->checksum_byte_pos >= hex_len))
+                {
+                    return FALSE;
+                }
+                break;
+            case CHECKSUM_TYPE_SPEC_HALF_BYTE:
+            case CHECKSUM_TYPE_SPEC_HALF_BYTE_INVERSE:
+            case CHECKSUM_TYPE_SPEC_HALF_BYTE_ONE_BYTE:
+            case CHECKSUM_TYPE_SPEC_HALF_BYTE_INVERSE_ONE_BYTE:
+                if (cs->len < 4)
+                {
+                    break;
+                }
+                // positions are of half bytes
+                if (NULL == cs->spec_pos || (cs->checksum_byte_pos >> 1) >= hex_len)
+                {
+                    return FALSE;
+                }
+                for (j = 0; j < cs->len - 3; j++)
+                {
+                    if ((cs->spec_pos[j] >> 1) >= hex_len)
+                    {
+                        return FALSE;
+                    }
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    return TRUE;
+}
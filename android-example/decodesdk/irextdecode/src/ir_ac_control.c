@@ -19,44 +19,54 @@ Revision log:
 #include "../include/ir_ac_parse_parameter.h"
 #include "../include/ir_ac_parse_forbidden_info.h"
 #include "../include/ir_ac_parse_frame_info.h"
+#include "../include/ir_ac_build_frame.h"
 #include "../include/ir_utils.h"
 
 
-extern struct tag_head *tags;
-extern UINT8 tag_count;
+static INT8 ir_context_init(protocol *context);
+static UINT16 tag_group(UINT16 tag);
+static INT8 parse_tag(protocol *context, struct tag_head *tag);
+static void mark_solo_functions(protocol *context);
+static INT8 keep_pending_tags(struct ir_decoder *decoder);
+static void free_segment(protocol *context, UINT8 *segment);
 
-static INT8 ir_context_init();
 
-
-static INT8 ir_context_init()
+static INT8 ir_context_init(protocol *context)
 {
     ir_memset(context, 0, sizeof(protocol));
     return IR_DECODE_SUCCEEDED;
 }
 
 
-INT8 ir_ac_lib_parse()
+INT8 ir_ac_lib_parse(struct ir_decoder *decoder)
 {
     UINT8 i = 0;
+    protocol *context = &decoder->ac;
+
     // suggest not to call init function here for de-couple purpose
-    ir_context_init();
+    ir_context_init(context);
+    if (TRUE == decoder->ac_in_place)
+    {
+        context->in_place_data = decoder->ac_buffer.data;
+        context->in_place_len = decoder->ac_buffer.len;
+    }
 
-    if (IR_DECODE_FAILED == binary_parse_offset())
+    if (IR_DECODE_FAILED == binary_parse_offset(decoder))
     {
         return IR_DECODE_FAILED;
     }
 
-    if (IR_DECODE_FAILED == binary_parse_len())
+    if (IR_DECODE_FAILED == binary_parse_len(decoder))
     {
         return IR_DECODE_FAILED;
     }
 
-    if (IR_DECODE_FAILED == binary_parse_data())
+    if (IR_DECODE_FAILED == binary_parse_data(decoder))
     {
         return IR_DECODE_FAILED;
     }
 
-    binary_tags_info();
+    binary_tags_info(decoder);
 
     context->endian = 0;
     context->lastbit = 0;
@@ -73,8 +83,57 @@ INT8 ir_ac_lib_parse()
         context->n_mode[i].temp_cnt = 0;
     }
 
+    // the frame tags are parsed on open in any case, every decode and the frame length need them
+    decoder->ac_pending = AC_TAG_GROUP_ALL;
+    decoder->ac_lazy_failed = FALSE;
+    if (IR_DECODE_FAILED == ir_ac_lib_parse_groups(decoder, AC_TAG_GROUP_FRAME))
+    {
+        return IR_DECODE_FAILED;
+    }
+
+    context->ir_hex_code = (UINT8 *) ir_malloc(context->default_code.len);
+    if (NULL == context->ir_hex_code)
+    {
+        // warning: this AC bin contains no default code
+        return IR_DECODE_FAILED;
+    }
+
+    context->ir_hex_len = context->default_code.len;
+    ir_memset(context->ir_hex_code, 0x00, context->ir_hex_len);
+    build_frame_plan(context);
+
+    if (TRUE == decoder->ac_lazy)
+    {
+        // the tag index and a copy of the pending tags are kept for the groups still pending
+        return keep_pending_tags(decoder);
+    }
+    return ir_ac_lib_parse_groups(decoder, AC_TAG_GROUP_ALL);
+}
+
+
+INT8 ir_ac_lib_parse_groups(struct ir_decoder *decoder, UINT16 groups)
+{
+    UINT8 i = 0;
+    UINT8 pass = 0;
+    BOOL late = FALSE;
+    protocol *context = &decoder->ac;
+    struct tag_head *tags = decoder->tags;
+    UINT8 tag_count = decoder->tag_count;
+
+    if (TRUE == decoder->ac_lazy_failed)
+    {
+        return IR_DECODE_FAILED;
+    }
+    groups &= decoder->ac_pending;
+    if (0 == groups)
+    {
+        return IR_DECODE_SUCCEEDED;
+    }
+    // left set on any failure below, a group parsed in part could not be parsed again
+    decoder->ac_lazy_failed = TRUE;
+
     // parse TAG 46 in first priority
-    for (i = 0; i < tag_count; i++)
+    for (i = 0; 0 != (groups & AC_TAG_GROUP_SWING) && i < tag_count; i++)
     {
         if (tags[i].tag == TAG_AC_SWING_INFO)
         {
@@ -91,309 +150,50 @@ INT8 ir_ac_lib_parse()
         }
     }
 
-    for (i = 0; i < tag_count; i++)
+    // delay codes and the last bit are parsed once the rest is
+    for (pass = 0; pass < 2; pass++)
     {
-        if (tags[i].len == 0)
-        {
-            continue;
-        }
-        // then parse TAG 26 or 33
-        if (context->si.type == SWING_TYPE_NORMAL)
-        {
-            UINT16 swing_space_size = 0;
-            if (tags[i].tag == TAG_AC_SWING_1)
-            {
-                context->swing1.count = context->si.mode_count;
-                context->swing1.len = (UINT8) tags[i].len >> 1;
-                swing_space_size = sizeof(tag_comp) * context->si.mode_count;
-                context->swing1.comp_data = (tag_comp *) ir_malloc(swing_space_size);
-                if (NULL == context->swing1.comp_data)
-                {
-                    return IR_DECODE_FAILED;
-                }
-
-                ir_memset(context->swing1.comp_data, 0x00, swing_space_size);
-                if (IR_DECODE_FAILED == parse_common_ac_parameter(&tags[i],
-                                                                  context->swing1.comp_data,
-                                                                  context->si.mode_count,
-                                                                  AC_PARAMETER_TYPE_1))
-                {
-                    return IR_DECODE_FAILED;
-                }
-            }
-            else if (tags[i].tag == TAG_AC_SWING_2)
-            {
-                context->swing2.count = context->si.mode_count;
-                context->swing2.len = (UINT8) tags[i].len >> 1;
-                swing_space_size = sizeof(tag_comp) * context->si.mode_count;
-                context->swing2.comp_data = (tag_comp *) ir_malloc(swing_space_size);
-                if (NULL == context->swing2.comp_data)
-                {
-                    return IR_DECODE_FAILED;
-                }
-                ir_memset(context->swing2.comp_data, 0x00, swing_space_size);
-                if (IR_DECODE_FAILED == parse_common_ac_parameter(&tags[i],
-                                                                  context->swing2.comp_data,
-                                                                  context->si.mode_count,
-                                                                  AC_PARAMETER_TYPE_2))
-                {
-                    return IR_DECODE_FAILED;
-                }
-            }
-        }
-
-        if (tags[i].tag == TAG_AC_DEFAULT_CODE) // default code TAG
-        {
-            context->default_code.data = (UINT8 *) ir_malloc(((size_t) tags[i].len - 2) >> 1);
-            if (NULL == context->default_code.data)
-            {
-                return IR_DECODE_FAILED;
-            }
-            if (IR_DECODE_FAILED == parse_default_code(&tags[i], &(context->default_code)))
-            {
-                return IR_DECODE_FAILED;
-            }
-        }
-        else if (tags[i].tag == TAG_AC_POWER_1) // power tag
+        for (i = 0; i < tag_count; i++)
         {
-            context->power1.len = (UINT8) tags[i].len >> 1;
-            if (IR_DECODE_FAILED == parse_common_ac_parameter(&tags[i],
-                                                              context->power1.comp_data,
-                                                              AC_POWER_MAX,
-                                                              AC_PARAMETER_TYPE_1))
+            late = (tags[i].tag == TAG_AC_DELAY_CODE || tags[i].tag == TAG_AC_LASTBIT) ? TRUE : FALSE;
+            if (tags[i].len == 0 || 0 == (groups & tag_group(tags[i].tag)) || late != pass)
             {
-                return IR_DECODE_FAILED;
+                continue;
             }
-        }
-        else if (tags[i].tag == TAG_AC_TEMP_1) // temperature tag type 1
-        {
-            if (IR_DECODE_FAILED == parse_temp_1(&tags[i], &(context->temp1)))
-            {
-                return IR_DECODE_FAILED;
-            }
-        }
-        else if (tags[i].tag == TAG_AC_MODE_1) // mode tag
-        {
-            context->mode1.len = (UINT8) tags[i].len >> 1;
-            if (IR_DECODE_FAILED == parse_common_ac_parameter(&tags[i],
-                                                              context->mode1.comp_data,
-                                                              AC_MODE_MAX,
-                                                              AC_PARAMETER_TYPE_1))
-            {
-                return IR_DECODE_FAILED;
-            }
-        }
-        else if (tags[i].tag == TAG_AC_SPEED_1) // wind speed tag
-        {
-            context->speed1.len = (UINT8) tags[i].len >> 1;
-            if (IR_DECODE_FAILED == parse_common_ac_parameter(&tags[i],
-                                                              context->speed1.comp_data,
-                                                              AC_WS_MAX,
-                                                              AC_PARAMETER_TYPE_1))
-            {
-                return IR_DECODE_FAILED;
-            }
-        }
-        else if (tags[i].tag == TAG_AC_CHECKSUM_TYPE)
-        {
-            if (IR_DECODE_FAILED == parse_checksum(&tags[i], &(context->checksum)))
-            {
-                return IR_DECODE_FAILED;
-            }
-        }
-        else if (tags[i].tag == TAG_AC_MODE_2)
-        {
-            context->mode2.len = (UINT8) tags[i].len >> 1;
-            if (IR_DECODE_FAILED ==
-                parse_common_ac_parameter(&tags[i],
-                                          context->mode2.comp_data, AC_MODE_MAX, AC_PARAMETER_TYPE_1))
-            {
-                return IR_DECODE_FAILED;
-            }
-        }
-        else if (tags[i].tag == TAG_AC_SPEED_2)
-        {
-            context->speed2.len = (UINT8) tags[i].len >> 1;
-            if (IR_DECODE_FAILED ==
-                parse_common_ac_parameter(&tags[i],
-                                          context->speed2.comp_data, AC_WS_MAX, AC_PARAMETER_TYPE_1))
-            {
-                return IR_DECODE_FAILED;
-            }
-        }
-        else if (tags[i].tag == TAG_AC_TEMP_2)
-        {
-            if (IR_DECODE_FAILED == parse_temp_2(&tags[i], &(context->temp2)))
-            {
-                return IR_DECODE_FAILED;
-            }
-        }
-        else if (tags[i].tag == TAG_AC_SOLO_FUNCTION)
-        {
-            if (IR_DECODE_FAILED == parse_solo_code(&tags[i], &(context->sc)))
-            {
-                return IR_DECODE_FAILED;
-            }
-            context->solo_function_mark = 1;
-        }
-        else if (tags[i].tag == TAG_AC_FUNCTION_1)
-        {
-            if (IR_DECODE_FAILED == parse_function_1_tag29(&tags[i], &(context->function1)))
-            {
-                ir_printf("\nfunction code parse error\n");
-                return IR_DECODE_FAILED;
-            }
-        }
-        else if (tags[i].tag == TAG_AC_FUNCTION_2)
-        {
-            if (IR_DECODE_FAILED == parse_function_2_tag34(&tags[i], &(context->function2)))
-            {
-                return IR_DECODE_FAILED;
-            }
-        }
-        else if (tags[i].tag == TAG_AC_FRAME_LENGTH)
-        {
-            if (IR_DECODE_FAILED == parse_frame_len(&tags[i], tags[i].len))
-            {
-                return IR_DECODE_FAILED;
-            }
-        }
-        else if (tags[i].tag == TAG_AC_ZERO)
-        {
-            if (IR_DECODE_FAILED == parse_zero(&tags[i]))
-            {
-                return IR_DECODE_FAILED;
-            }
-        }
-        else if (tags[i].tag == TAG_AC_ONE)
-        {
-            if (IR_DECODE_FAILED == parse_one(&tags[i]))
-            {
-                return IR_DECODE_FAILED;
-            }
-        }
-        else if (tags[i].tag == TAG_AC_BOOT_CODE)
-        {
-            if (IR_DECODE_FAILED == parse_boot_code(&tags[i]))
-            {
-                return IR_DECODE_FAILED;
-            }
-        }
-        else if (tags[i].tag == TAG_AC_REPEAT_TIMES)
-        {
-            if (IR_DECODE_FAILED == parse_repeat_times(&tags[i]))
-            {
-                return IR_DECODE_FAILED;
-            }
-        }
-        else if (tags[i].tag == TAG_AC_BITNUM)
-        {
-            if (IR_DECODE_FAILED == parse_bit_num(&tags[i]))
-            {
-                return IR_DECODE_FAILED;
-            }
-        }
-        else if (tags[i].tag == TAG_AC_ENDIAN)
-        {
-            if (IR_DECODE_FAILED == parse_endian(&tags[i]))
-            {
-                return IR_DECODE_FAILED;
-            }
-        }
-        else if (tags[i].tag == TAG_AC_BAN_FUNCTION_IN_COOL_MODE)
-        {
-            if (IR_DECODE_FAILED == parse_nmode(&tags[i], N_COOL))
-            {
-                return IR_DECODE_FAILED;
-            }
-        }
-        else if (tags[i].tag == TAG_AC_BAN_FUNCTION_IN_HEAT_MODE)
-        {
-            if (IR_DECODE_FAILED == parse_nmode(&tags[i], N_HEAT))
-            {
-                return IR_DECODE_FAILED;
-            }
-        }
-        else if (tags[i].tag == TAG_AC_BAN_FUNCTION_IN_AUTO_MODE)
-        {
-            if (IR_DECODE_FAILED == parse_nmode(&tags[i], N_AUTO))
-            {
-                return IR_DECODE_FAILED;
-            }
-        }
-        else if (tags[i].tag == TAG_AC_BAN_FUNCTION_IN_FAN_MODE)
-        {
-            if (IR_DECODE_FAILED == parse_nmode(&tags[i], N_FAN))
-            {
-                return IR_DECODE_FAILED;
-            }
-        }
-        else if (tags[i].tag == TAG_AC_BAN_FUNCTION_IN_DRY_MODE)
-        {
-            if (IR_DECODE_FAILED == parse_nmode(&tags[i], N_DRY))
+            if (IR_DECODE_FAILED == parse_tag(context, &tags[i]))
             {
                 return IR_DECODE_FAILED;
             }
         }
     }
 
-    for (i = 0; i < tag_count; i++)
+    if (0 != (groups & AC_TAG_GROUP_SOLO))
     {
-        if (tags[i].len == 0)
-        {
-            continue;
-        }
-        if (tags[i].tag == TAG_AC_DELAY_CODE)
-        {
-            if (IR_DECODE_FAILED == parse_delay_code(&tags[i]))
-            {
-                return IR_DECODE_FAILED;
-            }
-        }
-        if (tags[i].tag == TAG_AC_LASTBIT)
-        {
-            if (IR_DECODE_FAILED == parse_lastbit(&tags[i]))
-            {
-                return IR_DECODE_FAILED;
-            }
-        }
+        mark_solo_functions(context);
     }
-
-    if (NULL != tags)
+    decoder->ac_pending &= (UINT16) ~groups;
+    decoder->ac_lazy_failed = FALSE;
+    if (0 != decoder->ac_pending)
     {
-        ir_free(tags);
-        tags = NULL;
+        return IR_DECODE_SUCCEEDED;
     }
 
-    ir_hex_code = (UINT8 *) ir_malloc(context->default_code.len);
-    if (NULL == ir_hex_code)
+    if (NULL != decoder->tags)
     {
-        // warning: this AC bin contains no default code
-        return IR_DECODE_FAILED;
+        ir_free(decoder->tags);
+        decoder->tags = NULL;
     }
-
-    ir_hex_len = context->default_code.len;
-    ir_memset(ir_hex_code, 0x00, ir_hex_len);
-
-    // pre-calculate solo function status after parse phase
-    if (1 == context->solo_function_mark)
+    if (NULL != decoder->ac_lazy_tags)
     {
-        context->solo_function_mark = 0x00;
-        // bit order from right to left : power, mode, temp+, temp-, wind_speed, swing, fix
-        for (i = AC_FUNCTION_POWER; i < AC_FUNCTION_MAX; i++)
-        {
-            if (isin(context->sc.solo_function_codes, i, context->sc.solo_func_count))
-            {
-                context->solo_function_mark |= (1 << (i - 1));
-            }
-        }
+        ir_free(decoder->ac_lazy_tags);
+        decoder->ac_lazy_tags = NULL;
     }
 
     // it is strongly recommended that we free p_ir_buffer
     // or make global buffer shared in extreme memory case
     /* in case of running with test - begin */
 #if (defined BOARD_PC || defined BOARD_PC_DLL)
-    ir_lib_free_inner_buffer();
+    ir_lib_free_inner_buffer(decoder);
     ir_printf("AC parse done\n");
 #endif
     /* in case of running with test - end */
@@ -402,20 +202,20 @@ INT8 ir_ac_lib_parse()
 }
 
 
-INT8 free_ac_context()
+INT8 free_ac_context(protocol *context)
 {
     UINT16 i = 0;
 
-    if (ir_hex_code != NULL)
+    if (context->ir_hex_code != NULL)
     {
-        ir_free(ir_hex_code);
-        ir_hex_code = NULL;
+        ir_free(context->ir_hex_code);
+        context->ir_hex_code = NULL;
     }
-    ir_hex_len = 0;
+    context->ir_hex_len = 0;
 
     if (context->default_code.data != NULL)
     {
-        ir_free(context->default_code.data);
+        free_segment(context, context->default_code.data);
         context->default_code.data = NULL;
         context->default_code.len = 0;
     }
@@ -424,7 +224,7 @@ INT8 free_ac_context()
     {
         if (context->power1.comp_data[i].segment != NULL)
         {
-            ir_free(context->power1.comp_data[i].segment);
+            free_segment(context, context->power1.comp_data[i].segment);
             context->power1.comp_data[i].segment = NULL;
             context->power1.comp_data[i].seg_len = 0;
         }
@@ -434,13 +234,13 @@ INT8 free_ac_context()
     {
         if (context->temp1.comp_data[i].segment != NULL)
         {
-            ir_free(context->temp1.comp_data[i].segment);
+            free_segment(context, context->temp1.comp_data[i].segment);
             context->temp1.comp_data[i].segment = NULL;
             context->temp1.comp_data[i].seg_len = 0;
         }
         if (context->temp2.comp_data[i].segment != NULL)
         {
-            ir_free(context->temp2.comp_data[i].segment);
+            free_segment(context, context->temp2.comp_data[i].segment);
             context->temp2.comp_data[i].segment = NULL;
             context->temp2.comp_data[i].seg_len = 0;
         }
@@ -450,13 +250,13 @@ INT8 free_ac_context()
     {
         if (context->mode1.comp_data[i].segment != NULL)
         {
-            ir_free(context->mode1.comp_data[i].segment);
+            free_segment(context, context->mode1.comp_data[i].segment);
             context->mode1.comp_data[i].segment = NULL;
             context->mode1.comp_data[i].seg_len = 0;
         }
         if (context->mode2.comp_data[i].segment != NULL)
         {
-            ir_free(context->mode2.comp_data[i].segment);
+            free_segment(context, context->mode2.comp_data[i].segment);
             context->mode2.comp_data[i].segment = NULL;
             context->mode2.comp_data[i].seg_len = 0;
         }
@@ -465,13 +265,13 @@ INT8 free_ac_context()
     {
         if (context->speed1.comp_data[i].segment != NULL)
         {
-            ir_free(context->speed1.comp_data[i].segment);
+            free_segment(context, context->speed1.comp_data[i].segment);
             context->speed1.comp_data[i].segment = NULL;
             context->speed1.comp_data[i].seg_len = 0;
         }
         if (context->speed2.comp_data[i].segment != NULL)
         {
-            ir_free(context->speed2.comp_data[i].segment);
+            free_segment(context, context->speed2.comp_data[i].segment);
             context->speed2.comp_data[i].segment = NULL;
             context->speed2.comp_data[i].seg_len = 0;
         }
@@ -482,14 +282,14 @@ INT8 free_ac_context()
         if (context->swing1.comp_data != NULL &&
             context->swing1.comp_data[i].segment != NULL)
         {
-            ir_free(context->swing1.comp_data[i].segment);
+            free_segment(context, context->swing1.comp_data[i].segment);
             context->swing1.comp_data[i].segment = NULL;
             context->swing1.comp_data[i].seg_len = 0;
         }
         if (context->swing2.comp_data != NULL &&
             context->swing2.comp_data[i].segment != NULL)
         {
-            ir_free(context->swing2.comp_data[i].segment);
+            free_segment(context, context->swing2.comp_data[i].segment);
             context->swing2.comp_data[i].segment = NULL;
             context->swing2.comp_data[i].seg_len = 0;
         }
@@ -499,13 +299,13 @@ INT8 free_ac_context()
     {
         if (context->function1.comp_data[i].segment != NULL)
         {
-            ir_free(context->function1.comp_data[i].segment);
+            free_segment(context, context->function1.comp_data[i].segment);
             context->function1.comp_data[i].segment = NULL;
             context->function1.comp_data[i].seg_len = 0;
         }
         if (context->function2.comp_data[i].segment != NULL)
         {
-            ir_free(context->function2.comp_data[i].segment);
+            free_segment(context, context->function2.comp_data[i].segment);
             context->function2.comp_data[i].segment = NULL;
             context->function2.comp_data[i].seg_len = 0;
         }
@@ -528,7 +328,7 @@ INT8 free_ac_context()
         if (context->checksum.checksum_data != NULL &&
             context->checksum.checksum_data[i].spec_pos != NULL)
         {
-            ir_free(context->checksum.checksum_data[i].spec_pos);
+            free_segment(context, context->checksum.checksum_data[i].spec_pos);
             context->checksum.checksum_data[i].len = 0;
             context->checksum.checksum_data[i].spec_pos = NULL;
         }
@@ -539,10 +339,440 @@ INT8 free_ac_context()
         context->checksum.checksum_data = NULL;
     }
 
+    if (NULL != context->frame_plan)
+    {
+        ir_free(context->frame_plan);
+        context->frame_plan = NULL;
+    }
+
     return IR_DECODE_SUCCEEDED;
 }
 
-BOOL is_solo_function(UINT8 function_code)
+size_t ac_context_size(protocol *context)
+{
+    // bytes allocated by ir_ac_lib_parse, as released by free_ac_context
+    size_t size = context->default_code.len + context->ir_hex_len;
+    UINT16 i = 0;
+
+    for (i = 0; i < AC_POWER_MAX; i++)
+    {
+        size += context->power1.comp_data[i].seg_len;
+    }
+    for (i = 0; i < AC_TEMP_MAX; i++)
+    {
+        size += context->temp1.comp_data[i].seg_len + context->temp2.comp_data[i].seg_len;
+    }
+    for (i = 0; i < AC_MODE_MAX; i++)
+    {
+        size += context->mode1.comp_data[i].seg_len + context->mode2.comp_data[i].seg_len;
+    }
+    for (i = 0; i < AC_WS_MAX; i++)
+    {
+        size += context->speed1.comp_data[i].seg_len + context->speed2.comp_data[i].seg_len;
+    }
+    for (i = 0; i < AC_FUNCTION_MAX - 1; i++)
+    {
+        size += context->function1.comp_data[i].seg_len + context->function2.comp_data[i].seg_len;
+    }
+    for (i = 0; i < context->si.mode_count; i++)
+    {
+        if (NULL != context->swing1.comp_data)
+        {
+            size += sizeof(tag_comp) + context->swing1.comp_data[i].seg_len;
+        }
+        if (NULL != context->swing2.comp_data)
+        {
+            size += sizeof(tag_comp) + context->swing2.comp_data[i].seg_len;
+        }
+    }
+    if (NULL != context->checksum.checksum_data)
+    {
+        for (i = 0; i < context->checksum.count; i++)
+        {
+            size += sizeof(tag_checksum_data);
+            if (NULL != context->checksum.checksum_data[i].spec_pos)
+            {
+                size += (size_t) context->checksum.checksum_data[i].len - 3;
+            }
+        }
+    }
+    if (NULL != context->frame_plan)
+    {
+        size += sizeof(ac_frame_plan);
+    }
+    return size;
+}
+
+BOOL is_solo_function(protocol *context, UINT8 function_code)
 {
     return (((context->solo_function_mark >> (function_code - 1)) & 0x01) == 0x01) ? TRUE : FALSE;
 }
+
+static INT8 keep_pending_tags(struct ir_decoder *decoder)
+{
+    UINT8 i = 0;
+    size_t size = 0;
+    UINT8 *copy = NULL;
+    struct tag_head *tags = decoder->tags;
+
+    // text decoded in place stays in the binary, the caller keeps it for the whole decoder anyway
+    if (TRUE == decoder->ac_in_place || 0 == decoder->ac_pending)
+    {
+        return IR_DECODE_SUCCEEDED;
+    }
+
+    for (i = 0; i < decoder->tag_count; i++)
+    {
+        if (tags[i].len != 0 && 0 != (decoder->ac_pending & tag_group(tags[i].tag)))
+        {
+            size += tags[i].len;
+        }
+    }
+    if (0 == size)
+    {
+        return IR_DECODE_SUCCEEDED;
+    }
+
+    decoder->ac_lazy_tags = (UINT8 *) ir_malloc(size);
+    if (NULL == decoder->ac_lazy_tags)
+    {
+        return IR_DECODE_FAILED;
+    }
+    copy = decoder->ac_lazy_tags;
+    for (i = 0; i < decoder->tag_count; i++)
+    {
+        if (tags[i].len != 0 && 0 != (decoder->ac_pending & tag_group(tags[i].tag)))
+        {
+            ir_memcpy(copy, tags[i].pdata, tags[i].len);
+            tags[i].pdata = copy;
+            copy += tags[i].len;
+        }
+    }
+    return IR_DECODE_SUCCEEDED;
+}
+
+static UINT16 tag_group(UINT16 tag)
+{
+    switch (tag)
+    {
+        case TAG_AC_POWER_1:
+            return AC_TAG_GROUP_POWER;
+        case TAG_AC_MODE_1:
+        case TAG_AC_MODE_2:
+            return AC_TAG_GROUP_MODE;
+        case TAG_AC_TEMP_1:
+        case TAG_AC_TEMP_2:
+            return AC_TAG_GROUP_TEMPERATURE;
+        case TAG_AC_SPEED_1:
+        case TAG_AC_SPEED_2:
+            return AC_TAG_GROUP_WIND_SPEED;
+        case TAG_AC_SWING_1:
+        case TAG_AC_SWING_2:
+        case TAG_AC_SWING_INFO:
+            return AC_TAG_GROUP_SWING;
+        case TAG_AC_FUNCTION_1:
+        case TAG_AC_FUNCTION_2:
+            return AC_TAG_GROUP_FUNCTION;
+        case TAG_AC_SOLO_FUNCTION:
+            return AC_TAG_GROUP_SOLO;
+        case TAG_AC_BAN_FUNCTION_IN_COOL_MODE:
+        case TAG_AC_BAN_FUNCTION_IN_HEAT_MODE:
+        case TAG_AC_BAN_FUNCTION_IN_AUTO_MODE:
+        case TAG_AC_BAN_FUNCTION_IN_FAN_MODE:
+        case TAG_AC_BAN_FUNCTION_IN_DRY_MODE:
+            return AC_TAG_GROUP_BAN;
+        case TAG_AC_CHECKSUM_TYPE:
+            return AC_TAG_GROUP_CHECKSUM;
+        default:
+            return AC_TAG_GROUP_FRAME;
+    }
+}
+
+static INT8 parse_tag(protocol *context, struct tag_head *tag)
+{
+    // then parse TAG 26 or 33
+    if (context->si.type == SWING_TYPE_NORMAL)
+    {
+        UINT16 swing_space_size = 0;
+        if (tag->tag == TAG_AC_SWING_1)
+        {
+            context->swing1.count = context->si.mode_count;
+            context->swing1.len = (UINT8) tag->len >> 1;
+            swing_space_size = sizeof(tag_comp) * context->si.mode_count;
+            context->swing1.comp_data = (tag_comp *) ir_malloc(swing_space_size);
+            if (NULL == context->swing1.comp_data)
+            {
+                return IR_DECODE_FAILED;
+            }
+
+            ir_memset(context->swing1.comp_data, 0x00, swing_space_size);
+            if (IR_DECODE_FAILED == parse_common_ac_parameter(tag,
+                                                              context->swing1.comp_data,
+                                                              context->si.mode_count,
+                                                              AC_PARAMETER_TYPE_1))
+            {
+                return IR_DECODE_FAILED;
+            }
+        }
+        else if (tag->tag == TAG_AC_SWING_2)
+        {
+            context->swing2.count = context->si.mode_count;
+            context->swing2.len = (UINT8) tag->len >> 1;
+            swing_space_size = sizeof(tag_comp) * context->si.mode_count;
+            context->swing2.comp_data = (tag_comp *) ir_malloc(swing_space_size);
+            if (NULL == context->swing2.comp_data)
+            {
+                return IR_DECODE_FAILED;
+            }
+            ir_memset(context->swing2.comp_data, 0x00, swing_space_size);
+            if (IR_DECODE_FAILED == parse_common_ac_parameter(tag,
+                                                              context->swing2.comp_data,
+                                                              context->si.mode_count,
+                                                              AC_PARAMETER_TYPE_2))
+            {
+                return IR_DECODE_FAILED;
+            }
+        }
+    }
+
+    if (tag->tag == TAG_AC_DEFAULT_CODE) // default code TAG
+    {
+        if (FALSE == tag->in_place)
+        {
+            context->default_code.data = (UINT8 *) ir_malloc(((size_t) tag->len - 2) >> 1);
+            if (NULL == context->default_code.data)
+            {
+                return IR_DECODE_FAILED;
+            }
+        }
+        if (IR_DECODE_FAILED == parse_default_code(tag, &(context->default_code)))
+        {
+            return IR_DECODE_FAILED;
+        }
+    }
+    else if (tag->tag == TAG_AC_POWER_1) // power tag
+    {
+        context->power1.len = (UINT8) tag->len >> 1;
+        if (IR_DECODE_FAILED == parse_common_ac_parameter(tag,
+                                                          context->power1.comp_data,
+                                                          AC_POWER_MAX,
+                                                          AC_PARAMETER_TYPE_1))
+        {
+            return IR_DECODE_FAILED;
+        }
+    }
+    else if (tag->tag == TAG_AC_TEMP_1) // temperature tag type 1
+    {
+        if (IR_DECODE_FAILED == parse_temp_1(tag, &(context->temp1)))
+        {
+            return IR_DECODE_FAILED;
+        }
+    }
+    else if (tag->tag == TAG_AC_MODE_1) // mode tag
+    {
+        context->mode1.len = (UINT8) tag->len >> 1;
+        if (IR_DECODE_FAILED == parse_common_ac_parameter(tag,
+                                                          context->mode1.comp_data,
+                                                          AC_MODE_MAX,
+                                                          AC_PARAMETER_TYPE_1))
+        {
+            return IR_DECODE_FAILED;
+        }
+    }
+    else if (tag->tag == TAG_AC_SPEED_1) // wind speed tag
+    {
+        context->speed1.len = (UINT8) tag->len >> 1;
+        if (IR_DECODE_FAILED == parse_common_ac_parameter(tag,
+                                                          context->speed1.comp_data,
+                                                          AC_WS_MAX,
+                                                          AC_PARAMETER_TYPE_1))
+        {
+            return IR_DECODE_FAILED;
+        }
+    }
+    else if (tag->tag == TAG_AC_CHECKSUM_TYPE)
+    {
+        if (IR_DECODE_FAILED == parse_checksum(tag, &(context->checksum)))
+        {
+            return IR_DECODE_FAILED;
+        }
+    }
+    else if (tag->tag == TAG_AC_MODE_2)
+    {
+        context->mode2.len = (UINT8) tag->len >> 1;
+        if (IR_DECODE_FAILED ==
+            parse_common_ac_parameter(tag,
+                                      context->mode2.comp_data, AC_MODE_MAX, AC_PARAMETER_TYPE_1))
+        {
+            return IR_DECODE_FAILED;
+        }
+    }
+    else if (tag->tag == TAG_AC_SPEED_2)
+    {
+        context->speed2.len = (UINT8) tag->len >> 1;
+        if (IR_DECODE_FAILED ==
+            parse_common_ac_parameter(tag,
+                                      context->speed2.comp_data, AC_WS_MAX, AC_PARAMETER_TYPE_1))
+        {
+            return IR_DECODE_FAILED;
+        }
+    }
+    else if (tag->tag == TAG_AC_TEMP_2)
+    {
+        if (IR_DECODE_FAILED == parse_temp_2(tag, &(context->temp2)))
+        {
+            return IR_DECODE_FAILED;
+        }
+    }
+    else if (tag->tag == TAG_AC_SOLO_FUNCTION)
+    {
+        if (IR_DECODE_FAILED == parse_solo_code(tag, &(context->sc)))
+        {
+            return IR_DECODE_FAILED;
+        }
+        context->solo_function_mark = 1;
+    }
+    else if (tag->tag == TAG_AC_FUNCTION_1)
+    {
+        if (IR_DECODE_FAILED == parse_function_1_tag29(tag, &(context->function1)))
+        {
+            ir_printf("\nfunction code parse error\n");
+            return IR_DECODE_FAILED;
+        }
+    }
+    else if (tag->tag == TAG_AC_FUNCTION_2)
+    {
+        if (IR_DECODE_FAILED == parse_function_2_tag34(tag, &(context->function2)))
+        {
+            return IR_DECODE_FAILED;
+        }
+    }
+    else if (tag->tag == TAG_AC_FRAME_LENGTH)
+    {
+        if (IR_DECODE_FAILED == parse_frame_len(context, tag, tag->len))
+        {
+            return IR_DECODE_FAILED;
+        }
+    }
+    else if (tag->tag == TAG_AC_ZERO)
+    {
+        if (IR_DECODE_FAILED == parse_zero(context, tag))
+        {
+            return IR_DECODE_FAILED;
+        }
+    }
+    else if (tag->tag == TAG_AC_ONE)
+    {
+        if (IR_DECODE_FAILED == parse_one(context, tag))
+        {
+            return IR_DECODE_FAILED;
+        }
+    }
+    else if (tag->tag == TAG_AC_BOOT_CODE)
+    {
+        if (IR_DECODE_FAILED == parse_boot_code(context, tag))
+        {
+            return IR_DECODE_FAILED;
+        }
+    }
+    else if (tag->tag == TAG_AC_REPEAT_TIMES)
+    {
+        if (IR_DECODE_FAILED == parse_repeat_times(context, tag))
+        {
+            return IR_DECODE_FAILED;
+        }
+    }
+    else if (tag->tag == TAG_AC_BITNUM)
+    {
+        if (IR_DECODE_FAILED == parse_bit_num(context, tag))
+        {
+            return IR_DECODE_FAILED;
+        }
+    }
+    else if (tag->tag == TAG_AC_ENDIAN)
+    {
+        if (IR_DECODE_FAILED == parse_endian(context, tag))
+        {
+            return IR_DECODE_FAILED;
+        }
+    }
+    else if (tag->tag == TAG_AC_BAN_FUNCTION_IN_COOL_MODE)
+    {
+        if (IR_DECODE_FAILED == parse_nmode(context, tag, N_COOL))
+        {
+            return IR_DECODE_FAILED;
+        }
+    }
+    else if (tag->tag == TAG_AC_BAN_FUNCTION_IN_HEAT_MODE)
+    {
+        if (IR_DECODE_FAILED == parse_nmode(context, tag, N_HEAT))
+        {
+            return IR_DECODE_FAILED;
+        }
+    }
+    else if (tag->tag == TAG_AC_BAN_FUNCTION_IN_AUTO_MODE)
+    {
+        if (IR_DECODE_FAILED == parse_nmode(context, tag, N_AUTO))
+        {
+            return IR_DECODE_FAILED;
+        }
+    }
+    else if (tag->tag == TAG_AC_BAN_FUNCTION_IN_FAN_MODE)
+    {
+        if (IR_DECODE_FAILED == parse_nmode(context, tag, N_FAN))
+        {
+            return IR_DECODE_FAILED;
+        }
+    }
+    else if (tag->tag == TAG_AC_BAN_FUNCTION_IN_DRY_MODE)
+    {
+        if (IR_DECODE_FAILED == parse_nmode(context, tag, N_DRY))
+        {
+            return IR_DECODE_FAILED;
+        }
+    }
+    else if (tag->tag == TAG_AC_DELAY_CODE)
+    {
+        if (IR_DECODE_FAILED == parse_delay_code(context, tag))
+        {
+            return IR_DECODE_FAILED;
+        }
+    }
+    else if (tag->tag == TAG_AC_LASTBIT)
+    {
+        if (IR_DECODE_FAILED == parse_lastbit(context, tag))
+        {
+            return IR_DECODE_FAILED;
+        }
+    }
+    return IR_DECODE_SUCCEEDED;
+}
+
+static void mark_solo_functions(protocol *context)
+{
+    UINT8 i = 0;
+
+    // pre-calculate solo function status after parse phase
+    if (1 == context->solo_function_mark)
+    {
+        context->solo_function_mark = 0x00;
+        // bit order from right to left : power, mode, temp+, temp-, wind_speed, swing, fix
+        for (i = AC_FUNCTION_POWER; i < AC_FUNCTION_MAX; i++)
+        {
+            if (isin(context->sc.solo_function_codes, i, context->sc.solo_func_count))
+            {
+                context->solo_function_mark |= (1 << (i - 1));
+            }
+        }
+    }
+}
+
+static void free_segment(protocol *context, UINT8 *segment)
+{
+    // segments decoded in place belong to the binary
+    if (NULL == context->in_place_data || segment < context->in_place_data ||
+        segment >= context->in_place_data + context->in_place_len)
+    {
+        ir_free(segment);
+    }
+}
@@ -0,0 +1,462 @@
+/**************************************************************************************
+Filename:       ir_ac_delta.c
+Revised:        Date: 2026-10-17
+Revision:       Revision: 1.0
+
+Description:    This file provides the incremental re-encoding of the AC working frame
+
+Revision log:
+* 2026-10-17: created by agent
+**************************************************************************************/
+
+#include <string.h>
+
+#include "../include/ir_ac_delta.h"
+#include "../include/ir_ac_apply.h"
+
+#define STEP_BIT(step)               ((UINT8) (1 << (step)))
+// the steps a patch could apply again
+#define PATCH_STEPS                  (STEP_BIT(AC_DELTA_WIND_SPEED) | STEP_BIT(AC_DELTA_SWING) | \
+                                      STEP_BIT(AC_DELTA_TEMPERATURE))
+
+static BOOL mark_steps(UINT8 *masks, UINT8 size, protocol *context);
+static BOOL mark_comp(UINT8 *mask, UINT8 size, tag_comp *comp, BOOL bitwise);
+static BOOL mark_checksum(UINT8 *mask, UINT8 size, protocol *context);
+static BOOL mark_bits(UINT8 *mask, UINT8 size, UINT pos, UINT8 bits);
+static UINT8 applied_steps(protocol *context);
+static void restore(ir_ac_delta_t *delta, protocol *context, UINT8 step);
+static void build_base(ir_ac_delta_t *delta, protocol *context, remote_ac_status_t *ac_status, UINT8 function_code);
+
+
+ir_ac_delta_t *ir_ac_delta_create(protocol *context)
+{
+    UINT8 size = context->default_code.len;
+    size_t mask_size = (size_t) AC_DELTA_MAX * size;
+    UINT8 *masks = (UINT8 *) ir_malloc(mask_size + 1);
+    ir_ac_delta_t *delta = NULL;
+    BOOL usable = FALSE;
+    UINT16 entries = 0;
+    UINT16 i = 0;
+    UINT8 step = 0;
+    UINT8 other = 0;
+    UINT8 *mask = NULL;
+
+    if (NULL == masks)
+    {
+        return NULL;
+    }
+    // a mask of a bit for every bit of the frame for every step, only the bytes written are kept
+    ir_memset(masks, 0x00, mask_size);
+    usable = mark_steps(masks, size, context);
+    for (i = 0; TRUE == usable && i < mask_size; i++)
+    {
+        if (0 != masks[i])
+        {
+            entries++;
+        }
+    }
+
+    delta = (ir_ac_delta_t *) ir_malloc(sizeof(ir_ac_delta_t) + (size_t) entries * 2 + size);
+    if (NULL == delta)
+    {
+        ir_free(masks);
+        return NULL;
+    }
+    ir_memset(delta, 0x00, sizeof(ir_ac_delta_t));
+    delta->positions = (UINT8 *) (delta + 1);
+    delta->bits = delta->positions + entries;
+    delta->base = delta->bits + entries;
+    delta->usable = usable;
+    delta->applied = applied_steps(context);
+
+    entries = 0;
+    for (step = 0; step < AC_DELTA_MAX; step++)
+    {
+        delta->first[step] = entries;
+        mask = masks + step * size;
+        for (i = 0; TRUE == usable && i < size; i++)
+        {
+            if (0 == mask[i])
+            {
+                continue;
+            }
+            delta->positions[entries] = (UINT8) i;
+            delta->bits[entries] = mask[i];
+            entries++;
+            for (other = AC_DELTA_WIND_SPEED; other <= AC_DELTA_TEMPERATURE; other++)
+            {
+                if (0 != (mask[i] & masks[other * size + i]))
+                {
+                    delta->overlaps[step] |= STEP_BIT(other);
+                }
+            }
+        }
+    }
+    delta->first[AC_DELTA_MAX] = entries;
+    ir_free(masks);
+    return delta;
+}
+
+void ir_ac_delta_destroy(ir_ac_delta_t *delta)
+{
+    if (NULL != delta)
+    {
+        ir_free(delta);
+    }
+}
+
+void ir_ac_delta_get_stats(ir_ac_delta_t *delta, ir_ac_delta_stats_t *stats)
+{
+    stats->patched = delta->patched;
+    stats->rebuilt = delta->rebuilt;
+    stats->overlapped = delta->overlapped;
+}
+
+/*
+ * the working frame is patched when power and mode are kept, as they decide which other steps apply,
+ * and the steps to apply again are the changed ones along with the step of the key pressed,
+ * since only that step could fail, and any step writing bits of those, their bits are restored
+ * from default code with power and mode applied, then the function code and checksum are applied
+ * over as a rebuild does
+ */
+BOOL ir_ac_delta_apply(ir_ac_delta_t *delta, protocol *context, remote_ac_status_t *ac_status,
+                       UINT8 function_code, INT8 *ret)
+{
+    UINT8 again = 0;
+    UINT8 reached = 0;
+    UINT8 added = 0;
+    UINT8 step = 0;
+    BOOL overlapped = FALSE;
+
+    if (FALSE == delta->usable || FALSE == delta->valid ||
+        AC_POWER_OFF == ac_status->acPower || ac_status->acPower != delta->status.acPower ||
+        ac_status->acMode != delta->status.acMode ||
+        function_code < AC_FUNCTION_POWER || function_code >= AC_FUNCTION_MAX ||
+        delta->function_code < AC_FUNCTION_POWER || delta->function_code >= AC_FUNCTION_MAX ||
+        TRUE == is_solo_function(context, function_code) ||
+        TRUE == is_solo_function(context, delta->function_code))
+    {
+        return FALSE;
+    }
+
+    if (ac_status->acWindSpeed != delta->status.acWindSpeed || AC_FUNCTION_WIND_SPEED == function_code)
+    {
+        again |= STEP_BIT(AC_DELTA_WIND_SPEED);
+    }
+    if (context->swing_status != delta->swing_status ||
+        AC_FUNCTION_WIND_SWING == function_code || AC_FUNCTION_WIND_FIX == function_code)
+    {
+        again |= STEP_BIT(AC_DELTA_SWING);
+    }
+    if (ac_status->acTemp != delta->status.acTemp ||
+        AC_FUNCTION_TEMPERATURE_UP == function_code || AC_FUNCTION_TEMPERATURE_DOWN == function_code)
+    {
+        again |= STEP_BIT(AC_DELTA_TEMPERATURE);
+    }
+    again &= delta->applied;
+
+    // a kept step writing restored bits is applied again too, which may overlap further steps
+    reached = (UINT8) (delta->overlaps[AC_DELTA_CHECKSUM] |
+                       delta->overlaps[AC_DELTA_FUNCTION + delta->function_code - 1] |
+                       delta->overlaps[AC_DELTA_FUNCTION + function_code - 1]);
+    added = again;
+    do
+    {
+        for (step = AC_DELTA_WIND_SPEED; step <= AC_DELTA_TEMPERATURE; step++)
+        {
+            if (0 != (added & STEP_BIT(step)))
+            {
+                reached |= delta->overlaps[step];
+            }
+        }
+        added = (UINT8) (reached & delta->applied & ~again);
+        if (0 != added)
+        {
+            again |= added;
+            overlapped = TRUE;
+        }
+    }
+    while (0 != added);
+    if (TRUE == overlapped && (delta->applied & PATCH_STEPS) == again)
+    {
+        // nothing is left to keep, a rebuild costs the same
+        delta->overlapped++;
+        return FALSE;
+    }
+
+    if (FALSE == delta->base_ready || ac_status->acMode != delta->base_mode)
+    {
+        build_base(delta, context, ac_status, function_code);
+    }
+    restore(delta, context, AC_DELTA_CHECKSUM);
+    restore(delta, context, (UINT8) (AC_DELTA_FUNCTION + delta->function_code - 1));
+    restore(delta, context, (UINT8) (AC_DELTA_FUNCTION + function_code - 1));
+    for (step = AC_DELTA_WIND_SPEED; step <= AC_DELTA_TEMPERATURE; step++)
+    {
+        if (0 != (again & STEP_BIT(step)))
+        {
+            restore(delta, context, step);
+        }
+    }
+    delta->patched++;
+    *ret = IR_DECODE_SUCCEEDED;
+    if ((0 != (again & STEP_BIT(AC_DELTA_WIND_SPEED)) &&
+         IR_DECODE_FAILED == apply_wind_speed(context, *ac_status, function_code)) ||
+        (0 != (again & STEP_BIT(AC_DELTA_SWING)) &&
+         IR_DECODE_FAILED == apply_swing(context, *ac_status, function_code)) ||
+        (0 != (again & STEP_BIT(AC_DELTA_TEMPERATURE)) &&
+         IR_DECODE_FAILED == apply_temperature(context, *ac_status, function_code)))
+    {
+        // the frame is left half built as a rebuild would leave it
+        delta->valid = FALSE;
+        *ret = IR_DECODE_FAILED;
+        return TRUE;
+    }
+    apply_function(context, function_code);
+    apply_checksum(context);
+
+    delta->status = *ac_status;
+    delta->function_code = function_code;
+    delta->swing_status = context->swing_status;
+    return TRUE;
+}
+
+void ir_ac_delta_record(ir_ac_delta_t *delta, protocol *context, remote_ac_status_t *ac_status,
+                        UINT8 function_code, INT8 ret)
+{
+    if (NULL == delta)
+    {
+        return;
+    }
+    delta->rebuilt++;
+    delta->valid = (IR_DECODE_SUCCEEDED == ret) ? TRUE : FALSE;
+    delta->status = *ac_status;
+    delta->function_code = function_code;
+    delta->swing_status = context->swing_status;
+}
+
+
+// every value a step could apply into the mask of the step, the values of type 2 segments are bit ranges
+static BOOL mark_steps(UINT8 *masks, UINT8 size, protocol *context)
+{
+    BOOL usable = TRUE;
+    UINT16 i = 0;
+
+    for (i = 0; 0 != context->power1.len && i < AC_POWER_MAX; i++)
+    {
+        usable &= mark_comp(masks + AC_DELTA_POWER * size, size, &context->power1.comp_data[i], FALSE);
+    }
+    for (i = 0; i < AC_MODE_MAX; i++)
+    {
+        if (0 != context->mode1.len)
+        {
+            usable &= mark_comp(masks + AC_DELTA_MODE * size, size, &context->mode1.comp_data[i], FALSE);
+        }
+        else if (0 != context->mode2.len)
+        {
+            usable &= mark_comp(masks + AC_DELTA_MODE * size, size, &context->mode2.comp_data[i], TRUE);
+        }
+    }
+    for (i = 0; i < AC_WS_MAX; i++)
+    {
+        if (0 != context->speed1.len)
+        {
+            usable &= mark_comp(masks + AC_DELTA_WIND_SPEED * size, size, &context->speed1.comp_data[i], FALSE);
+        }
+        else if (0 != context->speed2.len)
+        {
+            usable &= mark_comp(masks + AC_DELTA_WIND_SPEED * size, size, &context->speed2.comp_data[i], TRUE);
+        }
+    }
+    for (i = 0; i < AC_TEMP_MAX; i++)
+    {
+        if (0 != context->temp1.len)
+        {
+            usable &= mark_comp(masks + AC_DELTA_TEMPERATURE * size, size, &context->temp1.comp_data[i], FALSE);
+        }
+        else if (0 != context->temp2.len)
+        {
+            usable &= mark_comp(masks + AC_DELTA_TEMPERATURE * size, size, &context->temp2.comp_data[i], TRUE);
+        }
+    }
+    for (i = 0; 0 != context->swing1.len && i < context->swing1.count; i++)
+    {
+        usable &= mark_comp(masks + AC_DELTA_SWING * size, size, &context->swing1.comp_data[i], FALSE);
+    }
+    for (i = 0; 0 == context->swing1.len && 0 != context->swing2.len && i < context->swing2.count; i++)
+    {
+        usable &= mark_comp(masks + AC_DELTA_SWING * size, size, &context->swing2.comp_data[i], TRUE);
+    }
+    // function codes are kept apart, a key press only rewrites the bits of the previous and current one
+    for (i = 0; i < AC_FUNCTION_MAX - 1; i++)
+    {
+        if (0 != context->function1.len)
+        {
+            usable &= mark_comp(masks + (AC_DELTA_FUNCTION + i) * size, size,
+                                &context->function1.comp_data[i], FALSE);
+        }
+        else if (0 != context->function2.len)
+        {
+            usable &= mark_comp(masks + (AC_DELTA_FUNCTION + i) * size, size,
+                                &context->function2.comp_data[i], TRUE);
+        }
+    }
+    usable &= mark_checksum(masks + AC_DELTA_CHECKSUM * size, size, context);
+    return usable;
+}
+
+// type 1 segments set whole bytes, type 2 ones set the bits from start bit to end bit, the first bit the highest
+static BOOL mark_comp(UINT8 *mask, UINT8 size, tag_comp *comp, BOOL bitwise)
+{
+    UINT8 start_bit = 0;
+    UINT8 end_bit = 0;
+    UINT8 i = 0;
+    UINT bit = 0;
+
+    if (FALSE == bitwise)
+    {
+        for (i = 0; i + 1 < comp->seg_len; i += 2)
+        {
+            if (FALSE == mark_bits(mask, size, comp->segment[i], 0xFF))
+            {
+                return FALSE;
+            }
+        }
+        return TRUE;
+    }
+    for (i = 0; i + 2 < comp->seg_len; i += 3)
+    {
+        start_bit = comp->segment[i];
+        end_bit = comp->segment[i + 1];
+        if (start_bit >= end_bit)
+        {
+            // not a range of bits, what it writes is not told
+            return FALSE;
+        }
+        for (bit = start_bit; bit < end_bit; bit++)
+        {
+            if (FALSE == mark_bits(mask, size, bit >> 3, (UINT8) (0x80 >> (bit & 0x07))))
+            {
+                return FALSE;
+            }
+        }
+    }
+    return TRUE;
+}
+
+static BOOL mark_checksum(UINT8 *mask, UINT8 size, protocol *context)
+{
+    tag_checksum_data *cs = NULL;
+    BOOL usable = TRUE;
+    UINT16 i = 0;
+
+    for (i = 0; 0 != context->checksum.len && i < context->checksum.count; i++)
+    {
+        cs = &context->checksum.checksum_data[i];
+        switch (cs->type)
+        {
+            case CHECKSUM_TYPE_BYTE:
+            case CHECKSUM_TYPE_BYTE_INVERSE:
+            case CHECKSUM_TYPE_HALF_BYTE:
+            case CHECKSUM_TYPE_HALF_BYTE_INVERSE:
+                if (cs->len >= 3)
+                {
+                    usable &= mark_bits(mask, size, cs->checksum_byte_pos, 0xFF);
+                }
+                break;
+            case CHECKSUM_TYPE_SPEC_HALF_BYTE:
+            case CHECKSUM_TYPE_SPEC_HALF_BYTE_INVERSE:
+                // the position is of a half byte, the high one first
+                if (cs->len >= 4)
+                {
+                    usable &= mark_bits(mask, size, cs->checksum_byte_pos >> 1,
+                                        (UINT8) ((0 == (cs->checksum_byte_pos & 0x01)) ? 0xF0 : 0x0F));
+                }
+                break;
+            case CHECKSUM_TYPE_SPEC_HALF_BYTE_ONE_BYTE:
+            case CHECKSUM_TYPE_SPEC_HALF_BYTE_INVERSE_ONE_BYTE:
+                if (cs->len >= 4)
+                {
+                    usable &= mark_bits(mask, size, cs->checksum_byte_pos >> 1, 0xFF);
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    return usable;
+}
+
+static BOOL mark_bits(UINT8 *mask, UINT8 size, UINT pos, UINT8 bits)
+{
+    if (pos >= size)
+    {
+        // written out of the frame, it could not be told apart from the other steps
+        return FALSE;
+    }
+    mask[pos] |= bits;
+    return TRUE;
+}
+
+// the steps applied by a rebuild with power on and a function code not sent solo
+static UINT8 applied_steps(protocol *context)
+{
+    UINT8 applied = 0;
+
+    if (!is_solo_function(context, AC_FUNCTION_POWER))
+    {
+        applied |= STEP_BIT(AC_DELTA_POWER);
+    }
+    if (!is_solo_function(context, AC_FUNCTION_MODE))
+    {
+        applied |= STEP_BIT(AC_DELTA_MODE);
+    }
+    if (!is_solo_function(context, AC_FUNCTION_WIND_SPEED))
+    {
+        applied |= STEP_BIT(AC_DELTA_WIND_SPEED);
+    }
+    if (!is_solo_function(context, AC_FUNCTION_WIND_SWING) && !is_solo_function(context, AC_FUNCTION_WIND_FIX))
+    {
+        applied |= STEP_BIT(AC_DELTA_SWING);
+    }
+    if (!is_solo_function(context, AC_FUNCTION_TEMPERATURE_UP) &&
+        !is_solo_function(context, AC_FUNCTION_TEMPERATURE_DOWN))
+    {
+        applied |= STEP_BIT(AC_DELTA_TEMPERATURE);
+    }
+    return applied;
+}
+
+// the bits a step writes back to the ones of the base frame
+static void restore(ir_ac_delta_t *delta, protocol *context, UINT8 step)
+{
+    UINT8 *frame = context->ir_hex_code;
+    UINT8 pos = 0;
+    UINT16 i = 0;
+
+    for (i = delta->first[step]; i < delta->first[step + 1]; i++)
+    {
+        pos = delta->positions[i];
+        frame[pos] = (UINT8) ((frame[pos] & ~delta->bits[i]) | (delta->base[pos] & delta->bits[i]));
+    }
+}
+
+// default code with power on and mode applied, which every frame of the mode is built over
+static void build_base(ir_ac_delta_t *delta, protocol *context, remote_ac_status_t *ac_status, UINT8 function_code)
+{
+    UINT8 *working = context->ir_hex_code;
+
+    context->ir_hex_code = delta->base;
+    ir_memcpy(delta->base, context->default_code.data, context->default_code.len);
+    if (0 != (delta->applied & STEP_BIT(AC_DELTA_POWER)))
+    {
+        apply_power(context, *ac_status, function_code);
+    }
+    if (0 != (delta->applied & STEP_BIT(AC_DELTA_MODE)))
+    {
+        apply_mode(context, *ac_status, function_code);
+    }
+    context->ir_hex_code = working;
+    delta->base_mode = (UINT8) ac_status->acMode;
+    delta->base_ready = TRUE;
+}
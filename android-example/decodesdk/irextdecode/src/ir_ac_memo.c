@@ -0,0 +1,224 @@
+/**************************************************************************************
+Filename:       ir_ac_memo.c
+Revised:        Date: 2026-10-17
+Revision:       Revision: 1.0
+
+Description:    This file provides a cache of decoded AC frames keyed by AC status
+
+Revision log:
+* 2026-10-17: created by agent
+**************************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/ir_ac_memo.h"
+
+#define FNV_OFFSET_BASIS            0xCBF29CE484222325ULL
+#define FNV_PRIME                   0x00000100000001B3ULL
+
+static UINT64 key_hash(ir_ac_memo_key_t *key);
+static void lru_unlink(ir_ac_memo_t *memo, ir_ac_memo_entry_t *entry);
+static void lru_push_front(ir_ac_memo_t *memo, ir_ac_memo_entry_t *entry);
+static void evict_entry(ir_ac_memo_t *memo, ir_ac_memo_entry_t *entry);
+
+
+ir_ac_memo_t *ir_ac_memo_create(size_t memory_budget)
+{
+    ir_ac_memo_t *memo = (ir_ac_memo_t *) ir_malloc(sizeof(ir_ac_memo_t));
+
+    if (NULL == memo)
+    {
+        return NULL;
+    }
+    ir_memset(memo, 0x00, sizeof(ir_ac_memo_t));
+    memo->memory_budget = memory_budget;
+    return memo;
+}
+
+void ir_ac_memo_destroy(ir_ac_memo_t *memo)
+{
+    if (NULL == memo)
+    {
+        return;
+    }
+    while (NULL != memo->lru_tail)
+    {
+        evict_entry(memo, memo->lru_tail);
+    }
+    ir_free(memo);
+}
+
+void ir_ac_memo_get_stats(ir_ac_memo_t *memo, ir_ac_memo_stats_t *stats)
+{
+    stats->hits = memo->hits;
+    stats->misses = memo->misses;
+    stats->evictions = memo->evictions;
+    stats->entry_count = memo->entry_count;
+    stats->memory_used = memo->memory_used;
+    stats->memory_budget = memo->memory_budget;
+}
+
+BOOL ir_ac_memo_make_key(ir_ac_memo_key_t *key, remote_ac_status_t *ac_status, UINT8 function_code,
+                         BOOL change_wind_direction, protocol *context)
+{
+    // status values out of their ranges are not memoized
+    if ((UINT) ac_status->acPower >= AC_POWER_MAX || (UINT) ac_status->acTemp >= AC_TEMP_MAX ||
+        (UINT) ac_status->acMode >= AC_MODE_MAX || (UINT) ac_status->acWindDir >= AC_SWING_MAX ||
+        (UINT) ac_status->acWindSpeed >= AC_WS_MAX)
+    {
+        return FALSE;
+    }
+
+    key->power = (UINT8) ac_status->acPower;
+    key->temperature = (UINT8) ac_status->acTemp;
+    key->mode = (UINT8) ac_status->acMode;
+    key->wind_dir = (UINT8) ac_status->acWindDir;
+    key->wind_speed = (UINT8) ac_status->acWindSpeed;
+    key->display = ac_status->acDisplay;
+    key->sleep = ac_status->acSleep;
+    key->timer = ac_status->acTimer;
+    key->function_code = function_code;
+    key->change_wind_direction = (UINT8) (FALSE != change_wind_direction);
+    key->swing_status = context->swing_status;
+    key->dir_index = context->si.dir_index;
+    return TRUE;
+}
+
+ir_ac_memo_entry_t *ir_ac_memo_lookup(ir_ac_memo_t *memo, ir_ac_memo_key_t *key, UINT64 *hash)
+{
+    ir_ac_memo_entry_t *entry = NULL;
+
+    *hash = key_hash(key);
+    entry = memo->buckets[*hash % IR_AC_MEMO_BUCKETS];
+    while (NULL != entry)
+    {
+        if (entry->hash == *hash && 0 == memcmp(&entry->key, key, sizeof(ir_ac_memo_key_t)))
+        {
+            break;
+        }
+        entry = entry->hash_next;
+    }
+
+    if (NULL == entry)
+    {
+        memo->misses++;
+        return NULL;
+    }
+
+    memo->hits++;
+    lru_unlink(memo, entry);
+    lru_push_front(memo, entry);
+    return entry;
+}
+
+void ir_ac_memo_store(ir_ac_memo_t *memo, UINT64 hash, ir_ac_memo_key_t *key,
+                      UINT16 *timings, UINT16 length, protocol *context)
+{
+    ir_ac_memo_entry_t *entry = NULL;
+    size_t size = sizeof(ir_ac_memo_entry_t) + length * sizeof(UINT16);
+    UINT bucket = (UINT) (hash % IR_AC_MEMO_BUCKETS);
+
+    if (size > memo->memory_budget)
+    {
+        return;
+    }
+    while (memo->memory_used + size > memo->memory_budget)
+    {
+        evict_entry(memo, memo->lru_tail);
+        memo->evictions++;
+    }
+
+    entry = (ir_ac_memo_entry_t *) ir_malloc(size);
+    if (NULL == entry)
+    {
+        return;
+    }
+    ir_memset(entry, 0x00, sizeof(ir_ac_memo_entry_t));
+    entry->hash = hash;
+    ir_memcpy(&entry->key, key, sizeof(ir_ac_memo_key_t));
+    entry->swing_status = context->swing_status;
+    entry->dir_index = context->si.dir_index;
+    entry->length = length;
+    entry->size = size;
+    entry->timings = (UINT16 *) (entry + 1);
+    ir_memcpy(entry->timings, timings, length * sizeof(UINT16));
+
+    entry->hash_next = memo->buckets[bucket];
+    memo->buckets[bucket] = entry;
+    lru_push_front(memo, entry);
+    memo->entry_count++;
+    memo->memory_used += size;
+}
+
+
+static UINT64 key_hash(ir_ac_memo_key_t *key)
+{
+    // FNV-1a over the key bytes
+    UINT64 hash = FNV_OFFSET_BASIS;
+    UINT8 *p = (UINT8 *) key;
+    UINT8 i = 0;
+
+    for (i = 0; i < sizeof(ir_ac_memo_key_t); i++)
+    {
+        hash ^= p[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+static void lru_unlink(ir_ac_memo_t *memo, ir_ac_memo_entry_t *entry)
+{
+    if (NULL != entry->lru_prev)
+    {
+        entry->lru_prev->lru_next = entry->lru_next;
+    }
+    else
+    {
+        memo->lru_head = entry->lru_next;
+    }
+    if (NULL != entry->lru_next)
+    {
+        entry->lru_next->lru_prev = entry->lru_prev;
+    }
+    else
+    {
+        memo->lru_tail = entry->lru_prev;
+    }
+    entry->lru_prev = NULL;
+    entry->lru_next = NULL;
+}
+
+static void lru_push_front(ir_ac_memo_t *memo, ir_ac_memo_entry_t *entry)
+{
+    entry->lru_prev = NULL;
+    entry->lru_next = memo->lru_head;
+    if (NULL != memo->lru_head)
+    {
+        memo->lru_head->lru_prev = entry;
+    }
+    memo->lru_head = entry;
+    if (NULL == memo->lru_tail)
+    {
+        memo->lru_tail = entry;
+    }
+}
+
+static void evict_entry(ir_ac_memo_t *memo, ir_ac_memo_entry_t *entry)
+{
+    ir_ac_memo_entry_t **link = &memo->buckets[entry->hash % IR_AC_MEMO_BUCKETS];
+
+    while (NULL != *link && *link != entry)
+    {
+        link = &(*link)->hash_next;
+    }
+    if (NULL != *link)
+    {
+        *link = entry->hash_next;
+    }
+    lru_unlink(memo, entry);
+
+    memo->entry_count--;
+    memo->memory_used -= entry->size;
+    ir_free(entry);
+}
@@ -14,130 +14,95 @@ Revision log:
 #include <string.h>
 
 #include "../include/ir_decode.h"
+#include "../include/ir_scan.h"
 #include "../include/ir_ac_parse_forbidden_info.h"
 
+static void parse_nmode_data_speed(protocol *context, ir_scan_t *data, ac_n_mode seq);
+static void parse_nmode_data_temp(protocol *context, ir_scan_t *data, ac_n_mode seq);
+static void parse_nmode_pos(protocol *context, ir_scan_t *record, ac_n_mode index);
 
-extern protocol *context;
 
-
-INT8 parse_nmode_data_speed(char *pdata, ac_n_mode seq)
+INT8 parse_nmode(protocol *context, struct tag_head *tag, ac_n_mode index)
 {
-    char buf[16] = {0};
-    char *p = pdata;
-    UINT16 pos = 0;
-    UINT16 cnt = 0, index = 0;
+    ir_scan_t scan;
+    ir_scan_t record;
 
-    while (index <= ir_strlen(pdata))
+    if (tag->pdata[0] == 'N' && tag->pdata[1] == 'A')
     {
-        while ((index != ir_strlen(pdata)) && (*(p++) != ','))
-        {
-            index++;
-        }
-        ir_memcpy(buf, pdata + pos, index - pos);
-        pos = (UINT16) (index + 1);
-        index = pos;
-        context->n_mode[seq].speed[cnt++] = (UINT8) atoi(buf);
-        context->n_mode[seq].speed_cnt = (UINT8) cnt;
-        ir_memset(buf, 0, 16);
+        // ban this function directly
+        context->n_mode[index].enable = 0;
+        return IR_DECODE_SUCCEEDED;
+    }
+    else
+    {
+        context->n_mode[index].enable = 1;
     }
 
+    ir_scan_init(&scan, tag->pdata, tag->len);
+    while (TRUE == ir_scan_field(&scan, '|', &record))
+    {
+        parse_nmode_pos(context, &record, index);
+    }
     return IR_DECODE_SUCCEEDED;
 }
 
-INT8 parse_nmode_data_temp(char *pdata, ac_n_mode seq)
-{
 
-    char buf[16] = {0};
-    char *p = pdata;
-    UINT16 pos = 0;
-    UINT16 cnt = 0, index = 0;
+static void parse_nmode_data_speed(protocol *context, ir_scan_t *data, ac_n_mode seq)
+{
+    ir_scan_t field;
+    UINT16 cnt = 0;
 
-    while (index <= ir_strlen(pdata))
+    while (TRUE == ir_scan_field(data, ',', &field))
     {
-        while ((index != ir_strlen(pdata)) && (*(p++) != ','))
+        if (cnt < AC_WS_MAX)
         {
-            index++;
+            context->n_mode[seq].speed[cnt++] = (UINT8) ir_scan_int(&field);
         }
-        ir_memcpy(buf, pdata + pos, index - pos);
-        pos = (UINT16) (index + 1);
-        index = pos;
-        context->n_mode[seq].temp[cnt++] = (UINT8) (atoi(buf) - 16);
-        context->n_mode[seq].temp_cnt = (UINT8) cnt;
-        ir_memset(buf, 0, 16);
     }
-    return IR_DECODE_SUCCEEDED;
+    context->n_mode[seq].speed_cnt = (UINT8) cnt;
 }
 
-INT8 parse_nmode_pos(char *buf, ac_n_mode index)
+static void parse_nmode_data_temp(protocol *context, ir_scan_t *data, ac_n_mode seq)
 {
-    UINT16 i = 0;
-    char data[64] = {0};
-    // char start[8] = {0};
-    if (ir_strlen(buf) == 1)
-    {
-        if (buf[0] == 'S' || buf[0] == 's')
-        {
-            context->n_mode[index].allspeed = 1;
-        }
-        else if (buf[0] == 'T' || buf[0] == 't')
-        {
-            context->n_mode[index].alltemp = 1;
-        }
-        return IR_DECODE_SUCCEEDED;
-    }
+    ir_scan_t field;
+    UINT16 cnt = 0;
 
-    for (i = 0; i < ir_strlen(buf); i++)
+    while (TRUE == ir_scan_field(data, ',', &field))
     {
-        if (buf[i] == '&')
+        if (cnt < AC_TEMP_MAX)
         {
-            ir_memcpy(data, buf + i + 1, ir_strlen(buf) - i - 1);
-            break;
+            context->n_mode[seq].temp[cnt++] = (UINT8) (ir_scan_int(&field) - 16);
         }
     }
-    if (buf[0] == 'S')
-    {
-        parse_nmode_data_speed(data, index);
-    }
-    else
-    {
-        parse_nmode_data_temp(data, index);
-    }
-
-    return IR_DECODE_SUCCEEDED;
+    context->n_mode[seq].temp_cnt = (UINT8) cnt;
 }
 
-INT8 parse_nmode(struct tag_head *tag, ac_n_mode index)
+static void parse_nmode_pos(protocol *context, ir_scan_t *record, ac_n_mode index)
 {
-    UINT16 i = 0;
-    UINT16 preindex = 0;
-
-    char buf[64] = {0};
+    ir_scan_t key;
+    ir_scan_t data;
 
-    if (tag->pdata[0] == 'N' && tag->pdata[1] == 'A')
+    if (1 == ir_scan_length(record))
     {
-        // ban this function directly
-        context->n_mode[index].enable = 0;
-        return IR_DECODE_SUCCEEDED;
+        if (record->cursor[0] == 'S' || record->cursor[0] == 's')
+        {
+            context->n_mode[index].allspeed = 1;
+        }
+        else if (record->cursor[0] == 'T' || record->cursor[0] == 't')
+        {
+            context->n_mode[index].alltemp = 1;
+        }
+        return;
     }
-    else
+
+    // S&speed,speed,... or T&temperature,temperature,...
+    ir_scan_pair(record, '&', &key, &data);
+    if (0 != ir_scan_length(record) && record->cursor[0] == 'S')
     {
-        context->n_mode[index].enable = 1;
+        parse_nmode_data_speed(context, &data, index);
     }
-
-    preindex = 0;
-    for (i = 0; i < tag->len; i++)
+    else
     {
-        if (tag->pdata[i] == '|')
-        {
-            ir_memcpy(buf, tag->pdata + preindex, i - preindex);
-            preindex = (UINT16) (i + 1);
-            parse_nmode_pos(buf, index);
-            ir_memset(buf, 0, 64);
-        }
-
+        parse_nmode_data_temp(context, &data, index);
     }
-    ir_memcpy(buf, tag->pdata + preindex, i - preindex);
-    parse_nmode_pos(buf, index);
-    ir_memset(buf, 0, 64);
-    return IR_DECODE_SUCCEEDED;
 }
@@ -14,316 +14,225 @@ Revision log:
 #include <string.h>
 
 #include "../include/ir_utils.h"
+#include "../include/ir_scan.h"
 #include "../include/ir_ac_parse_frame_info.h"
 
+#define BOOT_CODE_MAX (sizeof(((ac_bootcode *) 0)->data) / sizeof(UINT16))
+#define DELAY_TIME_MAX (sizeof(((ac_delaycode *) 0)->time) / sizeof(UINT16))
 
-INT8 parse_boot_code(struct tag_head *tag)
-{
-    UINT8 buf[16] = {0};
-    UINT8 *p = NULL;
-    UINT16 pos = 0;
-    UINT16 cnt = 0, index = 0;
+static INT8 parse_level(ac_level *level, struct tag_head *tag);
+static INT8 parse_delay_code_pos(protocol *context, ir_scan_t *record);
+static INT8 parse_delay_code_tag48_pos(protocol *context, ir_scan_t *record);
+static INT8 parse_tag_int(struct tag_head *tag, INT *value);
 
-    if (NULL == tag)
-    {
-        return IR_DECODE_FAILED;
-    }
-    p = tag->pdata;
 
-    if (NULL == p)
+INT8 parse_boot_code(protocol *context, struct tag_head *tag)
+{
+    ir_scan_t scan;
+    ir_scan_t field;
+    UINT16 cnt = 0;
+
+    if (NULL == tag || NULL == tag->pdata)
     {
         return IR_DECODE_FAILED;
     }
 
-    while (index <= tag->len)
+    ir_scan_init(&scan, tag->pdata, tag->len);
+    while (TRUE == ir_scan_field(&scan, ',', &field))
     {
-        while ((index != (tag->len)) && (*(p++) != ','))
+        if (cnt < BOOT_CODE_MAX)
         {
-            index++;
+            context->bootcode.data[cnt++] = (UINT16) ir_scan_int(&field);
         }
-        ir_memcpy(buf, tag->pdata + pos, index - pos);
-        pos = (UINT16) (index + 1);
-        index = pos;
-        context->bootcode.data[cnt++] = (UINT16) (atoi((char *) buf));
-        ir_memset(buf, 0, 16);
     }
     context->bootcode.len = cnt;
     return IR_DECODE_SUCCEEDED;
 }
 
-INT8 parse_zero(struct tag_head *tag)
+INT8 parse_zero(protocol *context, struct tag_head *tag)
 {
-    UINT8 low[16] = {0};
-    UINT8 high[16] = {0};
-    UINT16 index = 0;
-    UINT8 *p = NULL;
+    return parse_level(&context->zero, tag);
+}
 
-    if (NULL == tag)
-    {
-        return IR_DECODE_FAILED;
-    }
-    p = tag->pdata;
+INT8 parse_one(protocol *context, struct tag_head *tag)
+{
+    return parse_level(&context->one, tag);
+}
+
+INT8 parse_delay_code(protocol *context, struct tag_head *tag)
+{
+    ir_scan_t scan;
+    ir_scan_t record;
 
-    if (NULL == p)
+    if (NULL == tag)
     {
         return IR_DECODE_FAILED;
     }
 
-    while (*(p++) != ',')
+    ir_scan_init(&scan, tag->pdata, tag->len);
+    while (TRUE == ir_scan_field(&scan, '|', &record))
     {
-        index++;
+        parse_delay_code_pos(context, &record);
     }
 
-    ir_memcpy(low, tag->pdata, index);
-    ir_memcpy(high, tag->pdata + index + 1, (size_t) (tag->len - index - 1));
-
-    context->zero.low = (UINT16) (atoi((char *) low));
-    context->zero.high = (UINT16) (atoi((char *) high));
     return IR_DECODE_SUCCEEDED;
 }
 
-INT8 parse_one(struct tag_head *tag)
+INT8 parse_frame_len(protocol *context, struct tag_head *tag, UINT16 len)
 {
-    UINT8 low[16] = {0};
-    UINT8 high[16] = {0};
-    UINT16 index = 0;
-    UINT8 *p = NULL;
+    ir_scan_t scan;
 
     if (NULL == tag)
     {
         return IR_DECODE_FAILED;
     }
-    p = tag->pdata;
-
-    if (NULL == p)
-    {
-        return IR_DECODE_FAILED;
-    }
-
-    while (*(p++) != ',')
-    {
-        index++;
-    }
-    ir_memcpy(low, tag->pdata, index);
-    ir_memcpy(high, tag->pdata + index + 1, (size_t) (tag->len - index - 1));
-
-    context->one.low = (UINT16) (atoi((char *) low));
-    context->one.high = (UINT16) (atoi((char *) high));
 
+    ir_scan_init(&scan, tag->pdata, len);
+    context->frame_length = (UINT16) ir_scan_int(&scan);
     return IR_DECODE_SUCCEEDED;
 }
 
-INT8 parse_delay_code_data(UINT8 *pdata)
+INT8 parse_endian(protocol *context, struct tag_head *tag)
 {
-    UINT8 buf[16] = {0};
-    UINT8 *p = NULL;
-    UINT16 pos = 0;
-    UINT16 cnt = 0, index = 0;
+    INT value = 0;
 
-    if (NULL == pdata)
+    if (IR_DECODE_FAILED == parse_tag_int(tag, &value))
     {
         return IR_DECODE_FAILED;
     }
-    p = pdata;
-
-    while (index <= ir_strlen((char *) pdata))
-    {
-        while ((index != ir_strlen((char *) pdata)) && (*(p++) != ','))
-        {
-            index++;
-        }
-        ir_memcpy(buf, pdata + pos, index - pos);
-        pos = (UINT16) (index + 1);
-        index = pos;
-        context->dc[context->dc_cnt].time[cnt++] = (UINT16) (atoi((char *) buf));
-        context->dc[context->dc_cnt].time_cnt = cnt;
-        ir_memset(buf, 0, 16);
-    }
-
+    context->endian = (UINT8) value;
     return IR_DECODE_SUCCEEDED;
 }
 
-INT8 parse_delay_code_pos(UINT8 *buf)
+INT8 parse_lastbit(protocol *context, struct tag_head *tag)
 {
-    UINT16 i = 0;
-    UINT8 data[64] = {0}, start[8] = {0};
+    INT value = 0;
 
-    if (NULL == buf)
+    if (IR_DECODE_FAILED == parse_tag_int(tag, &value))
     {
         return IR_DECODE_FAILED;
     }
-
-    for (i = 0; i < ir_strlen((char *) buf); i++)
-    {
-        if (buf[i] == '&')
-        {
-            ir_memcpy(start, buf, i);
-            ir_memcpy(data, buf + i + 1, ir_strlen((char *) buf) - i - 1);
-            break;
-        }
-    }
-    parse_delay_code_data(data);
-    context->dc[context->dc_cnt].pos = (UINT16) (atoi((char *) start));
-
-    context->dc_cnt++;
+    context->lastbit = (UINT8) value;
     return IR_DECODE_SUCCEEDED;
 }
 
-INT8 parse_delay_code(struct tag_head *tag)
+INT8 parse_repeat_times(protocol *context, struct tag_head *tag)
 {
-    UINT8 buf[64] = {0};
-    UINT16 i = 0;
-    UINT16 preindex = 0;
-    preindex = 0;
+    INT value = 0;
 
-    if (NULL == tag)
+    if (IR_DECODE_FAILED == parse_tag_int(tag, &value))
     {
         return IR_DECODE_FAILED;
     }
-
-    for (i = 0; i < tag->len; i++)
-    {
-        if (tag->pdata[i] == '|')
-        {
-            ir_memcpy(buf, tag->pdata + preindex, i - preindex);
-            preindex = (UINT16) (i + 1);
-            parse_delay_code_pos(buf);
-            ir_memset(buf, 0, 64);
-        }
-
-    }
-    ir_memcpy(buf, tag->pdata + preindex, i - preindex);
-    parse_delay_code_pos(buf);
-    ir_memset(buf, 0, 64);
-
+    context->repeat_times = (UINT16) value;
     return IR_DECODE_SUCCEEDED;
 }
 
-INT8 parse_frame_len(struct tag_head *tag, UINT16 len)
+INT8 parse_bit_num(protocol *context, struct tag_head *tag)
 {
-    UINT8 *temp = NULL;
+    ir_scan_t scan;
+    ir_scan_t record;
+    UINT16 i = 0;
 
     if (NULL == tag)
     {
         return IR_DECODE_FAILED;
     }
 
-    temp = (UINT8 *) ir_malloc(len + 1);
-
-    if (NULL == temp)
+    ir_scan_init(&scan, tag->pdata, tag->len);
+    while (TRUE == ir_scan_field(&scan, '|', &record))
     {
-        return IR_DECODE_FAILED;
+        parse_delay_code_tag48_pos(context, &record);
     }
 
-    ir_memset(temp, 0x00, len + 1);
-
-    ir_memcpy(temp, tag->pdata, len);
-    temp[len] = '\0';
-
-    context->frame_length = (UINT16) (atoi((char *) temp));
-
-    ir_free(temp);
-    return IR_DECODE_SUCCEEDED;
-}
-
-INT8 parse_endian(struct tag_head *tag)
-{
-    UINT8 buf[8] = {0};
-
-    if (NULL == tag)
+    for (i = 0; i < context->bitnum_cnt; i++)
     {
-        return IR_DECODE_FAILED;
+        if (context->bitnum[i].pos == -1)
+            context->bitnum[i].pos = (UINT16) (context->default_code.len - 1); //convert -1 to last data pos
     }
-    ir_memcpy(buf, tag->pdata, tag->len);
-    context->endian = (UINT8) (atoi((char *) buf));
     return IR_DECODE_SUCCEEDED;
 }
 
-INT8 parse_lastbit(struct tag_head *tag)
+
+static INT8 parse_level(ac_level *level, struct tag_head *tag)
 {
-    UINT8 buf[8] = {0};
+    ir_scan_t scan;
+    ir_scan_t low;
+    ir_scan_t high;
 
-    if (NULL == tag)
+    if (NULL == tag || NULL == tag->pdata)
     {
         return IR_DECODE_FAILED;
     }
-    ir_memcpy(buf, tag->pdata, tag->len);
-    context->lastbit = (UINT8) (atoi((char *) buf));
-    return IR_DECODE_SUCCEEDED;
-}
 
-INT8 parse_repeat_times(struct tag_head *tag)
-{
-    char asc_code[8] = {0};
-    if (NULL == tag)
+    // low,high
+    ir_scan_init(&scan, tag->pdata, tag->len);
+    if (FALSE == ir_scan_pair(&scan, ',', &low, &high))
     {
         return IR_DECODE_FAILED;
     }
-
-    ir_memcpy(asc_code, tag->pdata, tag->len);
-
-    context->repeat_times = (UINT16) (atoi((char *) asc_code));
-
+    level->low = (UINT16) ir_scan_int(&low);
+    level->high = (UINT16) ir_scan_int(&high);
     return IR_DECODE_SUCCEEDED;
 }
 
-INT8 parse_delay_code_tag48_pos(UINT8 *buf)
+static INT8 parse_delay_code_pos(protocol *context, ir_scan_t *record)
 {
-    UINT16 i = 0;
-    UINT8 data[64] = {0}, start[8] = {0};
+    ir_scan_t start;
+    ir_scan_t data;
+    ir_scan_t field;
+    ac_delaycode *dc = NULL;
+    UINT16 cnt = 0;
 
-    if (NULL == buf)
+    if (context->dc_cnt >= MAX_DELAYCODE_NUM)
     {
         return IR_DECODE_FAILED;
     }
+    dc = &context->dc[context->dc_cnt];
 
-    for (i = 0; i < ir_strlen((char *) buf); i++)
+    // pos&time,time,...
+    ir_scan_pair(record, '&', &start, &data);
+    while (TRUE == ir_scan_field(&data, ',', &field))
     {
-        if (buf[i] == '&')
+        if (cnt < DELAY_TIME_MAX)
         {
-            ir_memcpy(start, buf, i);
-            ir_memcpy(data, buf + i + 1, ir_strlen((char *) buf) - i - 1);
-            break;
+            dc->time[cnt++] = (UINT16) ir_scan_int(&field);
         }
     }
+    dc->time_cnt = cnt;
+    dc->pos = (INT16) ir_scan_int(&start);
 
-    context->bitnum[context->bitnum_cnt].pos = (UINT16) (atoi((char *) start));
-    context->bitnum[context->bitnum_cnt].bits = (UINT16) (atoi((char *) data));
-    context->bitnum_cnt++;
+    context->dc_cnt++;
     return IR_DECODE_SUCCEEDED;
 }
 
-INT8 parse_bit_num(struct tag_head *tag)
+static INT8 parse_delay_code_tag48_pos(protocol *context, ir_scan_t *record)
 {
-    UINT16 i = 0;
-    UINT16 preindex = 0;
-    UINT8 buf[64] = {0};
+    ir_scan_t start;
+    ir_scan_t data;
 
-    if (NULL == tag)
+    if (context->bitnum_cnt >= MAX_BITNUM)
     {
         return IR_DECODE_FAILED;
     }
 
-    preindex = 0;
-    for (i = 0; i < tag->len; i++)
-    {
-        if (tag->pdata[i] == '|')
-        {
-            ir_memcpy(buf, tag->pdata + preindex, i - preindex);
-            preindex = (UINT16) (i + 1);
-            parse_delay_code_tag48_pos(buf);
-            ir_memset(buf, 0, 64);
-        }
+    // pos&bits
+    ir_scan_pair(record, '&', &start, &data);
+    context->bitnum[context->bitnum_cnt].pos = (INT16) ir_scan_int(&start);
+    context->bitnum[context->bitnum_cnt].bits = (UINT16) ir_scan_int(&data);
+    context->bitnum_cnt++;
+    return IR_DECODE_SUCCEEDED;
+}
 
-    }
-    ir_memcpy(buf, tag->pdata + preindex, i - preindex);
-    parse_delay_code_tag48_pos(buf);
-    ir_memset(buf, 0, 64);
+static INT8 parse_tag_int(struct tag_head *tag, INT *value)
+{
+    ir_scan_t scan;
 
-    for (i = 0; i < context->bitnum_cnt; i++)
+    if (NULL == tag)
     {
-        if (context->bitnum[i].pos == -1)
-            context->bitnum[i].pos = (UINT16) (context->default_code.len - 1); //convert -1 to last data pos
+        return IR_DECODE_FAILED;
     }
+    ir_scan_init(&scan, tag->pdata, tag->len);
+    *value = ir_scan_int(&scan);
     return IR_DECODE_SUCCEEDED;
 }
@@ -16,8 +16,11 @@ Revision log:
 #include "../include/ir_utils.h"
 #include "../include/ir_ac_parse_parameter.h"
 
+static UINT8 *hex_decode(UINT8 *text, UINT16 hex_len, UINT8 in_place);
+static void hex_release(UINT8 *hex_data, UINT8 in_place);
 
-INT8 parse_comp_data_type_1(UINT8 *data, UINT16 *trav_offset, tag_comp *comp)
+
+INT8 parse_comp_data_type_1(UINT8 *data, UINT16 *trav_offset, tag_comp *comp, UINT8 in_place)
 {
     UINT8 seg_len = data[*trav_offset];
     (*trav_offset)++;
@@ -31,6 +34,12 @@ INT8 parse_comp_data_type_1(UINT8 *data, UINT16 *trav_offset, tag_comp *comp)
     }
 
     comp->seg_len = seg_len;
+    if (TRUE == in_place)
+    {
+        comp->segment = &data[*trav_offset];
+        *trav_offset += seg_len;
+        return IR_DECODE_SUCCEEDED;
+    }
     comp->segment = (UINT8 *) ir_malloc(seg_len);
     if (NULL == comp->segment)
     {
@@ -43,7 +52,7 @@ INT8 parse_comp_data_type_1(UINT8 *data, UINT16 *trav_offset, tag_comp *comp)
     return IR_DECODE_SUCCEEDED;
 }
 
-INT8 parse_comp_data_type_2(UINT8 *data, UINT16 *trav_offset, tag_comp *comp)
+INT8 parse_comp_data_type_2(UINT8 *data, UINT16 *trav_offset, tag_comp *comp, UINT8 in_place)
 {
     UINT8 seg_len = data[*trav_offset];
     (*trav_offset)++;
@@ -57,6 +66,12 @@ INT8 parse_comp_data_type_2(UINT8 *data, UINT16 *trav_offset, tag_comp *comp)
     }
 
     comp->seg_len = seg_len;
+    if (TRUE == in_place)
+    {
+        comp->segment = &data[*trav_offset];
+        *trav_offset += seg_len;
+        return IR_DECODE_SUCCEEDED;
+    }
     comp->segment = (UINT8 *) ir_malloc(seg_len);
     if (NULL == comp->segment)
     {
@@ -87,14 +102,12 @@ INT8 parse_common_ac_parameter(t_tag_head *tag, tag_comp *comp_data, UINT8 with_
     }
 
     hex_len = tag->len >> 1;
-    hex_data = (UINT8 *) ir_malloc(hex_len);
+    hex_data = hex_decode(tag->pdata, hex_len, tag->in_place);
     if (NULL == hex_data)
     {
         return IR_DECODE_FAILED;
     }
 
-    string_to_hex_common(tag->pdata, hex_data, hex_len);
-
     // parse hex data to AC data structure
     //*comp_len = hex_len;
 
@@ -102,9 +115,10 @@ INT8 parse_common_ac_parameter(t_tag_head *tag, tag_comp *comp_data, UINT8 with_
     {
         for (seg_index = 0; seg_index < with_end; seg_index++)
         {
-            if (IR_DECODE_FAILED == parse_comp_data_type_1(hex_data, &trav_offset, &comp_data[seg_index]))
+            if (IR_DECODE_FAILED == parse_comp_data_type_1(hex_data, &trav_offset,
+                                                           &comp_data[seg_index], tag->in_place))
             {
-                ir_free(hex_data);
+                hex_release(hex_data, tag->in_place);
                 return IR_DECODE_FAILED;
             }
 
@@ -118,9 +132,10 @@ INT8 parse_common_ac_parameter(t_tag_head *tag, tag_comp *comp_data, UINT8 with_
     {
         for (seg_index = 0; seg_index < with_end; seg_index++)
         {
-            if (IR_DECODE_FAILED == parse_comp_data_type_2(hex_data, &trav_offset, &comp_data[seg_index]))
+            if (IR_DECODE_FAILED == parse_comp_data_type_2(hex_data, &trav_offset,
+                                                           &comp_data[seg_index], tag->in_place))
             {
-                ir_free(hex_data);
+                hex_release(hex_data, tag->in_place);
                 return IR_DECODE_FAILED;
             }
 
@@ -131,7 +146,7 @@ INT8 parse_common_ac_parameter(t_tag_head *tag, tag_comp *comp_data, UINT8 with_
         }
     }
 
-    ir_free(hex_data);
+    hex_release(hex_data, tag->in_place);
 
     return IR_DECODE_SUCCEEDED;
 }
@@ -146,6 +161,13 @@ INT8 parse_default_code(struct tag_head *tag, ac_hex *default_code)
     }
 
     byteLen = tag->len >> 1;
+    if (TRUE == tag->in_place)
+    {
+        string_to_hex_common(tag->pdata, tag->pdata, byteLen);
+        default_code->len = tag->pdata[0];
+        default_code->data = tag->pdata + 1;
+        return IR_DECODE_SUCCEEDED;
+    }
     string_to_hex(tag->pdata, default_code, byteLen);
 
     return IR_DECODE_SUCCEEDED;
@@ -169,23 +191,22 @@ INT8 parse_power_1(struct tag_head *tag, power_1 *power1)
     }
 
     hex_len = tag->len >> 1;
-    hex_data = (UINT8 *) ir_malloc(hex_len);
+    hex_data = hex_decode(tag->pdata, hex_len, tag->in_place);
 
     if (NULL == hex_data)
     {
         return IR_DECODE_FAILED;
     }
 
-    string_to_hex_common(tag->pdata, hex_data, hex_len);
-
     // parse hex data to power1 data structure
     power1->len = (UINT8) hex_len;
 
     for (seg_index = AC_POWER_ON; seg_index < AC_POWER_MAX; seg_index++)
     {
-        if (IR_DECODE_FAILED == parse_comp_data_type_1(hex_data, &trav_offset, &power1->comp_data[seg_index]))
+        if (IR_DECODE_FAILED == parse_comp_data_type_1(hex_data, &trav_offset,
+                                                       &power1->comp_data[seg_index], tag->in_place))
         {
-            ir_free(hex_data);
+            hex_release(hex_data, tag->in_place);
             return IR_DECODE_FAILED;
         }
 
@@ -196,7 +217,7 @@ INT8 parse_power_1(struct tag_head *tag, power_1 *power1)
         }
     }
 
-    ir_free(hex_data);
+    hex_release(hex_data, tag->in_place);
 
     return IR_DECODE_SUCCEEDED;
 }
@@ -215,15 +236,13 @@ INT8 parse_temp_1(struct tag_head *tag, temp_1 *temp1)
     }
 
     hex_len = tag->len >> 1;
-    hex_data = (UINT8 *) ir_malloc(hex_len);
+    hex_data = hex_decode(tag->pdata, hex_len, tag->in_place);
 
     if (NULL == hex_data)
     {
         return IR_DECODE_FAILED;
     }
 
-    string_to_hex_common(tag->pdata, hex_data, hex_len);
-
     // parse hex data according to length
     if (hex_data[0] == hex_len - 1)
     {
@@ -239,7 +258,7 @@ INT8 parse_temp_1(struct tag_head *tag, temp_1 *temp1)
             temp1->comp_data[seg_index].segment = (UINT8 *) ir_malloc(seg_len);
             if (NULL == temp1->comp_data[seg_index].segment)
             {
-                ir_free(hex_data);
+                hex_release(hex_data, tag->in_place);
                 return IR_DECODE_FAILED;
             }
 
@@ -259,9 +278,10 @@ INT8 parse_temp_1(struct tag_head *tag, temp_1 *temp1)
         temp1->type = TEMP_TYPE_STATIC;
         for (seg_index = AC_TEMP_16; seg_index < AC_TEMP_MAX; seg_index++)
         {
-            if (IR_DECODE_FAILED == parse_comp_data_type_1(hex_data, &trav_offset, &temp1->comp_data[seg_index]))
+            if (IR_DECODE_FAILED == parse_comp_data_type_1(hex_data, &trav_offset,
+                                                           &temp1->comp_data[seg_index], tag->in_place))
             {
-                ir_free(hex_data);
+                hex_release(hex_data, tag->in_place);
                 return IR_DECODE_FAILED;
             }
 
@@ -271,7 +291,7 @@ INT8 parse_temp_1(struct tag_head *tag, temp_1 *temp1)
             }
         }
     }
-    ir_free(hex_data);
+    hex_release(hex_data, tag->in_place);
 
     return IR_DECODE_SUCCEEDED;
 }
@@ -289,23 +309,22 @@ INT8 parse_mode_1(struct tag_head *tag, mode_1 *mode1)
     }
 
     hex_len = tag->len >> 1;
-    hex_data = (UINT8 *) ir_malloc(hex_len);
+    hex_data = hex_decode(tag->pdata, hex_len, tag->in_place);
 
     if (NULL == hex_data)
     {
         return IR_DECODE_FAILED;
     }
 
-    string_to_hex_common(tag->pdata, hex_data, hex_len);
-
     // parse hex data to mode1 data structure
     mode1->len = (UINT8) hex_len;
 
     for (seg_index = AC_MODE_COOL; seg_index < AC_MODE_MAX; seg_index++)
     {
-        if (IR_DECODE_FAILED == parse_comp_data_type_1(hex_data, &trav_offset, &mode1->comp_data[seg_index]))
+        if (IR_DECODE_FAILED == parse_comp_data_type_1(hex_data, &trav_offset,
+                                                       &mode1->comp_data[seg_index], tag->in_place))
         {
-            ir_free(hex_data);
+            hex_release(hex_data, tag->in_place);
             return IR_DECODE_FAILED;
         }
 
@@ -315,7 +334,7 @@ INT8 parse_mode_1(struct tag_head *tag, mode_1 *mode1)
         }
     }
 
-    ir_free(hex_data);
+    hex_release(hex_data, tag->in_place);
 
     return IR_DECODE_SUCCEEDED;
 }
@@ -333,23 +352,22 @@ INT8 parse_speed_1(struct tag_head *tag, speed_1 *speed1)
     }
 
     hex_len = tag->len >> 1;
-    hex_data = (UINT8 *) ir_malloc(hex_len);
+    hex_data = hex_decode(tag->pdata, hex_len, tag->in_place);
 
     if (NULL == hex_data)
     {
         return IR_DECODE_FAILED;
     }
 
-    string_to_hex_common(tag->pdata, hex_data, hex_len);
-
     // parse hex data to speed1 data structure
     speed1->len = (UINT8) hex_len;
 
     for (seg_index = AC_WS_AUTO; seg_index < AC_WS_MAX; seg_index++)
     {
-        if (IR_DECODE_FAILED == parse_comp_data_type_1(hex_data, &trav_offset, &speed1->comp_data[seg_index]))
+        if (IR_DECODE_FAILED == parse_comp_data_type_1(hex_data, &trav_offset,
+                                                       &speed1->comp_data[seg_index], tag->in_place))
         {
-            ir_free(hex_data);
+            hex_release(hex_data, tag->in_place);
             return IR_DECODE_FAILED;
         }
 
@@ -359,7 +377,7 @@ INT8 parse_speed_1(struct tag_head *tag, speed_1 *speed1)
         }
     }
 
-    ir_free(hex_data);
+    hex_release(hex_data, tag->in_place);
 
     return IR_DECODE_SUCCEEDED;
 }
@@ -377,30 +395,29 @@ INT8 parse_swing_1(struct tag_head *tag, swing_1 *swing1, UINT16 swing_count)
     }
 
     hex_len = tag->len >> 1;
-    hex_data = (UINT8 *) ir_malloc(hex_len);
+    hex_data = hex_decode(tag->pdata, hex_len, tag->in_place);
 
     if (NULL == hex_data)
     {
         return IR_DECODE_FAILED;
     }
 
-    string_to_hex_common(tag->pdata, hex_data, hex_len);
-
     // parse hex data to swing1 data structure
     swing1->count = swing_count;
     swing1->len = (UINT8) hex_len;
     swing1->comp_data = (tag_comp *) ir_malloc(sizeof(tag_comp) * swing_count);
     if (NULL == swing1->comp_data)
     {
-        ir_free(hex_data);
+        hex_release(hex_data, tag->in_place);
         return IR_DECODE_FAILED;
     }
 
     for (seg_index = 0; seg_index < swing_count; seg_index++)
     {
-        if (IR_DECODE_FAILED == parse_comp_data_type_1(hex_data, &trav_offset, &swing1->comp_data[seg_index]))
+        if (IR_DECODE_FAILED == parse_comp_data_type_1(hex_data, &trav_offset,
+                                                       &swing1->comp_data[seg_index], tag->in_place))
         {
-            ir_free(hex_data);
+            hex_release(hex_data, tag->in_place);
             return IR_DECODE_FAILED;
         }
 
@@ -410,7 +427,7 @@ INT8 parse_swing_1(struct tag_head *tag, swing_1 *swing1, UINT16 swing_count)
         }
     }
 
-    ir_free(hex_data);
+    hex_release(hex_data, tag->in_place);
 
     return IR_DECODE_SUCCEEDED;
 }
@@ -452,7 +469,7 @@ INT8 parse_checksum_half_byte_typed(UINT8 *csdata, tag_checksum_data *checksum,
     return IR_DECODE_SUCCEEDED;
 }
 
-INT8 parse_checksum_spec_half_byte_typed(UINT8 *csdata, tag_checksum_data *checksum, UINT16 len)
+INT8 parse_checksum_spec_half_byte_typed(UINT8 *csdata, tag_checksum_data *checksum, UINT16 len, UINT8 in_place)
 {
     /*
      * note:
@@ -468,6 +485,11 @@ INT8 parse_checksum_spec_half_byte_typed(UINT8 *csdata, tag_checksum_data *check
     checksum->checksum_plus = csdata[3];
     checksum->start_byte_pos = 0;
     checksum->end_byte_pos = 0;
+    if (TRUE == in_place)
+    {
+        checksum->spec_pos = &csdata[4];
+        return IR_DECODE_SUCCEEDED;
+    }
     checksum->spec_pos = (UINT8 *) ir_malloc(spec_pos_size);
     if (NULL == checksum->spec_pos)
     {
@@ -504,7 +526,7 @@ INT8 parse_checksum_malloc(struct tag_head *tag, tchecksum *checksum)
     return IR_DECODE_SUCCEEDED;
 }
 
-INT8 parse_checksum_data(UINT8 *buf, tag_checksum_data *checksum, UINT8 length)
+INT8 parse_checksum_data(UINT8 *buf, tag_checksum_data *checksum, UINT8 length, UINT8 in_place)
 {
     UINT8 *hex_data = NULL;
     UINT16 hex_len = 0;
@@ -520,18 +542,16 @@ INT8 parse_checksum_data(UINT8 *buf, tag_checksum_data *checksum, UINT8 length)
     }
 
     hex_len = length;
-    hex_data = (UINT8 *) ir_malloc(hex_len);
+    hex_data = hex_decode(buf, hex_len, in_place);
 
     if (NULL == hex_data)
     {
         return IR_DECODE_FAILED;
     }
 
-    string_to_hex_common(buf, hex_data, hex_len);
-
     if (length != hex_data[0] + 1)
     {
-        ir_free(hex_data);
+        hex_release(hex_data, in_place);
         return IR_DECODE_FAILED;
     }
 
@@ -543,7 +563,7 @@ INT8 parse_checksum_data(UINT8 *buf, tag_checksum_data *checksum, UINT8 length)
         case CHECKSUM_TYPE_BYTE_INVERSE:
             if (IR_DECODE_FAILED == parse_checksum_byte_typed(hex_data, checksum, hex_len))
             {
-                ir_free(hex_data);
+                hex_release(hex_data, in_place);
                 return IR_DECODE_FAILED;
             }
             break;
@@ -551,7 +571,7 @@ INT8 parse_checksum_data(UINT8 *buf, tag_checksum_data *checksum, UINT8 length)
         case CHECKSUM_TYPE_HALF_BYTE_INVERSE:
             if (IR_DECODE_FAILED == parse_checksum_half_byte_typed(hex_data, checksum, hex_len))
             {
-                ir_free(hex_data);
+                hex_release(hex_data, in_place);
                 return IR_DECODE_FAILED;
             }
             break;
@@ -559,18 +579,18 @@ INT8 parse_checksum_data(UINT8 *buf, tag_checksum_data *checksum, UINT8 length)
         case CHECKSUM_TYPE_SPEC_HALF_BYTE_INVERSE:
         case CHECKSUM_TYPE_SPEC_HALF_BYTE_ONE_BYTE:
         case CHECKSUM_TYPE_SPEC_HALF_BYTE_INVERSE_ONE_BYTE:
-            if (IR_DECODE_FAILED == parse_checksum_spec_half_byte_typed(hex_data, checksum, hex_len))
+            if (IR_DECODE_FAILED == parse_checksum_spec_half_byte_typed(hex_data, checksum, hex_len, in_place))
             {
-                ir_free(hex_data);
+                hex_release(hex_data, in_place);
                 return IR_DECODE_FAILED;
             }
             break;
         default:
-            ir_free(hex_data);
+            hex_release(hex_data, in_place);
             return IR_DECODE_FAILED;
     }
 
-    ir_free(hex_data);
+    hex_release(hex_data, in_place);
     return IR_DECODE_SUCCEEDED;
 }
 
@@ -601,7 +621,7 @@ INT8 parse_checksum(struct tag_head *tag, tchecksum *checksum)
         {
             if (IR_DECODE_FAILED == parse_checksum_data(tag->pdata + preindex,
                                                         checksum->checksum_data + num,
-                                                        (UINT8) (i - preindex) >> 1))
+                                                        (UINT8) (i - preindex) >> 1, tag->in_place))
             {
                 return IR_DECODE_FAILED;
             }
@@ -612,7 +632,7 @@ INT8 parse_checksum(struct tag_head *tag, tchecksum *checksum)
 
     if (IR_DECODE_FAILED == parse_checksum_data(tag->pdata + preindex,
                                                 checksum->checksum_data + num,
-                                                (UINT8) (i - preindex) >> 1))
+                                                (UINT8) (i - preindex) >> 1, tag->in_place))
     {
         return IR_DECODE_FAILED;
     }
@@ -620,7 +640,7 @@ INT8 parse_checksum(struct tag_head *tag, tchecksum *checksum)
     return IR_DECODE_SUCCEEDED;
 }
 
-INT8 parse_function_1(UINT8 *data, UINT16 *trav_offset, tag_comp *mode_seg)
+INT8 parse_function_1(UINT8 *data, UINT16 *trav_offset, tag_comp *mode_seg, UINT8 in_place)
 {
     UINT8 seg_len = 0;
     BOOL valid_function_id = TRUE;
@@ -664,7 +684,7 @@ INT8 parse_function_1(UINT8 *data, UINT16 *trav_offset, tag_comp *mode_seg)
 
             if (NULL != mode_seg[function_id].segment)
             {
-                ir_free(mode_seg[function_id].segment);
+                hex_release(mode_seg[function_id].segment, in_place);
                 mode_seg[function_id].segment = NULL;
             }
         }
@@ -675,6 +695,12 @@ INT8 parse_function_1(UINT8 *data, UINT16 *trav_offset, tag_comp *mode_seg)
     if (TRUE == valid_function_id)
     {
         mode_seg[function_id].seg_len = (UINT8) (seg_len - 1);
+        if (TRUE == in_place)
+        {
+            mode_seg[function_id].segment = &data[*trav_offset];
+            *trav_offset += seg_len - 1;
+            return function_id;
+        }
         mode_seg[function_id].segment = (UINT8 *) ir_malloc((size_t) (seg_len - 1));
         if (NULL == mode_seg[function_id].segment)
         {
@@ -705,22 +731,20 @@ INT8 parse_function_1_tag29(struct tag_head *tag, function_1 *function1)
     }
 
     hex_len = tag->len >> 1;
-    hex_data = (UINT8 *) ir_malloc(hex_len);
+    hex_data = hex_decode(tag->pdata, hex_len, tag->in_place);
 
     if (NULL == hex_data)
     {
         return IR_DECODE_FAILED;
     }
 
-    string_to_hex_common(tag->pdata, hex_data, hex_len);
-
     // parse hex data to mode1 data structure
     function1->len = (UINT8) hex_len;
 
     // seg_index in TAG only refers to functional count
     for (seg_index = AC_FUNCTION_POWER; seg_index < AC_FUNCTION_MAX; seg_index++)
     {
-        INT8 fid = parse_function_1(hex_data, &trav_offset, &function1->comp_data[0]);
+        INT8 fid = parse_function_1(hex_data, &trav_offset, &function1->comp_data[0], tag->in_place);
 
         /** WARNING: for strict mode only **/
         /**
@@ -738,7 +762,7 @@ INT8 parse_function_1_tag29(struct tag_head *tag, function_1 *function1)
         }
     }
 
-    ir_free(hex_data);
+    hex_release(hex_data, tag->in_place);
 
     return IR_DECODE_SUCCEEDED;
 }
@@ -762,15 +786,13 @@ INT8 parse_temp_2(struct tag_head *tag, temp_2 *temp2)
     }
 
     hex_len = tag->len >> 1;
-    hex_data = (UINT8 *) ir_malloc(hex_len);
+    hex_data = hex_decode(tag->pdata, hex_len, tag->in_place);
 
     if (NULL == hex_data)
     {
         return IR_DECODE_FAILED;
     }
 
-    string_to_hex_common(tag->pdata, hex_data, hex_len);
-
     // parse hex data according to length
     if (hex_data[0] == hex_len - 1)
     {
@@ -786,7 +808,7 @@ INT8 parse_temp_2(struct tag_head *tag, temp_2 *temp2)
             temp2->comp_data[seg_index].segment = (UINT8 *) ir_malloc(seg_len);
             if (NULL == temp2->comp_data[seg_index].segment)
             {
-                ir_free(hex_data);
+                hex_release(hex_data, tag->in_place);
                 return IR_DECODE_FAILED;
             }
             for (i = 2; i < seg_len; i += 3)
@@ -806,9 +828,10 @@ INT8 parse_temp_2(struct tag_head *tag, temp_2 *temp2)
         temp2->type = TEMP_TYPE_STATIC;
         for (seg_index = AC_TEMP_16; seg_index < AC_TEMP_MAX; seg_index++)
         {
-            if (IR_DECODE_FAILED == parse_comp_data_type_2(hex_data, &trav_offset, &temp2->comp_data[seg_index]))
+            if (IR_DECODE_FAILED == parse_comp_data_type_2(hex_data, &trav_offset,
+                                                           &temp2->comp_data[seg_index], tag->in_place))
             {
-                ir_free(hex_data);
+                hex_release(hex_data, tag->in_place);
                 return IR_DECODE_FAILED;
             }
 
@@ -818,7 +841,7 @@ INT8 parse_temp_2(struct tag_head *tag, temp_2 *temp2)
             }
         }
     }
-    ir_free(hex_data);
+    hex_release(hex_data, tag->in_place);
 
     return IR_DECODE_SUCCEEDED;
 }
@@ -841,23 +864,22 @@ INT8 parse_mode_2(struct tag_head *tag, mode_2 *mode2)
     }
 
     hex_len = tag->len >> 1;
-    hex_data = (UINT8 *) ir_malloc(hex_len);
+    hex_data = hex_decode(tag->pdata, hex_len, tag->in_place);
 
     if (NULL == hex_data)
     {
         return IR_DECODE_FAILED;
     }
 
-    string_to_hex_common(tag->pdata, hex_data, hex_len);
-
     // parse hex data to mode1 data structure
     mode2->len = (UINT8) hex_len;
 
     for (seg_index = AC_MODE_COOL; seg_index < AC_MODE_MAX; seg_index++)
     {
-        if (IR_DECODE_FAILED == parse_comp_data_type_2(hex_data, &trav_offset, &mode2->comp_data[seg_index]))
+        if (IR_DECODE_FAILED == parse_comp_data_type_2(hex_data, &trav_offset,
+                                                       &mode2->comp_data[seg_index], tag->in_place))
         {
-            ir_free(hex_data);
+            hex_release(hex_data, tag->in_place);
             return IR_DECODE_FAILED;
         }
 
@@ -867,7 +889,7 @@ INT8 parse_mode_2(struct tag_head *tag, mode_2 *mode2)
         }
     }
 
-    ir_free(hex_data);
+    hex_release(hex_data, tag->in_place);
 
     return IR_DECODE_SUCCEEDED;
 }
@@ -890,23 +912,22 @@ INT8 parse_speed_2(struct tag_head *tag, speed_2 *speed2)
     }
 
     hex_len = tag->len >> 1;
-    hex_data = (UINT8 *) ir_malloc(hex_len);
+    hex_data = hex_decode(tag->pdata, hex_len, tag->in_place);
 
     if (NULL == hex_data)
     {
         return IR_DECODE_FAILED;
     }
 
-    string_to_hex_common(tag->pdata, hex_data, hex_len);
-
     // parse hex data to speed1 data structure
     speed2->len = (UINT8) hex_len;
 
     for (seg_index = AC_WS_AUTO; seg_index < AC_WS_MAX; seg_index++)
     {
-        if (IR_DECODE_FAILED == parse_comp_data_type_2(hex_data, &trav_offset, &speed2->comp_data[seg_index]))
+        if (IR_DECODE_FAILED == parse_comp_data_type_2(hex_data, &trav_offset,
+                                                       &speed2->comp_data[seg_index], tag->in_place))
         {
-            ir_free(hex_data);
+            hex_release(hex_data, tag->in_place);
             return IR_DECODE_FAILED;
         }
 
@@ -916,7 +937,7 @@ INT8 parse_speed_2(struct tag_head *tag, speed_2 *speed2)
         }
     }
 
-    ir_free(hex_data);
+    hex_release(hex_data, tag->in_place);
 
     return IR_DECODE_SUCCEEDED;
 }
@@ -939,30 +960,29 @@ INT8 parse_swing_2(struct tag_head *tag, swing_2 *swing2, UINT16 swing_count)
     }
 
     hex_len = tag->len >> 1;
-    hex_data = (UINT8 *) ir_malloc(hex_len);
+    hex_data = hex_decode(tag->pdata, hex_len, tag->in_place);
 
     if (NULL == hex_data)
     {
         return IR_DECODE_FAILED;
     }
 
-    string_to_hex_common(tag->pdata, hex_data, hex_len);
-
     // parse hex data to swing2 data structure
     swing2->count = swing_count;
     swing2->len = (UINT8) hex_len;
     swing2->comp_data = (tag_comp *) ir_malloc(sizeof(tag_comp) * swing_count);
     if (NULL == swing2->comp_data)
     {
-        ir_free(hex_data);
+        hex_release(hex_data, tag->in_place);
         return IR_DECODE_FAILED;
     }
 
     for (seg_index = 0; seg_index < swing_count; seg_index++)
     {
-        if (IR_DECODE_FAILED == parse_comp_data_type_2(hex_data, &trav_offset, &swing2->comp_data[seg_index]))
+        if (IR_DECODE_FAILED == parse_comp_data_type_2(hex_data, &trav_offset,
+                                                       &swing2->comp_data[seg_index], tag->in_place))
         {
-            ir_free(hex_data);
+            hex_release(hex_data, tag->in_place);
             return IR_DECODE_FAILED;
         }
 
@@ -972,12 +992,12 @@ INT8 parse_swing_2(struct tag_head *tag, swing_2 *swing2, UINT16 swing_count)
         }
     }
 
-    ir_free(hex_data);
+    hex_release(hex_data, tag->in_place);
 
     return IR_DECODE_SUCCEEDED;
 }
 
-INT8 parse_function_2(UINT8 *data, UINT16 *trav_offset, tag_comp *mode_seg)
+INT8 parse_function_2(UINT8 *data, UINT16 *trav_offset, tag_comp *mode_seg, UINT8 in_place)
 {
     UINT8 seg_len = 0;
     BOOL valid_function_id = TRUE;
@@ -1020,7 +1040,7 @@ INT8 parse_function_2(UINT8 *data, UINT16 *trav_offset, tag_comp *mode_seg)
 
             if (NULL != mode_seg[function_id].segment)
             {
-                ir_free(mode_seg[function_id].segment);
+                hex_release(mode_seg[function_id].segment, in_place);
                 mode_seg[function_id].segment = NULL;
             }
         }
@@ -1031,6 +1051,12 @@ INT8 parse_function_2(UINT8 *data, UINT16 *trav_offset, tag_comp *mode_seg)
     if (TRUE == valid_function_id)
     {
         mode_seg[function_id].seg_len = (UINT8) (seg_len - 1);
+        if (TRUE == in_place)
+        {
+            mode_seg[function_id].segment = &data[*trav_offset];
+            *trav_offset += seg_len - 1;
+            return function_id;
+        }
         mode_seg[function_id].segment = (UINT8 *) ir_malloc((size_t) (seg_len - 1));
 
         if (NULL == mode_seg[function_id].segment)
@@ -1063,22 +1089,20 @@ INT8 parse_function_2_tag34(struct tag_head *tag, function_2 *function2)
     }
 
     hex_len = tag->len >> 1;
-    hex_data = (UINT8 *) ir_malloc(hex_len);
+    hex_data = hex_decode(tag->pdata, hex_len, tag->in_place);
 
     if (NULL == hex_data)
     {
         return IR_DECODE_FAILED;
     }
 
-    string_to_hex_common(tag->pdata, hex_data, hex_len);
-
     // parse hex data to mode1 data structure
     function2->len = (UINT8) hex_len;
 
     // seg_index in TAG only refers to functional count
     for (seg_index = AC_FUNCTION_POWER; seg_index < AC_FUNCTION_MAX; seg_index++)
     {
-        INT8 fid = parse_function_2(hex_data, &trav_offset, &function2->comp_data[0]);
+        INT8 fid = parse_function_2(hex_data, &trav_offset, &function2->comp_data[0], tag->in_place);
 
         /** WARNING: for strict mode only **/
         /**
@@ -1096,7 +1120,7 @@ INT8 parse_function_2_tag34(struct tag_head *tag, function_2 *function2)
         }
     }
 
-    ir_free(hex_data);
+    hex_release(hex_data, tag->in_place);
 
     return IR_DECODE_SUCCEEDED;
 }
@@ -1169,13 +1193,12 @@ INT8 parse_solo_code(struct tag_head *tag, solo_code *sc)
         return IR_DECODE_FAILED;
     }
 
-    hex_data = (UINT8 *) ir_malloc(hex_len);
+    hex_data = hex_decode(tag->pdata, hex_len, tag->in_place);
 
     if (NULL == hex_data)
     {
         return IR_DECODE_FAILED;
     }
-    string_to_hex_common(tag->pdata, hex_data, hex_len);
 
     // parse hex data to mode1 data structure
     sc->len = (UINT8) hex_len;
@@ -1188,6 +1211,31 @@ INT8 parse_solo_code(struct tag_head *tag, solo_code *sc)
         sc->solo_function_codes[i - 1] = hex_data[i];
     }
 
-    ir_free(hex_data);
+    hex_release(hex_data, tag->in_place);
     return IR_DECODE_SUCCEEDED;
-}
\ No newline at end of file
+}
+
+static UINT8 *hex_decode(UINT8 *text, UINT16 hex_len, UINT8 in_place)
+{
+    UINT8 *hex_data = text;
+
+    // in place, byte i is written over characters already read, the segments then point into the binary
+    if (FALSE == in_place)
+    {
+        hex_data = (UINT8 *) ir_malloc(hex_len);
+        if (NULL == hex_data)
+        {
+            return NULL;
+        }
+    }
+    string_to_hex_common(text, hex_data, hex_len);
+    return hex_data;
+}
+
+static void hex_release(UINT8 *hex_data, UINT8 in_place)
+{
+    if (FALSE == in_place)
+    {
+        ir_free(hex_data);
+    }
+}
@@ -0,0 +1,276 @@
+/**************************************************************************************
+Filename:       ir_alloc.c
+Revised:        Date: 2026-10-17
+Revision:       Revision: 1.0
+
+Description:    This file provides the pluggable allocator and the parse arena of IR decode
+
+Revision log:
+* 2026-10-17: created by agent
+**************************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/ir_alloc.h"
+#include "../include/ir_decode.h"
+
+#if defined BOARD_CC26XX
+#define IR_THREAD_LOCAL
+#elif defined _MSC_VER
+#define IR_THREAD_LOCAL __declspec(thread)
+#elif defined __GNUC__
+#define IR_THREAD_LOCAL __thread
+#else
+#define IR_THREAD_LOCAL
+#endif
+
+#if defined __GNUC__ && !defined BOARD_CC26XX
+#define ir_atomic_add(A, B) __atomic_add_fetch(A, B, __ATOMIC_RELAXED)
+#define ir_atomic_sub(A, B) __atomic_sub_fetch(A, B, __ATOMIC_RELAXED)
+#define ir_atomic_load(A) __atomic_load_n(A, __ATOMIC_RELAXED)
+#define ir_atomic_cas(A, E, D) \
+    __atomic_compare_exchange_n(A, E, D, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)
+#else
+#define ir_atomic_add(A, B) (*(A) += (B))
+#define ir_atomic_sub(A, B) (*(A) -= (B))
+#define ir_atomic_load(A) (*(A))
+#define ir_atomic_cas(A, E, D) (*(A) = (D), 1)
+#endif
+
+// every allocation is prefixed with its size so that the live bytes could be counted on free
+typedef union ir_alloc_header
+{
+    size_t size;
+    void *align_pointer;
+    UINT64 align_integer;
+} ir_alloc_header_t;
+
+#define ARENA_ALIGNMENT sizeof(void *)
+#define ARENA_ALIGN(A) (((A) + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1))
+#define ARENA_BLOCK_HEAD ARENA_ALIGN(sizeof(ir_arena_block_t))
+
+static void *default_malloc(void *alloc_context, size_t size);
+static void default_free(void *alloc_context, void *ptr);
+static void *arena_malloc(ir_arena_t *arena, size_t size);
+static BOOL arena_free(ir_arena_t *arena, void *ptr);
+static ir_arena_block_t *arena_add_block(ir_arena_t *arena, size_t size);
+
+static ir_allocator_t allocator = { default_malloc, default_free, NULL };
+static ir_alloc_stats_t alloc_stats = { 0, 0, 0, 0 };
+static BOOL ac_arena = FALSE;
+static IR_THREAD_LOCAL ir_arena_t *current_arena = NULL;
+
+
+void ir_set_allocator(const ir_allocator_t *new_allocator)
+{
+    if (NULL == new_allocator || NULL == new_allocator->malloc_fn || NULL == new_allocator->free_fn)
+    {
+        allocator.malloc_fn = default_malloc;
+        allocator.free_fn = default_free;
+        allocator.alloc_context = NULL;
+        return;
+    }
+    allocator = *new_allocator;
+}
+
+void ir_set_ac_arena(BOOL enable)
+{
+    ac_arena = enable;
+}
+
+BOOL ir_get_ac_arena()
+{
+    return ac_arena;
+}
+
+void ir_get_alloc_stats(ir_alloc_stats_t *stats)
+{
+    if (NULL == stats)
+    {
+        return;
+    }
+    *stats = alloc_stats;
+}
+
+void ir_reset_alloc_stats()
+{
+    alloc_stats.alloc_count = 0;
+    alloc_stats.free_count = 0;
+    alloc_stats.peak_bytes = alloc_stats.live_bytes;
+}
+
+void *ir_alloc_malloc(size_t size)
+{
+    ir_alloc_header_t *header = NULL;
+    size_t live_bytes = 0;
+    size_t peak_bytes = 0;
+
+    if (NULL != current_arena)
+    {
+        return arena_malloc(current_arena, size);
+    }
+
+    header = (ir_alloc_header_t *) allocator.malloc_fn(allocator.alloc_context, sizeof(ir_alloc_header_t) + size);
+    if (NULL == header)
+    {
+        return NULL;
+    }
+    header->size = size;
+
+    // raise the peak with compare and exchange so that a racing thread could not lower it back
+    ir_atomic_add(&alloc_stats.alloc_count, 1);
+    live_bytes = ir_atomic_add(&alloc_stats.live_bytes, size);
+    peak_bytes = ir_atomic_load(&alloc_stats.peak_bytes);
+    while (live_bytes > peak_bytes)
+    {
+        if (ir_atomic_cas(&alloc_stats.peak_bytes, &peak_bytes, live_bytes))
+        {
+            break;
+        }
+    }
+    return header + 1;
+}
+
+void ir_alloc_free(void *ptr)
+{
+    ir_alloc_header_t *header = NULL;
+
+    if (NULL == ptr)
+    {
+        return;
+    }
+    if (NULL != current_arena && TRUE == arena_free(current_arena, ptr))
+    {
+        return;
+    }
+
+    header = (ir_alloc_header_t *) ptr - 1;
+    ir_atomic_add(&alloc_stats.free_count, 1);
+    ir_atomic_sub(&alloc_stats.live_bytes, header->size);
+    allocator.free_fn(allocator.alloc_context, header);
+}
+
+INT8 ir_arena_begin(ir_arena_t *arena, size_t size)
+{
+    if (NULL == arena)
+    {
+        return IR_DECODE_FAILED;
+    }
+    if (NULL == arena->head && NULL == arena_add_block(arena, size))
+    {
+        return IR_DECODE_FAILED;
+    }
+    arena->previous = current_arena;
+    current_arena = arena;
+    return IR_DECODE_SUCCEEDED;
+}
+
+void ir_arena_end(ir_arena_t *arena)
+{
+    if (NULL != arena && current_arena == arena)
+    {
+        current_arena = arena->previous;
+        arena->previous = NULL;
+    }
+}
+
+void ir_arena_release(ir_arena_t *arena)
+{
+    ir_arena_block_t *block = NULL;
+
+    if (NULL == arena)
+    {
+        return;
+    }
+    while (NULL != arena->head)
+    {
+        block = arena->head;
+        arena->head = block->next;
+        ir_free(block);
+    }
+    ir_memset(arena, 0x00, sizeof(ir_arena_t));
+}
+
+
+static void *default_malloc(void *alloc_context, size_t size)
+{
+    (void) alloc_context;
+#if !defined BOARD_CC26XX
+    return malloc(size);
+#else
+    return ICall_malloc(size);
+#endif
+}
+
+static void default_free(void *alloc_context, void *ptr)
+{
+    (void) alloc_context;
+#if !defined BOARD_CC26XX
+    free(ptr);
+#else
+    ICall_free(ptr);
+#endif
+}
+
+static void *arena_malloc(ir_arena_t *arena, size_t size)
+{
+    ir_arena_block_t *block = arena->head;
+    size_t aligned = ARENA_ALIGN(size);
+
+    if (NULL == block || aligned > block->size - block->used)
+    {
+        // the first block was sized too small, grow by half of it at least
+        block = arena_add_block(arena, (NULL != block && aligned < block->size / 2) ? block->size / 2 : aligned);
+        if (NULL == block)
+        {
+            return NULL;
+        }
+    }
+    arena->last = block->used;
+    block->used += aligned;
+    return (UINT8 *) block + ARENA_BLOCK_HEAD + arena->last;
+}
+
+static BOOL arena_free(ir_arena_t *arena, void *ptr)
+{
+    ir_arena_block_t *block = NULL;
+    UINT8 *data = NULL;
+
+    for (block = arena->head; NULL != block; block = block->next)
+    {
+        data = (UINT8 *) block + ARENA_BLOCK_HEAD;
+        if ((UINT8 *) ptr >= data && (UINT8 *) ptr < data + block->size)
+        {
+            // only the latest allocation could be given back, temporaries freed in order cost nothing
+            if (block == arena->head && (UINT8 *) ptr == data + arena->last)
+            {
+                block->used = arena->last;
+            }
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+static ir_arena_block_t *arena_add_block(ir_arena_t *arena, size_t size)
+{
+    ir_arena_t *scope = current_arena;
+    ir_arena_block_t *block = NULL;
+
+    // blocks themselves come from the allocator
+    current_arena = NULL;
+    block = (ir_arena_block_t *) ir_malloc(ARENA_BLOCK_HEAD + ARENA_ALIGN(size));
+    current_arena = scope;
+    if (NULL == block)
+    {
+        return NULL;
+    }
+    block->next = arena->head;
+    block->size = ARENA_ALIGN(size);
+    block->used = 0;
+    arena->head = block;
+    arena->last = 0;
+    arena->block_count++;
+    return block;
+}
@@ -0,0 +1,795 @@
+/**************************************************************************************
+Filename:       ir_bench_main.c
+Revised:        Date: 2026-10-17
+Revision:       Revision: 1.0
+
+Description:    This file provides the benchmark of open, parse, decode and close of IR binaries
+
+Revision log:
+* 2026-10-17: created by agent
+**************************************************************************************/
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include "../include/ir_defs.h"
+#include "../include/ir_decode.h"
+#include "../include/ir_alloc.h"
+#include "../include/ir_ac_control.h"
+#include "../include/ir_ac_compiled.h"
+#include "../include/ir_tv_control.h"
+
+#define DEFAULT_ROUNDS               1
+#define DEFAULT_SUB_CATEGORY         1
+#define DEFAULT_KEY_COUNT            TV_KEY_MAX
+
+// latencies are bucketed by quarter octave, from 1 ns up to 2 ^ 40 ns
+#define HISTOGRAM_OCTAVES            40
+#define HISTOGRAM_STEPS              4
+#define HISTOGRAM_BUCKETS            (HISTOGRAM_OCTAVES * HISTOGRAM_STEPS)
+
+enum
+{
+    PHASE_OPEN = 0,
+    PHASE_PARSE,
+    PHASE_DECODE,
+    PHASE_CLOSE,
+    PHASE_MAX
+};
+
+typedef struct phase_stats
+{
+    const char *name;
+    UINT64 count;
+    UINT64 total_ns;
+    UINT64 min_ns;
+    UINT64 max_ns;
+    UINT64 allocs;
+    UINT64 frees;
+    size_t peak_bytes;
+    // bytes of binary for open and parse, timings for decode
+    UINT64 volume;
+    UINT64 buckets[HISTOGRAM_BUCKETS];
+} phase_stats_t;
+
+typedef struct remote
+{
+    char file_name[512];
+    UINT8 *binary;
+    UINT length;
+    UINT8 category;
+    UINT8 sub_category;
+} remote_t;
+
+typedef struct alloc_probe
+{
+    ir_alloc_stats_t start;
+} alloc_probe_t;
+
+static phase_stats_t phases[PHASE_MAX] =
+{
+    { "open", 0, 0, 0, 0, 0, 0, 0, 0, { 0 } },
+    { "parse", 0, 0, 0, 0, 0, 0, 0, 0, { 0 } },
+    { "decode", 0, 0, 0, 0, 0, 0, 0, 0, { 0 } },
+    { "close", 0, 0, 0, 0, 0, 0, 0, 0, { 0 } }
+};
+
+static ir_decoder_t decoder;
+static ir_decoder_t scratch;
+static UINT16 user_data[USER_DATA_SIZE];
+// AC frames patched from the previous frame of their remote rather than rebuilt
+static ir_ac_delta_stats_t delta_totals;
+
+
+static UINT64 now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (UINT64) ts.tv_sec * 1000000000ULL + (UINT64) ts.tv_nsec;
+}
+
+static UINT bucket_of(UINT64 ns)
+{
+    UINT octave = 0;
+    UINT step = 0;
+
+    if (ns < 2)
+    {
+        return 0;
+    }
+    while ((ns >> (octave + 1)) != 0)
+    {
+        octave++;
+    }
+    // the two bits below the leading one pick the quarter of the octave
+    step = (octave >= 2) ? (UINT) ((ns >> (octave - 2)) & 0x03) : (UINT) ((ns << (2 - octave)) & 0x03);
+    if (octave >= HISTOGRAM_OCTAVES)
+    {
+        return HISTOGRAM_BUCKETS - 1;
+    }
+    return octave * HISTOGRAM_STEPS + step;
+}
+
+// exclusive upper bound of a bucket in ns
+static UINT64 bucket_limit(UINT bucket)
+{
+    UINT octave = bucket / HISTOGRAM_STEPS;
+    UINT step = bucket % HISTOGRAM_STEPS;
+
+    return ((1ULL << octave) * (HISTOGRAM_STEPS + step + 1) + HISTOGRAM_STEPS - 1) / HISTOGRAM_STEPS;
+}
+
+static void alloc_begin(alloc_probe_t *probe)
+{
+    ir_reset_alloc_stats();
+    ir_get_alloc_stats(&probe->start);
+}
+
+static void phase_add(UINT phase, UINT64 elapsed, UINT64 volume, const alloc_probe_t *probe)
+{
+    phase_stats_t *stats = &phases[phase];
+    ir_alloc_stats_t end;
+
+    if (0 == stats->count || elapsed < stats->min_ns)
+    {
+        stats->min_ns = elapsed;
+    }
+    if (elapsed > stats->max_ns)
+    {
+        stats->max_ns = elapsed;
+    }
+    stats->count++;
+    stats->total_ns += elapsed;
+    stats->volume += volume;
+    stats->buckets[bucket_of(elapsed)]++;
+
+    if (NULL != probe)
+    {
+        ir_get_alloc_stats(&end);
+        stats->allocs += end.alloc_count - probe->start.alloc_count;
+        stats->frees += end.free_count - probe->start.free_count;
+        if (end.peak_bytes > probe->start.live_bytes &&
+            end.peak_bytes - probe->start.live_bytes > stats->peak_bytes)
+        {
+            stats->peak_bytes = end.peak_bytes - probe->start.live_bytes;
+        }
+    }
+}
+
+static UINT64 percentile(const phase_stats_t *stats, UINT per_mille)
+{
+    UINT64 rank = (stats->count * per_mille + 999) / 1000;
+    UINT64 seen = 0;
+    UINT i = 0;
+
+    if (0 == stats->count)
+    {
+        return 0;
+    }
+    for (i = 0; i < HISTOGRAM_BUCKETS; i++)
+    {
+        seen += stats->buckets[i];
+        if (seen >= rank)
+        {
+            // the bucket bound is never reported above the slowest sample
+            return (bucket_limit(i) < stats->max_ns) ? bucket_limit(i) : stats->max_ns;
+        }
+    }
+    return stats->max_ns;
+}
+
+static UINT8 *read_file(const char *file_name, UINT *length)
+{
+    FILE *stream = fopen(file_name, "rb");
+    UINT8 *content = NULL;
+    long size = 0;
+
+    if (NULL == stream)
+    {
+        return NULL;
+    }
+    fseek(stream, 0, SEEK_END);
+    size = ftell(stream);
+    fseek(stream, 0, SEEK_SET);
+    if (size > 0 && size <= 0xFFFF)
+    {
+        content = (UINT8 *) malloc((size_t) size);
+    }
+    if (NULL != content && 1 != fread(content, (size_t) size, 1, stream))
+    {
+        free(content);
+        content = NULL;
+    }
+    fclose(stream);
+    *length = (NULL != content) ? (UINT) size : 0;
+    return content;
+}
+
+static int compare_remote(const void *a, const void *b)
+{
+    return strcmp(((const remote_t *) a)->file_name, ((const remote_t *) b)->file_name);
+}
+
+static BOOL append_remote(remote_t **remotes, UINT *count, UINT *capacity, remote_t *remote)
+{
+    remote_t *grown = NULL;
+
+    if (*count == *capacity)
+    {
+        *capacity = (0 == *capacity) ? 64 : *capacity * 2;
+        grown = (remote_t *) realloc(*remotes, *capacity * sizeof(remote_t));
+        if (NULL == grown)
+        {
+            free(remote->binary);
+            return FALSE;
+        }
+        *remotes = grown;
+    }
+    (*remotes)[(*count)++] = *remote;
+    return TRUE;
+}
+
+// every regular file of the directory, sorted by name so that runs are comparable
+static remote_t *load_directory(const char *directory, UINT8 sub_category, UINT *count)
+{
+    DIR *dir = opendir(directory);
+    struct dirent *entry = NULL;
+    struct stat file_stat;
+    remote_t *remotes = NULL;
+    UINT capacity = 0;
+
+    *count = 0;
+    if (NULL == dir)
+    {
+        return NULL;
+    }
+    while (NULL != (entry = readdir(dir)))
+    {
+        remote_t remote;
+
+        memset(&remote, 0x00, sizeof(remote_t));
+        snprintf(remote.file_name, sizeof(remote.file_name), "%s/%s", directory, entry->d_name);
+        if (0 != stat(remote.file_name, &file_stat) || !S_ISREG(file_stat.st_mode))
+        {
+            continue;
+        }
+        remote.binary = read_file(remote.file_name, &remote.length);
+        if (NULL == remote.binary)
+        {
+            printf("skip %s\n", remote.file_name);
+            continue;
+        }
+        // AC binaries start with their tag count, TV binaries with their protocol name
+        remote.category = (TAG_COUNT_FOR_PROTOCOL == remote.binary[0] ||
+                           ir_ac_is_compiled(remote.binary, (UINT16) remote.length)) ?
+                          IR_CATEGORY_AC : IR_CATEGORY_TV;
+        remote.sub_category = sub_category;
+        if (FALSE == append_remote(&remotes, count, &capacity, &remote))
+        {
+            break;
+        }
+    }
+    closedir(dir);
+    if (NULL != remotes)
+    {
+        qsort(remotes, *count, sizeof(remote_t), compare_remote);
+    }
+    return remotes;
+}
+
+// remotes of a list as read by ir_bundle, "id category sub_category name file" per line, kept in list order
+static remote_t *load_list(const char *list_name, UINT *count)
+{
+    FILE *list = fopen(list_name, "r");
+    remote_t *remotes = NULL;
+    UINT capacity = 0;
+    UINT remote_id = 0;
+    UINT category = 0;
+    UINT sub_category = 0;
+    char name[256];
+
+    *count = 0;
+    if (NULL == list)
+    {
+        return NULL;
+    }
+    while (1)
+    {
+        remote_t remote;
+
+        memset(&remote, 0x00, sizeof(remote_t));
+        if (5 != fscanf(list, "%u %u %u %255s %511s", &remote_id, &category, &sub_category, name,
+                        remote.file_name))
+        {
+            break;
+        }
+        remote.binary = read_file(remote.file_name, &remote.length);
+        if (NULL == remote.binary)
+        {
+            printf("skip %s\n", remote.file_name);
+            continue;
+        }
+        remote.category = (UINT8) category;
+        remote.sub_category = (UINT8) sub_category;
+        if (FALSE == append_remote(&remotes, count, &capacity, &remote))
+        {
+            break;
+        }
+    }
+    fclose(list);
+    return remotes;
+}
+
+// the parse step of open alone, on a scratch decoder that is then closed untimed
+static BOOL bench_parse(remote_t *remote)
+{
+    alloc_probe_t probe;
+    UINT64 start = 0;
+    UINT64 elapsed = 0;
+    INT8 ret = IR_DECODE_SUCCEEDED;
+
+    memset(&scratch, 0x00, sizeof(ir_decoder_t));
+    if (IR_CATEGORY_AC == remote->category)
+    {
+        if (ir_ac_is_compiled(remote->binary, (UINT16) remote->length))
+        {
+            // compiled images are loaded without being parsed
+            return TRUE;
+        }
+        scratch.binary_type = IR_TYPE_STATUS;
+        scratch.ac_buffer.data = remote->binary;
+        scratch.ac_buffer.len = (UINT16) remote->length;
+        scratch.ac_buffer.offset = 0;
+
+        alloc_begin(&probe);
+        start = now_ns();
+        if (TRUE == ir_get_ac_arena())
+        {
+            ret = ir_arena_begin(&scratch.ac_arena, AC_ARENA_SIZE(remote->length));
+            if (IR_DECODE_SUCCEEDED == ret)
+            {
+                ret = ir_ac_lib_parse(&scratch);
+            }
+            ir_arena_end(&scratch.ac_arena);
+        }
+        else
+        {
+            scratch.ac_lazy = ir_get_ac_lazy();
+            ret = ir_ac_lib_parse(&scratch);
+        }
+        elapsed = now_ns() - start;
+    }
+    else
+    {
+        scratch.binary_type = IR_TYPE_COMMANDS;
+        scratch.hexadecimal = (2 == remote->sub_category) ? SUB_CATEGORY_HEXADECIMAL : SUB_CATEGORY_QUATERNARY;
+
+        alloc_begin(&probe);
+        start = now_ns();
+        ret = tv_lib_open(&scratch.tv, remote->binary, (UINT16) remote->length);
+        if (IR_DECODE_SUCCEEDED == ret && FALSE == tv_lib_parse(&scratch.tv, scratch.hexadecimal))
+        {
+            ret = IR_DECODE_FAILED;
+        }
+        elapsed = now_ns() - start;
+    }
+
+    if (IR_DECODE_SUCCEEDED == ret)
+    {
+        phase_add(PHASE_PARSE, elapsed, remote->length, &probe);
+    }
+    ir_decoder_close(&scratch);
+    return (IR_DECODE_SUCCEEDED == ret) ? TRUE : FALSE;
+}
+
+static void decode_one(UINT8 key_code, remote_ac_status_t *ac_status)
+{
+    alloc_probe_t probe;
+    UINT64 start = 0;
+    UINT64 elapsed = 0;
+    UINT16 length = 0;
+
+    alloc_begin(&probe);
+    start = now_ns();
+    length = ir_decoder_decode(&decoder, key_code, user_data, ac_status, FALSE);
+    elapsed = now_ns() - start;
+    phase_add(PHASE_DECODE, elapsed, length, &probe);
+}
+
+// bits set in mask, or only fallback when none is
+static UINT values_of_mask(UINT8 mask, UINT count, UINT fallback, UINT8 *values)
+{
+    UINT found = 0;
+    UINT i = 0;
+
+    for (i = 0; i < count; i++)
+    {
+        if (0 != (mask & (1 << i)))
+        {
+            values[found++] = (UINT8) i;
+        }
+    }
+    if (0 == found)
+    {
+        values[found++] = (UINT8) fallback;
+    }
+    return found;
+}
+
+// every function key in every status the remote supports
+static void decode_ac(void)
+{
+    remote_ac_status_t ac_status;
+    UINT8 modes[AC_MODE_MAX];
+    UINT8 speeds[AC_WS_MAX];
+    UINT8 swings[AC_SWING_MAX];
+    UINT mode_count = 0;
+    UINT speed_count = 0;
+    UINT swing_count = 0;
+    UINT8 mask = 0;
+    UINT power = 0;
+    UINT mode = 0;
+    UINT speed = 0;
+    UINT swing = 0;
+    UINT function = 0;
+    INT temperature = 0;
+    INT8 temp_min = 0;
+    INT8 temp_max = 0;
+
+    ir_decoder_get_supported_mode(&decoder, &mask);
+    mode_count = values_of_mask(mask, AC_MODE_MAX, AC_MODE_COOL, modes);
+
+    memset(&ac_status, 0x00, sizeof(remote_ac_status_t));
+    for (power = 0; power < AC_POWER_MAX; power++)
+    {
+        for (mode = 0; mode < mode_count; mode++)
+        {
+            ir_decoder_get_temperature_range(&decoder, modes[mode], &temp_min, &temp_max);
+            if (temp_min < 0 || temp_max < 0)
+            {
+                // temperature is not controlled in this mode
+                temp_min = temp_max = AC_TEMP_16;
+            }
+            ir_decoder_get_supported_wind_speed(&decoder, modes[mode], &mask);
+            speed_count = values_of_mask(mask, AC_WS_MAX, AC_WS_AUTO, speeds);
+            ir_decoder_get_supported_swing(&decoder, modes[mode], &mask);
+            swing_count = values_of_mask(mask, AC_SWING_MAX, AC_SWING_ON, swings);
+
+            for (temperature = temp_min; temperature <= temp_max; temperature++)
+            {
+                for (speed = 0; speed < speed_count; speed++)
+                {
+                    for (swing = 0; swing < swing_count; swing++)
+                    {
+                        for (function = AC_FUNCTION_POWER; function < AC_FUNCTION_MAX; function++)
+                        {
+                            ac_status.acPower = (ac_power) power;
+                            ac_status.acMode = (ac_mode) modes[mode];
+                            ac_status.acTemp = (ac_temperature) temperature;
+                            ac_status.acWindSpeed = (ac_wind_speed) speeds[speed];
+                            ac_status.acWindDir = (ac_swing) swings[swing];
+                            decode_one((UINT8) function, &ac_status);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+static void decode_tv(UINT key_count)
+{
+    UINT key = 0;
+
+    for (key = 0; key < key_count; key++)
+    {
+        decode_one((UINT8) key, NULL);
+    }
+}
+
+static void add_delta_stats(void)
+{
+    ir_ac_delta_stats_t stats;
+
+    if (IR_DECODE_SUCCEEDED == ir_decoder_get_delta_stats(&decoder, &stats))
+    {
+        delta_totals.patched += stats.patched;
+        delta_totals.rebuilt += stats.rebuilt;
+        delta_totals.overlapped += stats.overlapped;
+    }
+}
+
+static BOOL bench_remote(remote_t *remote, UINT key_count)
+{
+    alloc_probe_t probe;
+    UINT64 start = 0;
+    UINT64 elapsed = 0;
+    INT8 ret = IR_DECODE_SUCCEEDED;
+
+    if (FALSE == bench_parse(remote))
+    {
+        return FALSE;
+    }
+
+    alloc_begin(&probe);
+    start = now_ns();
+    ret = ir_decoder_open_binary(&decoder, remote->category, remote->sub_category, remote->binary,
+                                 (UINT16) remote->length);
+    elapsed = now_ns() - start;
+    if (IR_DECODE_SUCCEEDED != ret)
+    {
+        ir_decoder_close(&decoder);
+        return FALSE;
+    }
+    phase_add(PHASE_OPEN, elapsed, remote->length, &probe);
+
+    if (IR_CATEGORY_AC == remote->category)
+    {
+        decode_ac();
+        add_delta_stats();
+    }
+    else
+    {
+        decode_tv(key_count);
+    }
+
+    alloc_begin(&probe);
+    start = now_ns();
+    ir_decoder_close(&decoder);
+    elapsed = now_ns() - start;
+    phase_add(PHASE_CLOSE, elapsed, 0, &probe);
+    return TRUE;
+}
+
+static void write_json_string(FILE *out, const char *text)
+{
+    fputc('"', out);
+    for (; '\0' != *text; text++)
+    {
+        if ('"' == *text || '\\' == *text)
+        {
+            fprintf(out, "\\%c", *text);
+        }
+        else if ((unsigned char) *text < 0x20)
+        {
+            fprintf(out, "\\u%04x", (UINT) (unsigned char) *text);
+        }
+        else
+        {
+            fputc(*text, out);
+        }
+    }
+    fputc('"', out);
+}
+
+static double per_second(UINT64 amount, UINT64 ns)
+{
+    return (0 == ns) ? 0.0 : (double) amount * 1e9 / (double) ns;
+}
+
+static void write_json(FILE *out, const char *directory, UINT rounds, UINT ac_count, UINT tv_count,
+                       UINT failed, UINT64 wall_ns)
+{
+    const phase_stats_t *stats = NULL;
+    UINT phase = 0;
+    UINT i = 0;
+    BOOL first = TRUE;
+
+    fprintf(out, "{\n  \"tool\": \"ir_bench\",\n  \"directory\": ");
+    write_json_string(out, directory);
+    fprintf(out, ",\n  \"rounds\": %u,\n  \"ac_arena\": %s,\n  \"ac_lazy\": %s,\n", rounds,
+            ir_get_ac_arena() ? "true" : "false", ir_get_ac_lazy() ? "true" : "false");
+    fprintf(out, "  \"remotes\": { \"ac\": %u, \"tv\": %u, \"failed\": %u },\n", ac_count, tv_count, failed);
+    fprintf(out, "  \"wall_ns\": %llu,\n  \"phases\": {\n", (unsigned long long) wall_ns);
+
+    for (phase = 0; phase < PHASE_MAX; phase++)
+    {
+        stats = &phases[phase];
+        fprintf(out, "    \"%s\": {\n", stats->name);
+        fprintf(out, "      \"count\": %llu, \"total_ns\": %llu, \"mean_ns\": %.1f,\n",
+                (unsigned long long) stats->count, (unsigned long long) stats->total_ns,
+                (0 == stats->count) ? 0.0 : (double) stats->total_ns / (double) stats->count);
+        fprintf(out, "      \"min_ns\": %llu, \"p50_ns\": %llu, \"p90_ns\": %llu, "
+                "\"p99_ns\": %llu, \"max_ns\": %llu,\n",
+                (unsigned long long) stats->min_ns, (unsigned long long) percentile(stats, 500),
+                (unsigned long long) percentile(stats, 900), (unsigned long long) percentile(stats, 990),
+                (unsigned long long) stats->max_ns);
+        fprintf(out, "      \"allocs\": %llu, \"frees\": %llu, \"peak_bytes\": %llu, \"volume\": %llu,\n",
+                (unsigned long long) stats->allocs, (unsigned long long) stats->frees,
+                (unsigned long long) stats->peak_bytes, (unsigned long long) stats->volume);
+        fprintf(out, "      \"histogram\": [");
+        first = TRUE;
+        for (i = 0; i < HISTOGRAM_BUCKETS; i++)
+        {
+            if (0 != stats->buckets[i])
+            {
+                fprintf(out, "%s{ \"lt_ns\": %llu, \"count\": %llu }", first ? "" : ", ",
+                        (unsigned long long) bucket_limit(i), (unsigned long long) stats->buckets[i]);
+                first = FALSE;
+            }
+        }
+        fprintf(out, "]\n    }%s\n", (phase + 1 < PHASE_MAX) ? "," : "");
+    }
+
+    fprintf(out, "  },\n  \"ac_frames\": { \"patched\": %u, \"rebuilt\": %u, \"overlapped\": %u },\n",
+            delta_totals.patched, delta_totals.rebuilt, delta_totals.overlapped);
+    fprintf(out, "  \"throughput\": {\n");
+    fprintf(out, "    \"remotes_per_s\": %.1f,\n", per_second(phases[PHASE_OPEN].count, wall_ns));
+    fprintf(out, "    \"opens_per_s\": %.1f,\n",
+            per_second(phases[PHASE_OPEN].count, phases[PHASE_OPEN].total_ns));
+    fprintf(out, "    \"parse_bytes_per_s\": %.1f,\n",
+            per_second(phases[PHASE_PARSE].volume, phases[PHASE_PARSE].total_ns));
+    fprintf(out, "    \"decodes_per_s\": %.1f,\n",
+            per_second(phases[PHASE_DECODE].count, phases[PHASE_DECODE].total_ns));
+    fprintf(out, "    \"timings_per_s\": %.1f\n",
+            per_second(phases[PHASE_DECODE].volume, phases[PHASE_DECODE].total_ns));
+    fprintf(out, "  }\n}\n");
+}
+
+static void print_summary(UINT ac_count, UINT tv_count, UINT failed, UINT64 wall_ns)
+{
+    const phase_stats_t *stats = NULL;
+    UINT phase = 0;
+
+    printf("remotes: %u AC, %u TV, %u failed, %.3f s\n", ac_count, tv_count, failed, (double) wall_ns / 1e9);
+    printf("%-8s %10s %10s %10s %10s %10s %10s %10s\n",
+           "phase", "count", "mean ns", "p50 ns", "p99 ns", "max ns", "allocs", "peak B");
+    for (phase = 0; phase < PHASE_MAX; phase++)
+    {
+        stats = &phases[phase];
+        printf("%-8s %10llu %10.0f %10llu %10llu %10llu %10llu %10llu\n", stats->name,
+               (unsigned long long) stats->count,
+               (0 == stats->count) ? 0.0 : (double) stats->total_ns / (double) stats->count,
+               (unsigned long long) percentile(stats, 500), (unsigned long long) percentile(stats, 990),
+               (unsigned long long) stats->max_ns, (unsigned long long) stats->allocs,
+               (unsigned long long) stats->peak_bytes);
+    }
+    printf("decodes: %.0f /s, %.0f timings /s\n",
+           per_second(phases[PHASE_DECODE].count, phases[PHASE_DECODE].total_ns),
+           per_second(phases[PHASE_DECODE].volume, phases[PHASE_DECODE].total_ns));
+    printf("AC frames: %u patched, %u rebuilt (%u as steps overlap), %.1f%% patched\n",
+           delta_totals.patched, delta_totals.rebuilt, delta_totals.overlapped,
+           (0 == delta_totals.patched + delta_totals.rebuilt) ? 0.0 :
+           100.0 * delta_totals.patched / (delta_totals.patched + delta_totals.rebuilt));
+}
+
+static void usage(const char *program)
+{
+    printf("usage: %s [-r rounds] [-s tv_sub_category] [-k tv_key_count] [-a] [-l] [-o result.json] "
+           "<directory | list>\n", program);
+    printf("  a list names the category and sub category of every binary, as read by ir_bundle\n");
+    printf("  -a  parse AC remotes into an arena\n");
+    printf("  -l  parse AC tags when first needed rather than on open\n");
+    printf("  -o  write JSON results to a file, - for stdout\n");
+}
+
+int main(int argc, char *argv[])
+{
+    remote_t *remotes = NULL;
+    struct stat path_stat;
+    const char *directory = NULL;
+    const char *json_name = NULL;
+    FILE *json = NULL;
+    UINT rounds = DEFAULT_ROUNDS;
+    UINT sub_category = DEFAULT_SUB_CATEGORY;
+    UINT key_count = DEFAULT_KEY_COUNT;
+    UINT count = 0;
+    UINT ac_count = 0;
+    UINT failed = 0;
+    UINT round = 0;
+    UINT64 start = 0;
+    UINT64 wall_ns = 0;
+    UINT i = 0;
+    int arg = 0;
+
+    for (arg = 1; arg < argc; arg++)
+    {
+        if (0 == strcmp(argv[arg], "-a"))
+        {
+            ir_set_ac_arena(TRUE);
+        }
+        else if (0 == strcmp(argv[arg], "-l"))
+        {
+            ir_set_ac_lazy(TRUE);
+        }
+        else if (0 == strcmp(argv[arg], "-r") && arg + 1 < argc)
+        {
+            rounds = (UINT) atoi(argv[++arg]);
+        }
+        else if (0 == strcmp(argv[arg], "-s") && arg + 1 < argc)
+        {
+            sub_category = (UINT) atoi(argv[++arg]);
+        }
+        else if (0 == strcmp(argv[arg], "-k") && arg + 1 < argc)
+        {
+            key_count = (UINT) atoi(argv[++arg]);
+        }
+        else if (0 == strcmp(argv[arg], "-o") && arg + 1 < argc)
+        {
+            json_name = argv[++arg];
+        }
+        else if ('-' != argv[arg][0] && NULL == directory)
+        {
+            directory = argv[arg];
+        }
+        else
+        {
+            directory = NULL;
+            break;
+        }
+    }
+    if (NULL == directory || 0 == rounds || (1 != sub_category && 2 != sub_category) || key_count > 256)
+    {
+        usage(argv[0]);
+        return -1;
+    }
+
+    if (0 == stat(directory, &path_stat) && S_ISREG(path_stat.st_mode))
+    {
+        remotes = load_list(directory, &count);
+    }
+    else
+    {
+        remotes = load_directory(directory, (UINT8) sub_category, &count);
+    }
+    if (0 == count)
+    {
+        printf("no binary found in %s\n", directory);
+        return -1;
+    }
+    for (i = 0; i < count; i++)
+    {
+        ac_count += (IR_CATEGORY_AC == remotes[i].category) ? 1 : 0;
+    }
+
+    start = now_ns();
+    for (round = 0; round < rounds; round++)
+    {
+        for (i = 0; i < count; i++)
+        {
+            if (FALSE == bench_remote(&remotes[i], key_count))
+            {
+                if (0 == round)
+                {
+                    printf("failed to open %s\n", remotes[i].file_name);
+                }
+                failed++;
+            }
+        }
+    }
+    wall_ns = now_ns() - start;
+
+    if (NULL == json_name || 0 != strcmp(json_name, "-"))
+    {
+        print_summary(ac_count, count - ac_count, failed, wall_ns);
+    }
+    if (NULL != json_name)
+    {
+        json = (0 == strcmp(json_name, "-")) ? stdout : fopen(json_name, "w");
+        if (NULL == json)
+        {
+            printf("cannot write %s\n", json_name);
+        }
+        else
+        {
+            write_json(json, directory, rounds, ac_count, count - ac_count, failed, wall_ns);
+            if (stdout != json)
+            {
+                fclose(json);
+            }
+        }
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        free(remotes[i].binary);
+    }
+    free(remotes);
+    return (NULL != json_name && NULL == json) ? -1 : 0;
+}
@@ -0,0 +1,287 @@
+/**************************************************************************************
+Filename:       ir_bundle.c
+Revised:        Date: 2026-10-17
+Revision:       Revision: 1.0
+
+Description:    This file provides the single file bundle of IR binaries
+
+Revision log:
+* 2026-10-17: created by agent
+**************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if !defined NO_FS && !defined NO_MMAP && (defined __linux__ || defined __APPLE__)
+#define USE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "../include/ir_bundle.h"
+
+static UINT read_u32(UINT8 *p);
+static INT8 read_record(ir_bundle_t *bundle, UINT index, ir_bundle_item_t *item);
+
+
+INT8 ir_bundle_open_binary(ir_bundle_t *bundle, UINT8 *content, size_t length)
+{
+    UINT entry_count = 0;
+
+    if (NULL == bundle || NULL == content)
+    {
+        return IR_DECODE_FAILED;
+    }
+    ir_memset(bundle, 0x00, sizeof(ir_bundle_t));
+
+    if (length < IR_BUNDLE_HEADER_SIZE ||
+        0 != memcmp(content, IR_BUNDLE_MAGIC, 4) ||
+        IR_BUNDLE_VERSION != (content[4] | (content[5] << 8)) ||
+        read_u32(content + 12) != length)
+    {
+        return IR_DECODE_FAILED;
+    }
+
+    // records are checked on lookup, opening only checks that both indexes are in the bundle
+    entry_count = read_u32(content + 8);
+    if (entry_count > (length - IR_BUNDLE_HEADER_SIZE) / (IR_BUNDLE_RECORD_SIZE + IR_BUNDLE_ID_RECORD_SIZE))
+    {
+        return IR_DECODE_FAILED;
+    }
+
+    bundle->content = content;
+    bundle->length = length;
+    bundle->entry_count = entry_count;
+    bundle->names = content + IR_BUNDLE_HEADER_SIZE;
+    bundle->ids = bundle->names + (size_t) entry_count * IR_BUNDLE_RECORD_SIZE;
+    return IR_DECODE_SUCCEEDED;
+}
+
+#if !defined NO_FS
+INT8 ir_bundle_open_file(ir_bundle_t *bundle, const char *file_name)
+{
+#if defined USE_MMAP
+    struct stat file_stat;
+    void *mapping = NULL;
+    int fd = -1;
+
+    if (NULL == bundle)
+    {
+        return IR_DECODE_FAILED;
+    }
+
+    fd = open(file_name, O_RDONLY);
+    if (fd < 0)
+    {
+        ir_printf("\nbundle open failed\n");
+        return IR_DECODE_FAILED;
+    }
+    if (fstat(fd, &file_stat) < 0 || file_stat.st_size <= 0)
+    {
+        close(fd);
+        return IR_DECODE_FAILED;
+    }
+
+    mapping = mmap(NULL, (size_t) file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (MAP_FAILED == mapping)
+    {
+        ir_printf("\nfailed to map bundle\n");
+        return IR_DECODE_FAILED;
+    }
+
+    if (IR_DECODE_SUCCEEDED != ir_bundle_open_binary(bundle, (UINT8 *) mapping, (size_t) file_stat.st_size))
+    {
+        munmap(mapping, (size_t) file_stat.st_size);
+        return IR_DECODE_FAILED;
+    }
+    bundle->owned = TRUE;
+    return IR_DECODE_SUCCEEDED;
+#else
+    size_t length = 0;
+    UINT8 *content = NULL;
+#if !defined WIN32
+    FILE *stream = fopen(file_name, "rb");
+#else
+    FILE *stream;
+    fopen_s(&stream, file_name, "rb");
+#endif
+
+    if (NULL == bundle || NULL == stream)
+    {
+        ir_printf("\nbundle open failed\n");
+        if (NULL != stream)
+        {
+            fclose(stream);
+        }
+        return IR_DECODE_FAILED;
+    }
+
+    fseek(stream, 0, SEEK_END);
+    length = (size_t) ftell(stream);
+    content = (UINT8 *) ir_malloc(length);
+    if (NULL == content)
+    {
+        ir_printf("\nfailed to alloc memory for bundle\n");
+        fclose(stream);
+        return IR_DECODE_FAILED;
+    }
+
+    fseek(stream, 0, SEEK_SET);
+    if (1 != fread(content, length, 1, stream) ||
+        IR_DECODE_SUCCEEDED != ir_bundle_open_binary(bundle, content, length))
+    {
+        fclose(stream);
+        ir_free(content);
+        return IR_DECODE_FAILED;
+    }
+    fclose(stream);
+    bundle->owned = TRUE;
+    return IR_DECODE_SUCCEEDED;
+#endif
+}
+#endif
+
+INT8 ir_bundle_close(ir_bundle_t *bundle)
+{
+    if (NULL == bundle)
+    {
+        return IR_DECODE_FAILED;
+    }
+    if (TRUE == bundle->owned && NULL != bundle->content)
+    {
+#if defined USE_MMAP
+        munmap(bundle->content, bundle->length);
+#else
+        ir_free(bundle->content);
+#endif
+    }
+    ir_memset(bundle, 0x00, sizeof(ir_bundle_t));
+    return IR_DECODE_SUCCEEDED;
+}
+
+INT8 ir_bundle_find_name(ir_bundle_t *bundle, const char *name, ir_bundle_item_t *item)
+{
+    UINT low = 0;
+    UINT high = 0;
+    UINT middle = 0;
+    int diff = 0;
+
+    if (NULL == bundle || NULL == name || NULL == item)
+    {
+        return IR_DECODE_FAILED;
+    }
+
+    high = bundle->entry_count;
+    while (low < high)
+    {
+        middle = low + (high - low) / 2;
+        diff = strncmp(name, (const char *) (bundle->names + (size_t) middle * IR_BUNDLE_RECORD_SIZE + 16),
+                       IR_BUNDLE_NAME_SIZE);
+        if (0 == diff)
+        {
+            return read_record(bundle, middle, item);
+        }
+        if (diff < 0)
+        {
+            high = middle;
+        }
+        else
+        {
+            low = middle + 1;
+        }
+    }
+    return IR_DECODE_FAILED;
+}
+
+INT8 ir_bundle_find_id(ir_bundle_t *bundle, UINT remote_id, ir_bundle_item_t *item)
+{
+    UINT low = 0;
+    UINT high = 0;
+    UINT middle = 0;
+    UINT id = 0;
+    UINT8 *record = NULL;
+
+    if (NULL == bundle || NULL == item)
+    {
+        return IR_DECODE_FAILED;
+    }
+
+    high = bundle->entry_count;
+    while (low < high)
+    {
+        middle = low + (high - low) / 2;
+        record = bundle->ids + (size_t) middle * IR_BUNDLE_ID_RECORD_SIZE;
+        id = read_u32(record);
+        if (id == remote_id)
+        {
+            return read_record(bundle, read_u32(record + 4), item);
+        }
+        if (remote_id < id)
+        {
+            high = middle;
+        }
+        else
+        {
+            low = middle + 1;
+        }
+    }
+    return IR_DECODE_FAILED;
+}
+
+INT8 ir_bundle_get(ir_bundle_t *bundle, UINT index, ir_bundle_item_t *item)
+{
+    if (NULL == bundle || NULL == item)
+    {
+        return IR_DECODE_FAILED;
+    }
+    return read_record(bundle, index, item);
+}
+
+INT8 ir_decoder_open_bundle_item(ir_decoder_t *decoder, ir_bundle_item_t *item)
+{
+    if (NULL == item)
+    {
+        return IR_DECODE_FAILED;
+    }
+    return ir_decoder_open_binary(decoder, item->category, item->sub_category, item->binary, item->binary_length);
+}
+
+
+static UINT read_u32(UINT8 *p)
+{
+    return (UINT) p[0] | ((UINT) p[1] << 8) | ((UINT) p[2] << 16) | ((UINT) p[3] << 24);
+}
+
+static INT8 read_record(ir_bundle_t *bundle, UINT index, ir_bundle_item_t *item)
+{
+    UINT8 *record = NULL;
+    UINT offset = 0;
+    UINT length = 0;
+
+    if (index >= bundle->entry_count)
+    {
+        return IR_DECODE_FAILED;
+    }
+    record = bundle->names + (size_t) index * IR_BUNDLE_RECORD_SIZE;
+    offset = read_u32(record + 8);
+    length = read_u32(record + 12);
+
+    // the blob must be within the bundle and openable through the UINT16 binary length of the decoder
+    if (0 == length || length > 0xFFFF || offset > bundle->length || length > bundle->length - offset)
+    {
+        return IR_DECODE_FAILED;
+    }
+
+    item->remote_id = read_u32(record);
+    item->category = record[4];
+    item->sub_category = record[5];
+    ir_memcpy(item->name, record + 16, IR_BUNDLE_NAME_SIZE);
+    item->name[IR_BUNDLE_NAME_SIZE - 1] = '\0';
+    item->binary = bundle->content + offset;
+    item->binary_length = (UINT16) length;
+    return IR_DECODE_SUCCEEDED;
+}
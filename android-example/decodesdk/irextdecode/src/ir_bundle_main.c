@@ -0,0 +1,439 @@
+/**************************************************************************************
+Filename:       ir_bundle_main.c
+Revised:        Date: 2026-10-17
+Revision:       Revision: 1.0
+
+Description:    This file provides the packer and benchmark of IR binary bundles
+
+Revision log:
+* 2026-10-17: created by agent
+**************************************************************************************/
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "../include/ir_defs.h"
+#include "../include/ir_decode.h"
+#include "../include/ir_bundle.h"
+
+#define DEFAULT_ROUNDS               20
+
+/*
+ * list file, one remote per line:
+ * <remote id> <category> <sub_category> <remote map name> <binary file>
+ */
+typedef struct remote
+{
+    UINT remote_id;
+    UINT category;
+    UINT sub_category;
+    char name[IR_BUNDLE_NAME_SIZE];
+    char file_name[512];
+    UINT8 *binary;
+    UINT length;
+    UINT offset;
+    UINT index;
+} remote_t;
+
+static ir_decoder_t decoder;
+
+
+static void put_u16(UINT8 *p, UINT value)
+{
+    p[0] = (UINT8) (value & 0xFF);
+    p[1] = (UINT8) ((value >> 8) & 0xFF);
+}
+
+static void put_u32(UINT8 *p, UINT value)
+{
+    put_u16(p, value & 0xFFFF);
+    put_u16(p + 2, value >> 16);
+}
+
+static UINT8 *read_file(const char *file_name, UINT *length)
+{
+    FILE *stream = fopen(file_name, "rb");
+    UINT8 *content = NULL;
+    long size = 0;
+
+    if (NULL == stream)
+    {
+        return NULL;
+    }
+    fseek(stream, 0, SEEK_END);
+    size = ftell(stream);
+    fseek(stream, 0, SEEK_SET);
+    if (size > 0)
+    {
+        content = (UINT8 *) malloc((size_t) size);
+    }
+    if (NULL != content && 1 != fread(content, (size_t) size, 1, stream))
+    {
+        free(content);
+        content = NULL;
+    }
+    fclose(stream);
+    *length = (UINT) size;
+    return content;
+}
+
+static remote_t *read_list(const char *list_name, UINT *count)
+{
+    FILE *stream = fopen(list_name, "r");
+    remote_t *remotes = NULL;
+    remote_t *grown = NULL;
+    UINT capacity = 0;
+    char line[1024];
+    char name[256];
+
+    *count = 0;
+    if (NULL == stream)
+    {
+        printf("failed to open list %s\n", list_name);
+        return NULL;
+    }
+
+    while (NULL != fgets(line, sizeof(line), stream))
+    {
+        if ('#' == line[0] || '\n' == line[0])
+        {
+            continue;
+        }
+        if (*count == capacity)
+        {
+            capacity = (0 == capacity) ? 64 : capacity * 2;
+            grown = (remote_t *) realloc(remotes, capacity * sizeof(remote_t));
+            if (NULL == grown)
+            {
+                break;
+            }
+            remotes = grown;
+        }
+        memset(&remotes[*count], 0x00, sizeof(remote_t));
+        if (5 != sscanf(line, "%u %u %u %255s %511s", &remotes[*count].remote_id, &remotes[*count].category,
+                        &remotes[*count].sub_category, name, remotes[*count].file_name) ||
+            strlen(name) >= IR_BUNDLE_NAME_SIZE)
+        {
+            printf("invalid list line: %s", line);
+            fclose(stream);
+            free(remotes);
+            *count = 0;
+            return NULL;
+        }
+        strcpy(remotes[*count].name, name);
+        (*count)++;
+    }
+    fclose(stream);
+    return remotes;
+}
+
+static int compare_name(const void *a, const void *b)
+{
+    return strncmp(((const remote_t *) a)->name, ((const remote_t *) b)->name, IR_BUNDLE_NAME_SIZE);
+}
+
+static int compare_id(const void *a, const void *b)
+{
+    UINT id_a = (*(const remote_t * const *) a)->remote_id;
+    UINT id_b = (*(const remote_t * const *) b)->remote_id;
+    return (id_a > id_b) - (id_a < id_b);
+}
+
+static int pack(const char *bundle_name, const char *list_name)
+{
+    remote_t *remotes = NULL;
+    remote_t **by_id = NULL;
+    UINT count = 0;
+    UINT i = 0;
+    UINT length = 0;
+    UINT8 *bundle = NULL;
+    UINT8 *record = NULL;
+    FILE *stream = NULL;
+    int ret = -1;
+
+    remotes = read_list(list_name, &count);
+    if (NULL == remotes || 0 == count)
+    {
+        printf("no remote to pack\n");
+        free(remotes);
+        return -1;
+    }
+
+    // every binary must open as listed, a broken entry is found now instead of on a device
+    for (i = 0; i < count; i++)
+    {
+        remotes[i].binary = read_file(remotes[i].file_name, &remotes[i].length);
+        if (NULL == remotes[i].binary || remotes[i].length > 0xFFFF ||
+            IR_DECODE_SUCCEEDED != ir_decoder_open_binary(&decoder, (UINT8) remotes[i].category,
+                                                          (UINT8) remotes[i].sub_category,
+                                                          remotes[i].binary, (UINT16) remotes[i].length))
+        {
+            printf("failed to open %s as category %u / %u\n", remotes[i].file_name,
+                   remotes[i].category, remotes[i].sub_category);
+            ir_decoder_close(&decoder);
+            goto done;
+        }
+        ir_decoder_close(&decoder);
+    }
+
+    qsort(remotes, count, sizeof(remote_t), compare_name);
+    by_id = (remote_t **) malloc(count * sizeof(remote_t *));
+    if (NULL == by_id)
+    {
+        goto done;
+    }
+    for (i = 0; i < count; i++)
+    {
+        remotes[i].index = i;
+        by_id[i] = &remotes[i];
+    }
+    qsort(by_id, count, sizeof(remote_t *), compare_id);
+    for (i = 1; i < count; i++)
+    {
+        if (0 == compare_name(&remotes[i - 1], &remotes[i]) || by_id[i - 1]->remote_id == by_id[i]->remote_id)
+        {
+            printf("duplicated remote %s / %u\n", remotes[i].name, by_id[i]->remote_id);
+            goto done;
+        }
+    }
+
+    length = IR_BUNDLE_HEADER_SIZE + count * (IR_BUNDLE_RECORD_SIZE + IR_BUNDLE_ID_RECORD_SIZE);
+    for (i = 0; i < count; i++)
+    {
+        length = (length + IR_BUNDLE_ALIGNMENT - 1) / IR_BUNDLE_ALIGNMENT * IR_BUNDLE_ALIGNMENT;
+        remotes[i].offset = length;
+        length += remotes[i].length;
+    }
+
+    bundle = (UINT8 *) calloc(1, length);
+    if (NULL == bundle)
+    {
+        goto done;
+    }
+    memcpy(bundle, IR_BUNDLE_MAGIC, 4);
+    put_u16(bundle + 4, IR_BUNDLE_VERSION);
+    put_u32(bundle + 8, count);
+    put_u32(bundle + 12, length);
+    for (i = 0; i < count; i++)
+    {
+        record = bundle + IR_BUNDLE_HEADER_SIZE + i * IR_BUNDLE_RECORD_SIZE;
+        put_u32(record, remotes[i].remote_id);
+        record[4] = (UINT8) remotes[i].category;
+        record[5] = (UINT8) remotes[i].sub_category;
+        put_u32(record + 8, remotes[i].offset);
+        put_u32(record + 12, remotes[i].length);
+        memcpy(record + 16, remotes[i].name, strlen(remotes[i].name));
+
+        record = bundle + IR_BUNDLE_HEADER_SIZE + count * IR_BUNDLE_RECORD_SIZE + i * IR_BUNDLE_ID_RECORD_SIZE;
+        put_u32(record, by_id[i]->remote_id);
+        put_u32(record + 4, by_id[i]->index);
+
+        memcpy(bundle + remotes[i].offset, remotes[i].binary, remotes[i].length);
+    }
+
+    stream = fopen(bundle_name, "wb");
+    if (NULL == stream || 1 != fwrite(bundle, length, 1, stream))
+    {
+        printf("failed to write %s\n", bundle_name);
+    }
+    else
+    {
+        printf("%s: %u remotes, %u bytes\n", bundle_name, count, length);
+        ret = 0;
+    }
+    if (NULL != stream)
+    {
+        fclose(stream);
+    }
+
+done:
+    for (i = 0; i < count; i++)
+    {
+        free(remotes[i].binary);
+    }
+    free(remotes);
+    free(by_id);
+    free(bundle);
+    return ret;
+}
+
+static int list(const char *bundle_name)
+{
+    ir_bundle_t bundle;
+    ir_bundle_item_t item;
+    UINT i = 0;
+
+    if (IR_DECODE_SUCCEEDED != ir_bundle_open_file(&bundle, bundle_name))
+    {
+        printf("failed to open bundle %s\n", bundle_name);
+        return -1;
+    }
+    for (i = 0; i < bundle.entry_count; i++)
+    {
+        if (IR_DECODE_SUCCEEDED != ir_bundle_get(&bundle, i, &item))
+        {
+            printf("entry %u is corrupted\n", i);
+            continue;
+        }
+        printf("%u %u %u %s %u\n", item.remote_id, item.category, item.sub_category, item.name,
+               item.binary_length);
+    }
+    ir_bundle_close(&bundle);
+    return 0;
+}
+
+static double now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec * 1e6 + (double) ts.tv_nsec / 1e3;
+}
+
+// write back and evict the pages of a file, so the next open reads it from storage
+static void drop_cached_pages(const char *file_name)
+{
+#if defined POSIX_FADV_DONTNEED
+    int fd = open(file_name, O_RDONLY);
+
+    if (fd >= 0)
+    {
+        fdatasync(fd);
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        close(fd);
+    }
+#endif
+}
+
+// open and close every remote of the file per remote layout, returns the number of failures
+static UINT open_files(remote_t *remotes, UINT count)
+{
+    UINT i = 0;
+    UINT failed = 0;
+
+    for (i = 0; i < count; i++)
+    {
+        if (IR_DECODE_SUCCEEDED != ir_decoder_open_file(&decoder, (UINT8) remotes[i].category,
+                                                        (UINT8) remotes[i].sub_category, remotes[i].file_name))
+        {
+            failed++;
+        }
+        ir_decoder_close(&decoder);
+    }
+    return failed;
+}
+
+// look up, open and close every remote of an opened bundle, returns the number of failures
+static UINT open_items(ir_bundle_t *bundle, remote_t *remotes, UINT count)
+{
+    ir_bundle_item_t item;
+    UINT i = 0;
+    UINT failed = 0;
+
+    for (i = 0; i < count; i++)
+    {
+        if (IR_DECODE_SUCCEEDED != ir_bundle_find_name(bundle, remotes[i].name, &item) ||
+            IR_DECODE_SUCCEEDED != ir_decoder_open_bundle_item(&decoder, &item))
+        {
+            failed++;
+        }
+        ir_decoder_close(&decoder);
+    }
+    return failed;
+}
+
+static int bench(const char *bundle_name, const char *list_name, UINT rounds)
+{
+    remote_t *remotes = NULL;
+    ir_bundle_t bundle;
+    UINT count = 0;
+    UINT i = 0;
+    UINT failed = 0;
+    double start = 0;
+    double files_cold = 0;
+    double files_warm = 0;
+    double bundle_cold = 0;
+    double bundle_warm = 0;
+
+    remotes = read_list(list_name, &count);
+    if (NULL == remotes || 0 == count || 0 == rounds)
+    {
+        printf("no remote to open\n");
+        free(remotes);
+        return -1;
+    }
+
+    // cold: page cache dropped, every remote opened once
+    for (i = 0; i < count; i++)
+    {
+        drop_cached_pages(remotes[i].file_name);
+    }
+    start = now_us();
+    failed += open_files(remotes, count);
+    files_cold = now_us() - start;
+
+    drop_cached_pages(bundle_name);
+    start = now_us();
+    if (IR_DECODE_SUCCEEDED != ir_bundle_open_file(&bundle, bundle_name))
+    {
+        printf("failed to open bundle %s\n", bundle_name);
+        free(remotes);
+        return -1;
+    }
+    failed += open_items(&bundle, remotes, count);
+    bundle_cold = now_us() - start;
+
+    // warm: files in page cache and the bundle kept opened
+    start = now_us();
+    for (i = 0; i < rounds; i++)
+    {
+        failed += open_files(remotes, count);
+    }
+    files_warm = now_us() - start;
+
+    start = now_us();
+    for (i = 0; i < rounds; i++)
+    {
+        failed += open_items(&bundle, remotes, count);
+    }
+    bundle_warm = now_us() - start;
+    ir_bundle_close(&bundle);
+
+    printf("remotes: %u, warm rounds: %u, failed opens: %u\n", count, rounds, failed);
+    printf("%-18s %14s %14s\n", "layout", "cold us/open", "warm us/open");
+    printf("%-18s %14.2f %14.2f\n", "file per remote", files_cold / count, files_warm / count / rounds);
+    printf("%-18s %14.2f %14.2f\n", "bundle", bundle_cold / count, bundle_warm / count / rounds);
+#if !defined POSIX_FADV_DONTNEED
+    printf("page cache could not be dropped, cold numbers are warm\n");
+#endif
+
+    free(remotes);
+    return 0 == failed ? 0 : -1;
+}
+
+int main(int argc, char *argv[])
+{
+    if (4 == argc && 0 == strcmp(argv[1], "pack"))
+    {
+        return pack(argv[2], argv[3]);
+    }
+    if (3 == argc && 0 == strcmp(argv[1], "list"))
+    {
+        return list(argv[2]);
+    }
+    if ((4 == argc || 5 == argc) && 0 == strcmp(argv[1], "bench"))
+    {
+        return bench(argv[2], argv[3], 5 == argc ? (UINT) atoi(argv[4]) : DEFAULT_ROUNDS);
+    }
+
+    printf("usage: %s pack <bundle> <list>\n", argv[0]);
+    printf("       %s list <bundle>\n", argv[0]);
+    printf("       %s bench <bundle> <list> [warm rounds]\n", argv[0]);
+    printf("list lines: <remote id> <category> <sub_category> <remote map name> <binary file>\n");
+    return -1;
+}
@@ -0,0 +1,395 @@
+/**************************************************************************************
+Filename:       ir_codec.c
+Revised:        Date: 2026-10-17
+Revision:       Revision: 1.0
+
+Description:    This file provides the compact encoding of decoded IR timings for transport
+
+Revision log:
+* 2026-10-17: created by agent
+**************************************************************************************/
+
+#include <string.h>
+
+#include "../include/ir_codec.h"
+#include "../include/ir_decode.h"
+
+#define SEGMENT_SIZE                 6
+
+/*
+ * the encoder works in the output buffer only, the dictionary is looked up where it is written
+ * so that nothing but the buffers of the caller is needed on a MCU
+ */
+typedef struct codec_writer
+{
+    UINT8 *data;
+    UINT16 capacity;
+    UINT16 used;
+    UINT bits;
+    UINT8 bit_count;
+    BOOL failed;
+} codec_writer_t;
+
+// where each part of encoded timings is, checked against the length of data
+typedef struct codec_layout
+{
+    UINT8 dictionary_size;
+    UINT8 width;
+    UINT16 dictionary_offset;
+    UINT8 segment_count;
+    UINT16 segment_offset;
+    UINT16 symbol_offset;
+} codec_layout_t;
+
+static UINT16 get_u16(const UINT8 *p);
+static UINT8 symbol_width(UINT8 dictionary_size);
+
+
+static void put_byte(codec_writer_t *writer, UINT8 value)
+{
+    if (writer->used >= writer->capacity)
+    {
+        writer->failed = TRUE;
+        return;
+    }
+    writer->data[writer->used++] = value;
+}
+
+static void put_u16(codec_writer_t *writer, UINT16 value)
+{
+    put_byte(writer, (UINT8) (value & 0xFF));
+    put_byte(writer, (UINT8) (value >> 8));
+}
+
+static void put_symbol(codec_writer_t *writer, UINT8 symbol, UINT8 width)
+{
+    writer->bits |= (UINT) symbol << writer->bit_count;
+    writer->bit_count = (UINT8) (writer->bit_count + width);
+    while (writer->bit_count >= 8)
+    {
+        put_byte(writer, (UINT8) (writer->bits & 0xFF));
+        writer->bits >>= 8;
+        writer->bit_count = (UINT8) (writer->bit_count - 8);
+    }
+}
+
+static void flush_symbols(codec_writer_t *writer)
+{
+    if (0 != writer->bit_count)
+    {
+        put_byte(writer, (UINT8) (writer->bits & 0xFF));
+    }
+    writer->bits = 0;
+    writer->bit_count = 0;
+}
+
+// index of a duration in the dictionary written at data + 2, the dictionary grows by the duration if not found
+static INT find_duration(codec_writer_t *writer, UINT16 *dictionary_size, UINT16 duration, BOOL grow)
+{
+    UINT16 i = 0;
+
+    for (i = 0; i < *dictionary_size; i++)
+    {
+        if (get_u16(writer->data + 2 + i * 2) == duration)
+        {
+            return (INT) i;
+        }
+    }
+    if (FALSE == grow || *dictionary_size == IR_CODEC_DICTIONARY_MAX)
+    {
+        return -1;
+    }
+    put_u16(writer, duration);
+    if (TRUE == writer->failed)
+    {
+        return -1;
+    }
+    return (INT) (*dictionary_size)++;
+}
+
+static BOOL segment_valid(const ir_waveform_t *waveform, const ir_segment_t *segment)
+{
+    return (0 != segment->length && 0 != segment->repeat &&
+            (UINT) segment->offset + segment->length <= waveform->used) ? TRUE : FALSE;
+}
+
+static BOOL parse_layout(const UINT8 *data, UINT16 length, codec_layout_t *layout)
+{
+    UINT total_bits = 0;
+    UINT8 i = 0;
+
+    if (NULL == data || length < 3 || IR_CODEC_VERSION != data[0] || 0 == data[1])
+    {
+        return FALSE;
+    }
+    layout->dictionary_size = data[1];
+    layout->width = symbol_width(layout->dictionary_size);
+    layout->dictionary_offset = 2;
+    layout->segment_offset = (UINT16) (layout->dictionary_offset + layout->dictionary_size * 2 + 1);
+    if (layout->segment_offset > length)
+    {
+        return FALSE;
+    }
+    layout->segment_count = data[layout->segment_offset - 1];
+    layout->symbol_offset = (UINT16) (layout->segment_offset + layout->segment_count * SEGMENT_SIZE);
+    if (layout->symbol_offset > length)
+    {
+        return FALSE;
+    }
+    for (i = 0; i < layout->segment_count; i++)
+    {
+        total_bits += (UINT) get_u16(data + layout->segment_offset + i * SEGMENT_SIZE) * layout->width;
+    }
+    return (total_bits <= (UINT) (length - layout->symbol_offset) * 8) ? TRUE : FALSE;
+}
+
+static void get_segment(const UINT8 *data, const codec_layout_t *layout, UINT8 index, ir_segment_t *segment)
+{
+    const UINT8 *p = data + layout->segment_offset + index * SEGMENT_SIZE;
+
+    segment->offset = 0;
+    segment->length = get_u16(p);
+    segment->repeat = get_u16(p + 2);
+    segment->gap = get_u16(p + 4);
+}
+
+// durations of count symbols from bit_pos on, FALSE on a symbol out of the dictionary
+static BOOL get_span(const UINT8 *data, const codec_layout_t *layout, UINT bit_pos, UINT16 count, UINT16 *timings)
+{
+    const UINT8 *symbols = data + layout->symbol_offset;
+    UINT8 mask = (UINT8) ((1 << layout->width) - 1);
+    UINT byte = 0;
+    UINT8 shift = 0;
+    UINT16 value = 0;
+    UINT16 i = 0;
+
+    for (i = 0; i < count; i++)
+    {
+        byte = bit_pos >> 3;
+        shift = (UINT8) (bit_pos & 0x07);
+        value = symbols[byte];
+        if (shift + layout->width > 8)
+        {
+            value = (UINT16) (value | (symbols[byte + 1] << 8));
+        }
+        value = (UINT16) ((value >> shift) & mask);
+        if (value >= layout->dictionary_size)
+        {
+            return FALSE;
+        }
+        timings[i] = get_u16(data + layout->dictionary_offset + value * 2);
+        bit_pos += layout->width;
+    }
+    return TRUE;
+}
+
+
+INT8 ir_codec_encode_waveform(const ir_waveform_t *waveform, UINT8 *data, UINT16 capacity, UINT16 *length)
+{
+    codec_writer_t writer;
+    const ir_segment_t *segment = NULL;
+    UINT16 dictionary_size = 0;
+    UINT16 segment_count = 0;
+    UINT16 i = 0;
+    UINT16 j = 0;
+    UINT8 width = 0;
+
+    if (NULL == waveform || NULL == waveform->timings || NULL == data || NULL == length)
+    {
+        return IR_DECODE_FAILED;
+    }
+    ir_memset(&writer, 0x00, sizeof(codec_writer_t));
+    writer.data = data;
+    writer.capacity = capacity;
+
+    // version and dictionary size, then the dictionary of every duration of every span
+    put_byte(&writer, IR_CODEC_VERSION);
+    put_byte(&writer, 0);
+    for (i = 0; i < waveform->segment_count; i++)
+    {
+        segment = &waveform->segments[i];
+        if (FALSE == segment_valid(waveform, segment))
+        {
+            continue;
+        }
+        for (j = 0; j < segment->length; j++)
+        {
+            if (find_duration(&writer, &dictionary_size, waveform->timings[segment->offset + j], TRUE) < 0)
+            {
+                return IR_DECODE_FAILED;
+            }
+        }
+        segment_count++;
+    }
+    if (TRUE == writer.failed || 0 == segment_count)
+    {
+        return IR_DECODE_FAILED;
+    }
+    data[1] = (UINT8) dictionary_size;
+    width = symbol_width((UINT8) dictionary_size);
+
+    put_byte(&writer, (UINT8) segment_count);
+    for (i = 0; i < waveform->segment_count; i++)
+    {
+        segment = &waveform->segments[i];
+        if (TRUE == segment_valid(waveform, segment))
+        {
+            put_u16(&writer, segment->length);
+            put_u16(&writer, segment->repeat);
+            put_u16(&writer, segment->gap);
+        }
+    }
+    for (i = 0; i < waveform->segment_count; i++)
+    {
+        segment = &waveform->segments[i];
+        for (j = 0; TRUE == segment_valid(waveform, segment) && j < segment->length; j++)
+        {
+            put_symbol(&writer, (UINT8) find_duration(&writer, &dictionary_size,
+                                                      waveform->timings[segment->offset + j], FALSE), width);
+        }
+    }
+    flush_symbols(&writer);
+    if (TRUE == writer.failed)
+    {
+        return IR_DECODE_FAILED;
+    }
+    *length = writer.used;
+    return IR_DECODE_SUCCEEDED;
+}
+
+INT8 ir_codec_encode(const UINT16 *timings, UINT16 count, UINT8 *data, UINT16 capacity, UINT16 *length)
+{
+    ir_waveform_t waveform;
+    UINT16 period = 0;
+
+    if (NULL == timings || 0 == count)
+    {
+        return IR_DECODE_FAILED;
+    }
+
+    // the shortest frame the timings are whole repeats of, repeated frames are written back to back
+    for (period = 1; period < count; period++)
+    {
+        if (0 == count % period && 0 == memcmp(timings, timings + period, (count - period) * sizeof(UINT16)))
+        {
+            break;
+        }
+    }
+    ir_waveform_init(&waveform, (UINT16 *) timings, count);
+    waveform.used = count;
+    waveform.segments[0].offset = 0;
+    waveform.segments[0].length = period;
+    waveform.segments[0].repeat = (UINT16) (count / period);
+    waveform.segments[0].gap = 0;
+    waveform.segment_count = 1;
+    return ir_codec_encode_waveform(&waveform, data, capacity, length);
+}
+
+UINT16 ir_codec_decode(const UINT8 *data, UINT16 length, UINT16 *user_data, UINT16 capacity)
+{
+    codec_layout_t layout;
+    ir_segment_t segment;
+    UINT bit_pos = 0;
+    UINT16 used = 0;
+    UINT16 start = 0;
+    UINT16 repeat = 0;
+    UINT8 i = 0;
+
+    if (NULL == user_data || FALSE == parse_layout(data, length, &layout))
+    {
+        return 0;
+    }
+    for (i = 0; i < layout.segment_count; i++)
+    {
+        get_segment(data, &layout, i, &segment);
+        start = used;
+        for (repeat = 0; repeat < segment.repeat; repeat++)
+        {
+            if ((UINT) used + segment.length > capacity)
+            {
+                return 0;
+            }
+            if (0 == repeat)
+            {
+                if (FALSE == get_span(data, &layout, bit_pos, segment.length, user_data + used))
+                {
+                    return 0;
+                }
+            }
+            else
+            {
+                ir_memcpy(user_data + used, user_data + start, segment.length * sizeof(UINT16));
+            }
+            used = (UINT16) (used + segment.length);
+            if (0 == segment.gap || 0 == segment.length || repeat + 1 == segment.repeat)
+            {
+                continue;
+            }
+            // a gap between repeats as ir_waveform_flatten puts it
+            if (0 == (segment.length & 0x01))
+            {
+                user_data[used - 1] = (UINT16) (user_data[used - 1] + segment.gap);
+            }
+            else if (used < capacity)
+            {
+                user_data[used++] = segment.gap;
+            }
+            else
+            {
+                return 0;
+            }
+        }
+        bit_pos += (UINT) segment.length * layout.width;
+    }
+    return used;
+}
+
+UINT16 ir_codec_decode_waveform(const UINT8 *data, UINT16 length, ir_waveform_t *waveform)
+{
+    codec_layout_t layout;
+    ir_segment_t *segment = NULL;
+    UINT bit_pos = 0;
+    UINT8 i = 0;
+
+    if (NULL == waveform || NULL == waveform->timings || FALSE == parse_layout(data, length, &layout) ||
+        layout.segment_count > IR_WAVEFORM_SEGMENT_MAX)
+    {
+        return 0;
+    }
+    waveform->used = 0;
+    waveform->segment_count = 0;
+    for (i = 0; i < layout.segment_count; i++)
+    {
+        segment = &waveform->segments[i];
+        get_segment(data, &layout, i, segment);
+        segment->offset = waveform->used;
+        if ((UINT) waveform->used + segment->length > waveform->capacity ||
+            FALSE == get_span(data, &layout, bit_pos, segment->length, waveform->timings + waveform->used))
+        {
+            waveform->used = 0;
+            return 0;
+        }
+        waveform->used = (UINT16) (waveform->used + segment->length);
+        bit_pos += (UINT) segment->length * layout.width;
+    }
+    waveform->segment_count = layout.segment_count;
+    return waveform->used;
+}
+
+
+static UINT16 get_u16(const UINT8 *p)
+{
+    return (UINT16) (p[0] | (p[1] << 8));
+}
+
+// bits to tell dictionary_size symbols apart, a dictionary of a single duration needs none
+static UINT8 symbol_width(UINT8 dictionary_size)
+{
+    UINT8 width = 0;
+
+    while ((1U << width) < dictionary_size)
+    {
+        width++;
+    }
+    return width;
+}
@@ -0,0 +1,268 @@
+/**************************************************************************************
+Filename:       ir_codec_bench_main.c
+Revised:        Date: 2026-10-17
+Revision:       Revision: 1.0
+
+Description:    This file provides the round trip check and benchmark of IR timing encoding
+
+Revision log:
+* 2026-10-17: created by agent
+**************************************************************************************/
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../include/ir_defs.h"
+#include "../include/ir_decode.h"
+#include "../include/ir_codec.h"
+
+#define DEFAULT_ROUNDS               10
+#define BINARY_SIZE_MAX              0xFFFF
+// an encoding is never larger than the timings themselves plus its header
+#define ENCODED_SIZE_MAX             (USER_DATA_SIZE * 2 + IR_CODEC_DICTIONARY_MAX * 2 + 16)
+
+typedef struct frame
+{
+    UINT16 *timings;
+    UINT16 count;
+} frame_t;
+
+static UINT8 binary[BINARY_SIZE_MAX];
+static UINT16 user_data[USER_DATA_SIZE];
+static UINT16 flattened[USER_DATA_SIZE];
+static UINT16 decoded[USER_DATA_SIZE];
+static UINT8 encoded[ENCODED_SIZE_MAX];
+static ir_decoder_t decoder;
+
+static frame_t *frames = NULL;
+static UINT frame_count = 0;
+static UINT frame_capacity = 0;
+static UINT waveform_count = 0;
+static UINT waveform_mismatched = 0;
+
+static double now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec * 1e6 + (double) ts.tv_nsec / 1e3;
+}
+
+static UINT16 read_binary(const char *file_name)
+{
+    FILE *stream = fopen(file_name, "rb");
+    size_t length = 0;
+
+    if (NULL == stream)
+    {
+        return 0;
+    }
+    length = fread(binary, 1, sizeof(binary), stream);
+    fclose(stream);
+    return (UINT16) length;
+}
+
+static void keep_frame(UINT16 count)
+{
+    frame_t *grown = NULL;
+
+    if (0 == count)
+    {
+        return;
+    }
+    if (frame_count == frame_capacity)
+    {
+        frame_capacity = (0 == frame_capacity) ? 1024 : frame_capacity * 2;
+        grown = (frame_t *) realloc(frames, frame_capacity * sizeof(frame_t));
+        if (NULL == grown)
+        {
+            return;
+        }
+        frames = grown;
+    }
+    frames[frame_count].timings = (UINT16 *) malloc(count * sizeof(UINT16));
+    if (NULL == frames[frame_count].timings)
+    {
+        return;
+    }
+    memcpy(frames[frame_count].timings, user_data, count * sizeof(UINT16));
+    frames[frame_count].count = count;
+    frame_count++;
+}
+
+// a waveform with its segments and gaps encoded as they are decodes to the waveform in full
+static void check_waveform(UINT8 key_code, remote_ac_status_t *ac_status)
+{
+    ir_waveform_t waveform;
+    UINT16 count = 0;
+    UINT16 length = 0;
+
+    ir_waveform_init(&waveform, user_data, USER_DATA_SIZE);
+    if (0 == ir_decoder_decode_waveform(&decoder, key_code, ac_status, FALSE, &waveform))
+    {
+        return;
+    }
+    waveform_count++;
+    count = ir_waveform_flatten(&waveform, flattened, USER_DATA_SIZE);
+    if (IR_DECODE_SUCCEEDED != ir_codec_encode_waveform(&waveform, encoded, sizeof(encoded), &length) ||
+        count != ir_codec_decode(encoded, length, decoded, USER_DATA_SIZE) ||
+        0 != memcmp(flattened, decoded, count * sizeof(UINT16)))
+    {
+        waveform_mismatched++;
+    }
+}
+
+// the power and mode keys of every mode for AC, the common keys for TV
+static void decode_frames(UINT8 category)
+{
+    remote_ac_status_t ac_status;
+    UINT8 modes = 0;
+    UINT mode = 0;
+    UINT key = 0;
+
+    if (IR_CATEGORY_AC != category)
+    {
+        for (key = 0; key < TV_KEY_MAX; key++)
+        {
+            keep_frame(ir_decoder_decode(&decoder, (UINT8) key, user_data, NULL, FALSE));
+        }
+        check_waveform(0, NULL);
+        return;
+    }
+    ir_decoder_get_supported_mode(&decoder, &modes);
+    memset(&ac_status, 0x00, sizeof(remote_ac_status_t));
+    ac_status.acTemp = AC_TEMP_24;
+    for (mode = 0; mode < AC_MODE_MAX; mode++)
+    {
+        if (0 != (modes & (1 << mode)))
+        {
+            ac_status.acMode = (ac_mode) mode;
+            keep_frame(ir_decoder_decode(&decoder, AC_FUNCTION_POWER, user_data, &ac_status, FALSE));
+            keep_frame(ir_decoder_decode(&decoder, AC_FUNCTION_MODE, user_data, &ac_status, FALSE));
+        }
+    }
+    check_waveform(AC_FUNCTION_POWER, &ac_status);
+    ac_status.acPower = AC_POWER_OFF;
+    keep_frame(ir_decoder_decode(&decoder, AC_FUNCTION_POWER, user_data, &ac_status, FALSE));
+}
+
+static UINT load_list(const char *list_name)
+{
+    FILE *list = fopen(list_name, "r");
+    char file_name[512];
+    char name[256];
+    UINT remote_id = 0;
+    UINT category = 0;
+    UINT sub_category = 0;
+    UINT remotes = 0;
+    UINT16 length = 0;
+
+    if (NULL == list)
+    {
+        return 0;
+    }
+    while (5 == fscanf(list, "%u %u %u %255s %511s", &remote_id, &category, &sub_category, name, file_name))
+    {
+        length = read_binary(file_name);
+        if (0 == length || IR_DECODE_SUCCEEDED != ir_decoder_open_binary(&decoder, (UINT8) category,
+                                                                        (UINT8) sub_category, binary, length))
+        {
+            printf("skip %s\n", file_name);
+            ir_decoder_close(&decoder);
+            continue;
+        }
+        decode_frames((UINT8) category);
+        ir_decoder_close(&decoder);
+        remotes++;
+    }
+    fclose(list);
+    return remotes;
+}
+
+int main(int argc, char *argv[])
+{
+    UINT rounds = DEFAULT_ROUNDS;
+    UINT remotes = 0;
+    UINT mismatched = 0;
+    UINT unencoded = 0;
+    UINT repeated = 0;
+    UINT largest_dictionary = 0;
+    UINT64 timings = 0;
+    UINT64 encoded_bytes = 0;
+    double start = 0;
+    double encode_us = 0;
+    double decode_us = 0;
+    UINT16 length = 0;
+    UINT round = 0;
+    UINT i = 0;
+
+    if (argc < 2 || argc > 3 || (3 == argc && 0 == (rounds = (UINT) atoi(argv[2]))))
+    {
+        printf("usage: %s <list> [rounds]\n", argv[0]);
+        printf("  every frame decoded from the remotes of the list, as read by ir_bundle, is encoded\n");
+        printf("  and decoded back, then encoded and decoded rounds times for throughput\n");
+        return -1;
+    }
+    remotes = load_list(argv[1]);
+    if (0 == frame_count)
+    {
+        printf("no frame decoded from %s\n", argv[1]);
+        return -1;
+    }
+
+    // round trip of every frame
+    for (i = 0; i < frame_count; i++)
+    {
+        timings += frames[i].count;
+        if (IR_DECODE_SUCCEEDED != ir_codec_encode(frames[i].timings, frames[i].count,
+                                                   encoded, sizeof(encoded), &length))
+        {
+            unencoded++;
+            continue;
+        }
+        encoded_bytes += length;
+        largest_dictionary = (encoded[1] > largest_dictionary) ? encoded[1] : largest_dictionary;
+        // repeat of the first segment, following the dictionary, the segment count and the segment length
+        repeated += (1 < (encoded[5 + encoded[1] * 2] | (encoded[6 + encoded[1] * 2] << 8))) ? 1 : 0;
+        if (frames[i].count != ir_codec_decode(encoded, length, decoded, USER_DATA_SIZE) ||
+            0 != memcmp(frames[i].timings, decoded, frames[i].count * sizeof(UINT16)))
+        {
+            mismatched++;
+        }
+    }
+
+    for (round = 0; round < rounds; round++)
+    {
+        for (i = 0; i < frame_count; i++)
+        {
+            start = now_us();
+            ir_codec_encode(frames[i].timings, frames[i].count, encoded, sizeof(encoded), &length);
+            encode_us += now_us() - start;
+            start = now_us();
+            ir_codec_decode(encoded, length, decoded, USER_DATA_SIZE);
+            decode_us += now_us() - start;
+        }
+    }
+
+    printf("remotes: %u, frames: %u, timings: %llu\n", remotes, frame_count, (unsigned long long) timings);
+    printf("round trip: %u mismatched, %u not encoded, %u frames with repeats, largest dictionary %u\n",
+           mismatched, unencoded, repeated, largest_dictionary);
+    printf("waveform round trip: %u of %u mismatched\n", waveform_mismatched, waveform_count);
+    printf("size: %llu bytes as UINT16, %llu bytes as 3 bytes per pulse, %llu bytes encoded, %.2fx smaller\n",
+           (unsigned long long) timings * 2, (unsigned long long) timings * 3,
+           (unsigned long long) encoded_bytes, (double) timings * 2 / (double) encoded_bytes);
+    printf("encode: %.0f frames/s, %.1f M timings/s\n", frame_count * rounds * 1e6 / encode_us,
+           (double) timings * rounds / encode_us);
+    printf("decode: %.0f frames/s, %.1f M timings/s\n", frame_count * rounds * 1e6 / decode_us,
+           (double) timings * rounds / decode_us);
+
+    for (i = 0; i < frame_count; i++)
+    {
+        free(frames[i].timings);
+    }
+    free(frames);
+    return (0 == mismatched && 0 == unencoded && 0 == waveform_mismatched) ? 0 : -1;
+}
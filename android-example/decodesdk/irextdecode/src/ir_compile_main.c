@@ -0,0 +1,142 @@
+/**************************************************************************************
+Filename:       ir_compile_main.c
+Revised:        Date: 2026-10-17
+Revision:       Revision: 1.0
+
+Description:    This file provides the offline compiler of AC binaries into precompiled images
+
+Revision log:
+* 2026-10-17: created by agent
+**************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/ir_defs.h"
+#include "../include/ir_decode.h"
+
+static ir_decoder_t source;
+static ir_decoder_t compiled;
+static UINT16 source_data[USER_DATA_SIZE];
+static UINT16 compiled_data[USER_DATA_SIZE];
+
+
+// decode every status with both decoders and count the outputs that differ
+static int verify(void)
+{
+    remote_ac_status_t ac_status;
+    UINT8 function_code = 0;
+    UINT8 mode = 0;
+    UINT8 temperature = 0;
+    UINT8 speed = 0;
+    UINT8 swing = 0;
+    UINT16 source_length = 0;
+    UINT16 compiled_length = 0;
+    int mismatches = 0;
+
+    memset(&ac_status, 0x00, sizeof(remote_ac_status_t));
+    for (function_code = AC_FUNCTION_POWER; function_code < AC_FUNCTION_MAX; function_code++)
+    {
+        for (mode = 0; mode < AC_MODE_MAX; mode++)
+        {
+            for (temperature = 0; temperature < AC_TEMP_MAX; temperature++)
+            {
+                for (speed = 0; speed < AC_WS_MAX; speed++)
+                {
+                    for (swing = 0; swing < AC_SWING_MAX; swing++)
+                    {
+                        ac_status.acPower = AC_POWER_ON;
+                        ac_status.acMode = (ac_mode) mode;
+                        ac_status.acTemp = (ac_temperature) temperature;
+                        ac_status.acWindSpeed = (ac_wind_speed) speed;
+                        ac_status.acWindDir = (ac_swing) swing;
+                        source_length = ir_decoder_decode(&source, function_code, source_data, &ac_status,
+                                                          AC_FUNCTION_WIND_SWING == function_code);
+                        compiled_length = ir_decoder_decode(&compiled, function_code, compiled_data, &ac_status,
+                                                            AC_FUNCTION_WIND_SWING == function_code);
+                        if (source_length != compiled_length ||
+                            0 != memcmp(source_data, compiled_data, source_length * sizeof(UINT16)))
+                        {
+                            mismatches++;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return mismatches;
+}
+
+int main(int argc, char *argv[])
+{
+    UINT8 *image = NULL;
+    UINT16 image_length = 0;
+    FILE *stream = NULL;
+    int mismatches = 0;
+
+    if (3 != argc)
+    {
+        printf("usage: %s <AC binary> <compiled output>\n", argv[0]);
+        return -1;
+    }
+
+    if (IR_DECODE_SUCCEEDED != ir_decoder_open_file(&source, IR_CATEGORY_AC, 0, argv[1]))
+    {
+        printf("failed to open AC binary %s\n", argv[1]);
+        ir_decoder_close(&source);
+        return -1;
+    }
+
+    if (IR_DECODE_SUCCEEDED != ir_decoder_compile(&source, NULL, &image_length))
+    {
+        printf("AC binary %s could not be compiled\n", argv[1]);
+        ir_decoder_close(&source);
+        return -1;
+    }
+    image = (UINT8 *) malloc(image_length);
+    if (NULL == image || IR_DECODE_SUCCEEDED != ir_decoder_compile(&source, image, &image_length))
+    {
+        printf("failed to compile AC binary %s\n", argv[1]);
+        free(image);
+        ir_decoder_close(&source);
+        return -1;
+    }
+
+    // the image must decode exactly as the source does before it is written out
+    if (IR_DECODE_SUCCEEDED != ir_decoder_open_binary(&compiled, IR_CATEGORY_AC, 0, image, image_length))
+    {
+        printf("failed to load compiled image\n");
+        mismatches = -1;
+    }
+    else
+    {
+        mismatches = verify();
+    }
+    ir_decoder_close(&compiled);
+    ir_decoder_close(&source);
+
+    if (0 != mismatches)
+    {
+        printf("compiled image does not match the source (%d)\n", mismatches);
+        free(image);
+        return -1;
+    }
+
+    stream = fopen(argv[2], "wb");
+    if (NULL == stream || 1 != fwrite(image, image_length, 1, stream))
+    {
+        printf("failed to write %s\n", argv[2]);
+        if (NULL != stream)
+        {
+            fclose(stream);
+        }
+        free(image);
+        return -1;
+    }
+    fclose(stream);
+    free(image);
+
+    printf("%s -> %s, %d bytes\n", argv[1], argv[2], image_length);
+    return 0;
+}
@@ -14,28 +14,27 @@ Revision log:
 
 #include <string.h>
 
+#if !defined NO_FS && !defined NO_MMAP && (defined __linux__ || defined __APPLE__)
+#define USE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// AC frames are patched rather than rebuilt when a key press changes little, not with the apply table
+#if !defined NO_AC_DELTA && !defined USE_APPLY_TABLE
+#define USE_AC_DELTA
+#endif
+
 #include "../include/ir_decode.h"
 #include "../include/ir_utils.h"
 #include "../include/ir_ac_build_frame.h"
 #include "../include/ir_ac_apply.h"
 
-struct ir_bin_buffer binary_file;
-struct ir_bin_buffer *p_ir_buffer = &binary_file;
-struct tag_head *tags;
-
-
-UINT8 *ir_hex_code = NULL;
-UINT8 ir_hex_len = 0;
-
-UINT8 byteArray[PROTOCOL_SIZE] = {0};
-
-size_t binary_length = 0;
-UINT8 *binary_content = NULL;
-
-UINT8 ir_binary_type = IR_TYPE_STATUS;
-UINT8 ir_hexadecimal = SUB_CATEGORY_QUATERNARY;
-
-protocol *context = (protocol *) byteArray;
+static ir_decoder_t default_decoder;
+static ir_ac_cache_t *default_cache = NULL;
+static BOOL ac_lazy = FALSE;
 
 lp_apply_ac_parameter apply_table[AC_APPLY_MAX] =
 {
@@ -48,17 +47,43 @@ lp_apply_ac_parameter apply_table[AC_APPLY_MAX] =
     apply_swing
 };
 
+// tag groups read by each entry of apply_table
+static const UINT16 apply_groups[AC_APPLY_MAX] =
+{
+    AC_TAG_GROUP_POWER,
+    AC_TAG_GROUP_MODE,
+    AC_TAG_GROUP_TEMPERATURE,
+    AC_TAG_GROUP_TEMPERATURE,
+    AC_TAG_GROUP_WIND_SPEED,
+    AC_TAG_GROUP_SWING,
+    AC_TAG_GROUP_SWING
+};
+
 // static functions declarations
-static INT8 ir_ac_file_open(const char *file_name);
-static INT8 ir_ac_lib_open(UINT8 *binary, UINT16 binary_length);
-static UINT16 ir_ac_lib_control(remote_ac_status_t ac_status, UINT16 *user_data, UINT8 function_code,
-                                BOOL change_wind_direction);
-static INT8 ir_ac_lib_close();
-static INT8 ir_tv_file_open(const char *file_name);
-static INT8 ir_tv_lib_open(UINT8 *binary, UINT16 binary_length);
-static INT8 ir_tv_lib_parse(UINT8 ir_hex_encode);
-static UINT16 ir_tv_lib_control(UINT8 key, UINT16 *l_user_data);
-static INT8 ir_tv_lib_close();
+static INT8 ir_ac_file_open(ir_decoder_t *decoder, const char *file_name);
+static INT8 ir_ac_lib_open(ir_decoder_t *decoder, UINT8 *binary, UINT16 binary_length);
+static INT8 ir_ac_lib_load(ir_decoder_t *decoder);
+static INT8 ir_ac_lib_prepare(ir_decoder_t *decoder, remote_ac_status_t *ac_status, UINT8 function_code);
+static UINT ir_decode_output(ir_decoder_t *decoder, UINT8 key_code, remote_ac_status_t *ac_status,
+                             BOOL change_wind_direction, ir_output_t *output);
+static UINT ir_ac_lib_control(ir_decoder_t *decoder, remote_ac_status_t ac_status, ir_output_t *output,
+                              UINT8 function_code, BOOL change_wind_direction);
+static UINT ir_ac_lib_render(ir_decoder_t *decoder, remote_ac_status_t ac_status, ir_output_t *output,
+                             UINT8 function_code, BOOL change_wind_direction);
+static INT8 ir_ac_lib_apply(ir_decoder_t *decoder, remote_ac_status_t ac_status, UINT8 function_code);
+static INT8 ir_ac_lib_rebuild(protocol *context, remote_ac_status_t ac_status, UINT8 function_code);
+static UINT16 ir_ac_lib_length(ir_decoder_t *decoder, remote_ac_status_t ac_status, UINT8 function_code,
+                               BOOL change_wind_direction);
+static INT8 ir_ac_lib_close(ir_decoder_t *decoder);
+static INT8 ir_tv_file_open(ir_decoder_t *decoder, const char *file_name);
+static INT8 ir_tv_lib_open(ir_decoder_t *decoder, UINT8 *binary, UINT16 binary_length);
+static INT8 ir_tv_lib_parse(ir_decoder_t *decoder, UINT8 ir_hex_encode);
+static UINT ir_tv_lib_control(ir_decoder_t *decoder, UINT8 key, ir_output_t *output);
+static INT8 ir_tv_lib_close(ir_decoder_t *decoder);
+#if !defined NO_FS
+static INT8 ir_load_file(ir_decoder_t *decoder, const char *file_name);
+#endif
+static void ir_release_file(ir_decoder_t *decoder);
 
 
 void noprint(const char *fmt, ...)
@@ -68,16 +93,24 @@ void noprint(const char *fmt, ...)
 
 // pubic function definitions
 
-INT8 ir_file_open(const UINT8 category, const UINT8 sub_category, const char* file_name)
+INT8 ir_decoder_open_file(ir_decoder_t *decoder, const UINT8 category, const UINT8 sub_category,
+                          const char* file_name)
 {
     INT8 ret = IR_DECODE_SUCCEEDED;
+
+    if (NULL == decoder)
+    {
+        return IR_DECODE_FAILED;
+    }
+    ir_memset(decoder, 0x00, sizeof(ir_decoder_t));
+
     if (category == IR_CATEGORY_AC)
     {
-        ir_binary_type = IR_TYPE_STATUS;
-        ret = ir_ac_file_open(file_name);
+        decoder->binary_type = IR_TYPE_STATUS;
+        ret = ir_ac_file_open(decoder, file_name);
         if (IR_DECODE_SUCCEEDED == ret)
         {
-            return ir_ac_lib_parse();
+            return ir_ac_lib_load(decoder);
         }
         else
         {
@@ -86,24 +119,24 @@ INT8 ir_file_open(const UINT8 category, const UINT8 sub_category, const char* fi
     }
     else
     {
-        ir_binary_type = IR_TYPE_COMMANDS;
+        decoder->binary_type = IR_TYPE_COMMANDS;
         if (1 == sub_category)
         {
-            ir_hexadecimal = SUB_CATEGORY_QUATERNARY;
+            decoder->hexadecimal = SUB_CATEGORY_QUATERNARY;
         }
         else if (2 == sub_category)
         {
-            ir_hexadecimal = SUB_CATEGORY_HEXADECIMAL;
+            decoder->hexadecimal = SUB_CATEGORY_HEXADECIMAL;
         }
         else
         {
             return IR_DECODE_FAILED;
         }
 
-        ret = ir_tv_file_open(file_name);
+        ret = ir_tv_file_open(decoder, file_name);
         if (IR_DECODE_SUCCEEDED == ret)
         {
-            return ir_tv_lib_parse(ir_hexadecimal);
+            return ir_tv_lib_parse(decoder, decoder->hexadecimal);
         }
         else
         {
@@ -113,57 +146,634 @@ INT8 ir_file_open(const UINT8 category, const UINT8 sub_category, const char* fi
 }
 
 
-INT8 ir_binary_open(const UINT8 category, const UINT8 sub_category, UINT8* binary, UINT16 binary_length)
+INT8 ir_decoder_open_binary(ir_decoder_t *decoder, const UINT8 category, const UINT8 sub_category,
+                            UINT8* binary, UINT16 binary_length)
 {
     INT8 ret = IR_DECODE_SUCCEEDED;
 
+    if (NULL == decoder)
+    {
+        return IR_DECODE_FAILED;
+    }
+    ir_memset(decoder, 0x00, sizeof(ir_decoder_t));
+
     if (category == IR_CATEGORY_AC)
     {
-        ir_binary_type = IR_TYPE_STATUS;
-        ret = ir_ac_lib_open(binary, binary_length);
-        if (IR_DECODE_SUCCEEDED == ret)
-        {
-            return ir_ac_lib_parse();
-        }
-        else
-        {
-            return ret;
-        }
+        decoder->binary_type = IR_TYPE_STATUS;
+        ret = ir_ac_lib_open(decoder, binary, binary_length);
+        if (IR_DECODE_SUCCEEDED == ret)
+        {
+            return ir_ac_lib_load(decoder);
+        }
+        else
+        {
+            return ret;
+        }
+    }
+    else
+    {
+        decoder->binary_type = IR_TYPE_COMMANDS;
+        if (1 == sub_category)
+        {
+            decoder->hexadecimal = SUB_CATEGORY_QUATERNARY;
+        }
+        else if (2 == sub_category)
+        {
+            decoder->hexadecimal = SUB_CATEGORY_HEXADECIMAL;
+        }
+        else
+        {
+            return IR_DECODE_FAILED;
+        }
+
+        ret = ir_tv_lib_open(decoder, binary, binary_length);
+        if (IR_DECODE_SUCCEEDED == ret)
+        {
+            return ir_tv_lib_parse(decoder, decoder->hexadecimal);
+        }
+        else
+        {
+            return ret;
+        }
+    }
+}
+
+
+INT8 ir_decoder_open_binary_in_place(ir_decoder_t *decoder, const UINT8 category, const UINT8 sub_category,
+                                     UINT8* binary, UINT16 binary_length)
+{
+    if (IR_CATEGORY_AC != category)
+    {
+        // command type binaries are not parsed into segments
+        return ir_decoder_open_binary(decoder, category, sub_category, binary, binary_length);
+    }
+
+    if (NULL == decoder || NULL == binary)
+    {
+        return IR_DECODE_FAILED;
+    }
+    ir_memset(decoder, 0x00, sizeof(ir_decoder_t));
+    decoder->binary_type = IR_TYPE_STATUS;
+    decoder->ac_in_place = TRUE;
+    ir_ac_lib_open(decoder, binary, binary_length);
+    return ir_ac_lib_load(decoder);
+}
+
+
+INT8 ir_decoder_open_binary_cached(ir_decoder_t *decoder, ir_ac_cache_t *cache,
+                                   const UINT8 category, const UINT8 sub_category,
+                                   UINT8* binary, UINT16 binary_length)
+{
+    ir_ac_cache_entry_t *entry = NULL;
+    UINT64 hash = 0;
+
+    if (NULL == cache || IR_CATEGORY_AC != category)
+    {
+        return ir_decoder_open_binary(decoder, category, sub_category, binary, binary_length);
+    }
+
+    if (NULL == decoder || NULL == binary)
+    {
+        return IR_DECODE_FAILED;
+    }
+    ir_memset(decoder, 0x00, sizeof(ir_decoder_t));
+    decoder->binary_type = IR_TYPE_STATUS;
+    ir_ac_lib_open(decoder, binary, binary_length);
+    if (ir_ac_is_compiled(binary, binary_length))
+    {
+        // nothing to parse, nothing to cache
+        return ir_ac_lib_load(decoder);
+    }
+    if (TRUE == ac_lazy || TRUE == ir_get_ac_arena())
+    {
+        // a shared protocol is parsed as a whole out of any arena, the modes asked for could not be kept
+        ir_printf("\ncached open does not support lazy or arena parsing\n");
+        return IR_DECODE_FAILED;
+    }
+
+    entry = ir_ac_cache_acquire(cache, binary, binary_length, &hash);
+    if (NULL == entry)
+    {
+        if (IR_DECODE_FAILED == ir_ac_lib_parse(decoder))
+        {
+            return IR_DECODE_FAILED;
+        }
+        // the decoder keeps owning what it parsed if the cache could not take it
+        decoder->ac_cache_entry = ir_ac_cache_insert(cache, hash, binary, binary_length,
+                                                     &decoder->ac);
+        return IR_DECODE_SUCCEEDED;
+    }
+
+    ir_memcpy(&decoder->ac, &entry->ac, sizeof(protocol));
+    decoder->ac_cache_entry = entry;
+    decoder->ac.ir_hex_code = (UINT8 *) ir_malloc(decoder->ac.default_code.len);
+    if (NULL == decoder->ac.ir_hex_code)
+    {
+        return IR_DECODE_FAILED;
+    }
+    decoder->ac.ir_hex_len = decoder->ac.default_code.len;
+    ir_memset(decoder->ac.ir_hex_code, 0x00, decoder->ac.ir_hex_len);
+    return IR_DECODE_SUCCEEDED;
+}
+
+
+void ir_set_ac_lazy(BOOL enable)
+{
+    ac_lazy = enable;
+}
+
+
+BOOL ir_get_ac_lazy()
+{
+    return ac_lazy;
+}
+
+
+INT8 ir_decoder_compile(ir_decoder_t *decoder, UINT8 *image, UINT16 *image_length)
+{
+    if (NULL == decoder || IR_TYPE_STATUS != decoder->binary_type ||
+        IR_DECODE_FAILED == ir_ac_lib_parse_groups(decoder, AC_TAG_GROUP_ALL))
+    {
+        return IR_DECODE_FAILED;
+    }
+    return ir_ac_compile(&decoder->ac, image, image_length);
+}
+
+
+INT8 ir_decoder_materialize(ir_decoder_t *decoder, size_t *memory_size)
+{
+    if (NULL == decoder || IR_TYPE_COMMANDS != decoder->binary_type)
+    {
+        return IR_DECODE_FAILED;
+    }
+    return tv_lib_materialize(&decoder->tv, memory_size);
+}
+
+
+INT8 ir_decoder_enable_memo(ir_decoder_t *decoder, size_t memory_budget)
+{
+    if (NULL == decoder || IR_TYPE_STATUS != decoder->binary_type || NULL != decoder->ac_memo)
+    {
+        return IR_DECODE_FAILED;
+    }
+    decoder->ac_memo = ir_ac_memo_create(memory_budget);
+    return (NULL == decoder->ac_memo) ? IR_DECODE_FAILED : IR_DECODE_SUCCEEDED;
+}
+
+
+INT8 ir_decoder_get_memo_stats(ir_decoder_t *decoder, ir_ac_memo_stats_t *stats)
+{
+    if (NULL == decoder || NULL == decoder->ac_memo || NULL == stats)
+    {
+        return IR_DECODE_FAILED;
+    }
+    ir_ac_memo_get_stats(decoder->ac_memo, stats);
+    return IR_DECODE_SUCCEEDED;
+}
+
+
+INT8 ir_decoder_get_delta_stats(ir_decoder_t *decoder, ir_ac_delta_stats_t *stats)
+{
+    if (NULL == decoder || IR_TYPE_STATUS != decoder->binary_type || NULL == stats)
+    {
+        return IR_DECODE_FAILED;
+    }
+    if (NULL == decoder->ac_delta)
+    {
+        // nothing decoded yet
+        ir_memset(stats, 0x00, sizeof(ir_ac_delta_stats_t));
+        return IR_DECODE_SUCCEEDED;
+    }
+    ir_ac_delta_get_stats(decoder->ac_delta, stats);
+    return IR_DECODE_SUCCEEDED;
+}
+
+
+UINT16 ir_decoder_decode(ir_decoder_t *decoder, UINT8 key_code, UINT16* user_data,
+                         remote_ac_status_t* ac_status, BOOL change_wind_direction)
+{
+    return ir_decoder_decode_into(decoder, key_code, user_data, USER_DATA_SIZE, ac_status, change_wind_direction);
+}
+
+
+UINT16 ir_decoder_decode_into(ir_decoder_t *decoder, UINT8 key_code, UINT16* user_data, UINT16 capacity,
+                              remote_ac_status_t* ac_status, BOOL change_wind_direction)
+{
+    ir_output_t output;
+
+    if (NULL == user_data || 0 == capacity)
+    {
+        return 0;
+    }
+    ir_output_init(&output, user_data, capacity, NULL, NULL);
+    ir_decode_output(decoder, key_code, ac_status, change_wind_direction, &output);
+
+    // a frame longer than the buffer is a failure rather than a truncated frame
+    return (TRUE == output.overflow) ? 0 : (UINT16) output.total;
+}
+
+
+UINT ir_decoder_decode_stream(ir_decoder_t *decoder, UINT8 key_code, remote_ac_status_t* ac_status,
+                              BOOL change_wind_direction, UINT16 *chunk, UINT16 chunk_size,
+                              ir_sink_t sink, void *sink_data)
+{
+    ir_output_t output;
+
+    if (NULL == chunk || chunk_size < 2 || NULL == sink)
+    {
+        return 0;
+    }
+    ir_output_init(&output, chunk, chunk_size, sink, sink_data);
+    ir_decode_output(decoder, key_code, ac_status, change_wind_direction, &output);
+    return ir_output_finish(&output);
+}
+
+
+UINT16 ir_decoder_decode_waveform(ir_decoder_t *decoder, UINT8 key_code, remote_ac_status_t* ac_status,
+                                  BOOL change_wind_direction, ir_waveform_t *waveform)
+{
+    ir_output_t output;
+    ir_segment_t *segment = NULL;
+
+    if (NULL == waveform || NULL == waveform->timings)
+    {
+        return 0;
+    }
+    waveform->used = 0;
+    waveform->segment_count = 0;
+    ir_output_init(&output, waveform->timings, waveform->capacity, NULL, NULL);
+    output.single_frame = TRUE;
+    ir_decode_output(decoder, key_code, ac_status, change_wind_direction, &output);
+    if (TRUE == output.overflow || 0 == output.total)
+    {
+        return 0;
+    }
+
+    waveform->used = (UINT16) output.total;
+    segment = &waveform->segments[waveform->segment_count++];
+    segment->offset = 0;
+    segment->length = waveform->used;
+    segment->repeat = output.repeat_times;
+    segment->gap = 0;
+    if (output.repeat_times < 2 || 1 == (waveform->used & 0x01))
+    {
+        // a frame ending with a mark runs into its next repeat without any silence
+        return waveform->used;
+    }
+
+    // the space ending a frame is the gap before its next repeat, the last repeat is followed by it on its own
+    segment->length = (UINT16) (waveform->used - 1);
+    segment->gap = waveform->timings[waveform->used - 1];
+    segment = &waveform->segments[waveform->segment_count++];
+    segment->offset = (UINT16) (waveform->used - 1);
+    segment->length = 1;
+    segment->repeat = 1;
+    segment->gap = 0;
+    return waveform->used;
+}
+
+
+UINT16 ir_decoder_decode_batch(ir_decoder_t *decoder, const ir_command_t *commands, UINT8 command_count,
+                               const ir_batch_gap_t *gap, UINT16 *user_data, UINT16 capacity,
+                               UINT16 *offsets)
+{
+    ir_output_t output;
+    remote_ac_status_t ac_status;
+    UINT16 used = 0;
+    UINT16 silence = 0;
+    UINT8 i = 0;
+
+    if (NULL == commands || NULL == user_data)
+    {
+        return 0;
+    }
+    for (i = 0; i < command_count; i++)
+    {
+        if (NULL != offsets)
+        {
+            offsets[i] = used;
+        }
+
+        // every command is rendered in place right after the previous one, nothing is copied afterwards
+        ac_status = commands[i].ac_status;
+        ir_output_init(&output, user_data + used, (UINT16) (capacity - used), NULL, NULL);
+        ir_decode_output(decoder, commands[i].key_code, &ac_status, commands[i].change_wind_direction, &output);
+        if (TRUE == output.overflow)
+        {
+            return 0;
+        }
+        used = (UINT16) (used + output.total);
+
+        silence = (NULL == gap) ? 0 : ((NULL != gap->gaps) ? gap->gaps[i] : gap->gap);
+        if (0 == output.total || 0 == silence || i + 1 == command_count)
+        {
+            continue;
+        }
+        if (0 == (output.total & 0x01))
+        {
+            // the gap lengthens the last space, as long as the space could tell it
+            user_data[used - 1] = (user_data[used - 1] > 0xFFFF - silence) ?
+                                  0xFFFF : (UINT16) (user_data[used - 1] + silence);
+        }
+        else if (used < capacity)
+        {
+            user_data[used++] = silence;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+    return used;
+}
+
+
+UINT16 ir_decoder_decode_length(ir_decoder_t *decoder, UINT8 key_code, remote_ac_status_t* ac_status,
+                                BOOL change_wind_direction)
+{
+    UINT length = 0;
+
+    if (NULL == decoder)
+    {
+        return 0;
+    }
+    if (IR_TYPE_COMMANDS == decoder->binary_type)
+    {
+        length = tv_lib_key_length(&decoder->tv, key_code);
+        return (length > 0xFFFF) ? 0 : (UINT16) length;
+    }
+    if (NULL == ac_status)
+    {
+        return 0;
+    }
+    return ir_ac_lib_length(decoder, *ac_status, key_code, change_wind_direction);
+}
+
+
+UINT16 ir_decoder_max_decode_length(ir_decoder_t *decoder)
+{
+    UINT length = 0;
+
+    if (NULL == decoder)
+    {
+        return 0;
+    }
+    if (IR_TYPE_COMMANDS == decoder->binary_type)
+    {
+        length = decoder->tv.max_length;
+    }
+    else if (0 != decoder->ac.default_code.len)
+    {
+        length = ac_frame_length(&decoder->ac);
+    }
+
+    // no buffer could hold more
+    return (length > 0xFFFF) ? 0xFFFF : (UINT16) length;
+}
+
+
+INT8 ir_decoder_close(ir_decoder_t *decoder)
+{
+    INT8 ret = IR_DECODE_SUCCEEDED;
+
+    if (NULL == decoder)
+    {
+        return IR_DECODE_FAILED;
+    }
+
+    if (IR_TYPE_COMMANDS == decoder->binary_type)
+    {
+        ret = ir_tv_lib_close(decoder);
+    }
+    else
+    {
+        ret = ir_ac_lib_close(decoder);
+    }
+
+    // binary loaded from file is owned by decoder
+    ir_release_file(decoder);
+    return ret;
+}
+
+
+INT8 ir_file_open(const UINT8 category, const UINT8 sub_category, const char* file_name)
+{
+    return ir_decoder_open_file(&default_decoder, category, sub_category, file_name);
+}
+
+
+INT8 ir_binary_open(const UINT8 category, const UINT8 sub_category, UINT8* binary, UINT16 binary_length)
+{
+    return ir_decoder_open_binary_cached(&default_decoder, default_cache, category, sub_category,
+                                         binary, binary_length);
+}
+
+INT8 ir_binary_open_in_place(const UINT8 category, const UINT8 sub_category, UINT8* binary, UINT16 binary_length)
+{
+    return ir_decoder_open_binary_in_place(&default_decoder, category, sub_category, binary, binary_length);
+}
+
+
+void ir_set_ac_cache(ir_ac_cache_t *cache)
+{
+    default_cache = cache;
+}
+
+
+UINT16 ir_decode(UINT8 key_code, UINT16* user_data, remote_ac_status_t* ac_status, BOOL change_wind_direction)
+{
+    return ir_decoder_decode(&default_decoder, key_code, user_data, ac_status, change_wind_direction);
+}
+
+
+UINT16 ir_decode_into(UINT8 key_code, UINT16* user_data, UINT16 capacity, remote_ac_status_t* ac_status,
+                      BOOL change_wind_direction)
+{
+    return ir_decoder_decode_into(&default_decoder, key_code, user_data, capacity, ac_status, change_wind_direction);
+}
+
+
+UINT16 ir_decode_waveform(UINT8 key_code, remote_ac_status_t* ac_status, BOOL change_wind_direction,
+                          ir_waveform_t *waveform)
+{
+    return ir_decoder_decode_waveform(&default_decoder, key_code, ac_status, change_wind_direction, waveform);
+}
+
+
+UINT16 ir_decode_batch(const ir_command_t *commands, UINT8 command_count, const ir_batch_gap_t *gap,
+                       UINT16 *user_data, UINT16 capacity, UINT16 *offsets)
+{
+    return ir_decoder_decode_batch(&default_decoder, commands, command_count, gap, user_data, capacity, offsets);
+}
+
+
+UINT16 ir_decode_length(UINT8 key_code, remote_ac_status_t* ac_status, BOOL change_wind_direction)
+{
+    return ir_decoder_decode_length(&default_decoder, key_code, ac_status, change_wind_direction);
+}
+
+
+UINT16 ir_max_decode_length()
+{
+    return ir_decoder_max_decode_length(&default_decoder);
+}
+
+INT8 ir_close()
+{
+    return ir_decoder_close(&default_decoder);
+}
+
+
+INT8 get_temperature_range(UINT8 ac_mode, INT8 *temp_min, INT8 *temp_max)
+{
+    return ir_decoder_get_temperature_range(&default_decoder, ac_mode, temp_min, temp_max);
+}
+
+
+INT8 get_supported_mode(UINT8 *supported_mode)
+{
+    return ir_decoder_get_supported_mode(&default_decoder, supported_mode);
+}
+
+
+INT8 get_supported_wind_speed(UINT8 ac_mode, UINT8 *supported_wind_speed)
+{
+    return ir_decoder_get_supported_wind_speed(&default_decoder, ac_mode, supported_wind_speed);
+}
+
+
+INT8 get_supported_swing(UINT8 ac_mode, UINT8 *supported_swing)
+{
+    return ir_decoder_get_supported_swing(&default_decoder, ac_mode, supported_swing);
+}
+
+
+INT8 get_supported_wind_direction(UINT8 *supported_wind_direction)
+{
+    return ir_decoder_get_supported_wind_direction(&default_decoder, supported_wind_direction);
+}
+
+
+// static function definitions
+
+//////// AC Begin ////////
+static INT8 ir_ac_file_open(ir_decoder_t *decoder, const char *file_name)
+{
+#if !defined NO_FS
+    if (IR_DECODE_FAILED == ir_load_file(decoder, file_name))
+    {
+        return IR_DECODE_FAILED;
+    }
+
+    if (IR_DECODE_FAILED == ir_ac_lib_open(decoder, decoder->binary_content, (UINT16) decoder->binary_length))
+    {
+        ir_release_file(decoder);
+        return IR_DECODE_FAILED;
+    }
+#endif
+    return IR_DECODE_SUCCEEDED;
+}
+
+static INT8 ir_ac_lib_open(ir_decoder_t *decoder, UINT8 *binary, UINT16 binary_length)
+{
+    // it is recommended that the parameter binary pointing to
+    // a global memory block in embedded platform environment
+    decoder->ac_buffer.data = binary;
+    decoder->ac_buffer.len = binary_length;
+    decoder->ac_buffer.offset = 0;
+    return IR_DECODE_SUCCEEDED;
+}
+
+static INT8 ir_ac_lib_load(ir_decoder_t *decoder)
+{
+    INT8 ret = IR_DECODE_SUCCEEDED;
+
+    if (ir_ac_is_compiled(decoder->ac_buffer.data, decoder->ac_buffer.len))
+    {
+        decoder->ac_compiled = (ir_ac_compiled_storage_t *) ir_malloc(sizeof(ir_ac_compiled_storage_t));
+        if (NULL == decoder->ac_compiled)
+        {
+            return IR_DECODE_FAILED;
+        }
+        if (IR_DECODE_FAILED == ir_ac_compiled_load(&decoder->ac, decoder->ac_compiled,
+                                                    decoder->ac_buffer.data, decoder->ac_buffer.len))
+        {
+            ir_free(decoder->ac_compiled);
+            decoder->ac_compiled = NULL;
+            return IR_DECODE_FAILED;
+        }
+        decoder->ac_precompiled = TRUE;
+        return IR_DECODE_SUCCEEDED;
+    }
+    if (FALSE == ir_get_ac_arena())
+    {
+        // tags parsed later on would not be in the arena, an arena is always filled on open
+        decoder->ac_lazy = ac_lazy;
+        return ir_ac_lib_parse(decoder);
+    }
+
+    if (IR_DECODE_FAILED == ir_arena_begin(&decoder->ac_arena, AC_ARENA_SIZE(decoder->ac_buffer.len)))
+    {
+        return IR_DECODE_FAILED;
+    }
+    ret = ir_ac_lib_parse(decoder);
+    ir_arena_end(&decoder->ac_arena);
+    return ret;
+}
+
+// parse the pending tag groups a rebuild of the status and function code reads
+static INT8 ir_ac_lib_prepare(ir_decoder_t *decoder, remote_ac_status_t *ac_status, UINT8 function_code)
+{
+    protocol *context = &decoder->ac;
+    UINT16 groups = AC_TAG_GROUP_FUNCTION | AC_TAG_GROUP_CHECKSUM;
+
+    if (0 == decoder->ac_pending)
+    {
+        return IR_DECODE_SUCCEEDED;
+    }
+    if ((UINT) ac_status->acPower >= AC_POWER_MAX || (UINT) ac_status->acMode >= AC_MODE_MAX ||
+        function_code < AC_FUNCTION_POWER || function_code >= AC_FUNCTION_MAX)
+    {
+        return ir_ac_lib_parse_groups(decoder, AC_TAG_GROUP_ALL);
+    }
+    if (AC_POWER_OFF == ac_status->acPower)
+    {
+        return ir_ac_lib_parse_groups(decoder, groups | AC_TAG_GROUP_POWER);
+    }
+
+    // the mode bans and the solo functions tell which steps of the rebuild are applied
+    if (IR_DECODE_FAILED == ir_ac_lib_parse_groups(decoder, AC_TAG_GROUP_BAN | AC_TAG_GROUP_SOLO))
+    {
+        return IR_DECODE_FAILED;
+    }
+    if (TRUE != context->n_mode[ac_status->acMode].enable)
+    {
+        // the rebuild fails on the mode alone
+        return IR_DECODE_SUCCEEDED;
+    }
+    if (is_solo_function(context, function_code))
+    {
+        groups |= apply_groups[function_code - 1];
     }
     else
     {
-        ir_binary_type = IR_TYPE_COMMANDS;
-        if (1 == sub_category)
-        {
-            ir_hexadecimal = SUB_CATEGORY_QUATERNARY;
-        }
-        else if (2 == sub_category)
-        {
-            ir_hexadecimal = SUB_CATEGORY_HEXADECIMAL;
-        }
-        else
-        {
-            return IR_DECODE_FAILED;
-        }
-
-        ret = ir_tv_lib_open(binary, binary_length);
-        if (IR_DECODE_SUCCEEDED == ret)
-        {
-            return ir_tv_lib_parse(ir_hexadecimal);
-        }
-        else
-        {
-            return ret;
-        }
+        groups |= AC_TAG_GROUP_POWER | AC_TAG_GROUP_MODE | AC_TAG_GROUP_TEMPERATURE |
+                  AC_TAG_GROUP_WIND_SPEED | AC_TAG_GROUP_SWING;
     }
+    return ir_ac_lib_parse_groups(decoder, groups);
 }
 
-
-UINT16 ir_decode(UINT8 key_code, UINT16* user_data, remote_ac_status_t* ac_status, BOOL change_wind_direction)
+static UINT ir_decode_output(ir_decoder_t *decoder, UINT8 key_code, remote_ac_status_t *ac_status,
+                             BOOL change_wind_direction, ir_output_t *output)
 {
-    if (IR_TYPE_COMMANDS == ir_binary_type)
+    if (NULL == decoder)
+    {
+        return 0;
+    }
+
+    if (IR_TYPE_COMMANDS == decoder->binary_type)
     {
-        return ir_tv_lib_control(key_code, user_data);
+        return ir_tv_lib_control(decoder, key_code, output);
     }
     else
     {
@@ -171,198 +781,206 @@ UINT16 ir_decode(UINT8 key_code, UINT16* user_data, remote_ac_status_t* ac_statu
         {
             return 0;
         }
-        return ir_ac_lib_control(*ac_status, user_data, key_code, change_wind_direction);
+        return ir_ac_lib_control(decoder, *ac_status, output, key_code, change_wind_direction);
     }
 }
 
-
-INT8 ir_close()
+static UINT ir_ac_lib_control(ir_decoder_t *decoder, remote_ac_status_t ac_status, ir_output_t *output,
+                              UINT8 function_code, BOOL change_wind_direction)
 {
-    if (IR_TYPE_COMMANDS == ir_binary_type)
+    protocol *context = &decoder->ac;
+    ir_ac_memo_key_t key;
+    ir_ac_memo_entry_t *entry = NULL;
+    UINT64 hash = 0;
+    UINT time_length = 0;
+
+    if (NULL == decoder->ac_memo ||
+        FALSE == ir_ac_memo_make_key(&key, &ac_status, function_code, change_wind_direction, context))
     {
-        return ir_tv_lib_close();
+        return ir_ac_lib_render(decoder, ac_status, output, function_code, change_wind_direction);
     }
-    else
+
+    // the swing state is part of the key and is restored as the render would have left it
+    entry = ir_ac_memo_lookup(decoder->ac_memo, &key, &hash);
+    if (NULL != entry)
     {
-        return ir_ac_lib_close();
+        if (TRUE == output->single_frame)
+        {
+            // the memoized frame is written out in full, every repeat is a copy of the first
+            output->repeat_times = (context->repeat_times > 1) ? context->repeat_times : 1;
+            ir_output_write(output, entry->timings, (UINT16) (entry->length / output->repeat_times));
+        }
+        else
+        {
+            ir_output_write(output, entry->timings, entry->length);
+        }
+        context->change_wind_direction = change_wind_direction;
+        context->swing_status = entry->swing_status;
+        context->si.dir_index = entry->dir_index;
+        context->time = output->buffer;
+        context->code_cnt = entry->length;
+        return output->total;
     }
-}
-
-
-#if (defined BOARD_PC || defined BOARD_PC_DLL)
-void ir_lib_free_inner_buffer();
-#endif
 
+    time_length = ir_ac_lib_render(decoder, ac_status, output, function_code, change_wind_direction);
 
-// static function definitions
-
-//////// AC Begin ////////
-static INT8 ir_ac_file_open(const char *file_name)
-{
-#if !defined NO_FS
-    size_t ret = 0;
-#if !defined WIN32
-    FILE *stream = fopen(file_name, "rb");
-#else
-    FILE *stream;
-    fopen_s(&stream, file_name, "rb");
-#endif
-    if (NULL == stream)
+    // a streamed frame is not kept as a whole and a single frame lacks its repeats, neither is memoized
+    if (NULL == output->sink && FALSE == output->overflow && FALSE == output->single_frame)
     {
-        ir_printf("\nfile open failed\n");
-        return IR_DECODE_FAILED;
+        ir_ac_memo_store(decoder->ac_memo, hash, &key, output->buffer, (UINT16) time_length, context);
     }
+    return time_length;
+}
 
-    fseek(stream, 0, SEEK_END);
-    binary_length = (size_t) ftell(stream);
-    binary_content = (UINT8 *) ir_malloc(binary_length);
+static INT8 ir_ac_lib_apply(ir_decoder_t *decoder, remote_ac_status_t ac_status, UINT8 function_code)
+{
+    protocol *context = &decoder->ac;
+    INT8 ret = IR_DECODE_SUCCEEDED;
 
-    if (NULL == binary_content)
+    if (IR_DECODE_FAILED == ir_ac_lib_prepare(decoder, &ac_status, function_code))
     {
-        ir_printf("\nfailed to alloc memory for binary\n");
-        fclose(stream);
         return IR_DECODE_FAILED;
     }
-
-    fseek(stream, 0, SEEK_SET);
-    ret = fread(binary_content, binary_length, 1, stream);
-
-    if (ret <= 0)
+#if defined USE_AC_DELTA
+    if (NULL == decoder->ac_delta && 0 == decoder->ac_pending)
     {
-        fclose(stream);
-        ir_free(binary_content);
-        binary_length = 0;
-        return IR_DECODE_FAILED;
+        // worked out on the first frame with every tag parsed, a remote only opened costs nothing
+        decoder->ac_delta = ir_ac_delta_create(context);
     }
-
-    fclose(stream);
-
-    if (IR_DECODE_FAILED == ir_ac_lib_open(binary_content, (UINT16) binary_length))
+    if (NULL != decoder->ac_delta &&
+        TRUE == ir_ac_delta_apply(decoder->ac_delta, context, &ac_status, function_code, &ret))
     {
-        ir_free(binary_content);
-        binary_length = 0;
-        return IR_DECODE_FAILED;
+        return ret;
     }
 #endif
-    return IR_DECODE_SUCCEEDED;
-}
-
-static INT8 ir_ac_lib_open(UINT8 *binary, UINT16 binary_length)
-{
-    // it is recommended that the parameter binary pointing to
-    // a global memory block in embedded platform environment
-    p_ir_buffer->data = binary;
-    p_ir_buffer->len = binary_length;
-    p_ir_buffer->offset = 0;
-    return IR_DECODE_SUCCEEDED;
+    ret = ir_ac_lib_rebuild(context, ac_status, function_code);
+#if defined USE_AC_DELTA
+    ir_ac_delta_record(decoder->ac_delta, context, &ac_status, function_code, ret);
+#endif
+    return ret;
 }
 
-static UINT16 ir_ac_lib_control(remote_ac_status_t ac_status, UINT16 *user_data, UINT8 function_code,
-                         BOOL change_wind_direction)
+static INT8 ir_ac_lib_rebuild(protocol *context, remote_ac_status_t ac_status, UINT8 function_code)
 {
-    UINT16 time_length = 0;
-
-#if defined BOARD_PC
+#if defined USE_APPLY_TABLE
     UINT8 i = 0;
 #endif
 
-    if (0 == context->default_code.len)
-    {
-        ir_printf("\ndefault code is empty\n");
-        return 0;
-    }
-
-    // pre-set change wind direction flag here
-    context->change_wind_direction = change_wind_direction;
-
-    context->time = user_data;
-
     // generate temp buffer for frame calculation
-    ir_memcpy(ir_hex_code, context->default_code.data, context->default_code.len);
+    ir_memcpy(context->ir_hex_code, context->default_code.data, context->default_code.len);
 
 #if defined USE_APPLY_TABLE
     if(ac_status.acPower != AC_POWER_OFF)
     {
         for (i = AC_APPLY_POWER; i < AC_APPLY_MAX; i++)
         {
-            apply_table[i](context, parameter_array[i]);
+            apply_table[i](context, ac_status, function_code);
         }
     }
 #else
     if (ac_status.acPower == AC_POWER_OFF)
     {
         // otherwise, power should always be applied
-        apply_power(ac_status, function_code);
+        apply_power(context, ac_status, function_code);
     }
     else
     {
         // check the mode as the first priority, despite any other status
         if (TRUE == context->n_mode[ac_status.acMode].enable)
         {
-            if (is_solo_function(function_code))
+            if (is_solo_function(context, function_code))
             {
                 // this key press function needs to send solo code
-                apply_table[function_code - 1](ac_status, function_code);
+                apply_table[function_code - 1](context, ac_status, function_code);
             }
             else
             {
-                if (!is_solo_function(AC_FUNCTION_POWER))
+                if (!is_solo_function(context, AC_FUNCTION_POWER))
                 {
-                    apply_power(ac_status, function_code);
+                    apply_power(context, ac_status, function_code);
                 }
 
-                if (!is_solo_function(AC_FUNCTION_MODE))
+                if (!is_solo_function(context, AC_FUNCTION_MODE))
                 {
-                    if (IR_DECODE_FAILED == apply_mode(ac_status, function_code))
+                    if (IR_DECODE_FAILED == apply_mode(context, ac_status, function_code))
                     {
-                        return 0;
+                        return IR_DECODE_FAILED;
                     }
                 }
 
-                if (!is_solo_function(AC_FUNCTION_WIND_SPEED))
+                if (!is_solo_function(context, AC_FUNCTION_WIND_SPEED))
                 {
-                    if (IR_DECODE_FAILED == apply_wind_speed(ac_status, function_code))
+                    if (IR_DECODE_FAILED == apply_wind_speed(context, ac_status, function_code))
                     {
-                        return 0;
+                        return IR_DECODE_FAILED;
                     }
                 }
 
-                if (!is_solo_function(AC_FUNCTION_WIND_SWING) &&
-                    !is_solo_function(AC_FUNCTION_WIND_FIX))
+                if (!is_solo_function(context, AC_FUNCTION_WIND_SWING) &&
+                    !is_solo_function(context, AC_FUNCTION_WIND_FIX))
                 {
-                    if (IR_DECODE_FAILED == apply_swing(ac_status, function_code))
+                    if (IR_DECODE_FAILED == apply_swing(context, ac_status, function_code))
                     {
-                        return 0;
+                        return IR_DECODE_FAILED;
                     }
                 }
 
-                if (!is_solo_function(AC_FUNCTION_TEMPERATURE_UP) &&
-                    !is_solo_function(AC_FUNCTION_TEMPERATURE_DOWN))
+                if (!is_solo_function(context, AC_FUNCTION_TEMPERATURE_UP) &&
+                    !is_solo_function(context, AC_FUNCTION_TEMPERATURE_DOWN))
                 {
-                    if (IR_DECODE_FAILED == apply_temperature(ac_status, function_code))
+                    if (IR_DECODE_FAILED == apply_temperature(context, ac_status, function_code))
                     {
-                        return 0;
+                        return IR_DECODE_FAILED;
                     }
                 }
             }
         }
         else
         {
-            return 0;
+            return IR_DECODE_FAILED;
         }
     }
 #endif
     apply_function(context, function_code);
     // checksum should always be applied
     apply_checksum(context);
+    return IR_DECODE_SUCCEEDED;
+}
+
+static UINT ir_ac_lib_render(ir_decoder_t *decoder, remote_ac_status_t ac_status, ir_output_t *output,
+                             UINT8 function_code, BOOL change_wind_direction)
+{
+    UINT time_length = 0;
+    protocol *context = &decoder->ac;
+
+#if defined BOARD_PC
+    UINT8 i = 0;
+#endif
+
+    if (0 == context->default_code.len)
+    {
+        ir_printf("\ndefault code is empty\n");
+        return 0;
+    }
+
+    // pre-set change wind direction flag here
+    context->change_wind_direction = change_wind_direction;
 
-    time_length = create_ir_frame();
+    context->time = output->buffer;
+
+    if (IR_DECODE_FAILED == ir_ac_lib_apply(decoder, ac_status, function_code))
+    {
+        return 0;
+    }
+
+    time_length = create_ir_frame(context, output);
 
 #if (defined BOARD_PC)
 #if (defined BOARD_PC_JNI)
     ir_printf("code count = %d\n", context->code_cnt);
 #else
-    for (i = 0; i < context->code_cnt; i++)
+    // a streamed frame has been handed to the sink already
+    for (i = 0; NULL == output->sink && i < context->code_cnt; i++)
     {
         ir_printf("%d,", context->time[i]);
     }
@@ -373,29 +991,114 @@ static UINT16 ir_ac_lib_control(remote_ac_status_t ac_status, UINT16 *user_data,
     return time_length;
 }
 
-static INT8 ir_ac_lib_close()
+static UINT16 ir_ac_lib_length(ir_decoder_t *decoder, remote_ac_status_t ac_status, UINT8 function_code,
+                               BOOL change_wind_direction)
+{
+    protocol *context = &decoder->ac;
+    // default code is at most 255 bytes long
+    UINT8 scratch[0xFF];
+    UINT8 *ir_hex_code = context->ir_hex_code;
+    swing_info si;
+    UINT8 swing_status = 0;
+    BOOL saved_change_wind_direction = context->change_wind_direction;
+    INT8 ret = IR_DECODE_SUCCEEDED;
+    UINT length = 0;
+
+    if (0 == context->default_code.len ||
+        IR_DECODE_FAILED == ir_ac_lib_prepare(decoder, &ac_status, function_code))
+    {
+        return 0;
+    }
+    length = ac_frame_length(context);
+    if (0 == length || length > 0xFFFF)
+    {
+        return 0;
+    }
+
+    // the length is that of the frame plan whatever the bytes, only whether the status is sent at all is
+    // to be found, by applying it to a scratch frame that leaves the working frame and its delta record alone
+    si = context->si;
+    swing_status = context->swing_status;
+    context->change_wind_direction = change_wind_direction;
+    context->ir_hex_code = scratch;
+    ret = ir_ac_lib_rebuild(context, ac_status, function_code);
+    context->ir_hex_code = ir_hex_code;
+    context->change_wind_direction = saved_change_wind_direction;
+    context->swing_status = swing_status;
+    context->si = si;
+    return (IR_DECODE_FAILED == ret) ? 0 : (UINT16) length;
+}
+
+static INT8 ir_ac_lib_close(ir_decoder_t *decoder)
 {
+    ir_ac_memo_destroy(decoder->ac_memo);
+    decoder->ac_memo = NULL;
+    ir_ac_delta_destroy(decoder->ac_delta);
+    decoder->ac_delta = NULL;
+
     // free context
-    if (NULL != tags)
+    if (NULL != decoder->ac_arena.head)
+    {
+        // left in the arena by a failed parse
+        decoder->tags = NULL;
+    }
+    if (NULL != decoder->tags)
+    {
+        ir_free(decoder->tags);
+        decoder->tags = NULL;
+    }
+    if (NULL != decoder->ac_lazy_tags)
+    {
+        ir_free(decoder->ac_lazy_tags);
+        decoder->ac_lazy_tags = NULL;
+    }
+
+    if (TRUE == decoder->ac_precompiled)
+    {
+        // everything but the frame plan points into the compiled image or its storage
+        ir_free(decoder->ac.frame_plan);
+        ir_free(decoder->ac_compiled);
+        decoder->ac_compiled = NULL;
+        decoder->ac_precompiled = FALSE;
+        ir_memset(&decoder->ac, 0x00, sizeof(protocol));
+    }
+    else if (NULL != decoder->ac_cache_entry)
+    {
+        // parsed segments belong to the cache, only the working frame is ours
+        if (NULL != decoder->ac.ir_hex_code)
+        {
+            ir_free(decoder->ac.ir_hex_code);
+        }
+        ir_ac_cache_release(decoder->ac_cache_entry);
+        decoder->ac_cache_entry = NULL;
+        ir_memset(&decoder->ac, 0x00, sizeof(protocol));
+    }
+    else if (NULL != decoder->ac_arena.head)
     {
-        ir_free(tags);
-        tags = NULL;
+        // everything parsed is in the arena
+        ir_memset(&decoder->ac, 0x00, sizeof(protocol));
+        ir_arena_release(&decoder->ac_arena);
+    }
+    else
+    {
+        free_ac_context(&decoder->ac);
     }
-    free_ac_context();
 
     return IR_DECODE_SUCCEEDED;
 }
 
 // utils
-INT8 get_temperature_range(UINT8 ac_mode, INT8 *temp_min, INT8 *temp_max)
+INT8 ir_decoder_get_temperature_range(ir_decoder_t *decoder, UINT8 ac_mode, INT8 *temp_min, INT8 *temp_max)
 {
     UINT8 i = 0;
+    protocol *context = &decoder->ac;
 
     if (ac_mode >= AC_MODE_MAX)
     {
         return IR_DECODE_FAILED;
     }
-    if (NULL == temp_min || NULL == temp_max)
+    if (NULL == temp_min || NULL == temp_max ||
+        IR_DECODE_FAILED == ir_ac_lib_parse_groups(decoder, AC_TAG_GROUP_BAN | AC_TAG_GROUP_TEMPERATURE))
     {
         return IR_DECODE_FAILED;
     }
@@ -428,10 +1131,13 @@ INT8 get_temperature_range(UINT8 ac_mode, INT8 *temp_min, INT8 *temp_max)
     return IR_DECODE_SUCCEEDED;
 }
 
-INT8 get_supported_mode(UINT8 *supported_mode)
+INT8 ir_decoder_get_supported_mode(ir_decoder_t *decoder, UINT8 *supported_mode)
 {
     UINT8 i = 0;
-    if (NULL == supported_mode)
+    protocol *context = &decoder->ac;
+
+    if (NULL == supported_mode ||
+        IR_DECODE_FAILED == ir_ac_lib_parse_groups(decoder, AC_TAG_GROUP_BAN | AC_TAG_GROUP_MODE))
     {
         return IR_DECODE_FAILED;
     }
@@ -450,15 +1156,18 @@ INT8 get_supported_mode(UINT8 *supported_mode)
     return IR_DECODE_SUCCEEDED;
 }
 
-INT8 get_supported_wind_speed(UINT8 ac_mode, UINT8 *supported_wind_speed)
+INT8 ir_decoder_get_supported_wind_speed(ir_decoder_t *decoder, UINT8 ac_mode, UINT8 *supported_wind_speed)
 {
     UINT8 i = 0;
+    protocol *context = &decoder->ac;
+
     if (ac_mode >= AC_MODE_MAX)
     {
         return IR_DECODE_FAILED;
     }
 
-    if (NULL == supported_wind_speed)
+    if (NULL == supported_wind_speed ||
+        IR_DECODE_FAILED == ir_ac_lib_parse_groups(decoder, AC_TAG_GROUP_BAN | AC_TAG_GROUP_WIND_SPEED))
     {
         return IR_DECODE_FAILED;
     }
@@ -484,14 +1193,16 @@ INT8 get_supported_wind_speed(UINT8 ac_mode, UINT8 *supported_wind_speed)
     return IR_DECODE_SUCCEEDED;
 }
 
-INT8 get_supported_swing(UINT8 ac_mode, UINT8 *supported_swing)
+INT8 ir_decoder_get_supported_swing(ir_decoder_t *decoder, UINT8 ac_mode, UINT8 *supported_swing)
 {
+    protocol *context = &decoder->ac;
+
     if (ac_mode >= AC_MODE_MAX)
     {
         return IR_DECODE_FAILED;
     }
 
-    if (NULL == supported_swing)
+    if (NULL == supported_swing || IR_DECODE_FAILED == ir_ac_lib_parse_groups(decoder, AC_TAG_GROUP_SWING))
     {
         return IR_DECODE_FAILED;
     }
@@ -515,10 +1226,13 @@ INT8 get_supported_swing(UINT8 ac_mode, UINT8 *supported_swing)
     return IR_DECODE_SUCCEEDED;
 }
 
-INT8 get_supported_wind_direction(UINT8 *supported_wind_direction)
+INT8 ir_decoder_get_supported_wind_direction(ir_decoder_t *decoder, UINT8 *supported_wind_direction)
 {
-    if (NULL != context)
+    if (NULL != decoder && NULL != supported_wind_direction &&
+        IR_DECODE_SUCCEEDED == ir_ac_lib_parse_groups(decoder, AC_TAG_GROUP_SWING))
     {
+        protocol *context = &decoder->ac;
+
         *supported_wind_direction = (UINT8) (context->si.mode_count - 1);
         return IR_DECODE_SUCCEEDED;
     }
@@ -531,65 +1245,31 @@ INT8 get_supported_wind_direction(UINT8 *supported_wind_direction)
 //////// AC End ////////
 
 //////// TV Begin ////////
-static INT8 ir_tv_file_open(const char *file_name)
+static INT8 ir_tv_file_open(ir_decoder_t *decoder, const char *file_name)
 {
 #if !defined NO_FS
-    size_t ret = 0;
-
-#if !defined WIN32
-    FILE *stream = fopen(file_name, "rb");
-#else
-    FILE *stream;
-    fopen_s(&stream, file_name, "rb");
-#endif
-
-    if (stream == NULL)
-    {
-        ir_printf("\nfile open failed\n");
-        return IR_DECODE_FAILED;
-    }
-
-    fseek(stream, 0, SEEK_END);
-    binary_length = (size_t) ftell(stream);
-
-    binary_content = (UINT8 *) ir_malloc(binary_length);
-    if (NULL == binary_content)
-    {
-        ir_printf("\nfailed to alloc memory for binary\n");
-        fclose(stream);
-        return IR_DECODE_FAILED;
-    }
-
-    fseek(stream, 0, SEEK_SET);
-    ret = fread(binary_content, binary_length, 1, stream);
-    if (ret <= 0)
+    if (IR_DECODE_FAILED == ir_load_file(decoder, file_name))
     {
-        fclose(stream);
-        ir_free(binary_content);
-        binary_length = 0;
         return IR_DECODE_FAILED;
     }
 
-    fclose(stream);
-
-    if (IR_DECODE_FAILED == ir_tv_lib_open(binary_content, (UINT16) binary_length))
+    if (IR_DECODE_FAILED == ir_tv_lib_open(decoder, decoder->binary_content, (UINT16) decoder->binary_length))
     {
-        ir_free(binary_content);
-        binary_length = 0;
+        ir_release_file(decoder);
         return IR_DECODE_FAILED;
     }
 #endif
     return IR_DECODE_SUCCEEDED;
 }
 
-static INT8 ir_tv_lib_open(UINT8 *binary, UINT16 binary_length)
+static INT8 ir_tv_lib_open(ir_decoder_t *decoder, UINT8 *binary, UINT16 binary_length)
 {
-    return tv_lib_open(binary, binary_length);
+    return tv_lib_open(&decoder->tv, binary, binary_length);
 }
 
-static INT8 ir_tv_lib_parse(UINT8 ir_hex_encode)
+static INT8 ir_tv_lib_parse(ir_decoder_t *decoder, UINT8 ir_hex_encode)
 {
-    if (FALSE == tv_lib_parse(ir_hex_encode))
+    if (FALSE == tv_lib_parse(&decoder->tv, ir_hex_encode))
     {
         ir_printf("parse irda binary failed\n");
         return IR_DECODE_FAILED;
@@ -597,44 +1277,137 @@ static INT8 ir_tv_lib_parse(UINT8 ir_hex_encode)
     return IR_DECODE_SUCCEEDED;
 }
 
-static UINT16 ir_tv_lib_control(UINT8 key, UINT16 *l_user_data)
+static UINT ir_tv_lib_control(ir_decoder_t *decoder, UINT8 key, ir_output_t *output)
 {
 #if defined BOARD_PC
     UINT16 print_index = 0;
 #endif
-    UINT16 ir_code_length = 0;
-    memset(l_user_data, 0x00, USER_DATA_SIZE);
-    ir_code_length = tv_lib_control(key, l_user_data);
+    UINT ir_code_length = 0;
+    ir_code_length = tv_lib_control(&decoder->tv, key, output);
 
 #if defined BOARD_PC
     // have some debug
     ir_printf("length of IR code = %d\n", ir_code_length);
-    for (print_index = 0; print_index < ir_code_length; print_index++)
+    for (print_index = 0; print_index < output->used; print_index++)
     {
-        ir_printf("%d ", l_user_data[print_index]);
+        ir_printf("%d ", output->buffer[print_index]);
     }
 #endif
 
     return ir_code_length;
 }
 
-static INT8 ir_tv_lib_close()
+static INT8 ir_tv_lib_close(ir_decoder_t *decoder)
 {
 #if (defined BOARD_PC || defined BOARD_PC_DLL)
-    ir_lib_free_inner_buffer();
+    ir_lib_free_inner_buffer(decoder);
 #endif
+    tv_lib_close(&decoder->tv);
     return IR_DECODE_SUCCEEDED;
 }
 //////// TV End ////////
 
 
-#if (defined BOARD_PC || defined BOARD_PC_DLL)
-void ir_lib_free_inner_buffer()
+#if !defined NO_FS
+static INT8 ir_load_file(ir_decoder_t *decoder, const char *file_name)
+{
+#if defined USE_MMAP
+    // map the file read only, pages are shared by every decoder and process opening the same binary
+    struct stat file_stat;
+    void *mapping = NULL;
+    int fd = open(file_name, O_RDONLY);
+
+    if (fd < 0)
+    {
+        ir_printf("\nfile open failed\n");
+        return IR_DECODE_FAILED;
+    }
+    if (fstat(fd, &file_stat) < 0 || file_stat.st_size <= 0)
+    {
+        close(fd);
+        return IR_DECODE_FAILED;
+    }
+
+    mapping = mmap(NULL, (size_t) file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (MAP_FAILED == mapping)
+    {
+        ir_printf("\nfailed to map binary\n");
+        return IR_DECODE_FAILED;
+    }
+
+    decoder->binary_content = (UINT8 *) mapping;
+    decoder->binary_length = (size_t) file_stat.st_size;
+    decoder->binary_mapped = TRUE;
+#else
+    size_t ret = 0;
+#if !defined WIN32
+    FILE *stream = fopen(file_name, "rb");
+#else
+    FILE *stream;
+    fopen_s(&stream, file_name, "rb");
+#endif
+
+    if (NULL == stream)
+    {
+        ir_printf("\nfile open failed\n");
+        return IR_DECODE_FAILED;
+    }
+
+    fseek(stream, 0, SEEK_END);
+    decoder->binary_length = (size_t) ftell(stream);
+    decoder->binary_content = (UINT8 *) ir_malloc(decoder->binary_length);
+
+    if (NULL == decoder->binary_content)
+    {
+        ir_printf("\nfailed to alloc memory for binary\n");
+        fclose(stream);
+        return IR_DECODE_FAILED;
+    }
+
+    fseek(stream, 0, SEEK_SET);
+    ret = fread(decoder->binary_content, decoder->binary_length, 1, stream);
+
+    if (ret <= 0)
+    {
+        fclose(stream);
+        ir_release_file(decoder);
+        return IR_DECODE_FAILED;
+    }
+
+    fclose(stream);
+#endif
+    return IR_DECODE_SUCCEEDED;
+}
+#endif
+
+static void ir_release_file(ir_decoder_t *decoder)
 {
-    if (NULL != binary_content)
+    if (NULL == decoder->binary_content)
+    {
+        return;
+    }
+#if defined USE_MMAP
+    if (TRUE == decoder->binary_mapped)
+    {
+        munmap(decoder->binary_content, decoder->binary_length);
+    }
+    else
     {
-        ir_free(binary_content);
-        binary_content = NULL;
+        ir_free(decoder->binary_content);
     }
+#else
+    ir_free(decoder->binary_content);
+#endif
+    decoder->binary_content = NULL;
+    decoder->binary_length = 0;
+    decoder->binary_mapped = FALSE;
+}
+
+
+#if (defined BOARD_PC || defined BOARD_PC_DLL)
+void ir_lib_free_inner_buffer(ir_decoder_t *decoder)
+{
+    ir_release_file(decoder);
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,217 @@
+/**************************************************************************************
+Filename:       ir_frame_bench_main.c
+Revised:        Date: 2026-10-17
+Revision:       Revision: 1.0
+
+Description:    This file provides the microbenchmark of AC frame building
+
+Revision log:
+* 2026-10-17: created by agent
+**************************************************************************************/
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../include/ir_defs.h"
+#include "../include/ir_decode.h"
+#include "../include/ir_ac_build_frame.h"
+#include "../include/ir_synth.h"
+
+#define DEFAULT_TIMINGS              20000000
+#define BINARY_SIZE_MAX              0xFFFF
+#define CHUNK_SIZE                   1024
+
+typedef UINT (*frame_builder_t)(protocol *context, ir_output_t *output);
+
+static UINT8 binary[BINARY_SIZE_MAX];
+static UINT16 chunk[CHUNK_SIZE];
+static ir_decoder_t decoder;
+
+static double now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec * 1e6 + (double) ts.tv_nsec / 1e3;
+}
+
+// sink folding the timings into a hash so that both builders are checked to agree
+static void hash_sink(void *sink_data, const UINT16 *timings, UINT16 count)
+{
+    UINT64 *hash = (UINT64 *) sink_data;
+    UINT16 i = 0;
+
+    for (i = 0; i < count; i++)
+    {
+        *hash = (*hash ^ timings[i]) * 0x100000001B3ULL;
+    }
+}
+
+// the frame builder as it was before the frame plan, scanning bitnum and delay codes for every byte
+static UINT8 legacy_bits_per_byte(protocol *context, UINT8 index)
+{
+    UINT8 i = 0;
+    UINT8 size = (context->bitnum_cnt >= MAX_BITNUM) ? MAX_BITNUM : (UINT8) context->bitnum_cnt;
+
+    for (i = 0; i < size; i++)
+    {
+        if (context->bitnum[i].pos == index)
+            return (UINT8) context->bitnum[i].bits;
+        if (context->bitnum[i].pos > index)
+            return 8;
+    }
+    return 8;
+}
+
+static void legacy_add_delaycode(protocol *context, UINT8 index, ir_output_t *output)
+{
+    UINT8 i = 0, j = 0;
+    UINT8 tail_delaycode = 0;
+    UINT16 tail_pos = 0;
+
+    for (i = 0; i < context->dc_cnt; i++)
+    {
+        if (context->dc[i].pos == index)
+        {
+            for (j = 0; j < context->dc[i].time_cnt; j++)
+            {
+                ir_output_put(output, context->dc[i].time[j]);
+            }
+        }
+        else if (context->dc[i].pos == -1)
+        {
+            tail_delaycode = 1;
+            tail_pos = i;
+        }
+    }
+    if ((context->lastbit == 0) && (index == (context->ir_hex_len - 1)))
+    {
+        ir_output_put(output, context->one.low);
+    }
+    if ((index == (context->ir_hex_len - 1)) && (tail_delaycode == 1))
+    {
+        for (i = 0; i < context->dc[tail_pos].time_cnt; i++)
+        {
+            ir_output_put(output, context->dc[tail_pos].time[i]);
+        }
+    }
+}
+
+static UINT legacy_create_ir_frame(protocol *context, ir_output_t *output)
+{
+    UINT16 i = 0, j = 0, r = 0;
+    UINT8 bitnum = 0;
+    UINT8 mask = 1;
+
+    for (r = 0; r < context->repeat_times; r++)
+    {
+        for (i = 0; i < context->bootcode.len; i++)
+        {
+            ir_output_put(output, context->bootcode.data[i]);
+        }
+        for (i = 0; i < context->ir_hex_len; i++)
+        {
+            bitnum = legacy_bits_per_byte(context, (UINT8) i);
+            for (j = 0; j < bitnum; j++)
+            {
+                if (context->endian == 0)
+                    mask = (UINT8) ((1 << (bitnum - 1)) >> j);
+                else
+                    mask = (UINT8) (1 << j);
+
+                if (context->ir_hex_code[i] & mask)
+                {
+                    ir_output_put(output, context->one.low);
+                    ir_output_put(output, context->one.high);
+                }
+                else
+                {
+                    ir_output_put(output, context->zero.low);
+                    ir_output_put(output, context->zero.high);
+                }
+            }
+            legacy_add_delaycode(context, (UINT8) i, output);
+        }
+    }
+    return output->total;
+}
+
+static double run(frame_builder_t builder, UINT rounds, UINT64 *hash, UINT *length)
+{
+    protocol *context = &decoder.ac;
+    ir_output_t output;
+    double start = 0;
+    UINT i = 0;
+
+    *hash = 0xCBF29CE484222325ULL;
+    start = now_us();
+    for (i = 0; i < rounds; i++)
+    {
+        // frames are streamed so that every repeat is built rather than copied
+        ir_output_init(&output, chunk, CHUNK_SIZE, hash_sink, hash);
+        builder(context, &output);
+        *length = ir_output_finish(&output);
+    }
+    return (now_us() - start) * 1e3 / rounds;
+}
+
+static void bench(UINT8 code_length, UINT8 repeat_times, UINT total_timings)
+{
+    ir_synth_ac_t shape = { 0, 4, 4, 2, 4, 2, 0, 0, 2, 0 };
+    UINT64 seed = 0x5EED0000ULL + code_length * 31 + repeat_times;
+    UINT64 legacy_hash = 0;
+    UINT64 plan_hash = 0;
+    UINT16 length = 0;
+    UINT frame_length = 0;
+    UINT rounds = 0;
+    double legacy_ns = 0;
+    double plan_ns = 0;
+
+    shape.code_length = code_length;
+    shape.repeat_times = repeat_times;
+    if (IR_DECODE_SUCCEEDED != ir_synth_ac(&shape, &seed, binary, sizeof(binary), &length) ||
+        IR_DECODE_SUCCEEDED != ir_decoder_open_binary(&decoder, IR_CATEGORY_AC, 0, binary, length))
+    {
+        printf("cannot open a remote of %u bytes\n", (UINT) code_length);
+        ir_decoder_close(&decoder);
+        return;
+    }
+    ir_memcpy(decoder.ac.ir_hex_code, decoder.ac.default_code.data, decoder.ac.default_code.len);
+
+    run(create_ir_frame, 1, &plan_hash, &frame_length);
+    rounds = total_timings / frame_length + 1;
+    legacy_ns = run(legacy_create_ir_frame, rounds, &legacy_hash, &frame_length);
+    plan_ns = run(create_ir_frame, rounds, &plan_hash, &frame_length);
+
+    printf("%6u bytes x %2u %8u timings %12.1f ns %12.1f ns %8.2fx%s\n", (UINT) code_length, (UINT) repeat_times,
+           frame_length, legacy_ns, plan_ns, legacy_ns / plan_ns, (legacy_hash == plan_hash) ? "" : " MISMATCH");
+    ir_decoder_close(&decoder);
+}
+
+int main(int argc, char *argv[])
+{
+    static const UINT8 code_lengths[] = { 16, 64, 255 };
+    static const UINT8 repeats[] = { 1, 4, 16 };
+    UINT total_timings = (2 == argc) ? (UINT) atoi(argv[1]) : DEFAULT_TIMINGS;
+    UINT i = 0;
+    UINT j = 0;
+
+    if (0 == total_timings)
+    {
+        printf("usage: %s [timings per case]\n", argv[0]);
+        return -1;
+    }
+
+    printf("%-34s %15s %15s %9s\n", "frame", "per bit loop", "frame plan", "speedup");
+    for (i = 0; i < sizeof(code_lengths) / sizeof(code_lengths[0]); i++)
+    {
+        for (j = 0; j < sizeof(repeats) / sizeof(repeats[0]); j++)
+        {
+            bench(code_lengths[i], repeats[j], total_timings);
+        }
+    }
+    return 0;
+}
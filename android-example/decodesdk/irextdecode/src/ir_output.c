@@ -0,0 +1,92 @@
+/**************************************************************************************
+Filename:       ir_output.c
+Revised:        Date: 2026-10-17
+Revision:       Revision: 1.0
+
+Description:    This file provides the output of decoded IR timings into a buffer or a sink
+
+Revision log:
+* 2026-10-17: created by agent
+**************************************************************************************/
+
+#include <string.h>
+
+#include "../include/ir_output.h"
+
+static BOOL make_room(ir_output_t *output);
+
+
+void ir_output_init(ir_output_t *output, UINT16 *buffer, UINT16 capacity, ir_sink_t sink, void *sink_data)
+{
+    output->buffer = buffer;
+    output->capacity = capacity;
+    output->used = 0;
+    output->total = 0;
+    output->sink = sink;
+    output->sink_data = sink_data;
+    output->overflow = FALSE;
+    output->single_frame = FALSE;
+    output->repeat_times = 1;
+}
+
+void ir_output_put(ir_output_t *output, UINT16 timing)
+{
+    if (output->used == output->capacity && FALSE == make_room(output))
+    {
+        return;
+    }
+    output->buffer[output->used++] = timing;
+    output->total++;
+}
+
+void ir_output_write(ir_output_t *output, const UINT16 *timings, UINT16 count)
+{
+    UINT16 room = 0;
+
+    while (count > 0)
+    {
+        if (output->used == output->capacity && FALSE == make_room(output))
+        {
+            return;
+        }
+        room = (UINT16) (output->capacity - output->used);
+        room = (count < room) ? count : room;
+        ir_memcpy(output->buffer + output->used, timings, room * sizeof(UINT16));
+        output->used = (UINT16) (output->used + room);
+        output->total += room;
+        timings += room;
+        count = (UINT16) (count - room);
+    }
+}
+
+void ir_output_add_last(ir_output_t *output, UINT16 timing)
+{
+    if (0 != output->used)
+    {
+        output->buffer[output->used - 1] += timing;
+    }
+}
+
+UINT ir_output_finish(ir_output_t *output)
+{
+    if (NULL != output->sink && 0 != output->used)
+    {
+        output->sink(output->sink_data, output->buffer, output->used);
+        output->used = 0;
+    }
+    return output->total;
+}
+
+
+static BOOL make_room(ir_output_t *output)
+{
+    if (NULL == output->sink || output->capacity < 2)
+    {
+        output->overflow = TRUE;
+        return FALSE;
+    }
+    output->sink(output->sink_data, output->buffer, (UINT16) (output->used - 1));
+    output->buffer[0] = output->buffer[output->used - 1];
+    output->used = 1;
+    return TRUE;
+}
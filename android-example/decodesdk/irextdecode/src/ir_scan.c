@@ -0,0 +1,108 @@
+/**************************************************************************************
+Filename:       ir_scan.c
+Revised:        Date: 2026-10-17
+Revision:       Revision: 1.0
+
+Description:    This file provides the scanner of AC text tags
+
+Revision log:
+* 2026-10-17: created by agent
+**************************************************************************************/
+
+#include <stddef.h>
+
+#include "../include/ir_scan.h"
+
+#define SCAN_INT_LIMIT 100000000
+
+
+void ir_scan_init(ir_scan_t *scan, UINT8 *text, UINT16 length)
+{
+    scan->cursor = text;
+    scan->end = text + length;
+    scan->done = FALSE;
+}
+
+BOOL ir_scan_field(ir_scan_t *scan, UINT8 separator, ir_scan_t *field)
+{
+    UINT8 *p = scan->cursor;
+
+    if (TRUE == scan->done)
+    {
+        return FALSE;
+    }
+    while (p < scan->end && *p != separator)
+    {
+        p++;
+    }
+
+    field->cursor = scan->cursor;
+    field->end = p;
+    field->done = FALSE;
+    if (p == scan->end)
+    {
+        scan->done = TRUE;
+        scan->cursor = p;
+    }
+    else
+    {
+        scan->cursor = p + 1;
+    }
+    return TRUE;
+}
+
+BOOL ir_scan_pair(const ir_scan_t *field, UINT8 separator, ir_scan_t *key, ir_scan_t *value)
+{
+    UINT8 *p = field->cursor;
+
+    while (p < field->end && *p != separator)
+    {
+        p++;
+    }
+    if (p == field->end)
+    {
+        ir_scan_init(key, field->end, 0);
+        ir_scan_init(value, field->end, 0);
+        return FALSE;
+    }
+
+    key->cursor = field->cursor;
+    key->end = p;
+    key->done = FALSE;
+    value->cursor = p + 1;
+    value->end = field->end;
+    value->done = FALSE;
+    return TRUE;
+}
+
+INT ir_scan_int(const ir_scan_t *field)
+{
+    UINT8 *p = field->cursor;
+    INT value = 0;
+    BOOL negative = FALSE;
+
+    while (p < field->end && (' ' == *p || ('\t' <= *p && *p <= '\r')))
+    {
+        p++;
+    }
+    if (p < field->end && ('-' == *p || '+' == *p))
+    {
+        negative = ('-' == *p);
+        p++;
+    }
+    while (p < field->end && '0' <= *p && *p <= '9')
+    {
+        // digits beyond any tag value are skipped rather than overflowing
+        if (value < SCAN_INT_LIMIT)
+        {
+            value = value * 10 + (*p - '0');
+        }
+        p++;
+    }
+    return (TRUE == negative) ? -value : value;
+}
+
+UINT16 ir_scan_length(const ir_scan_t *field)
+{
+    return (UINT16) (field->end - field->cursor);
+}
@@ -0,0 +1,127 @@
+/**************************************************************************************
+Filename:       ir_scan_bench_main.c
+Revised:        Date: 2026-10-17
+Revision:       Revision: 1.0
+
+Description:    This file provides the microbenchmark of AC text tag parsing
+
+Revision log:
+* 2026-10-17: created by agent
+**************************************************************************************/
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../include/ir_defs.h"
+#include "../include/ir_decode.h"
+#include "../include/ir_ac_parse_frame_info.h"
+
+#define DEFAULT_ROUNDS               2000
+#define TAG_LENGTH_MAX               65000
+
+typedef INT8 (*tag_parser_t)(protocol *context, struct tag_head *tag);
+
+static UINT8 text[TAG_LENGTH_MAX + 32];
+
+static double now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec * 1e6 + (double) ts.tv_nsec / 1e3;
+}
+
+// "pos&time,time,...|pos&time,..." with values_per_record times in each record
+static UINT16 make_delay_code(UINT16 length, UINT16 values_per_record)
+{
+    UINT16 used = 0;
+    UINT16 value = 0;
+
+    while (used < length)
+    {
+        if (0 != used)
+        {
+            text[used++] = '|';
+        }
+        used += (UINT16) sprintf((char *) text + used, "%u&", (UINT) (used % 23));
+        for (value = 0; value < values_per_record && used < length; value++)
+        {
+            used += (UINT16) sprintf((char *) text + used, value ? ",%u" : "%u", (UINT) (4000 + used % 3000));
+        }
+    }
+    return used;
+}
+
+// "pos&bits|pos&bits|..."
+static UINT16 make_bit_num(UINT16 length)
+{
+    UINT16 used = 0;
+
+    while (used < length)
+    {
+        if (0 != used)
+        {
+            text[used++] = '|';
+        }
+        used += (UINT16) sprintf((char *) text + used, "%u&%u", (UINT) (used % 19), (UINT) (1 + used % 8));
+    }
+    return used;
+}
+
+static void run(const char *name, tag_parser_t parser, UINT16 length, UINT rounds)
+{
+    static protocol context;
+    struct tag_head tag;
+    double start = 0;
+    double elapsed = 0;
+    UINT i = 0;
+
+    tag.tag = 0;
+    tag.offset = 0;
+    tag.len = length;
+    tag.pdata = text;
+    tag.in_place = FALSE;
+
+    start = now_us();
+    for (i = 0; i < rounds; i++)
+    {
+        context.dc_cnt = 0;
+        context.bitnum_cnt = 0;
+        parser(&context, &tag);
+    }
+    elapsed = now_us() - start;
+
+    printf("%-28s %8u chars %12.1f ns/tag %8.3f ns/char\n", name, (UINT) length,
+           elapsed * 1e3 / rounds, elapsed * 1e3 / rounds / length);
+}
+
+int main(int argc, char *argv[])
+{
+    static const UINT16 lengths[] = { 64, 256, 1024, 4096, 16384, TAG_LENGTH_MAX };
+    UINT rounds = (2 == argc) ? (UINT) atoi(argv[1]) : DEFAULT_ROUNDS;
+    UINT i = 0;
+
+    if (0 == rounds)
+    {
+        printf("usage: %s [rounds]\n", argv[0]);
+        return -1;
+    }
+
+    // a linear scanner keeps ns/char flat as tags grow
+    for (i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++)
+    {
+        run("delay code, short records", parse_delay_code, make_delay_code(lengths[i], 4), rounds);
+    }
+    for (i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++)
+    {
+        run("delay code, single record", parse_delay_code, make_delay_code(lengths[i], 0xFFFF), rounds);
+    }
+    for (i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++)
+    {
+        run("bit num", parse_bit_num, make_bit_num(lengths[i]), rounds);
+    }
+    return 0;
+}
@@ -0,0 +1,742 @@
+/**************************************************************************************
+Filename:       ir_synth.c
+Revised:        Date: 2026-10-17
+Revision:       Revision: 1.0
+
+Description:    This file provides the generator of synthetic AC and TV binaries
+
+Revision log:
+* 2026-10-17: created by agent
+**************************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "../include/ir_synth.h"
+#include "../include/ir_decode.h"
+#include "../include/ir_ac_control.h"
+#include "../include/ir_tv_control.h"
+
+#define AC_HEADER_SIZE               (1 + TAG_COUNT_FOR_PROTOCOL * 2)
+#define AC_CODE_LENGTH_MIN           4
+#define AC_CODE_LENGTH_MAX           255
+// ends of bit ranges are UINT8 bit positions
+#define AC_TYPE_2_BYTES              31
+#define AC_CHANGES_MAX               8
+#define AC_CHECKSUM_MAX              8
+#define AC_SPEC_POS_MAX              6
+#define AC_SWING_POSITIONS_MAX       10
+
+#define TV_NAME_SIZE                 20
+// key items index prot_cycles_data of IRDA_MAX entries with their key code byte
+#define TV_KEY_BYTES_MAX             (IRDA_MAX - 1)
+#define TV_FRAME_MAX                 8
+#define TV_QUATERNARY_CYCLES         8
+
+typedef struct synth_writer
+{
+    UINT8 *binary;
+    UINT capacity;
+    UINT used;
+    BOOL overflow;
+} synth_writer_t;
+
+// tags in the order of their offsets in the header, as binary_parse_offset indexes them
+static const UINT8 ac_tags[TAG_COUNT_FOR_PROTOCOL] =
+{
+    TAG_AC_BOOT_CODE, TAG_AC_ZERO, TAG_AC_ONE, TAG_AC_DELAY_CODE, TAG_AC_FRAME_LENGTH, TAG_AC_ENDIAN,
+    TAG_AC_LASTBIT, TAG_AC_POWER_1, TAG_AC_DEFAULT_CODE, TAG_AC_TEMP_1, TAG_AC_MODE_1, TAG_AC_SPEED_1,
+    TAG_AC_SWING_1, TAG_AC_CHECKSUM_TYPE, TAG_AC_SOLO_FUNCTION, TAG_AC_FUNCTION_1, TAG_AC_TEMP_2,
+    TAG_AC_MODE_2, TAG_AC_SPEED_2, TAG_AC_SWING_2, TAG_AC_FUNCTION_2, TAG_AC_BAN_FUNCTION_IN_COOL_MODE,
+    TAG_AC_BAN_FUNCTION_IN_HEAT_MODE, TAG_AC_BAN_FUNCTION_IN_AUTO_MODE, TAG_AC_BAN_FUNCTION_IN_FAN_MODE,
+    TAG_AC_BAN_FUNCTION_IN_DRY_MODE, TAG_AC_SWING_INFO, TAG_AC_REPEAT_TIMES, TAG_AC_BITNUM
+};
+
+static UINT next_random(UINT64 *seed);
+static UINT random_range(UINT64 *seed, UINT low, UINT high);
+static UINT clamp(UINT value, UINT low, UINT high);
+static void put_byte(synth_writer_t *writer, UINT8 value);
+static void put_text(synth_writer_t *writer, const char *text);
+static void put_number(synth_writer_t *writer, INT value);
+static void put_hex(synth_writer_t *writer, UINT8 value);
+static void put_u16(synth_writer_t *writer, UINT16 value);
+static void put_segment(synth_writer_t *writer, const ir_synth_ac_t *shape, UINT64 *seed, UINT8 type_2);
+static void put_segments(synth_writer_t *writer, const ir_synth_ac_t *shape, UINT64 *seed, UINT count,
+                         UINT8 type_2);
+static void put_ac_tag(synth_writer_t *writer, const ir_synth_ac_t *shape, UINT64 *seed, UINT8 tag);
+static void put_temperature(synth_writer_t *writer, const ir_synth_ac_t *shape, UINT64 *seed, UINT8 type_2);
+static void put_checksum(synth_writer_t *writer, const ir_synth_ac_t *shape, UINT64 *seed);
+static void put_functions(synth_writer_t *writer, const ir_synth_ac_t *shape, UINT64 *seed, UINT8 type_2);
+static void put_ban(synth_writer_t *writer, UINT64 *seed, UINT8 tag);
+static void put_cycles(synth_writer_t *writer, UINT64 *seed, UINT8 flag, UINT16 mask, UINT16 space);
+static void put_item(synth_writer_t *writer, UINT8 bits, UINT8 lsb, UINT8 mode, UINT8 index);
+
+
+void ir_synth_ac_random(ir_synth_ac_t *shape, const ir_synth_ac_t *limit, UINT64 *seed)
+{
+    UINT8 flag = 0;
+
+    shape->code_length = (UINT8) random_range(seed, AC_CODE_LENGTH_MIN,
+                                              clamp(limit->code_length, AC_CODE_LENGTH_MIN, AC_CODE_LENGTH_MAX));
+    shape->boot_code_count = (UINT8) random_range(seed, 0, limit->boot_code_count);
+    shape->delay_code_count = (UINT8) random_range(seed, 0, limit->delay_code_count);
+    shape->delay_time_count = (UINT8) random_range(seed, 1, clamp(limit->delay_time_count, 1, 8));
+    shape->bitnum_count = (UINT8) random_range(seed, 0, limit->bitnum_count);
+    shape->checksum_count = (UINT8) random_range(seed, 0, limit->checksum_count);
+    shape->repeat_times = (UINT8) random_range(seed, 1, clamp(limit->repeat_times, 1, 0xFF));
+    shape->swing_count = (UINT8) random_range(seed, 0, limit->swing_count);
+    if (1 == shape->swing_count)
+    {
+        shape->swing_count = 0;
+    }
+    shape->segment_changes = (UINT8) random_range(seed, 1, clamp(limit->segment_changes, 1, AC_CHANGES_MAX));
+    shape->flags = 0;
+    for (flag = 0x01; 0 != flag; flag <<= 1)
+    {
+        if (0 != (limit->flags & flag) && 0 != (next_random(seed) & 0x01))
+        {
+            shape->flags |= flag;
+        }
+    }
+}
+
+void ir_synth_tv_random(ir_synth_tv_t *shape, const ir_synth_tv_t *limit, UINT64 *seed)
+{
+    UINT key_limit = clamp(limit->key_count, 1, 256);
+
+    shape->sub_category = (2 == limit->sub_category) ? 2 : 1;
+    shape->two_bits = (0 != limit->two_bits) ? (UINT8) (next_random(seed) & 0x01) : 0;
+    shape->key_bytes = (UINT8) random_range(seed, 1, clamp(limit->key_bytes, 1, TV_KEY_BYTES_MAX));
+    // at least as many keys as a TV has, so that every TV key could be decoded
+    shape->key_count = (UINT16) random_range(seed, (key_limit < TV_KEY_MAX) ? key_limit : TV_KEY_MAX, key_limit);
+    shape->frame_count = (UINT8) random_range(seed, 1, clamp(limit->frame_count, 1, TV_FRAME_MAX));
+    shape->flip = (0 != limit->flip) ? (UINT8) (next_random(seed) & 0x01) : 0;
+}
+
+INT8 ir_synth_ac(const ir_synth_ac_t *shape, UINT64 *seed, UINT8 *binary, UINT capacity, UINT16 *length)
+{
+    synth_writer_t writer;
+    ir_synth_ac_t clamped = *shape;
+    UINT offset = 0;
+    UINT i = 0;
+
+    clamped.code_length = (UINT8) clamp(shape->code_length, AC_CODE_LENGTH_MIN, AC_CODE_LENGTH_MAX);
+    clamped.boot_code_count = (UINT8) clamp(shape->boot_code_count, 0,
+                                            sizeof(((ac_bootcode *) 0)->data) / sizeof(UINT16));
+    clamped.delay_code_count = (UINT8) clamp(shape->delay_code_count, 0, MAX_DELAYCODE_NUM);
+    clamped.delay_time_count = (UINT8) clamp(shape->delay_time_count, 1,
+                                             sizeof(((ac_delaycode *) 0)->time) / sizeof(UINT16));
+    clamped.bitnum_count = (UINT8) clamp(shape->bitnum_count, 0, MAX_BITNUM);
+    if (clamped.bitnum_count > clamped.code_length - 1)
+    {
+        clamped.bitnum_count = (UINT8) (clamped.code_length - 1);
+    }
+    clamped.checksum_count = (UINT8) clamp(shape->checksum_count, 0, AC_CHECKSUM_MAX);
+    clamped.repeat_times = (UINT8) clamp(shape->repeat_times, 1, 0xFF);
+    clamped.swing_count = (0 == shape->swing_count) ? 0 :
+                          (UINT8) clamp(shape->swing_count, 2, AC_SWING_POSITIONS_MAX);
+    clamped.segment_changes = (UINT8) clamp(shape->segment_changes, 1, AC_CHANGES_MAX);
+
+    writer.binary = binary;
+    writer.capacity = capacity;
+    writer.used = AC_HEADER_SIZE;
+    writer.overflow = (capacity < AC_HEADER_SIZE) ? TRUE : FALSE;
+    if (TRUE == writer.overflow)
+    {
+        return IR_DECODE_FAILED;
+    }
+    binary[0] = TAG_COUNT_FOR_PROTOCOL;
+
+    // tags follow each other, the length of a tag is the distance to the next valid one
+    for (i = 0; i < TAG_COUNT_FOR_PROTOCOL; i++)
+    {
+        offset = writer.used;
+        put_ac_tag(&writer, &clamped, seed, ac_tags[i]);
+        if (writer.used == offset)
+        {
+            offset = TAG_INVALID;
+        }
+        else
+        {
+            offset -= AC_HEADER_SIZE;
+        }
+        binary[1 + i * 2] = (UINT8) (offset & 0xFF);
+        binary[2 + i * 2] = (UINT8) ((offset >> 8) & 0xFF);
+    }
+
+    if (TRUE == writer.overflow || writer.used > 0xFFFF)
+    {
+        return IR_DECODE_FAILED;
+    }
+    *length = (UINT16) writer.used;
+    return IR_DECODE_SUCCEEDED;
+}
+
+INT8 ir_synth_tv(const ir_synth_tv_t *shape, UINT64 *seed, UINT8 *binary, UINT capacity, UINT16 *length)
+{
+    synth_writer_t writer;
+    UINT8 cycles_num[IRDA_MAX];
+    UINT8 cycles_size = 0;
+    UINT8 hexadecimal = (2 == shape->sub_category) ? TRUE : FALSE;
+    UINT8 key_bytes = (UINT8) clamp(shape->key_bytes, 1, TV_KEY_BYTES_MAX);
+    UINT8 frame_count = (UINT8) clamp(shape->frame_count, 1, TV_FRAME_MAX);
+    UINT16 key_count = (UINT16) clamp(shape->key_count, 1, 256);
+    UINT8 item_count = 0;
+    UINT8 max_index = 0;
+    UINT16 unit = 0;
+    UINT8 frame = 0;
+    UINT i = 0;
+    char name[TV_NAME_SIZE];
+
+    writer.binary = binary;
+    writer.capacity = capacity;
+    writer.used = 0;
+    writer.overflow = FALSE;
+
+    // protocol name
+    memset(name, 0x00, sizeof(name));
+    snprintf(name, sizeof(name), "synth_%s%u", hexadecimal ? "hex" : "quat",
+             (UINT) ((hexadecimal || shape->two_bits) ? 2 : 1));
+    for (i = 0; i < TV_NAME_SIZE; i++)
+    {
+        put_byte(&writer, (UINT8) name[i]);
+    }
+
+    // cycles number, 1 or 2 bits per symbol take the 8 first flags only
+    cycles_size = (TRUE == hexadecimal) ? IRDA_MAX : TV_QUATERNARY_CYCLES;
+    memset(cycles_num, 0x00, sizeof(cycles_num));
+    cycles_num[IRDA_BOOT] = (UINT8) random_range(seed, 1, 2);
+    cycles_num[IRDA_STOP] = 1;
+    cycles_num[IRDA_SEP] = (frame_count > 1) ? 1 : 0;
+    cycles_num[IRDA_ONE] = 1;
+    cycles_num[IRDA_ZERO] = 1;
+    cycles_num[IRDA_FLIP] = (0 != shape->flip) ? 2 : 0;
+    for (i = IRDA_TWO; i < cycles_size; i++)
+    {
+        cycles_num[i] = (TRUE == hexadecimal || (0 != shape->two_bits && i <= IRDA_THREE)) ? 1 : 0;
+    }
+    for (i = 0; i < cycles_size; i++)
+    {
+        put_byte(&writer, cycles_num[i]);
+    }
+
+    // cycles data, in the order of flags, symbols differ by the length of their space
+    unit = (UINT16) random_range(seed, 300, 700);
+    for (i = 0; i < cycles_size; i++)
+    {
+        if (IRDA_BOOT == i)
+        {
+            put_cycles(&writer, seed, IRDA_FLAG_NORMAL, (UINT16) (unit * 16), (UINT16) (unit * 8));
+            if (2 == cycles_num[i])
+            {
+                put_cycles(&writer, seed, IRDA_FLAG_NORMAL, unit, (UINT16) (unit * 70));
+            }
+        }
+        else if (IRDA_STOP == i || IRDA_SEP == i)
+        {
+            if (0 != cycles_num[i])
+            {
+                put_cycles(&writer, seed, IRDA_FLAG_NORMAL, unit, (UINT16) (unit * (IRDA_STOP == i ? 40 : 20)));
+            }
+        }
+        else if (IRDA_FLIP == i)
+        {
+            if (0 != cycles_num[i])
+            {
+                put_cycles(&writer, seed, IRDA_FLAG_NORMAL, unit, unit);
+                put_cycles(&writer, seed, IRDA_FLAG_NORMAL, unit, (UINT16) (unit * 3));
+            }
+        }
+        else if (0 != cycles_num[i])
+        {
+            // symbol value v, ZERO is 0, ONE is 1, TWO (flag 6) is 2 and so on
+            UINT value = (IRDA_ZERO == i) ? 0 : (IRDA_ONE == i) ? 1 : i - IRDA_TWO + 2;
+            put_cycles(&writer, seed, (UINT8) ((0 == (next_random(seed) & 0x07)) ? IRDA_FLAG_INVERSE :
+                                               IRDA_FLAG_NORMAL), unit, (UINT16) (unit * (1 + value)));
+        }
+    }
+
+    // items, boot, the key code bytes split in frames, an optional toggle bit and stop
+    item_count = (UINT8) (2 + key_bytes + (frame_count - 1) + ((0 != shape->flip) ? 1 : 0));
+    put_byte(&writer, item_count);
+    put_item(&writer, 1, IRDA_LSB, 0, IRDA_BOOT);
+    for (i = 0; i < key_bytes; i++)
+    {
+        if (i > 0 && 0 == i % ((key_bytes + frame_count - 1) / frame_count) && frame < frame_count - 1)
+        {
+            put_item(&writer, 1, IRDA_LSB, 0, IRDA_SEP);
+            frame++;
+        }
+        put_item(&writer, 8, (UINT8) (next_random(seed) & 0x01), (UINT8) (0 == (next_random(seed) & 0x03)),
+                 (UINT8) (i + 1));
+        if (0 == i && 0 != shape->flip)
+        {
+            put_item(&writer, 1, IRDA_LSB, 0, IRDA_FLIP);
+        }
+    }
+    for (; frame < frame_count - 1; frame++)
+    {
+        put_item(&writer, 1, IRDA_LSB, 0, IRDA_SEP);
+    }
+    put_item(&writer, 1, IRDA_LSB, 0, IRDA_STOP);
+
+    // remote, then key codes of every key
+    put_text(&writer, "irda");
+    put_byte(&writer, key_bytes);
+    for (i = 0; i < (UINT) key_count * key_bytes; i++)
+    {
+        put_byte(&writer, (UINT8) next_random(seed));
+    }
+
+    // the key code of a flag item is read too, pad so that it stays within the binary for the last key
+    max_index = (0 != shape->flip) ? IRDA_FLIP : (frame_count > 1) ? IRDA_SEP : IRDA_STOP;
+    for (i = key_bytes; i < max_index; i++)
+    {
+        put_byte(&writer, 0x00);
+    }
+
+    if (TRUE == writer.overflow || writer.used > 0xFFFF)
+    {
+        return IR_DECODE_FAILED;
+    }
+    *length = (UINT16) writer.used;
+    return IR_DECODE_SUCCEEDED;
+}
+
+
+// xorshift64*, the sequence only depends on the seed
+static UINT next_random(UINT64 *seed)
+{
+    UINT64 x = (0 == *seed) ? 0x9E3779B97F4A7C15ULL : *seed;
+
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *seed = x;
+    return (UINT) ((x * 0x2545F4914F6CDD1DULL) >> 32);
+}
+
+static UINT random_range(UINT64 *seed, UINT low, UINT high)
+{
+    if (high <= low)
+    {
+        return low;
+    }
+    return low + next_random(seed) % (high - low + 1);
+}
+
+static UINT clamp(UINT value, UINT low, UINT high)
+{
+    return (value < low) ? low : (value > high) ? high : value;
+}
+
+static void put_byte(synth_writer_t *writer, UINT8 value)
+{
+    if (writer->used >= writer->capacity)
+    {
+        writer->overflow = TRUE;
+        return;
+    }
+    writer->binary[writer->used++] = value;
+}
+
+static void put_text(synth_writer_t *writer, const char *text)
+{
+    while ('\0' != *text)
+    {
+        put_byte(writer, (UINT8) *text++);
+    }
+}
+
+static void put_number(synth_writer_t *writer, INT value)
+{
+    char text[16];
+
+    snprintf(text, sizeof(text), "%d", value);
+    put_text(writer, text);
+}
+
+static void put_hex(synth_writer_t *writer, UINT8 value)
+{
+    static const char digits[] = "0123456789ABCDEF";
+
+    put_byte(writer, (UINT8) digits[value >> 4]);
+    put_byte(writer, (UINT8) digits[value & 0x0F]);
+}
+
+static void put_u16(synth_writer_t *writer, UINT16 value)
+{
+    // ir_cycles_t is read in place, little endian as on every supported target
+    put_byte(writer, (UINT8) (value & 0xFF));
+    put_byte(writer, (UINT8) ((value >> 8) & 0xFF));
+}
+
+// length, then byte and value pairs (type 1) or first bit, end bit and value triples (type 2)
+static void put_segment(synth_writer_t *writer, const ir_synth_ac_t *shape, UINT64 *seed, UINT8 type_2)
+{
+    UINT bits = ((shape->code_length < AC_TYPE_2_BYTES) ? shape->code_length : AC_TYPE_2_BYTES) * 8;
+    UINT width = 0;
+    UINT start = 0;
+    UINT i = 0;
+
+    put_hex(writer, (UINT8) (shape->segment_changes * (type_2 ? 3 : 2)));
+    for (i = 0; i < shape->segment_changes; i++)
+    {
+        if (FALSE == type_2)
+        {
+            put_hex(writer, (UINT8) random_range(seed, 0, shape->code_length - 1U));
+            put_hex(writer, (UINT8) next_random(seed));
+        }
+        else
+        {
+            // a range of up to 8 bits, within a byte or across two
+            width = random_range(seed, 1, 8);
+            start = random_range(seed, 0, bits - width);
+            put_hex(writer, (UINT8) start);
+            put_hex(writer, (UINT8) (start + width));
+            put_hex(writer, (UINT8) (next_random(seed) & ((1U << width) - 1)));
+        }
+    }
+}
+
+static void put_segments(synth_writer_t *writer, const ir_synth_ac_t *shape, UINT64 *seed, UINT count,
+                         UINT8 type_2)
+{
+    UINT i = 0;
+
+    for (i = 0; i < count; i++)
+    {
+        put_segment(writer, shape, seed, type_2);
+    }
+}
+
+static void put_ac_tag(synth_writer_t *writer, const ir_synth_ac_t *shape, UINT64 *seed, UINT8 tag)
+{
+    UINT8 type_2 = (0 != (shape->flags & IR_SYNTH_AC_TYPE_2)) ? TRUE : FALSE;
+    UINT8 positions[MAX_BITNUM];
+    UINT count = 0;
+    UINT i = 0;
+    UINT j = 0;
+
+    switch (tag)
+    {
+        case TAG_AC_BOOT_CODE:
+            for (i = 0; i < shape->boot_code_count; i++)
+            {
+                if (0 != i)
+                {
+                    put_byte(writer, ',');
+                }
+                put_number(writer, (INT) random_range(seed, 400, 9000));
+            }
+            break;
+        case TAG_AC_ZERO:
+        case TAG_AC_ONE:
+            put_number(writer, (INT) random_range(seed, 350, 650));
+            put_byte(writer, ',');
+            put_number(writer, (INT) random_range(seed, 350, 650) * (TAG_AC_ONE == tag ? 3 : 1));
+            break;
+        case TAG_AC_DELAY_CODE:
+            // pos&time,time,...|... with -1 for the end of the code
+            for (i = 0; i < shape->delay_code_count; i++)
+            {
+                if (0 != i)
+                {
+                    put_byte(writer, '|');
+                }
+                put_number(writer, (0 == random_range(seed, 0, 7)) ? -1 :
+                                   (INT) random_range(seed, 0, shape->code_length - 1U));
+                put_byte(writer, '&');
+                for (j = 0; j < shape->delay_time_count; j++)
+                {
+                    if (0 != j)
+                    {
+                        put_byte(writer, ',');
+                    }
+                    put_number(writer, (INT) random_range(seed, 400, 20000));
+                }
+            }
+            break;
+        case TAG_AC_FRAME_LENGTH:
+            put_number(writer, shape->code_length * 8);
+            break;
+        case TAG_AC_ENDIAN:
+        case TAG_AC_LASTBIT:
+            put_number(writer, (INT) (next_random(seed) & 0x01));
+            break;
+        case TAG_AC_POWER_1:
+            put_segments(writer, shape, seed, AC_POWER_MAX, FALSE);
+            break;
+        case TAG_AC_DEFAULT_CODE:
+            put_hex(writer, shape->code_length);
+            for (i = 0; i < shape->code_length; i++)
+            {
+                put_hex(writer, (UINT8) next_random(seed));
+            }
+            break;
+        case TAG_AC_TEMP_1:
+        case TAG_AC_TEMP_2:
+            if (type_2 == (TAG_AC_TEMP_2 == tag))
+            {
+                put_temperature(writer, shape, seed, type_2);
+            }
+            break;
+        case TAG_AC_MODE_1:
+        case TAG_AC_MODE_2:
+            if (type_2 == (TAG_AC_MODE_2 == tag))
+            {
+                put_segments(writer, shape, seed, AC_MODE_MAX, type_2);
+            }
+            break;
+        case TAG_AC_SPEED_1:
+        case TAG_AC_SPEED_2:
+            if (type_2 == (TAG_AC_SPEED_2 == tag))
+            {
+                put_segments(writer, shape, seed, AC_WS_MAX, type_2);
+            }
+            break;
+        case TAG_AC_SWING_1:
+        case TAG_AC_SWING_2:
+            if (type_2 == (TAG_AC_SWING_2 == tag) && 0 != shape->swing_count)
+            {
+                put_segments(writer, shape, seed, shape->swing_count, type_2);
+            }
+            break;
+        case TAG_AC_CHECKSUM_TYPE:
+            put_checksum(writer, shape, seed);
+            break;
+        case TAG_AC_SOLO_FUNCTION:
+            if (0 != (shape->flags & IR_SYNTH_AC_SOLO))
+            {
+                // swing and fix are sent alone, with their own function segment
+                put_hex(writer, 2);
+                put_hex(writer, AC_FUNCTION_WIND_SWING);
+                put_hex(writer, AC_FUNCTION_WIND_FIX);
+            }
+            break;
+        case TAG_AC_FUNCTION_1:
+        case TAG_AC_FUNCTION_2:
+            if (type_2 == (TAG_AC_FUNCTION_2 == tag) &&
+                0 != (shape->flags & (IR_SYNTH_AC_FUNCTIONS | IR_SYNTH_AC_SOLO)))
+            {
+                put_functions(writer, shape, seed, type_2);
+            }
+            break;
+        case TAG_AC_BAN_FUNCTION_IN_COOL_MODE:
+        case TAG_AC_BAN_FUNCTION_IN_HEAT_MODE:
+        case TAG_AC_BAN_FUNCTION_IN_AUTO_MODE:
+        case TAG_AC_BAN_FUNCTION_IN_FAN_MODE:
+        case TAG_AC_BAN_FUNCTION_IN_DRY_MODE:
+            if (0 != (shape->flags & IR_SYNTH_AC_BAN))
+            {
+                put_ban(writer, seed, tag);
+            }
+            break;
+        case TAG_AC_SWING_INFO:
+            // "1" for swing only, otherwise a list of as many items as swing positions
+            if (0 == shape->swing_count)
+            {
+                put_byte(writer, '1');
+            }
+            for (i = 0; i < shape->swing_count; i++)
+            {
+                if (0 != i)
+                {
+                    put_byte(writer, ',');
+                }
+                put_byte(writer, (UINT8) ('0' + i));
+            }
+            break;
+        case TAG_AC_REPEAT_TIMES:
+            if (shape->repeat_times > 1)
+            {
+                put_number(writer, shape->repeat_times);
+            }
+            break;
+        case TAG_AC_BITNUM:
+            // pos&bits|... in ascending positions, -1 for the last byte is only valid at the end
+            for (i = 0; i < shape->code_length - 1U && count < shape->bitnum_count; i++)
+            {
+                if (random_range(seed, 0, shape->code_length - 2U - i) < shape->bitnum_count - count)
+                {
+                    positions[count++] = (UINT8) i;
+                }
+            }
+            for (i = 0; i < count; i++)
+            {
+                if (0 != i)
+                {
+                    put_byte(writer, '|');
+                }
+                put_number(writer, (i + 1 == count && 0 == (next_random(seed) & 0x03)) ? -1 : positions[i]);
+                put_byte(writer, '&');
+                put_number(writer, (INT) random_range(seed, 1, 7));
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+static void put_temperature(synth_writer_t *writer, const ir_synth_ac_t *shape, UINT64 *seed, UINT8 type_2)
+{
+    UINT bits = ((shape->code_length < AC_TYPE_2_BYTES) ? shape->code_length : AC_TYPE_2_BYTES) * 8;
+    UINT start = 0;
+    UINT i = 0;
+
+    if (0 == (shape->flags & IR_SYNTH_AC_DYNAMIC_TEMP))
+    {
+        put_segments(writer, shape, seed, AC_TEMP_MAX, type_2);
+        return;
+    }
+
+    // a single segment covering the whole tag, its value is added once per degree above 16
+    put_hex(writer, (UINT8) (shape->segment_changes * (type_2 ? 3 : 2)));
+    for (i = 0; i < shape->segment_changes; i++)
+    {
+        if (FALSE == type_2)
+        {
+            put_hex(writer, (UINT8) random_range(seed, 0, shape->code_length - 1U));
+            put_hex(writer, (UINT8) random_range(seed, 1, 2));
+        }
+        else
+        {
+            start = random_range(seed, 0, bits - 4);
+            put_hex(writer, (UINT8) start);
+            put_hex(writer, (UINT8) (start + 4));
+            put_hex(writer, 1);
+        }
+    }
+}
+
+// records of every checksum type in turn, written to the last bytes of the code
+static void put_checksum(synth_writer_t *writer, const ir_synth_ac_t *shape, UINT64 *seed)
+{
+    UINT8 type = 0;
+    UINT8 target = 0;
+    UINT spec_count = 0;
+    UINT start = 0;
+    UINT i = 0;
+    UINT j = 0;
+
+    for (i = 0; i < shape->checksum_count; i++)
+    {
+        if (0 != i)
+        {
+            put_byte(writer, '|');
+        }
+        type = (UINT8) (CHECKSUM_TYPE_BYTE + i % (CHECKSUM_TYPE_MAX - CHECKSUM_TYPE_BYTE));
+        target = (UINT8) ((shape->code_length > i + 1) ? shape->code_length - 1 - i : 0);
+        if (type <= CHECKSUM_TYPE_HALF_BYTE_INVERSE)
+        {
+            // length, type, first byte, end byte, checksum byte, plus
+            start = random_range(seed, 0, target);
+            put_hex(writer, 5);
+            put_hex(writer, type);
+            put_hex(writer, (UINT8) start);
+            put_hex(writer, (UINT8) random_range(seed, start, target));
+            put_hex(writer, target);
+            put_hex(writer, (UINT8) next_random(seed));
+        }
+        else
+        {
+            // length, type, checksum half byte, plus, half bytes summed
+            spec_count = random_range(seed, 1, AC_SPEC_POS_MAX);
+            put_hex(writer, (UINT8) (3 + spec_count));
+            put_hex(writer, type);
+            put_hex(writer, (UINT8) (target * 2 + (next_random(seed) & 0x01)));
+            put_hex(writer, (UINT8) next_random(seed));
+            for (j = 0; j < spec_count; j++)
+            {
+                put_hex(writer, (UINT8) random_range(seed, 0, (target > 127) ? 255 : target * 2U + 1));
+            }
+        }
+    }
+}
+
+// a record per function, length counting the function id, function id, changes
+static void put_functions(synth_writer_t *writer, const ir_synth_ac_t *shape, UINT64 *seed, UINT8 type_2)
+{
+    UINT bits = ((shape->code_length < AC_TYPE_2_BYTES) ? shape->code_length : AC_TYPE_2_BYTES) * 8;
+    UINT width = 0;
+    UINT start = 0;
+    UINT function = 0;
+    UINT i = 0;
+
+    for (function = AC_FUNCTION_POWER; function < AC_FUNCTION_MAX; function++)
+    {
+        put_hex(writer, (UINT8) (1 + shape->segment_changes * (type_2 ? 3 : 2)));
+        put_hex(writer, (UINT8) function);
+        for (i = 0; i < shape->segment_changes; i++)
+        {
+            if (FALSE == type_2)
+            {
+                put_hex(writer, (UINT8) random_range(seed, 0, shape->code_length - 1U));
+                put_hex(writer, (UINT8) next_random(seed));
+            }
+            else
+            {
+                width = random_range(seed, 1, 8);
+                start = random_range(seed, 0, bits - width);
+                put_hex(writer, (UINT8) start);
+                put_hex(writer, (UINT8) (start + width));
+                put_hex(writer, (UINT8) (next_random(seed) & ((1U << width) - 1)));
+            }
+        }
+    }
+}
+
+// no ban, the mode banned (never cool), or some speeds and temperatures banned
+static void put_ban(synth_writer_t *writer, UINT64 *seed, UINT8 tag)
+{
+    UINT choice = random_range(seed, 0, 7);
+    UINT count = 0;
+    UINT i = 0;
+
+    if (choice < 3)
+    {
+        return;
+    }
+    if (choice == 3 && TAG_AC_BAN_FUNCTION_IN_COOL_MODE != tag)
+    {
+        put_text(writer, "NA");
+        return;
+    }
+
+    put_text(writer, "S&");
+    count = random_range(seed, 1, AC_WS_MAX - 1);
+    for (i = 0; i < count; i++)
+    {
+        if (0 != i)
+        {
+            put_byte(writer, ',');
+        }
+        put_number(writer, (INT) random_range(seed, 0, AC_WS_MAX - 1));
+    }
+    put_text(writer, "|T&");
+    count = random_range(seed, 1, 6);
+    for (i = 0; i < count; i++)
+    {
+        if (0 != i)
+        {
+            put_byte(writer, ',');
+        }
+        put_number(writer, (INT) random_range(seed, 0, AC_TEMP_MAX - 1));
+    }
+}
+
+static void put_cycles(synth_writer_t *writer, UINT64 *seed, UINT8 flag, UINT16 mask, UINT16 space)
+{
+    // some jitter so that remotes of a corpus do not share their timings
+    put_byte(writer, flag);
+    put_u16(writer, (UINT16) (mask + random_range(seed, 0, 20)));
+    put_u16(writer, (UINT16) (space + random_range(seed, 0, 20)));
+}
+
+static void put_item(synth_writer_t *writer, UINT8 bits, UINT8 lsb, UINT8 mode, UINT8 index)
+{
+    put_byte(writer, bits);
+    put_byte(writer, lsb);
+    put_byte(writer, mode);
+    put_byte(writer, index);
+}
@@ -0,0 +1,311 @@
+/**************************************************************************************
+Filename:       ir_synth_main.c
+Revised:        Date: 2026-10-17
+Revision:       Revision: 1.0
+
+Description:    This file provides the generator of synthetic remote corpora
+
+Revision log:
+* 2026-10-17: created by agent
+**************************************************************************************/
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/stat.h>
+
+#include "../include/ir_defs.h"
+#include "../include/ir_decode.h"
+#include "../include/ir_synth.h"
+
+#define DEFAULT_COUNT                1000
+#define DEFAULT_SEED                 1
+#define DEFAULT_TV_PERCENT           50
+#define DEFAULT_HEX_PERCENT          25
+#define BINARY_SIZE_MAX              0xFFFF
+#define CHUNK_SIZE                   256
+
+typedef struct check_stats
+{
+    UINT failed;
+    UINT decodes;
+    UINT unsupported;
+    UINT over_limit;
+    UINT ac_longest;
+    UINT tv_longest;
+} check_stats_t;
+
+static UINT8 binary[BINARY_SIZE_MAX];
+static UINT16 chunk[CHUNK_SIZE];
+static ir_decoder_t decoder;
+
+
+static void count_sink(void *sink_data, const UINT16 *timings, UINT16 count)
+{
+    (void) sink_data;
+    (void) timings;
+    (void) count;
+}
+
+static void count_decode(check_stats_t *stats, UINT length, UINT *longest)
+{
+    stats->decodes++;
+    if (0 == length)
+    {
+        stats->unsupported++;
+    }
+    if (length > USER_DATA_SIZE)
+    {
+        stats->over_limit++;
+    }
+    if (length > *longest)
+    {
+        *longest = length;
+    }
+}
+
+// every function key in a status of every supported mode, frames are streamed so lengths are not capped
+static void check_ac(check_stats_t *stats)
+{
+    remote_ac_status_t ac_status;
+    UINT8 modes = 0;
+    UINT mode = 0;
+    UINT function = 0;
+
+    ir_decoder_get_supported_mode(&decoder, &modes);
+    memset(&ac_status, 0x00, sizeof(remote_ac_status_t));
+    ac_status.acTemp = AC_TEMP_24;
+    ac_status.acWindSpeed = AC_WS_AUTO;
+    for (mode = 0; mode < AC_MODE_MAX; mode++)
+    {
+        if (0 == (modes & (1 << mode)))
+        {
+            continue;
+        }
+        ac_status.acMode = (ac_mode) mode;
+        for (function = AC_FUNCTION_POWER; function < AC_FUNCTION_MAX; function++)
+        {
+            ac_status.acPower = AC_POWER_ON;
+            count_decode(stats, ir_decoder_decode_stream(&decoder, (UINT8) function, &ac_status, FALSE,
+                                                         chunk, CHUNK_SIZE, count_sink, NULL), &stats->ac_longest);
+        }
+    }
+    ac_status.acPower = AC_POWER_OFF;
+    count_decode(stats, ir_decoder_decode_stream(&decoder, AC_FUNCTION_POWER, &ac_status, FALSE,
+                                                 chunk, CHUNK_SIZE, count_sink, NULL), &stats->ac_longest);
+}
+
+static void check_tv(check_stats_t *stats, UINT key_count)
+{
+    UINT key = 0;
+
+    for (key = 0; key < key_count; key++)
+    {
+        count_decode(stats, ir_decoder_decode_stream(&decoder, (UINT8) key, NULL, FALSE,
+                                                     chunk, CHUNK_SIZE, count_sink, NULL), &stats->tv_longest);
+    }
+}
+
+static BOOL write_file(const char *file_name, const UINT8 *content, UINT16 length)
+{
+    FILE *stream = fopen(file_name, "wb");
+    BOOL written = FALSE;
+
+    if (NULL == stream)
+    {
+        return FALSE;
+    }
+    written = (1 == fwrite(content, length, 1, stream)) ? TRUE : FALSE;
+    fclose(stream);
+    return written;
+}
+
+static void usage(const char *program)
+{
+    printf("usage: %s [-n count] [-s seed] [-t tv_percent] [-x hex_percent] [-l code_length] [-k key_count]\n"
+           "          [-b key_bytes] [-r repeat_times] [-w] [-c] <output directory>\n", program);
+    printf("  -l  -k -b -r  largest AC default code, TV key count, TV key code bytes and AC repeat drawn\n");
+    printf("  -w  draw every limit at its largest, for worst case output lengths\n");
+    printf("  -c  open every remote generated and decode it, reporting the longest frames\n");
+    printf("remotes are written as irext_synth_<n>.ir along with list.txt as read by ir_bundle and ir_bench\n");
+}
+
+int main(int argc, char *argv[])
+{
+    ir_synth_ac_t ac_limit = { 32, 4, 4, 2, 4, 2, 2, 6, 4, 0 };
+    ir_synth_tv_t tv_limit = { 1, 1, 4, 64, 2, 1 };
+    ir_synth_ac_t ac_shape;
+    ir_synth_tv_t tv_shape;
+    check_stats_t stats;
+    const char *directory = NULL;
+    FILE *list = NULL;
+    char file_name[512];
+    UINT64 seed = DEFAULT_SEED;
+    UINT64 total_bytes = 0;
+    UINT count = DEFAULT_COUNT;
+    UINT tv_percent = DEFAULT_TV_PERCENT;
+    UINT hex_percent = DEFAULT_HEX_PERCENT;
+    UINT ac_count = 0;
+    UINT tv_count = 0;
+    UINT largest = 0;
+    UINT16 length = 0;
+    UINT8 category = 0;
+    UINT8 sub_category = 0;
+    BOOL worst = FALSE;
+    BOOL check = FALSE;
+    INT8 ret = IR_DECODE_SUCCEEDED;
+    UINT i = 0;
+    int arg = 0;
+
+    ac_limit.flags = IR_SYNTH_AC_TYPE_2 | IR_SYNTH_AC_DYNAMIC_TEMP | IR_SYNTH_AC_FUNCTIONS |
+                     IR_SYNTH_AC_SOLO | IR_SYNTH_AC_BAN;
+    for (arg = 1; arg < argc; arg++)
+    {
+        if (0 == strcmp(argv[arg], "-w"))
+        {
+            worst = TRUE;
+        }
+        else if (0 == strcmp(argv[arg], "-c"))
+        {
+            check = TRUE;
+        }
+        else if ('-' == argv[arg][0] && '\0' != argv[arg][1] && '\0' == argv[arg][2] && arg + 1 < argc)
+        {
+            UINT value = (UINT) strtoul(argv[++arg], NULL, 0);
+
+            switch (argv[arg - 1][1])
+            {
+                case 'n': count = value; break;
+                case 's': seed = (0 == value) ? DEFAULT_SEED : value; break;
+                case 't': tv_percent = value; break;
+                case 'x': hex_percent = value; break;
+                case 'l': ac_limit.code_length = (UINT8) ((value > 255) ? 255 : value); break;
+                case 'k': tv_limit.key_count = (UINT16) ((value > 256) ? 256 : value); break;
+                case 'b': tv_limit.key_bytes = (UINT8) ((value > 19) ? 19 : value); break;
+                case 'r': ac_limit.repeat_times = (UINT8) ((value > 255) ? 255 : value); break;
+                default: count = 0; break;
+            }
+        }
+        else if ('-' != argv[arg][0] && NULL == directory)
+        {
+            directory = argv[arg];
+        }
+        else
+        {
+            count = 0;
+        }
+    }
+    if (NULL == directory || 0 == count || tv_percent > 100 || hex_percent > 100)
+    {
+        usage(argv[0]);
+        return -1;
+    }
+    if (TRUE == worst)
+    {
+        ac_limit.code_length = 255;
+        ac_limit.boot_code_count = 16;
+        ac_limit.delay_code_count = 16;
+        ac_limit.delay_time_count = 8;
+        ac_limit.bitnum_count = 16;
+        ac_limit.checksum_count = 8;
+        ac_limit.swing_count = 10;
+        ac_limit.segment_changes = 8;
+        tv_limit.key_bytes = 19;
+        tv_limit.key_count = 256;
+        tv_limit.frame_count = 8;
+    }
+
+    if (0 != mkdir(directory, 0755) && EEXIST != errno)
+    {
+        printf("cannot create %s\n", directory);
+        return -1;
+    }
+    snprintf(file_name, sizeof(file_name), "%s/list.txt", directory);
+    list = fopen(file_name, "w");
+    if (NULL == list)
+    {
+        printf("cannot write %s\n", file_name);
+        return -1;
+    }
+
+    memset(&stats, 0x00, sizeof(check_stats_t));
+    for (i = 0; i < count; i++)
+    {
+        if ((UINT) (i * 100ULL / count) >= tv_percent || 0 == tv_percent)
+        {
+            // the AC remotes of a corpus come first, each remote depends on the seed only
+            category = IR_CATEGORY_AC;
+            sub_category = 0;
+            ir_synth_ac_random(&ac_shape, &ac_limit, &seed);
+            if (TRUE == worst)
+            {
+                ac_shape = ac_limit;
+            }
+            ret = ir_synth_ac(&ac_shape, &seed, binary, sizeof(binary), &length);
+        }
+        else
+        {
+            category = IR_CATEGORY_TV;
+            tv_limit.sub_category = (UINT8) ((i % 100) < hex_percent ? 2 : 1);
+            ir_synth_tv_random(&tv_shape, &tv_limit, &seed);
+            if (TRUE == worst)
+            {
+                tv_shape.key_bytes = tv_limit.key_bytes;
+                tv_shape.key_count = tv_limit.key_count;
+                tv_shape.frame_count = tv_limit.frame_count;
+            }
+            sub_category = tv_shape.sub_category;
+            ret = ir_synth_tv(&tv_shape, &seed, binary, sizeof(binary), &length);
+        }
+        if (IR_DECODE_SUCCEEDED != ret)
+        {
+            printf("remote %u does not fit in %u bytes\n", i + 1, (UINT) sizeof(binary));
+            continue;
+        }
+
+        snprintf(file_name, sizeof(file_name), "%s/irext_synth_%u.ir", directory, i + 1);
+        if (FALSE == write_file(file_name, binary, length))
+        {
+            printf("cannot write %s\n", file_name);
+            fclose(list);
+            return -1;
+        }
+        fprintf(list, "%u %u %u synth%u %s\n", i + 1, (UINT) category, (UINT) sub_category, i + 1, file_name);
+        ac_count += (IR_CATEGORY_AC == category) ? 1 : 0;
+        tv_count += (IR_CATEGORY_TV == category) ? 1 : 0;
+        total_bytes += length;
+        largest = (length > largest) ? length : largest;
+
+        if (TRUE == check)
+        {
+            if (IR_DECODE_SUCCEEDED != ir_decoder_open_binary(&decoder, category, sub_category, binary, length))
+            {
+                printf("failed to open %s\n", file_name);
+                stats.failed++;
+            }
+            else if (IR_CATEGORY_AC == category)
+            {
+                check_ac(&stats);
+            }
+            else
+            {
+                check_tv(&stats, tv_shape.key_count);
+            }
+            ir_decoder_close(&decoder);
+        }
+    }
+    fclose(list);
+
+    printf("%u remotes (%u AC, %u TV) of %llu bytes, largest %u bytes\n", ac_count + tv_count, ac_count, tv_count,
+           (unsigned long long) total_bytes, largest);
+    if (TRUE == check)
+    {
+        printf("check: %u failed to open, %u decodes, %u without frame, %u over %u timings\n",
+               stats.failed, stats.decodes, stats.unsupported, stats.over_limit, (UINT) USER_DATA_SIZE);
+        printf("longest frame: AC %u timings, TV %u timings\n", stats.ac_longest, stats.tv_longest);
+    }
+    return (0 == stats.failed) ? 0 : -1;
+}
@@ -9,6 +9,7 @@ Revision log:
 * 2016-10-21: created by strawmanbobi
 **************************************************************************************/
 
+#include <stdlib.h>
 #include <string.h>
 
 #include "../include/ir_defs.h"
@@ -16,46 +17,46 @@ Revision log:
 #include "../include/ir_tv_control.h"
 
 
-struct buffer
-{
-    UINT8 *data;
-    UINT16 len;
-    UINT16 offset;
-} ir_file;
+// distinct timings counted when picking the ones told by index in a key table
+#define IR_TV_RUN_CANDIDATES         255
+
+static BOOL get_ir_protocol(ir_tv_context_t *tv, UINT8 encode_type);
+
+static BOOL get_ir_keymap(ir_tv_context_t *tv);
 
+static void render_key(ir_tv_context_t *tv, UINT8 key, ir_output_t *output);
 
-static struct buffer *pbuffer = &ir_file;
+static UINT16 render_to_buffer(ir_tv_context_t *tv, UINT8 key, UINT16 *buffer, UINT16 capacity);
 
-//static UINT8 *prot_name = NULL;
-static UINT8 *prot_cycles_num = NULL;
-static ir_cycles_t *prot_cycles_data[IRDA_MAX];
-static UINT8 prot_items_cnt = 0;
-static ir_data_t *prot_items_data = NULL;
-static ir_data_tv_t *remote_p;
-static UINT8 *remote_pdata = NULL;
+static void count_uses(UINT16 *candidates, UINT *uses, UINT8 *candidate_count, const UINT16 *timings,
+                       UINT16 length);
 
-static UINT16 time_index = 0;
-static UINT8 ir_level = IRDA_LEVEL_LOW;
-static UINT8 ir_toggle_bit = FALSE;
-static UINT8 ir_decode_flag = IRDA_DECODE_1_BIT;
-static UINT8 cycles_num_size = 0;
+static void pick_values(ir_tv_key_table_t *table, const UINT16 *candidates, UINT *uses, UINT8 candidate_count);
 
+static UINT encode_runs(const ir_tv_key_table_t *table, const UINT16 *timings, UINT16 length, UINT8 *runs);
 
-static BOOL get_ir_protocol(UINT8 encode_type);
+static void expand_runs(const ir_tv_key_table_t *table, const ir_tv_key_entry_t *entry, ir_output_t *output);
 
-static BOOL get_ir_keymap(void);
+static UINT16 keymap_key_count(ir_tv_context_t *tv);
 
-static void print_ir_time(ir_data_t *data, UINT8 key_index, UINT16 *ir_time);
+static UINT max_key_length(ir_tv_context_t *tv);
 
-static void process_decode_number(UINT8 keycode, ir_data_t *data, UINT8 valid_bits, UINT16 *ir_time);
+static void count_timings(void *sink_data, const UINT16 *timings, UINT16 count);
 
-static void convert_to_ir_time(UINT8 value, UINT16 *ir_time);
+static void print_ir_time(ir_tv_context_t *tv, ir_data_t *data, UINT8 key_index, ir_output_t *output);
 
-static void replace_with(ir_cycles_t *pcycles_num, UINT16 *ir_time);
+static void process_decode_number(ir_tv_context_t *tv, UINT8 keycode, ir_data_t *data, UINT8 valid_bits,
+                                  ir_output_t *output);
 
+static void convert_to_ir_time(ir_tv_context_t *tv, UINT8 value, ir_output_t *output);
 
-INT8 tv_lib_open(UINT8 *binary, UINT16 binary_length)
+static void replace_with(ir_tv_context_t *tv, ir_cycles_t *pcycles_num, ir_output_t *output);
+
+
+INT8 tv_lib_open(ir_tv_context_t *tv, UINT8 *binary, UINT16 binary_length)
 {
+    struct tv_buffer *pbuffer = &tv->buffer;
+
     // load binary to buffer
     pbuffer->data = binary;
     pbuffer->len = binary_length;
@@ -63,40 +64,210 @@ INT8 tv_lib_open(UINT8 *binary, UINT16 binary_length)
     return IR_DECODE_SUCCEEDED;
 }
 
-BOOL tv_lib_parse(UINT8 encode_type)
+BOOL tv_lib_parse(ir_tv_context_t *tv, UINT8 encode_type)
 {
-    if (FALSE == get_ir_protocol(encode_type))
+    if (FALSE == get_ir_protocol(tv, encode_type))
     {
         return FALSE;
     }
 
-    return get_ir_keymap();
+    if (FALSE == get_ir_keymap(tv))
+    {
+        return FALSE;
+    }
+    tv->max_length = max_key_length(tv);
+    return TRUE;
 }
 
-UINT16 tv_lib_control(UINT8 key, UINT16 *user_data)
+INT8 tv_lib_materialize(ir_tv_context_t *tv, size_t *memory_size)
 {
-    UINT16 i = 0;
+    ir_tv_key_table_t header;
+    ir_tv_key_table_t *final = NULL;
+    ir_tv_key_entry_t *entries = NULL;
+    ir_tv_key_entry_t *entry = NULL;
+    UINT16 *scratch = NULL;
+    UINT8 *pool = NULL;
+    UINT16 candidates[IR_TV_RUN_CANDIDATES];
+    UINT uses[IR_TV_RUN_CANDIDATES];
+    UINT16 values[IR_TV_RUN_VALUES];
+    UINT8 candidate_count = 0;
+    UINT16 key_count = 0;
+    UINT16 capacity = 0;
+    UINT8 toggle_states = 0;
+    UINT8 toggle_bit = 0;
+    UINT entry_count = 0;
+    UINT pool_size = 0;
+    UINT used = 0;
+    UINT i = 0;
+    UINT j = 0;
+    UINT16 length = 0;
+    UINT run_bytes = 0;
+    size_t size = 0;
+
+    if (NULL == tv->remote_pdata || NULL != tv->key_table || 0 == tv->max_length || tv->max_length > 0xFFFF)
+    {
+        return IR_DECODE_FAILED;
+    }
+
+    key_count = keymap_key_count(tv);
+    toggle_states = (UINT8) ((2 == tv->prot_cycles_num[IRDA_FLIP]) ? 2 : 1);
+    entry_count = (UINT) key_count * toggle_states;
+    if (0 == entry_count)
+    {
+        return IR_DECODE_FAILED;
+    }
+
+    // no key renders to more than max_length timings
+    capacity = (UINT16) tv->max_length;
+    scratch = (UINT16 *) ir_malloc(capacity * sizeof(UINT16));
+    if (NULL == scratch)
+    {
+        return IR_DECODE_FAILED;
+    }
+    toggle_bit = tv->ir_toggle_bit;
+
+    // first pass counts the uses of each timing and sizes the pool as if every timing took a literal
+    for (i = 0; i < entry_count; i++)
+    {
+        tv->ir_toggle_bit = (UINT8) (i % toggle_states);
+        length = render_to_buffer(tv, (UINT8) (i / toggle_states), scratch, capacity);
+        count_uses(candidates, uses, &candidate_count, scratch, length);
+        pool_size += (UINT) length * 3;
+    }
+    ir_memset(&header, 0x00, sizeof(ir_tv_key_table_t));
+    header.values = values;
+    pick_values(&header, candidates, uses, candidate_count);
+
+    entries = (ir_tv_key_entry_t *) ir_malloc(entry_count * sizeof(ir_tv_key_entry_t));
+    pool = (UINT8 *) ir_malloc(pool_size + 1);
+    if (NULL == entries || NULL == pool)
+    {
+        goto failed;
+    }
+
+    // second pass keeps the runs of every distinct waveform once
+    for (i = 0; i < entry_count; i++)
+    {
+        tv->ir_toggle_bit = (UINT8) (i % toggle_states);
+        length = render_to_buffer(tv, (UINT8) (i / toggle_states), scratch, capacity);
+        entry = &entries[i];
+        entry->offset = used;
+        entry->length = length;
+        run_bytes = encode_runs(&header, scratch, length, pool + used);
+        if (run_bytes > 0xFFFF)
+        {
+            goto failed;
+        }
+        entry->run_bytes = (UINT16) run_bytes;
+        for (j = 0; j < i; j++)
+        {
+            if (entries[j].length == length && entries[j].run_bytes == entry->run_bytes &&
+                0 == memcmp(pool + entries[j].offset, pool + used, entry->run_bytes))
+            {
+                entry->offset = entries[j].offset;
+                break;
+            }
+        }
+        if (j == i)
+        {
+            used += entry->run_bytes;
+        }
+    }
+
+    // the final block holds the entries and the values followed by the distinct runs only
+    size = sizeof(ir_tv_key_table_t) + entry_count * sizeof(ir_tv_key_entry_t) +
+           header.value_count * sizeof(UINT16) + used;
+    final = (ir_tv_key_table_t *) ir_malloc(size);
+    if (NULL == final)
+    {
+        goto failed;
+    }
+    ir_memcpy(final, &header, sizeof(ir_tv_key_table_t));
+    final->size = size;
+    final->key_count = key_count;
+    final->toggle_states = toggle_states;
+    final->run_size = used;
+    final->entries = (ir_tv_key_entry_t *) (final + 1);
+    final->values = (UINT16 *) (final->entries + entry_count);
+    final->runs = (UINT8 *) (final->values + header.value_count);
+    ir_memcpy(final->entries, entries, entry_count * sizeof(ir_tv_key_entry_t));
+    ir_memcpy(final->values, values, header.value_count * sizeof(UINT16));
+    ir_memcpy(final->runs, pool, used);
+    tv->key_table = final;
+    if (NULL != memory_size)
+    {
+        *memory_size = final->size;
+    }
 
-    time_index = 0;
-    ir_level = IRDA_LEVEL_LOW;
+failed:
+    tv->ir_toggle_bit = toggle_bit;
+    ir_free(scratch);
+    if (NULL != entries)
+    {
+        ir_free(entries);
+    }
+    if (NULL != pool)
+    {
+        ir_free(pool);
+    }
+    return (NULL != tv->key_table) ? IR_DECODE_SUCCEEDED : IR_DECODE_FAILED;
+}
 
-    for (i = 0; i < prot_items_cnt; i++)
+UINT tv_lib_control(ir_tv_context_t *tv, UINT8 key, ir_output_t *output)
+{
+    ir_tv_key_entry_t *entry = NULL;
+
+    if (NULL != tv->key_table && key < tv->key_table->key_count)
+    {
+        entry = &tv->key_table->entries[key * tv->key_table->toggle_states +
+                                        (tv->key_table->toggle_states - 1) * tv->ir_toggle_bit];
+        expand_runs(tv->key_table, entry, output);
+    }
+    else
     {
-        print_ir_time(&prot_items_data[i], key, user_data);
+        render_key(tv, key, output);
     }
 
     // next flip
-    if (2 == prot_cycles_num[IRDA_FLIP])
+    if (2 == tv->prot_cycles_num[IRDA_FLIP])
     {
-        ir_toggle_bit = (ir_toggle_bit == FALSE) ? TRUE : FALSE;
+        tv->ir_toggle_bit = (tv->ir_toggle_bit == FALSE) ? TRUE : FALSE;
     }
 
-    return time_index;
+    return output->total;
 }
 
+UINT tv_lib_key_length(ir_tv_context_t *tv, UINT8 key)
+{
+    ir_output_t output;
+    UINT16 chunk[16];
+
+    if (NULL != tv->key_table && key < tv->key_table->key_count)
+    {
+        return tv->key_table->entries[key * tv->key_table->toggle_states +
+                                      (tv->key_table->toggle_states - 1) * tv->ir_toggle_bit].length;
+    }
+
+    // rendered and counted only, the toggle bit moves on with tv_lib_control alone
+    ir_output_init(&output, chunk, sizeof(chunk) / sizeof(UINT16), count_timings, NULL);
+    render_key(tv, key, &output);
+    return ir_output_finish(&output);
+}
 
-static BOOL get_ir_protocol(UINT8 encode_type)
+UINT8 tv_lib_close(ir_tv_context_t *tv)
 {
+    if (NULL != tv->key_table)
+    {
+        ir_free(tv->key_table);
+    }
+    ir_memset(tv, 0x00, sizeof(ir_tv_context_t));
+    return IR_DECODE_SUCCEEDED;
+}
+
+
+static BOOL get_ir_protocol(ir_tv_context_t *tv, UINT8 encode_type)
+{
+    struct tv_buffer *pbuffer = &tv->buffer;
     UINT8 i = 0;
     UINT8 name_size = 20;
     UINT8 *prot_cycles = NULL;
@@ -114,97 +285,307 @@ static BOOL get_ir_protocol(UINT8 encode_type)
     pbuffer->offset += name_size;
 
     /* cycles number */
-    prot_cycles_num = pbuffer->data + pbuffer->offset;
+    tv->prot_cycles_num = pbuffer->data + pbuffer->offset;
 
     if (encode_type == 0)
     {
-        cycles_num_size = 8;      /* "BOOT", "STOP", "SEP", "ONE", "ZERO", "FLIP", "TWO", "THREE" */
-        if (prot_cycles_num[IRDA_TWO] == 0 && prot_cycles_num[IRDA_THREE] == 0)
+        tv->cycles_num_size = 8;      /* "BOOT", "STOP", "SEP", "ONE", "ZERO", "FLIP", "TWO", "THREE" */
+        if (tv->prot_cycles_num[IRDA_TWO] == 0 && tv->prot_cycles_num[IRDA_THREE] == 0)
         {
-            ir_decode_flag = IRDA_DECODE_1_BIT;
+            tv->ir_decode_flag = IRDA_DECODE_1_BIT;
         }
         else
         {
-            ir_decode_flag = IRDA_DECODE_2_BITS;
+            tv->ir_decode_flag = IRDA_DECODE_2_BITS;
         }
     }
     else if (encode_type == 1)
     {
-        cycles_num_size = IRDA_MAX;
-        ir_decode_flag = IRDA_DECODE_4_BITS;
+        tv->cycles_num_size = IRDA_MAX;
+        tv->ir_decode_flag = IRDA_DECODE_4_BITS;
     }
     else
     {
         return FALSE;
     }
-    pbuffer->offset += cycles_num_size;
+    pbuffer->offset += tv->cycles_num_size;
 
     /* cycles data */
     prot_cycles = pbuffer->data + pbuffer->offset;
-    for (i = 0; i < cycles_num_size; i++)
+    for (i = 0; i < tv->cycles_num_size; i++)
     {
-        if (0 != prot_cycles_num[i])
+        if (0 != tv->prot_cycles_num[i])
         {
-            prot_cycles_data[i] = (ir_cycles_t *) (&prot_cycles[sizeof(ir_cycles_t) * cycles_sum]);
+            tv->prot_cycles_data[i] = (ir_cycles_t *) (&prot_cycles[sizeof(ir_cycles_t) * cycles_sum]);
         }
         else
         {
-            prot_cycles_data[i] = NULL;
+            tv->prot_cycles_data[i] = NULL;
         }
-        cycles_sum += prot_cycles_num[i];
+        cycles_sum += tv->prot_cycles_num[i];
     }
     pbuffer->offset += sizeof(ir_cycles_t) * cycles_sum;
 
     /* items count */
-    prot_items_cnt = pbuffer->data[pbuffer->offset];
+    tv->prot_items_cnt = pbuffer->data[pbuffer->offset];
     pbuffer->offset += sizeof(UINT8);
 
     /* items data */
-    prot_items_data = (ir_data_t *) (pbuffer->data + pbuffer->offset);
-    pbuffer->offset += prot_items_cnt * sizeof(ir_data_t);
+    tv->prot_items_data = (ir_data_t *) (pbuffer->data + pbuffer->offset);
+    pbuffer->offset += tv->prot_items_cnt * sizeof(ir_data_t);
 
-    ir_toggle_bit = FALSE;
+    tv->ir_toggle_bit = FALSE;
 
     return TRUE;
 }
 
-static BOOL get_ir_keymap(void)
+static BOOL get_ir_keymap(ir_tv_context_t *tv)
 {
-    remote_p = (ir_data_tv_t *) (pbuffer->data + pbuffer->offset);
+    struct tv_buffer *pbuffer = &tv->buffer;
+
+    tv->remote_p = (ir_data_tv_t *) (pbuffer->data + pbuffer->offset);
     pbuffer->offset += sizeof(ir_data_tv_t);
 
-    if (strncmp(remote_p->magic, "irda", 4) == 0)
+    if (strncmp(tv->remote_p->magic, "irda", 4) == 0)
     {
-        remote_pdata = pbuffer->data + pbuffer->offset;
+        tv->remote_pdata = pbuffer->data + pbuffer->offset;
         return TRUE;
     }
 
     return FALSE;
 }
 
-static void print_ir_time(ir_data_t *data, UINT8 key_index, UINT16 *ir_time)
+static void render_key(ir_tv_context_t *tv, UINT8 key, ir_output_t *output)
+{
+    UINT16 i = 0;
+
+    tv->ir_level = IRDA_LEVEL_LOW;
+
+    for (i = 0; i < tv->prot_items_cnt; i++)
+    {
+        print_ir_time(tv, &tv->prot_items_data[i], key, output);
+    }
+}
+
+static UINT16 render_to_buffer(ir_tv_context_t *tv, UINT8 key, UINT16 *buffer, UINT16 capacity)
+{
+    ir_output_t output;
+
+    ir_output_init(&output, buffer, capacity, NULL, NULL);
+    render_key(tv, key, &output);
+    return (TRUE == output.overflow) ? 0 : output.used;
+}
+
+// timings past the first IR_TV_RUN_CANDIDATES distinct ones are not counted, they are kept as literals
+static void count_uses(UINT16 *candidates, UINT *uses, UINT8 *candidate_count, const UINT16 *timings,
+                       UINT16 length)
+{
+    UINT16 i = 0;
+    UINT8 j = 0;
+
+    for (i = 0; i < length; i++)
+    {
+        j = 0;
+        while (j < *candidate_count && candidates[j] != timings[i])
+        {
+            j++;
+        }
+        if (j < *candidate_count)
+        {
+            uses[j]++;
+        }
+        else if (*candidate_count < IR_TV_RUN_CANDIDATES)
+        {
+            candidates[j] = timings[i];
+            uses[j] = 1;
+            (*candidate_count)++;
+        }
+    }
+}
+
+static void pick_values(ir_tv_key_table_t *table, const UINT16 *candidates, UINT *uses, UINT8 candidate_count)
+{
+    UINT8 best = 0;
+    UINT8 i = 0;
+
+    // the most used timings are told by index
+    while (table->value_count < IR_TV_RUN_VALUES)
+    {
+        best = candidate_count;
+        for (i = 0; i < candidate_count; i++)
+        {
+            if (0 != uses[i] && (best == candidate_count || uses[i] > uses[best]))
+            {
+                best = i;
+            }
+        }
+        if (best == candidate_count)
+        {
+            break;
+        }
+        table->values[table->value_count++] = candidates[best];
+        uses[best] = 0;
+    }
+}
+
+static UINT encode_runs(const ir_tv_key_table_t *table, const UINT16 *timings, UINT16 length, UINT8 *runs)
+{
+    UINT bytes = 0;
+    UINT16 i = 0;
+    UINT16 count = 0;
+    UINT8 index = 0;
+
+    while (i < length)
+    {
+        count = 1;
+        while (i + count < length && count < IR_TV_RUN_MAX && timings[i + count] == timings[i])
+        {
+            count++;
+        }
+        index = 0;
+        while (index < table->value_count && table->values[index] != timings[i])
+        {
+            index++;
+        }
+        runs[bytes++] = (UINT8) (((count > 1) ? IR_TV_RUN_REPEAT : 0) |
+                                 ((index < table->value_count) ? index : IR_TV_RUN_LITERAL));
+        if (index == table->value_count)
+        {
+            runs[bytes++] = (UINT8) (timings[i] & 0xFF);
+            runs[bytes++] = (UINT8) (timings[i] >> 8);
+        }
+        if (count > 1)
+        {
+            runs[bytes++] = (UINT8) count;
+        }
+        i = (UINT16) (i + count);
+    }
+    return bytes;
+}
+
+static void expand_runs(const ir_tv_key_table_t *table, const ir_tv_key_entry_t *entry, ir_output_t *output)
+{
+    const UINT8 *run = table->runs + entry->offset;
+    const UINT8 *end = run + entry->run_bytes;
+    UINT16 timing = 0;
+    UINT8 count = 0;
+    UINT8 index = 0;
+    BOOL repeat = FALSE;
+
+    while (run < end)
+    {
+        index = (UINT8) (*run & IR_TV_RUN_LITERAL);
+        repeat = (0 != (*run & IR_TV_RUN_REPEAT)) ? TRUE : FALSE;
+        run++;
+        if (IR_TV_RUN_LITERAL == index)
+        {
+            timing = (UINT16) (run[0] | (run[1] << 8));
+            run += 2;
+        }
+        else
+        {
+            timing = table->values[index];
+        }
+        count = (TRUE == repeat) ? *run++ : 1;
+        while (count-- > 0)
+        {
+            ir_output_put(output, timing);
+        }
+    }
+}
+
+static UINT16 keymap_key_count(ir_tv_context_t *tv)
+{
+    struct tv_buffer *pbuffer = &tv->buffer;
+    UINT16 keymap_size = 0;
+    UINT16 key_count = 0;
+    UINT8 max_index = 0;
+    UINT8 i = 0;
+
+    if (0 == tv->remote_p->per_keycode_bytes || pbuffer->len <= pbuffer->offset)
+    {
+        return 0;
+    }
+
+    // a key is rendered only if every key code byte its items refer to is within the binary
+    for (i = 0; i < tv->prot_items_cnt; i++)
+    {
+        if (tv->prot_items_data[i].index > max_index)
+        {
+            max_index = tv->prot_items_data[i].index;
+        }
+    }
+    keymap_size = (UINT16) (pbuffer->len - pbuffer->offset);
+    if (max_index > tv->remote_p->per_keycode_bytes)
+    {
+        keymap_size = (keymap_size > max_index - tv->remote_p->per_keycode_bytes) ?
+                      (UINT16) (keymap_size - (max_index - tv->remote_p->per_keycode_bytes)) : 0;
+    }
+    key_count = keymap_size / tv->remote_p->per_keycode_bytes;
+
+    // key codes are UINT8
+    return (key_count > 256) ? 256 : key_count;
+}
+
+// at most 2 timings per cycle or per digit of key code, as print_ir_time puts them
+static UINT max_key_length(ir_tv_context_t *tv)
+{
+    ir_data_t *data = NULL;
+    UINT length = 0;
+    UINT8 cycles_num = 0;
+    UINT8 valid_bits = 0;
+    UINT8 i = 0;
+
+    valid_bits = (UINT8) ((tv->ir_decode_flag == IRDA_DECODE_1_BIT) ? 1 :
+                          ((tv->ir_decode_flag == IRDA_DECODE_2_BITS) ? 2 : 4));
+    for (i = 0; i < tv->prot_items_cnt; i++)
+    {
+        data = &tv->prot_items_data[i];
+        if (data->bits == 1)
+        {
+            // a flip of 2 cycles sends one of them
+            cycles_num = tv->prot_cycles_num[data->index];
+            cycles_num = (UINT8) ((cycles_num == 2 && data->index == IRDA_FLIP) ? 1 : cycles_num);
+            length += (cycles_num > 5) ? 0 : cycles_num * 2U;
+        }
+        else
+        {
+            length += (data->bits / valid_bits) * 2U;
+        }
+    }
+    return length;
+}
+
+static void count_timings(void *sink_data, const UINT16 *timings, UINT16 count)
+{
+    (void) sink_data;
+    (void) timings;
+    (void) count;
+}
+
+static void print_ir_time(ir_tv_context_t *tv, ir_data_t *data, UINT8 key_index, ir_output_t *output)
 {
     UINT8 i = 0;
     UINT8 cycles_num = 0;
     ir_cycles_t *pcycles = NULL;
     UINT8 key_code = 0;
 
-    if (NULL == data || NULL == ir_time)
+    if (NULL == data || NULL == output)
     {
-        ir_printf("data or ir_time is null\n");
+        ir_printf("data or output is null\n");
         return;
     }
 
-    pcycles = prot_cycles_data[data->index];
-    key_code = remote_pdata[remote_p->per_keycode_bytes * key_index + data->index - 1];
+    pcycles = tv->prot_cycles_data[data->index];
+    key_code = tv->remote_pdata[tv->remote_p->per_keycode_bytes * key_index + data->index - 1];
 
-    if (prot_cycles_num[IRDA_ONE] != 1 || prot_cycles_num[IRDA_ZERO] != 1)
+    if (tv->prot_cycles_num[IRDA_ONE] != 1 || tv->prot_cycles_num[IRDA_ZERO] != 1)
     {
         ir_printf("logical 1 or 0 is invalid\n");
         return;
     }
 
-    if (time_index >= USER_DATA_SIZE)
+    if (TRUE == output->overflow)
     {
         ir_printf("time index exceeded\n");
         return;
@@ -218,7 +599,7 @@ static void print_ir_time(ir_data_t *data, UINT8 key_index, UINT16 *ir_time)
             return;
         }
 
-        cycles_num = prot_cycles_num[data->index];
+        cycles_num = tv->prot_cycles_num[data->index];
         if (cycles_num > 5)
         {
             ir_printf("cycles number exceeded\n");
@@ -229,7 +610,7 @@ static void print_ir_time(ir_data_t *data, UINT8 key_index, UINT16 *ir_time)
         {
             if (cycles_num == 2 && data->index == IRDA_FLIP)
             {
-                if (ir_toggle_bit == TRUE)
+                if (tv->ir_toggle_bit == TRUE)
                 {
                     pcycles += 1;
                 }
@@ -239,58 +620,54 @@ static void print_ir_time(ir_data_t *data, UINT8 key_index, UINT16 *ir_time)
             {
                 if (pcycles->flag == IRDA_FLAG_NORMAL)
                 {
-                    if (ir_level == IRDA_LEVEL_HIGH && time_index != 0)
+                    if (tv->ir_level == IRDA_LEVEL_HIGH && 0 != output->total)
                     {
-                        time_index--;
-                        ir_time[time_index++] += pcycles->mask;
+                        ir_output_add_last(output, pcycles->mask);
                     }
-                    else if (ir_level == IRDA_LEVEL_LOW)
+                    else if (tv->ir_level == IRDA_LEVEL_LOW)
                     {
-                        ir_time[time_index++] = pcycles->mask;
+                        ir_output_put(output, pcycles->mask);
                     }
-                    ir_time[time_index++] = pcycles->space;
-                    ir_level = IRDA_LEVEL_LOW;
+                    ir_output_put(output, pcycles->space);
+                    tv->ir_level = IRDA_LEVEL_LOW;
                 }
                 else if (pcycles->flag == IRDA_FLAG_INVERSE)
                 {
-                    if (ir_level == IRDA_LEVEL_LOW && time_index != 0)
+                    if (tv->ir_level == IRDA_LEVEL_LOW && 0 != output->total)
                     {
-                        time_index--;
-                        ir_time[time_index++] += pcycles->space;
+                        ir_output_add_last(output, pcycles->space);
                     }
-                    else if (ir_level == IRDA_LEVEL_HIGH)
+                    else if (tv->ir_level == IRDA_LEVEL_HIGH)
                     {
-                        ir_time[time_index++] = pcycles->space;
+                        ir_output_put(output, pcycles->space);
                     }
-                    ir_time[time_index++] = pcycles->mask;
-                    ir_level = IRDA_LEVEL_HIGH;
+                    ir_output_put(output, pcycles->mask);
+                    tv->ir_level = IRDA_LEVEL_HIGH;
                 }
             }
             else if (0 == pcycles->mask && 0 != pcycles->space)
             {
-                if (ir_level == IRDA_LEVEL_LOW && time_index != 0)
+                if (tv->ir_level == IRDA_LEVEL_LOW && 0 != output->total)
                 {
-                    time_index--;
-                    ir_time[time_index++] += pcycles->space;
+                    ir_output_add_last(output, pcycles->space);
                 }
-                else if (ir_level == IRDA_LEVEL_HIGH)
+                else if (tv->ir_level == IRDA_LEVEL_HIGH)
                 {
-                    ir_time[time_index++] = pcycles->space;
+                    ir_output_put(output, pcycles->space);
                 }
-                ir_level = IRDA_LEVEL_LOW;
+                tv->ir_level = IRDA_LEVEL_LOW;
             }
             else if (0 == pcycles->space && 0 != pcycles->mask)
             {
-                if (ir_level == IRDA_LEVEL_HIGH && time_index != 0)
+                if (tv->ir_level == IRDA_LEVEL_HIGH && 0 != output->total)
                 {
-                    time_index--;
-                    ir_time[time_index++] += pcycles->mask;
+                    ir_output_add_last(output, pcycles->mask);
                 }
-                else if (ir_level == IRDA_LEVEL_LOW)
+                else if (tv->ir_level == IRDA_LEVEL_LOW)
                 {
-                    ir_time[time_index++] = pcycles->mask;
+                    ir_output_put(output, pcycles->mask);
                 }
-                ir_level = IRDA_LEVEL_HIGH;
+                tv->ir_level = IRDA_LEVEL_HIGH;
             }
             else
             {
@@ -313,25 +690,26 @@ static void print_ir_time(ir_data_t *data, UINT8 key_index, UINT16 *ir_time)
         if (data->mode == 1)
             key_code = ~key_code;
 
-        if (ir_decode_flag == IRDA_DECODE_1_BIT)
+        if (tv->ir_decode_flag == IRDA_DECODE_1_BIT)
         {
             // for binary formatted code
-            process_decode_number(key_code, data, 1, ir_time);
+            process_decode_number(tv, key_code, data, 1, output);
         }
-        else if (ir_decode_flag == IRDA_DECODE_2_BITS)
+        else if (tv->ir_decode_flag == IRDA_DECODE_2_BITS)
         {
             // for quanternary formatted code
-            process_decode_number(key_code, data, 2, ir_time);
+            process_decode_number(tv, key_code, data, 2, output);
         }
-        else if (ir_decode_flag == IRDA_DECODE_4_BITS)
+        else if (tv->ir_decode_flag == IRDA_DECODE_4_BITS)
         {
             // for hexadecimal formatted code
-            process_decode_number(key_code, data, 4, ir_time);
+            process_decode_number(tv, key_code, data, 4, output);
         }
     }
 }
 
-static void process_decode_number(UINT8 keycode, ir_data_t *data, UINT8 valid_bits, UINT16 *ir_time)
+static void process_decode_number(ir_tv_context_t *tv, UINT8 keycode, ir_data_t *data, UINT8 valid_bits,
+                                  ir_output_t *output)
 {
     UINT8 i = 0;
     UINT8 value = 0;
@@ -345,7 +723,7 @@ static void process_decode_number(UINT8 keycode, ir_data_t *data, UINT8 valid_bi
         for (i = 0; i < bit_num; i++)
         {
             value = (keycode >> (valid_bits * i)) & valid_value;
-            convert_to_ir_time(value, ir_time);
+            convert_to_ir_time(tv, value, output);
         }
     }
     else if (data->lsb == IRDA_MSB)
@@ -353,101 +731,99 @@ static void process_decode_number(UINT8 keycode, ir_data_t *data, UINT8 valid_bi
         for (i = 0; i < bit_num; i++)
         {
             value = (keycode >> (data->bits - valid_bits * (i + 1))) & valid_value;
-            convert_to_ir_time(value, ir_time);
+            convert_to_ir_time(tv, value, output);
         }
     }
 }
 
-static void convert_to_ir_time(UINT8 value, UINT16 *ir_time)
+static void convert_to_ir_time(ir_tv_context_t *tv, UINT8 value, ir_output_t *output)
 {
     switch (value)
     {
         case 0:
-            replace_with(prot_cycles_data[IRDA_ZERO], ir_time);
+            replace_with(tv, tv->prot_cycles_data[IRDA_ZERO], output);
             break;
         case 1:
-            replace_with(prot_cycles_data[IRDA_ONE], ir_time);
+            replace_with(tv, tv->prot_cycles_data[IRDA_ONE], output);
             break;
         case 2:
-            replace_with(prot_cycles_data[IRDA_TWO], ir_time);
+            replace_with(tv, tv->prot_cycles_data[IRDA_TWO], output);
             break;
         case 3:
-            replace_with(prot_cycles_data[IRDA_THREE], ir_time);
+            replace_with(tv, tv->prot_cycles_data[IRDA_THREE], output);
             break;
         case 4:
-            replace_with(prot_cycles_data[IRDA_FOUR], ir_time);
+            replace_with(tv, tv->prot_cycles_data[IRDA_FOUR], output);
             break;
         case 5:
-            replace_with(prot_cycles_data[IRDA_FIVE], ir_time);
+            replace_with(tv, tv->prot_cycles_data[IRDA_FIVE], output);
             break;
         case 6:
-            replace_with(prot_cycles_data[IRDA_SIX], ir_time);
+            replace_with(tv, tv->prot_cycles_data[IRDA_SIX], output);
             break;
         case 7:
-            replace_with(prot_cycles_data[IRDA_SEVEN], ir_time);
+            replace_with(tv, tv->prot_cycles_data[IRDA_SEVEN], output);
             break;
         case 8:
-            replace_with(prot_cycles_data[IRDA_EIGHT], ir_time);
+            replace_with(tv, tv->prot_cycles_data[IRDA_EIGHT], output);
             break;
         case 9:
-            replace_with(prot_cycles_data[IRDA_NINE], ir_time);
+            replace_with(tv, tv->prot_cycles_data[IRDA_NINE], output);
             break;
         case 0x0A:
-            replace_with(prot_cycles_data[IRDA_A], ir_time);
+            replace_with(tv, tv->prot_cycles_data[IRDA_A], output);
             break;
         case 0x0B:
-            replace_with(prot_cycles_data[IRDA_B], ir_time);
+            replace_with(tv, tv->prot_cycles_data[IRDA_B], output);
             break;
         case 0x0C:
-            replace_with(prot_cycles_data[IRDA_C], ir_time);
+            replace_with(tv, tv->prot_cycles_data[IRDA_C], output);
             break;
         case 0x0D:
-            replace_with(prot_cycles_data[IRDA_D], ir_time);
+            replace_with(tv, tv->prot_cycles_data[IRDA_D], output);
             break;
         case 0x0E:
-            replace_with(prot_cycles_data[IRDA_E], ir_time);
+            replace_with(tv, tv->prot_cycles_data[IRDA_E], output);
             break;
         case 0x0F:
-            replace_with(prot_cycles_data[IRDA_F], ir_time);
+            replace_with(tv, tv->prot_cycles_data[IRDA_F], output);
             break;
         default:
             break;
     }
 }
 
-static void replace_with(ir_cycles_t *pcycles_num, UINT16 *ir_time)
+static void replace_with(ir_tv_context_t *tv, ir_cycles_t *pcycles_num, ir_output_t *output)
 {
-    if (NULL == pcycles_num || NULL == ir_time)
+    if (NULL == pcycles_num || NULL == output)
     {
         return;
     }
 
     if (pcycles_num->flag == IRDA_FLAG_NORMAL)
     {
-        if (ir_level == IRDA_LEVEL_HIGH && time_index != 0)
+        if (tv->ir_level == IRDA_LEVEL_HIGH && 0 != output->total)
         {
-            time_index--;
-            ir_time[time_index++] += pcycles_num->mask;
+            ir_output_add_last(output, pcycles_num->mask);
         }
-        else if (ir_level == IRDA_LEVEL_LOW)
+        else if (tv->ir_level == IRDA_LEVEL_LOW)
         {
-            ir_time[time_index++] = pcycles_num->mask;
+            ir_output_put(output, pcycles_num->mask);
         }
-        ir_time[time_index++] = pcycles_num->space;
-        ir_level = IRDA_LEVEL_LOW;
+        ir_output_put(output, pcycles_num->space);
+        tv->ir_level = IRDA_LEVEL_LOW;
     }
     else if (pcycles_num->flag == IRDA_FLAG_INVERSE)
     {
-        if (ir_level == IRDA_LEVEL_LOW && time_index != 0)
+        if (tv->ir_level == IRDA_LEVEL_LOW && 0 != output->total)
         {
-            time_index--;
-            ir_time[time_index++] += pcycles_num->space;
+            ir_output_add_last(output, pcycles_num->space);
         }
-        else if (ir_level == IRDA_LEVEL_HIGH)
+        else if (tv->ir_level == IRDA_LEVEL_HIGH)
         {
-            ir_time[time_index++] = pcycles_num->space;
+            ir_output_put(output, pcycles_num->space);
         }
-        ir_time[time_index++] = pcycles_num->mask;
-        ir_level = IRDA_LEVEL_HIGH;
+        ir_output_put(output, pcycles_num->mask);
+        tv->ir_level = IRDA_LEVEL_HIGH;
     }
 }
\ No newline at end of file
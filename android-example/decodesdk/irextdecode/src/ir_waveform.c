@@ -0,0 +1,93 @@
+/**************************************************************************************
+Filename:       ir_waveform.c
+Revised:        Date: 2026-10-17
+Revision:       Revision: 1.0
+
+Description:    This file provides the compact description of decoded IR timings by repeated segments
+
+Revision log:
+* 2026-10-17: created by agent
+**************************************************************************************/
+
+#include <string.h>
+
+#include "../include/ir_waveform.h"
+
+static BOOL segment_valid(const ir_waveform_t *waveform, const ir_segment_t *segment);
+
+
+void ir_waveform_init(ir_waveform_t *waveform, UINT16 *timings, UINT16 capacity)
+{
+    ir_memset(waveform, 0x00, sizeof(ir_waveform_t));
+    waveform->timings = timings;
+    waveform->capacity = capacity;
+}
+
+UINT ir_waveform_length(const ir_waveform_t *waveform)
+{
+    const ir_segment_t *segment = NULL;
+    UINT length = 0;
+    UINT8 i = 0;
+
+    for (i = 0; i < waveform->segment_count; i++)
+    {
+        segment = &waveform->segments[i];
+        if (FALSE == segment_valid(waveform, segment))
+        {
+            continue;
+        }
+        length += (UINT) segment->length * segment->repeat;
+        // a gap after a span ending with a mark is a space of its own
+        if (0 != segment->gap && 1 == (segment->length & 0x01))
+        {
+            length += segment->repeat - 1U;
+        }
+    }
+    return length;
+}
+
+UINT16 ir_waveform_flatten(const ir_waveform_t *waveform, UINT16 *user_data, UINT16 capacity)
+{
+    const ir_segment_t *segment = NULL;
+    UINT16 used = 0;
+    UINT16 repeat = 0;
+    UINT8 i = 0;
+
+    if (NULL == user_data || ir_waveform_length(waveform) > capacity)
+    {
+        return 0;
+    }
+    for (i = 0; i < waveform->segment_count; i++)
+    {
+        segment = &waveform->segments[i];
+        if (FALSE == segment_valid(waveform, segment))
+        {
+            continue;
+        }
+        for (repeat = 0; repeat < segment->repeat; repeat++)
+        {
+            ir_memcpy(user_data + used, waveform->timings + segment->offset, segment->length * sizeof(UINT16));
+            used = (UINT16) (used + segment->length);
+            if (0 == segment->gap || repeat + 1 == segment->repeat)
+            {
+                continue;
+            }
+            if (0 == (segment->length & 0x01))
+            {
+                user_data[used - 1] = (UINT16) (user_data[used - 1] + segment->gap);
+            }
+            else
+            {
+                user_data[used++] = segment->gap;
+            }
+        }
+    }
+    return used;
+}
+
+
+static BOOL segment_valid(const ir_waveform_t *waveform, const ir_segment_t *segment)
+{
+    return (0 != segment->length && 0 != segment->repeat &&
+            (UINT) segment->offset + segment->length <= waveform->used) ? TRUE : FALSE;
+}
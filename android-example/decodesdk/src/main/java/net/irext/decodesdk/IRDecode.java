@@ -1,5 +1,7 @@
 package net.irext.decodesdk;
 
+import java.nio.ByteBuffer;
+
 import net.irext.decodesdk.bean.ACStatus;
 import net.irext.decodesdk.bean.TemperatureRange;
 import net.irext.decodesdk.utils.Constants;
@@ -28,6 +30,17 @@ public class IRDecode {
 
     private native int[] irDecode(int keyCode, ACStatus acStatus, int changeWindDirection);
 
+    private native int irDecodeInto(int keyCode, int acPower, int acMode, int acTemp, int acWindSpeed,
+                                    int acWindDir, int changeWindDirection, int[] output);
+
+    private native int irDecodeDirect(int keyCode, int acPower, int acMode, int acTemp, int acWindSpeed,
+                                      int acWindDir, int changeWindDirection, ByteBuffer output);
+
+    private native int irMaxDecodeLength();
+
+    private native int[] irDecodeBatch(int[] keyCodes, ACStatus[] acStatuses, int[] changeWindDirections,
+                                       int gap, int[] offsets);
+
     private native void irClose();
 
     private native TemperatureRange irACGetTemperatureRange(int acMode);
@@ -40,6 +53,8 @@ public class IRDecode {
 
     private static IRDecode mInstance;
 
+    private static final ACStatus DEFAULT_AC_STATUS = new ACStatus();
+
     public static IRDecode getInstance() {
         if (null == mInstance) {
             mInstance = new IRDecode();
@@ -66,6 +81,40 @@ public class IRDecode {
         return irDecode(keyCode, acStatus, changeWindDir);
     }
 
+    // most timings the opened remote decodes to, the size of int[] or half the size of ByteBuffer to decode into
+    public int getMaxDecodeLength() {
+        return irMaxDecodeLength();
+    }
+
+    // decodes into a reused array, returns the number of timings or 0 if it failed or output is too short
+    public int decodeBinary(int keyCode, ACStatus acStatus, int changeWindDir, int[] output) {
+        if (null == acStatus) {
+            acStatus = DEFAULT_AC_STATUS;
+        }
+        return irDecodeInto(keyCode, acStatus.getACPower(), acStatus.getACMode(), acStatus.getACTemp(),
+                acStatus.getACWindSpeed(), acStatus.getACWindDir(), changeWindDir, output);
+    }
+
+    // decodes into a direct buffer as native order 16-bit timings, returns the number of timings
+    public int decodeBinary(int keyCode, ACStatus acStatus, int changeWindDir, ByteBuffer output) {
+        if (null == acStatus) {
+            acStatus = DEFAULT_AC_STATUS;
+        }
+        return irDecodeDirect(keyCode, acStatus.getACPower(), acStatus.getACMode(), acStatus.getACTemp(),
+                acStatus.getACWindSpeed(), acStatus.getACWindDir(), changeWindDir, output);
+    }
+
+    // keys of a scene decoded into a single schedule, offsets (optional) gets where each key starts
+    public int[] decodeBatch(int[] keyCodes, ACStatus[] acStatuses, int[] changeWindDirs, int gap, int[] offsets) {
+        if (null == acStatuses) {
+            acStatuses = new ACStatus[keyCodes.length];
+        }
+        if (null == changeWindDirs) {
+            changeWindDirs = new int[keyCodes.length];
+        }
+        return irDecodeBatch(keyCodes, acStatuses, changeWindDirs, gap, offsets);
+    }
+
     public void closeBinary() {
         irClose();
     }
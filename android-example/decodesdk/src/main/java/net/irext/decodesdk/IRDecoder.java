@@ -0,0 +1,206 @@
+package net.irext.decodesdk;
+
+import java.util.ArrayDeque;
+import java.util.concurrent.Callable;
+import java.util.concurrent.Executor;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+import java.util.concurrent.FutureTask;
+
+import net.irext.decodesdk.bean.ACStatus;
+import net.irext.decodesdk.bean.TemperatureRange;
+
+/**
+ * Filename:       IRDecoder.java
+ * Revised:        Date: 2026-10-17
+ * Revision:       Revision: 1.0
+ * <p>
+ * Description:    Decoder of a single opened remote, backed by its own native decoder instance
+ * <p>
+ * Revision log:
+ * 2026-10-17: created by agent
+ */
+public class IRDecoder implements AutoCloseable {
+
+    static {
+        System.loadLibrary("irdecode");
+    }
+
+    public interface OpenCallback {
+        // called on a decode thread, decoder is null if the remote failed to open
+        void onOpened(IRDecoder decoder);
+    }
+
+    public interface DecodeCallback {
+        // called on a decode thread, decoded is empty if the key failed to decode
+        void onDecoded(int[] decoded);
+    }
+
+    private static final ACStatus DEFAULT_AC_STATUS = new ACStatus();
+
+    // threads shared by every decoder, each one queues its own work on them through a SerialExecutor
+    private static final ExecutorService DECODE_POOL = Executors.newCachedThreadPool();
+
+    // runs tasks one at a time in the order they are submitted, on whatever thread of the pool is free
+    private static final class SerialExecutor implements Executor {
+        private final ArrayDeque<Runnable> mTasks = new ArrayDeque<Runnable>();
+        private Runnable mActive;
+
+        @Override
+        public synchronized void execute(final Runnable task) {
+            mTasks.offer(new Runnable() {
+                @Override
+                public void run() {
+                    try {
+                        task.run();
+                    } finally {
+                        scheduleNext();
+                    }
+                }
+            });
+            if (null == mActive) {
+                scheduleNext();
+            }
+        }
+
+        private synchronized void scheduleNext() {
+            mActive = mTasks.poll();
+            if (null != mActive) {
+                DECODE_POOL.execute(mActive);
+            }
+        }
+    }
+
+    private static native long irOpen(int category, int subCate, String fileName);
+
+    private static native long irOpenBinary(int category, int subCate, byte[] binaries, int binLength);
+
+    private static native int[] irDecode(long handle, int keyCode, int acPower, int acMode, int acTemp,
+                                         int acWindSpeed, int acWindDir, int changeWindDirection);
+
+    private static native int irDecodeInto(long handle, int keyCode, int acPower, int acMode, int acTemp,
+                                           int acWindSpeed, int acWindDir, int changeWindDirection, int[] output);
+
+    private static native int irMaxDecodeLength(long handle);
+
+    private static native void irClose(long handle);
+
+    private static native TemperatureRange irACGetTemperatureRange(long handle, int acMode);
+
+    private static native int irACGetSupportedMode(long handle);
+
+    private static native int irACGetSupportedWindSpeed(long handle, int acMode);
+
+    private static native int irACGetSupportedSwing(long handle, int acMode);
+
+    private static native int irACGetSupportedWindDirection(long handle);
+
+    // native ir_decoder_t of the opened remote, 0 once closed
+    private long mHandle;
+
+    // key presses of this remote are decoded in order, those of other remotes run alongside them
+    private final Executor mDecodeExecutor = new SerialExecutor();
+
+    private IRDecoder(long handle) {
+        mHandle = handle;
+    }
+
+    // returns null if the remote failed to open
+    public static IRDecoder openFile(int category, int subCate, String fileName) {
+        long handle = irOpen(category, subCate, fileName);
+        return (0 == handle) ? null : new IRDecoder(handle);
+    }
+
+    // returns null if the remote failed to open, binaries may be reused once this returns
+    public static IRDecoder openBinary(int category, int subCate, byte[] binaries, int binLength) {
+        long handle = irOpenBinary(category, subCate, binaries, binLength);
+        return (0 == handle) ? null : new IRDecoder(handle);
+    }
+
+    public static Future<IRDecoder> openFileAsync(final int category, final int subCate, final String fileName,
+                                                  final OpenCallback callback) {
+        return DECODE_POOL.submit(new Callable<IRDecoder>() {
+            @Override
+            public IRDecoder call() {
+                IRDecoder decoder = openFile(category, subCate, fileName);
+                if (null != callback) {
+                    callback.onOpened(decoder);
+                }
+                return decoder;
+            }
+        });
+    }
+
+    public synchronized int[] decode(int keyCode, ACStatus acStatus, int changeWindDir) {
+        if (0 == mHandle) {
+            return new int[0];
+        }
+        if (null == acStatus) {
+            acStatus = DEFAULT_AC_STATUS;
+        }
+        return irDecode(mHandle, keyCode, acStatus.getACPower(), acStatus.getACMode(), acStatus.getACTemp(),
+                acStatus.getACWindSpeed(), acStatus.getACWindDir(), changeWindDir);
+    }
+
+    // decodes into a reused array, returns the number of timings or 0 if it failed or output is too short
+    public synchronized int decode(int keyCode, ACStatus acStatus, int changeWindDir, int[] output) {
+        if (0 == mHandle) {
+            return 0;
+        }
+        if (null == acStatus) {
+            acStatus = DEFAULT_AC_STATUS;
+        }
+        return irDecodeInto(mHandle, keyCode, acStatus.getACPower(), acStatus.getACMode(), acStatus.getACTemp(),
+                acStatus.getACWindSpeed(), acStatus.getACWindDir(), changeWindDir, output);
+    }
+
+    // acStatus is read when the decode runs, it should not be changed meanwhile
+    public Future<int[]> decodeAsync(final int keyCode, final ACStatus acStatus, final int changeWindDir,
+                                     final DecodeCallback callback) {
+        FutureTask<int[]> task = new FutureTask<int[]>(new Callable<int[]>() {
+            @Override
+            public int[] call() {
+                int[] decoded = decode(keyCode, acStatus, changeWindDir);
+                if (null != callback) {
+                    callback.onDecoded(decoded);
+                }
+                return decoded;
+            }
+        });
+        mDecodeExecutor.execute(task);
+        return task;
+    }
+
+    public synchronized int getMaxDecodeLength() {
+        return (0 == mHandle) ? 0 : irMaxDecodeLength(mHandle);
+    }
+
+    public synchronized TemperatureRange getTemperatureRange(int acMode) {
+        return (0 == mHandle) ? null : irACGetTemperatureRange(mHandle, acMode);
+    }
+
+    public synchronized int getACSupportedMode() {
+        return (0 == mHandle) ? 0 : irACGetSupportedMode(mHandle);
+    }
+
+    public synchronized int getACSupportedWindSpeed(int acMode) {
+        return (0 == mHandle) ? 0 : irACGetSupportedWindSpeed(mHandle, acMode);
+    }
+
+    public synchronized int getACSupportedSwing(int acMode) {
+        return (0 == mHandle) ? 0 : irACGetSupportedSwing(mHandle, acMode);
+    }
+
+    public synchronized int getACSupportedWindDirection() {
+        return (0 == mHandle) ? 0 : irACGetSupportedWindDirection(mHandle);
+    }
+
+    @Override
+    public synchronized void close() {
+        if (0 != mHandle) {
+            irClose(mHandle);
+            mHandle = 0;
+        }
+    }
+}
@@ -0,0 +1,67 @@
+package net.irext.decodesdk.utils;
+
+import android.util.Log;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+
+import net.irext.decodesdk.IRDecode;
+import net.irext.decodesdk.bean.ACStatus;
+
+/**
+ * Filename:       DecodeBenchmark.java
+ * Revised:        Date: 2026-10-17
+ * Revision:       Revision: 1.0
+ * <p>
+ * Description:    Decodes per second of the remote opened by IRDecode through each decode path
+ * <p>
+ * Revision log:
+ * 2026-10-17: created by agent
+ */
+public class DecodeBenchmark {
+
+    private static final String TAG = DecodeBenchmark.class.getSimpleName();
+
+    private static final int WARM_UP_ROUNDS = 100;
+
+    // the remote is to be opened with IRDecode beforehand, a TV remote ignores acStatus
+    public static String run(IRDecode irDecode, int keyCode, ACStatus acStatus, int rounds) {
+        int maxLength = irDecode.getMaxDecodeLength();
+        int[] output = new int[maxLength];
+        ByteBuffer direct = ByteBuffer.allocateDirect(maxLength * 2).order(ByteOrder.nativeOrder());
+        long start;
+        double arrayRate;
+        double reusedRate;
+        double directRate;
+        int i;
+
+        for (i = 0; i < WARM_UP_ROUNDS; i++) {
+            irDecode.decodeBinary(keyCode, acStatus, 0);
+            irDecode.decodeBinary(keyCode, acStatus, 0, output);
+            irDecode.decodeBinary(keyCode, acStatus, 0, direct);
+        }
+
+        start = System.nanoTime();
+        for (i = 0; i < rounds; i++) {
+            irDecode.decodeBinary(keyCode, acStatus, 0);
+        }
+        arrayRate = rounds * 1e9 / (System.nanoTime() - start);
+
+        start = System.nanoTime();
+        for (i = 0; i < rounds; i++) {
+            irDecode.decodeBinary(keyCode, acStatus, 0, output);
+        }
+        reusedRate = rounds * 1e9 / (System.nanoTime() - start);
+
+        start = System.nanoTime();
+        for (i = 0; i < rounds; i++) {
+            irDecode.decodeBinary(keyCode, acStatus, 0, direct);
+        }
+        directRate = rounds * 1e9 / (System.nanoTime() - start);
+
+        String report = String.format("decodes/s: new int[] %.0f, reused int[] %.0f, direct buffer %.0f",
+                arrayRate, reusedRate, directRate);
+        Log.d(TAG, report);
+        return report;
+    }
+}